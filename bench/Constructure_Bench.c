@@ -0,0 +1,482 @@
+/*
+ * Throughput benchmarks for the Constructure
+ * containers; built by the constructure_bench target
+ * (configure with -DCONSTRUCTURE_BENCH=ON).
+ *
+ * Each benchmark times batches of operations and
+ * reports the 50th and 99th percentile of the per
+ * batch average as CSV on stdout, so runs can be
+ * diffed against a saved baseline
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Constructure.h"
+#include "PGUtil.h"
+#include "Trifecta_Time.h"
+#include "ZMath_MT.h"
+
+/* number of operations timed together as one sample */
+#define batchSize 64
+/* times each benchmark is repeated on a fresh setup */
+#define roundCount 5
+/* max samples any one benchmark collects */
+#define maxSampleCount 16384
+
+/* per batch durations in nanoseconds */
+static uint64_t samples[maxSampleCount];
+static uint64_t sampleScratch[maxSampleCount];
+static size_t sampleCount = 0u;
+
+static ZMT zmt;
+
+/* Discards the samples of the previous benchmark */
+static void samplesReset(){
+    sampleCount = 0u;
+}
+
+/* Records the duration of a batch of operations */
+static void samplesRecord(TimePoint start, TimePoint end){
+    if(sampleCount < maxSampleCount){
+        samples[sampleCount] = (uint64_t)timePointDiffNano(
+            end,
+            start
+        );
+        ++sampleCount;
+    }
+}
+
+/*
+ * Prints one CSV row for the samples collected since
+ * the last reset, each of which timed the given
+ * number of operations
+ */
+static void samplesReportPerOp(
+    const char *container,
+    const char *operation,
+    size_t elementCount,
+    float loadFactor,
+    size_t opsPerSample
+){
+    if(sampleCount == 0u){
+        return;
+    }
+    radixSortKeys64(samples, sampleScratch, sampleCount);
+    size_t p50Index = sampleCount / 2u;
+    size_t p99Index = (sampleCount * 99u) / 100u;
+    if(p99Index >= sampleCount){
+        p99Index = sampleCount - 1u;
+    }
+    printf(
+        "%s,%s,%zu,%.2f,%zu,%.2f,%.2f\n",
+        container,
+        operation,
+        elementCount,
+        loadFactor,
+        sampleCount,
+        ((double)samples[p50Index]) / opsPerSample,
+        ((double)samples[p99Index]) / opsPerSample
+    );
+}
+
+/*
+ * Prints one CSV row for the samples collected since
+ * the last reset, each of which timed a batch
+ */
+static void samplesReport(
+    const char *container,
+    const char *operation,
+    size_t elementCount,
+    float loadFactor
+){
+    samplesReportPerOp(
+        container,
+        operation,
+        elementCount,
+        loadFactor,
+        batchSize
+    );
+}
+
+/*
+ * Fills the given array with distinct pseudorandom
+ * int keys; the keys for indices in [0, count) never
+ * collide with those in [count, 2 * count)
+ */
+static void makeKeys(int *keysPtr, size_t count){
+    for(size_t i = 0u; i < count; ++i){
+        /* multiplying by an odd constant is a bijection */
+        keysPtr[i] = (int)((uint32_t)i * 2654435761u);
+    }
+}
+
+/* Shuffles the given int array in place */
+static void shuffle(int *arrayPtr, size_t count){
+    for(size_t i = count; i > 1u; --i){
+        size_t j = zmtUIntDie(&zmt, 0u, (uint32_t)(i - 1u));
+        int temp = arrayPtr[i - 1u];
+        arrayPtr[i - 1u] = arrayPtr[j];
+        arrayPtr[j] = temp;
+    }
+}
+
+/* Fills the given map with the given keys */
+static void hashMapFill(
+    HashMap *mapPtr,
+    const int *keysPtr,
+    size_t count
+){
+    for(size_t i = 0u; i < count; ++i){
+        hashMapPut(int, int, mapPtr, keysPtr[i], (int)i);
+    }
+}
+
+/*
+ * Benchmarks insert, lookup, and erase on an int to
+ * int hashmap presized so that the given number of
+ * elements sits at the given load factor
+ */
+static void benchHashMap(size_t count, float loadFactor){
+    size_t capacity = (size_t)(count / loadFactor) + 1u;
+    int *keysPtr = pgAlloc(count * 2u, sizeof(int));
+    makeKeys(keysPtr, count * 2u);
+    int *missKeysPtr = keysPtr + count;
+    volatile unsigned int sink = 0u;
+
+    /* insert */
+    samplesReset();
+    for(int round = 0; round < roundCount; ++round){
+        shuffle(keysPtr, count);
+        HashMap map = hashMapMake(
+            int, int, capacity, intHash, intEquals
+        );
+        for(size_t i = 0u; i + batchSize <= count;
+            i += batchSize
+        ){
+            TimePoint start = getCurrentTime();
+            hashMapFill(&map, keysPtr + i, batchSize);
+            samplesRecord(start, getCurrentTime());
+        }
+        hashMapFree(int, int, &map);
+    }
+    samplesReport("HashMap", "insert", count, loadFactor);
+
+    HashMap map = hashMapMake(
+        int, int, capacity, intHash, intEquals
+    );
+    hashMapFill(&map, keysPtr, count);
+
+    /* lookup of present keys */
+    samplesReset();
+    for(int round = 0; round < roundCount; ++round){
+        shuffle(keysPtr, count);
+        for(size_t i = 0u; i + batchSize <= count;
+            i += batchSize
+        ){
+            TimePoint start = getCurrentTime();
+            for(size_t j = 0u; j < batchSize; ++j){
+                sink += (unsigned int)*hashMapGetPtr(
+                    int, int, &map, &keysPtr[i + j]
+                );
+            }
+            samplesRecord(start, getCurrentTime());
+        }
+    }
+    samplesReport("HashMap", "lookup_hit", count, loadFactor);
+
+    /* lookup of absent keys */
+    samplesReset();
+    for(int round = 0; round < roundCount; ++round){
+        for(size_t i = 0u; i + batchSize <= count;
+            i += batchSize
+        ){
+            TimePoint start = getCurrentTime();
+            for(size_t j = 0u; j < batchSize; ++j){
+                sink += hashMapHasKeyPtr(
+                    int, int, &map, &missKeysPtr[i + j]
+                );
+            }
+            samplesRecord(start, getCurrentTime());
+        }
+    }
+    samplesReport("HashMap", "lookup_miss", count, loadFactor);
+    hashMapFree(int, int, &map);
+
+    /* erase */
+    samplesReset();
+    for(int round = 0; round < roundCount; ++round){
+        map = hashMapMake(
+            int, int, capacity, intHash, intEquals
+        );
+        hashMapFill(&map, keysPtr, count);
+        shuffle(keysPtr, count);
+        for(size_t i = 0u; i + batchSize <= count;
+            i += batchSize
+        ){
+            TimePoint start = getCurrentTime();
+            for(size_t j = 0u; j < batchSize; ++j){
+                hashMapRemovePtr(
+                    int, int, &map, &keysPtr[i + j]
+                );
+            }
+            samplesRecord(start, getCurrentTime());
+        }
+        hashMapFree(int, int, &map);
+    }
+    samplesReport("HashMap", "erase", count, loadFactor);
+
+    (void)sink;
+    pgFree(keysPtr);
+}
+
+/*
+ * Benchmarks push back, insert at a random index, and
+ * erase at a random index on an int arraylist
+ */
+static void benchArrayList(size_t count){
+    /* push back from a tiny list, including growth */
+    samplesReset();
+    for(int round = 0; round < roundCount; ++round){
+        ArrayList list = arrayListMake(int, 1);
+        for(size_t i = 0u; i + batchSize <= count;
+            i += batchSize
+        ){
+            TimePoint start = getCurrentTime();
+            for(size_t j = 0u; j < batchSize; ++j){
+                arrayListPushBack(int, &list, (int)j);
+            }
+            samplesRecord(start, getCurrentTime());
+        }
+        arrayListFree(int, &list);
+    }
+    samplesReport("ArrayList", "push_back", count, 0.0f);
+
+    /* insert at random index */
+    samplesReset();
+    for(int round = 0; round < roundCount; ++round){
+        ArrayList list = arrayListMake(int, 1);
+        arrayListPushBack(int, &list, 0);
+        for(size_t i = 0u; i + batchSize <= count;
+            i += batchSize
+        ){
+            TimePoint start = getCurrentTime();
+            for(size_t j = 0u; j < batchSize; ++j){
+                size_t index = zmtUIntDie(
+                    &zmt, 0u, (uint32_t)(list.size - 1u)
+                );
+                arrayListInsert(int, &list, index, (int)j);
+            }
+            samplesRecord(start, getCurrentTime());
+        }
+        arrayListFree(int, &list);
+    }
+    samplesReport("ArrayList", "insert_random", count, 0.0f);
+
+    /* erase at random index */
+    samplesReset();
+    for(int round = 0; round < roundCount; ++round){
+        ArrayList list = arrayListMake(int, count);
+        for(size_t i = 0u; i < count; ++i){
+            arrayListPushBack(int, &list, (int)i);
+        }
+        for(size_t i = 0u; i + batchSize <= count;
+            i += batchSize
+        ){
+            TimePoint start = getCurrentTime();
+            for(size_t j = 0u; j < batchSize; ++j){
+                size_t index = zmtUIntDie(
+                    &zmt, 0u, (uint32_t)(list.size - 1u)
+                );
+                arrayListErase(int, &list, index);
+            }
+            samplesRecord(start, getCurrentTime());
+        }
+        arrayListFree(int, &list);
+    }
+    samplesReport("ArrayList", "erase_random", count, 0.0f);
+}
+
+/*
+ * Benchmarks churn on an int sparse set held at half
+ * occupancy; each operation removes a present index
+ * and sets an absent one
+ */
+static void benchSparseSet(size_t sparseCapacity){
+    size_t liveCount = sparseCapacity / 2u;
+    int *indicesPtr = pgAlloc(sparseCapacity, sizeof(int));
+    for(size_t i = 0u; i < sparseCapacity; ++i){
+        indicesPtr[i] = (int)i;
+    }
+
+    samplesReset();
+    for(int round = 0; round < roundCount; ++round){
+        shuffle(indicesPtr, sparseCapacity);
+        SparseSet set = sparseSetMake(
+            int, sparseCapacity, liveCount
+        );
+        /* first half of indices are live */
+        for(size_t i = 0u; i < liveCount; ++i){
+            sparseSetSetPtr(
+                int, &set, indicesPtr[i], &indicesPtr[i]
+            );
+        }
+        for(size_t i = 0u; i + batchSize <= liveCount;
+            i += batchSize
+        ){
+            TimePoint start = getCurrentTime();
+            for(size_t j = 0u; j < batchSize; ++j){
+                int *removePtr = &indicesPtr[i + j];
+                int *addPtr = &indicesPtr[
+                    liveCount + i + j
+                ];
+                sparseSetRemove(int, &set, *removePtr);
+                sparseSetSetPtr(int, &set, *addPtr, addPtr);
+            }
+            samplesRecord(start, getCurrentTime());
+        }
+        sparseSetFree(int, &set);
+    }
+    samplesReport("SparseSet", "churn", sparseCapacity, 0.5f);
+    pgFree(indicesPtr);
+}
+
+/*
+ * Benchmarks constructing and freeing a string from
+ * a C string of the given length
+ */
+static void benchString(size_t length){
+    char *cStringPtr = pgAlloc(length + 1u, sizeof(char));
+    for(size_t i = 0u; i < length; ++i){
+        cStringPtr[i] = (char)('a' + (i % 26u));
+    }
+    cStringPtr[length] = '\0';
+
+    enum{ opsPerRound = 16384 };
+    volatile size_t sink = 0u;
+    samplesReset();
+    for(int round = 0; round < roundCount; ++round){
+        for(size_t i = 0u; i < opsPerRound; i += batchSize){
+            TimePoint start = getCurrentTime();
+            for(size_t j = 0u; j < batchSize; ++j){
+                String string = stringMakeC(cStringPtr);
+                sink += string.length;
+                stringFree(&string);
+            }
+            samplesRecord(start, getCurrentTime());
+        }
+    }
+    samplesReport("String", "make_free", length, 0.0f);
+    (void)sink;
+    pgFree(cStringPtr);
+}
+
+/* Orders radix pairs by key for qsort */
+static int comparePairs(const void *aPtr, const void *bPtr){
+    uint32_t a = ((const RadixPair32 *)aPtr)->key;
+    uint32_t b = ((const RadixPair32 *)bPtr)->key;
+    return (a > b) - (a < b);
+}
+
+/* Fills the given pair array with random keys */
+static void fillPairs(RadixPair32 *pairsPtr, size_t count){
+    for(size_t i = 0u; i < count; ++i){
+        pairsPtr[i].key = zmtRandUInt(&zmt);
+        pairsPtr[i].index = (uint32_t)i;
+    }
+}
+
+/*
+ * Benchmarks sorting random 32 bit key-index pairs
+ * with the radix sort and with qsort; each sample is
+ * one whole sort, reported per element
+ */
+static void benchSort(size_t count){
+    /* about a million elements sorted per sort type */
+    size_t sortCount = 1000000u / count;
+    if(sortCount < roundCount){
+        sortCount = roundCount;
+    }
+    RadixPair32 *pairsPtr = pgAlloc(
+        count,
+        sizeof(RadixPair32)
+    );
+    RadixPair32 *scratchPtr = pgAlloc(
+        count,
+        sizeof(RadixPair32)
+    );
+
+    samplesReset();
+    for(size_t i = 0u; i < sortCount; ++i){
+        fillPairs(pairsPtr, count);
+        TimePoint start = getCurrentTime();
+        radixSortPairs32(pairsPtr, scratchPtr, count);
+        samplesRecord(start, getCurrentTime());
+    }
+    for(size_t i = 1u; i < count; ++i){
+        assertTrue(
+            pairsPtr[i - 1u].key <= pairsPtr[i].key,
+            "radix sort out of order; " SRC_LOCATION
+        );
+    }
+    samplesReportPerOp(
+        "RadixSort", "pairs32", count, 0.0f, count
+    );
+
+    samplesReset();
+    for(size_t i = 0u; i < sortCount; ++i){
+        fillPairs(pairsPtr, count);
+        TimePoint start = getCurrentTime();
+        qsort(
+            pairsPtr,
+            count,
+            sizeof(RadixPair32),
+            comparePairs
+        );
+        samplesRecord(start, getCurrentTime());
+    }
+    samplesReportPerOp(
+        "qsort", "pairs32", count, 0.0f, count
+    );
+
+    pgFree(pairsPtr);
+    pgFree(scratchPtr);
+}
+
+int main(){
+    zmt = zmtMake(1234u);
+
+    printf(
+        "container,operation,elements,load_factor,"
+        "samples,p50_ns_per_op,p99_ns_per_op\n"
+    );
+
+    const size_t hashMapCounts[] = {1000u, 100000u};
+    const float loadFactors[] = {0.25f, 0.5f, 0.7f};
+    for(size_t i = 0u; i < 2u; ++i){
+        for(size_t j = 0u; j < 3u; ++j){
+            benchHashMap(hashMapCounts[i], loadFactors[j]);
+        }
+    }
+
+    /* insert and erase are linear, so stay smaller */
+    benchArrayList(1000u);
+    benchArrayList(10000u);
+
+    benchSparseSet(1000u);
+    benchSparseSet(100000u);
+
+    /* inline, longest inline, just past, and heap lengths */
+    benchString(8u);
+    benchString(15u);
+    benchString(16u);
+    benchString(64u);
+    benchString(256u);
+
+    benchSort(1000u);
+    benchSort(10000u);
+    benchSort(100000u);
+
+    zmtFree(&zmt);
+    return 0;
+}
@@ -0,0 +1,289 @@
+/*
+ * Stress check for the Constructure ring buffers;
+ * built by the constructure_ringbuffer_check target
+ * (configure with -DCONSTRUCTURE_BENCH=ON) and run by
+ * ctest.
+ *
+ * Producer threads push sequence numbers tagged with
+ * their producer index, alternating single pushes
+ * and batches, into buffers small enough to be full
+ * most of the time; the main thread consumes and
+ * exits nonzero if any element is lost, duplicated,
+ * or arrives out of order for its producer
+ */
+
+#include <stdio.h>
+
+#include "Constructure.h"
+#include "PGUtil.h"
+#include "Trifecta_Concurrency.h"
+
+/* elements pushed by every producer */
+#define elementsPerProducer 200000u
+#define mpscProducerCount 4u
+/* small capacities keep the buffers contended */
+#define spscCapacity 100u
+#define mpscCapacity 64u
+#define maxBatchSize 7u
+#define maxPopSize 13u
+
+/* Packs a producer index and sequence number */
+#define makeElement(PRODUCERINDEX, SEQUENCE) \
+    ((((uint64_t)(PRODUCERINDEX)) << 32u) \
+        | ((uint64_t)(SEQUENCE)))
+#define elementProducer(ELEMENT) \
+    ((uint32_t)((ELEMENT) >> 32u))
+#define elementSequence(ELEMENT) \
+    ((uint32_t)((ELEMENT) & 0xFFFFFFFFu))
+
+static SpscRingBuffer spscBuffer;
+static MpscRingBuffer mpscBuffer;
+
+/*
+ * Returns how many elements to push at once for the
+ * given sequence number; every third push is a
+ * single element and the others batches of varying
+ * size, clamped to the elements remaining
+ */
+static uint32_t pushCount(uint32_t sequence){
+    uint32_t count = (sequence % 3u == 0u)
+        ? 1u
+        : 2u + (sequence % (maxBatchSize - 1u));
+    uint32_t remaining = elementsPerProducer - sequence;
+    return count < remaining ? count : remaining;
+}
+
+/* Pushes every element of producer 0 to the spsc */
+static DECLARE_RUNNABLE_FUNC(spscProducer, arg){
+    initThread();
+    (void)arg;
+    uint64_t batch[maxBatchSize];
+    uint32_t sequence = 0u;
+    while(sequence < elementsPerProducer){
+        uint32_t count = pushCount(sequence);
+        size_t pushed = 0u;
+        if(count == 1u){
+            batch[0] = makeElement(0u, sequence);
+            pushed = spscRingBufferPushPtr(uint64_t,
+                &spscBuffer,
+                &(batch[0])
+            ) ? 1u : 0u;
+        }
+        else{
+            for(uint32_t i = 0u; i < count; ++i){
+                batch[i] = makeElement(0u, sequence + i);
+            }
+            pushed = spscRingBufferPushBatch(uint64_t,
+                &spscBuffer,
+                batch,
+                count
+            );
+        }
+        sequence += (uint32_t)pushed;
+        if(pushed == 0u){
+            threadYield();
+        }
+    }
+    return 0;
+}
+
+/*
+ * Pushes every element of the producer whose index
+ * is passed as the arg to the mpsc
+ */
+static DECLARE_RUNNABLE_FUNC(mpscProducer, arg){
+    initThread();
+    uint32_t producerIndex = (uint32_t)(uintptr_t)arg;
+    uint64_t batch[maxBatchSize];
+    uint32_t sequence = 0u;
+    while(sequence < elementsPerProducer){
+        uint32_t count = pushCount(sequence);
+        size_t pushed = 0u;
+        for(uint32_t i = 0u; i < count; ++i){
+            batch[i] = makeElement(
+                producerIndex,
+                sequence + i
+            );
+        }
+        if(count == 1u){
+            pushed = mpscRingBufferPushPtr(uint64_t,
+                &mpscBuffer,
+                &(batch[0])
+            ) ? 1u : 0u;
+        }
+        else{
+            pushed = mpscRingBufferPushBatch(uint64_t,
+                &mpscBuffer,
+                batch,
+                count
+            );
+        }
+        sequence += (uint32_t)pushed;
+        if(pushed == 0u){
+            threadYield();
+        }
+    }
+    return 0;
+}
+
+/*
+ * Checks the given popped element against the next
+ * sequence number expected of its producer; returns
+ * false and prints the failure if it does not match
+ */
+static bool checkElement(
+    const char *bufferName,
+    uint64_t element,
+    uint32_t *nextSequences,
+    uint32_t producerCount
+){
+    uint32_t producerIndex = elementProducer(element);
+    uint32_t sequence = elementSequence(element);
+    if(producerIndex >= producerCount){
+        printf(
+            "%s: bad producer %u\n",
+            bufferName,
+            producerIndex
+        );
+        return false;
+    }
+    uint32_t expected = nextSequences[producerIndex];
+    if(sequence != expected){
+        printf(
+            "%s: producer %u sent %u, expected %u (%s)\n",
+            bufferName,
+            producerIndex,
+            sequence,
+            expected,
+            sequence < expected
+                ? "duplicated or reordered"
+                : "lost or reordered"
+        );
+        return false;
+    }
+    ++(nextSequences[producerIndex]);
+    return true;
+}
+
+/*
+ * Consumes every element of a single producer from
+ * the spsc; returns true if all arrived in order
+ */
+static bool checkSpsc(){
+    spscBuffer = spscRingBufferMake(uint64_t, spscCapacity);
+    CreateReturn createReturn = threadCreate(
+        spscProducer,
+        NULL
+    );
+    assertTrue(
+        createReturn.success,
+        "failed to create producer; " SRC_LOCATION
+    );
+
+    uint32_t nextSequence = 0u;
+    uint64_t popped[maxPopSize];
+    bool success = true;
+    size_t popRound = 0u;
+    while(success && nextSequence < elementsPerProducer){
+        /* alternate single pops and batches */
+        size_t count = (popRound++ % 2u == 0u)
+            ? (spscRingBufferPopPtr(uint64_t,
+                &spscBuffer,
+                &(popped[0])
+            ) ? 1u : 0u)
+            : spscRingBufferPopBatch(uint64_t,
+                &spscBuffer,
+                popped,
+                maxPopSize
+            );
+        if(count == 0u){
+            threadYield();
+        }
+        for(size_t i = 0u; success && i < count; ++i){
+            success = checkElement(
+                "spsc",
+                popped[i],
+                &nextSequence,
+                1u
+            );
+        }
+    }
+
+    threadJoin(createReturn.thread);
+    if(success && spscRingBufferSize(&spscBuffer) != 0u){
+        printf("spsc: elements left after the last\n");
+        success = false;
+    }
+    spscRingBufferFree(uint64_t, &spscBuffer);
+    return success;
+}
+
+/*
+ * Consumes every element of several producers from
+ * the mpsc; returns true if all arrived exactly once
+ * and in order per producer
+ */
+static bool checkMpsc(){
+    mpscBuffer = mpscRingBufferMake(uint64_t, mpscCapacity);
+    Thread producers[mpscProducerCount];
+    for(uint32_t i = 0u; i < mpscProducerCount; ++i){
+        CreateReturn createReturn = threadCreate(
+            mpscProducer,
+            (void *)(uintptr_t)i
+        );
+        assertTrue(
+            createReturn.success,
+            "failed to create producer; " SRC_LOCATION
+        );
+        producers[i] = createReturn.thread;
+    }
+
+    uint32_t nextSequences[mpscProducerCount] = {0};
+    size_t remaining = elementsPerProducer
+        * mpscProducerCount;
+    uint64_t popped[maxPopSize];
+    bool success = true;
+    size_t popRound = 0u;
+    while(success && remaining > 0u){
+        size_t count = (popRound++ % 2u == 0u)
+            ? (mpscRingBufferPopPtr(uint64_t,
+                &mpscBuffer,
+                &(popped[0])
+            ) ? 1u : 0u)
+            : mpscRingBufferPopBatch(uint64_t,
+                &mpscBuffer,
+                popped,
+                maxPopSize
+            );
+        if(count == 0u){
+            threadYield();
+        }
+        for(size_t i = 0u; success && i < count; ++i){
+            success = checkElement(
+                "mpsc",
+                popped[i],
+                nextSequences,
+                mpscProducerCount
+            );
+        }
+        remaining -= count;
+    }
+
+    for(uint32_t i = 0u; i < mpscProducerCount; ++i){
+        threadJoin(producers[i]);
+    }
+    if(success && mpscRingBufferSize(&mpscBuffer) != 0u){
+        printf("mpsc: elements left after the last\n");
+        success = false;
+    }
+    mpscRingBufferFree(uint64_t, &mpscBuffer);
+    return success;
+}
+
+int main(){
+    bool spscSuccess = checkSpsc();
+    printf("spsc %s\n", spscSuccess ? "ok" : "FAILED");
+    bool mpscSuccess = checkMpsc();
+    printf("mpsc %s\n", mpscSuccess ? "ok" : "FAILED");
+    return (spscSuccess && mpscSuccess) ? 0 : 1;
+}
@@ -0,0 +1,830 @@
+/*
+ * Translates Necro scripts ahead of time to C; built
+ * by the necro_aot target (configure with
+ * -DNECRO_BENCH=ON).
+ *
+ *     necro_aot <output.c> <script.nec>...
+ *
+ * Every script and each function nested in it is
+ * compiled as usual, then each program becomes a C
+ * function which runs its bytecode the way the
+ * virtual machine would, minus the dispatch: jumps
+ * become gotos, operands become constants, the top
+ * of the stack lives in a local, and numbers take
+ * inline fast paths. Values stay on the stack of the
+ * virtual machine so that the collector sees them,
+ * and a yield saves the instruction pointer which the
+ * function jumps back to when resumed; anything else
+ * is stepped by the virtual machine itself. Calls and
+ * returns go back to the virtual machine, which hands
+ * the new top frame to its own translation if it has
+ * one. Scripts are compiled against the natives of
+ * the game, as listed in NativeFuncList.h, so that
+ * their code matches the game's. See Necro_Aot.h for
+ * how the output is built into a program and bound
+ * to scripts
+ */
+
+#include <stdio.h>
+
+#include "Constructure.h"
+#include "Necro.h"
+#include "Necro_GameNatives.h"
+#include "PGUtil.h"
+
+#define funcListInitCapacity 8
+
+/* printed name of each opcode */
+static const char *opcodeNames[] = {
+    [necro_literal] = "literal",
+    [necro_pop] = "pop",
+    [necro_defineGlobal] = "defineGlobal",
+    [necro_getGlobal] = "getGlobal",
+    [necro_setGlobal] = "setGlobal",
+    [necro_getLocal] = "getLocal",
+    [necro_setLocal] = "setLocal",
+    [necro_true] = "true",
+    [necro_false] = "false",
+    [necro_add] = "add",
+    [necro_subtract] = "subtract",
+    [necro_multiply] = "multiply",
+    [necro_divide] = "divide",
+    [necro_modulo] = "modulo",
+    [necro_negate] = "negate",
+    [necro_addVectors] = "addVectors",
+    [necro_subtractVectors] = "subtractVectors",
+    [necro_addPointVector] = "addPointVector",
+    [necro_subtractPointVector] = "subtractPointVector",
+    [necro_subtractPoints] = "subtractPoints",
+    [necro_multiplyVector] = "multiplyVector",
+    [necro_divideVector] = "divideVector",
+    [necro_equal] = "equal",
+    [necro_greater] = "greater",
+    [necro_less] = "less",
+    [necro_not] = "not",
+    [necro_makeVector] = "makeVector",
+    [necro_makePoint] = "makePoint",
+    [necro_getR] = "getR",
+    [necro_getTheta] = "getTheta",
+    [necro_getX] = "getX",
+    [necro_getY] = "getY",
+    [necro_setRGlobal] = "setRGlobal",
+    [necro_setThetaGlobal] = "setThetaGlobal",
+    [necro_setXGlobal] = "setXGlobal",
+    [necro_setYGlobal] = "setYGlobal",
+    [necro_setRLocal] = "setRLocal",
+    [necro_setThetaLocal] = "setThetaLocal",
+    [necro_setXLocal] = "setXLocal",
+    [necro_setYLocal] = "setYLocal",
+    [necro_print] = "print",
+    [necro_jump] = "jump",
+    [necro_jumpIfFalse] = "jumpIfFalse",
+    [necro_loop] = "loop",
+    [necro_call] = "call",
+    [necro_callNative] = "callNative",
+    [necro_callNativeFast] = "callNativeFast",
+    [necro_return] = "return",
+    [necro_yield] = "yield",
+    [necro_sleep] = "sleep",
+    [necro_end] = "end",
+    [necro_addLocalLiteral] = "addLocalLiteral",
+    [necro_lessLocalLiteralJump] = "lessLocalLiteralJump",
+    [necro_greaterLocalLiteralJump]
+        = "greaterLocalLiteralJump",
+    [necro_callPop] = "callPop",
+    [necro_pointDistance] = "pointDistance",
+    [necro_pointAngle] = "pointAngle",
+    [necro_callNativePop] = "callNativePop",
+    [necro_callNativeFastPop] = "callNativeFastPop",
+};
+
+/* What the instructions of a program need */
+typedef struct ProgramInfo{
+    /*
+     * for each offset, whether the translation needs
+     * a label there, as a jump target or a place the
+     * program can be resumed from
+     */
+    bool *labels;
+    /* whether the program reads its literals */
+    bool usesLiterals;
+} ProgramInfo;
+
+/*
+ * Returns the 16 bit operand at the specified offset
+ * of the given code
+ */
+static uint16_t readShort(uint8_t *code, size_t offset){
+    return (uint16_t)((code[offset] << 8) | code[offset + 1]);
+}
+
+/*
+ * Returns the info of the specified program; errors
+ * if its code is malformed. The labels must be freed
+ */
+static ProgramInfo programInfoMake(NecroProgram *programPtr){
+    uint8_t *code = programPtr->code._ptr;
+    size_t codeSize = programPtr->code.size;
+    ProgramInfo toRet = {0};
+    toRet.labels = pgAlloc(codeSize + 1, sizeof(bool));
+    /* every program starts at its first instruction */
+    toRet.labels[0] = true;
+
+    size_t offset = 0;
+    while(offset < codeSize){
+        uint8_t opcode = code[offset];
+        size_t length = necroInstructionLength(opcode);
+        assertTrue(
+            length > 0 && offset + length <= codeSize,
+            "malformed Necro code; " SRC_LOCATION
+        );
+        size_t next = offset + length;
+        switch(opcode){
+            case necro_literal:
+            case necro_addLocalLiteral:
+                toRet.usesLiterals = true;
+                break;
+            case necro_jump:
+            case necro_jumpIfFalse:
+                toRet.labels[
+                    next + readShort(code, offset + 1)
+                ] = true;
+                break;
+            case necro_loop:
+                toRet.labels[
+                    next - readShort(code, offset + 1)
+                ] = true;
+                break;
+            case necro_lessLocalLiteralJump:
+            case necro_greaterLocalLiteralJump:
+                toRet.usesLiterals = true;
+                toRet.labels[
+                    next + readShort(code, offset + 4)
+                ] = true;
+                break;
+            /* frames are resumed right after these */
+            case necro_call:
+            case necro_yield:
+            case necro_sleep:
+                toRet.labels[next] = true;
+                break;
+            /* or at the pop of this one */
+            case necro_callPop:
+                toRet.labels[offset + 2] = true;
+                toRet.labels[next] = true;
+                break;
+            default:
+                break;
+        }
+        offset = next;
+    }
+    return toRet;
+}
+
+/*
+ * Writes the expression for the slots of the frame
+ * the specified number of access links away
+ */
+static void writeSlots(FILE *filePtr, uint8_t jumps){
+    fprintf(filePtr, "framePtr");
+    for(uint8_t i = 0; i < jumps; ++i){
+        fprintf(filePtr, "->accessPtr");
+    }
+    fprintf(filePtr, "->slots");
+}
+
+/*
+ * Writes the expression for the local in the
+ * specified slot of the frame the given number of
+ * access links away
+ */
+static void writeLocal(
+    FILE *filePtr,
+    uint8_t slot,
+    uint8_t jumps
+){
+    if(jumps == 0){
+        fprintf(filePtr, "slots[%u]", (unsigned)slot);
+    }
+    else{
+        writeSlots(filePtr, jumps);
+        fprintf(filePtr, "[%u]", (unsigned)slot);
+    }
+}
+
+/*
+ * Writes a binary arithmetic or comparison operator
+ * with inline paths for two ints and, if the given
+ * bool is true, for two floats; other operands are
+ * stepped by the virtual machine
+ */
+static void writeBinaryNumber(
+    FILE *filePtr,
+    size_t offset,
+    const char *operator,
+    bool pushBool,
+    bool withFloats
+){
+    fprintf(
+        filePtr,
+        "    if(necroIsInt(sp[-2]) "
+        "&& necroIsInt(sp[-1])){\n"
+        "        sp[-2] = %s(\n"
+        "            necroAsInt(sp[-2]) %s "
+        "necroAsInt(sp[-1])\n"
+        "        );\n"
+        "        --sp;\n"
+        "    }\n",
+        pushBool ? "necroBoolValue" : "necroIntValue",
+        operator
+    );
+    if(withFloats){
+        fprintf(
+            filePtr,
+            "    else if(necroIsFloat(sp[-2]) "
+            "&& necroIsFloat(sp[-1])){\n"
+            "        sp[-2] = %s(\n"
+            "            necroAsFloat(sp[-2]) %s "
+            "necroAsFloat(sp[-1])\n"
+            "        );\n"
+            "        --sp;\n"
+            "    }\n",
+            pushBool ? "necroBoolValue" : "necroFloatValue",
+            operator
+        );
+    }
+    fprintf(
+        filePtr,
+        "    else{\n"
+        "        necroAotStep(%zu);\n"
+        "    }\n",
+        offset
+    );
+}
+
+/*
+ * Writes a member get of the value on top of the
+ * stack, which is stepped if it has the wrong type
+ */
+static void writeMemberGet(
+    FILE *filePtr,
+    size_t offset,
+    const char *typeName,
+    const char *memberName
+){
+    fprintf(
+        filePtr,
+        "    if(necroIs%s(sp[-1])){\n"
+        "        sp[-1] = necroFloatValue(\n"
+        "            necroAs%s(sp[-1]).%s\n"
+        "        );\n"
+        "    }\n"
+        "    else{\n"
+        "        necroAotStep(%zu);\n"
+        "    }\n",
+        typeName,
+        typeName,
+        memberName,
+        offset
+    );
+}
+
+/*
+ * Writes a fused compare of a local to a literal
+ * which jumps to the specified target if false
+ */
+static void writeLocalLiteralCompareJump(
+    FILE *filePtr,
+    uint8_t *code,
+    size_t offset,
+    size_t target,
+    const char *operator
+){
+    uint8_t slot = code[offset + 1];
+    uint8_t jumps = code[offset + 2];
+    unsigned index = code[offset + 3];
+    fprintf(filePtr, "    if(necroIsInt(");
+    writeLocal(filePtr, slot, jumps);
+    fprintf(
+        filePtr,
+        ") && necroIsInt(literals[%u])){\n"
+        "        bool condition = necroAsInt(",
+        index
+    );
+    writeLocal(filePtr, slot, jumps);
+    fprintf(
+        filePtr,
+        ")\n"
+        "            %s necroAsInt(literals[%u]);\n"
+        "        necroAotPush(necroBoolValue(condition));\n"
+        "        if(!condition){\n"
+        "            goto op%zu;\n"
+        "        }\n"
+        "    }\n"
+        "    else{\n"
+        "        necroAotStep(%zu);\n"
+        "        if(framePtr->instructionPtr "
+        "!= code + %zu){\n"
+        "            goto op%zu;\n"
+        "        }\n"
+        "    }\n",
+        operator,
+        index,
+        target,
+        offset,
+        offset + 6,
+        target
+    );
+}
+
+/*
+ * Writes the translation of the instruction at the
+ * specified offset of the given code
+ */
+static void writeInstruction(
+    FILE *filePtr,
+    uint8_t *code,
+    size_t offset
+){
+    uint8_t opcode = code[offset];
+    size_t next = offset + necroInstructionLength(opcode);
+    switch(opcode){
+        case necro_literal:
+            fprintf(
+                filePtr,
+                "    necroAotPush(literals[%u]);\n",
+                (unsigned)code[offset + 1]
+            );
+            break;
+        case necro_pop:
+            fprintf(filePtr, "    --sp;\n");
+            break;
+        case necro_getLocal:
+            fprintf(filePtr, "    necroAotPush(");
+            writeLocal(
+                filePtr,
+                code[offset + 1],
+                code[offset + 2]
+            );
+            fprintf(filePtr, ");\n");
+            break;
+        case necro_setLocal:
+            fprintf(filePtr, "    ");
+            writeLocal(
+                filePtr,
+                code[offset + 1],
+                code[offset + 2]
+            );
+            fprintf(filePtr, " = sp[-1];\n");
+            break;
+        case necro_true:
+        case necro_false:
+            fprintf(
+                filePtr,
+                "    necroAotPush(necroBoolValue(%s));\n",
+                opcode == necro_true ? "true" : "false"
+            );
+            break;
+        case necro_add:
+            writeBinaryNumber(filePtr, offset, "+", false, true);
+            break;
+        case necro_subtract:
+            writeBinaryNumber(filePtr, offset, "-", false, true);
+            break;
+        case necro_multiply:
+            writeBinaryNumber(filePtr, offset, "*", false, true);
+            break;
+        case necro_divide:
+            writeBinaryNumber(filePtr, offset, "/", false, true);
+            break;
+        case necro_modulo:
+            writeBinaryNumber(
+                filePtr,
+                offset,
+                "%",
+                false,
+                false
+            );
+            break;
+        case necro_greater:
+            writeBinaryNumber(filePtr, offset, ">", true, true);
+            break;
+        case necro_less:
+            writeBinaryNumber(filePtr, offset, "<", true, true);
+            break;
+        case necro_negate:
+            fprintf(
+                filePtr,
+                "    if(necroIsInt(sp[-1])){\n"
+                "        sp[-1] = necroIntValue("
+                "-necroAsInt(sp[-1]));\n"
+                "    }\n"
+                "    else if(necroIsFloat(sp[-1])){\n"
+                "        sp[-1] = necroFloatValue("
+                "-necroAsFloat(sp[-1]));\n"
+                "    }\n"
+                "    else{\n"
+                "        necroAotStep(%zu);\n"
+                "    }\n",
+                offset
+            );
+            break;
+        case necro_equal:
+            fprintf(
+                filePtr,
+                "    sp[-2] = necroBoolValue("
+                "necroValueEquals(sp[-2], sp[-1]));\n"
+                "    --sp;\n"
+            );
+            break;
+        case necro_not:
+            fprintf(
+                filePtr,
+                "    if(necroIsBool(sp[-1])){\n"
+                "        sp[-1] = necroBoolValue("
+                "!necroAsBool(sp[-1]));\n"
+                "    }\n"
+                "    else{\n"
+                "        necroAotStep(%zu);\n"
+                "    }\n",
+                offset
+            );
+            break;
+        case necro_getR:
+            writeMemberGet(filePtr, offset, "Vector", "magnitude");
+            break;
+        case necro_getTheta:
+            writeMemberGet(filePtr, offset, "Vector", "angle");
+            break;
+        case necro_getX:
+            writeMemberGet(filePtr, offset, "Point", "x");
+            break;
+        case necro_getY:
+            writeMemberGet(filePtr, offset, "Point", "y");
+            break;
+        case necro_jump:
+            fprintf(
+                filePtr,
+                "    goto op%zu;\n",
+                next + readShort(code, offset + 1)
+            );
+            break;
+        case necro_jumpIfFalse:
+            fprintf(
+                filePtr,
+                "    if(necroIsBool(sp[-1]) "
+                "&& !necroAsBool(sp[-1])){\n"
+                "        goto op%zu;\n"
+                "    }\n",
+                next + readShort(code, offset + 1)
+            );
+            break;
+        case necro_loop:
+            fprintf(
+                filePtr,
+                "    goto op%zu;\n",
+                next - readShort(code, offset + 1)
+            );
+            break;
+        case necro_callPop:
+            /* a script func comes back at the pop */
+            fprintf(
+                filePtr,
+                "    necroAotStep(%zu);\n"
+                "    goto op%zu;\n"
+                "op%zu:\n"
+                "    --sp;\n",
+                offset,
+                next,
+                offset + 2
+            );
+            break;
+        case necro_return:
+            fprintf(
+                filePtr,
+                "    necroAotExit(\n"
+                "        %zu,\n"
+                "        necroVirtualMachineStep("
+                "vmPtr, framePtr)\n"
+                "    );\n",
+                offset
+            );
+            break;
+        case necro_yield:
+            fprintf(
+                filePtr,
+                "    necroAotExit(%zu, necro_stepYielded);\n",
+                next
+            );
+            break;
+        case necro_end:
+            fprintf(
+                filePtr,
+                "    necroAotExit(%zu, necro_stepSuccess);\n",
+                next
+            );
+            break;
+        case necro_addLocalLiteral: {
+            uint8_t slot = code[offset + 1];
+            uint8_t jumps = code[offset + 2];
+            unsigned index = code[offset + 3];
+            fprintf(filePtr, "    if(necroIsInt(");
+            writeLocal(filePtr, slot, jumps);
+            fprintf(
+                filePtr,
+                ") && necroIsInt(literals[%u])){\n"
+                "        ",
+                index
+            );
+            writeLocal(filePtr, slot, jumps);
+            fprintf(filePtr, " = necroIntValue(\n"
+                "            necroAsInt(");
+            writeLocal(filePtr, slot, jumps);
+            fprintf(
+                filePtr,
+                ") + necroAsInt(literals[%u])\n"
+                "        );\n"
+                "        necroAotPush(",
+                index
+            );
+            writeLocal(filePtr, slot, jumps);
+            fprintf(
+                filePtr,
+                ");\n"
+                "    }\n"
+                "    else{\n"
+                "        necroAotStep(%zu);\n"
+                "    }\n",
+                offset
+            );
+            break;
+        }
+        case necro_lessLocalLiteralJump:
+            writeLocalLiteralCompareJump(
+                filePtr,
+                code,
+                offset,
+                next + readShort(code, offset + 4),
+                "<"
+            );
+            break;
+        case necro_greaterLocalLiteralJump:
+            writeLocalLiteralCompareJump(
+                filePtr,
+                code,
+                offset,
+                next + readShort(code, offset + 4),
+                ">"
+            );
+            break;
+        /*
+         * globals, vectors, member sets, print, calls,
+         * and sleep are left to the virtual machine
+         */
+        default:
+            fprintf(
+                filePtr,
+                "    necroAotStep(%zu);\n",
+                offset
+            );
+            break;
+    }
+}
+
+/*
+ * Writes the function translating the program of the
+ * specified function, named after the given script
+ * and program indices
+ */
+static void writeProgram(
+    FILE *filePtr,
+    NecroObjectFunc *funcPtr,
+    const char *scriptName,
+    size_t scriptIndex,
+    size_t programIndex
+){
+    NecroProgram *programPtr = &(funcPtr->program);
+    uint8_t *code = programPtr->code._ptr;
+    size_t codeSize = programPtr->code.size;
+    ProgramInfo info = programInfoMake(programPtr);
+
+    fprintf(
+        filePtr,
+        "/* %s, %s */\n"
+        "static NecroStepResult "
+        "necroAotScript%zuProgram%zu(\n"
+        "    NecroVirtualMachine *vmPtr,\n"
+        "    NecroCallFrame *framePtr\n"
+        "){\n"
+        "    uint8_t *code = "
+        "framePtr->funcPtr->program.code._ptr;\n",
+        scriptName,
+        funcPtr->namePtr
+            ? stringCharPtr(&(funcPtr->namePtr->string))
+            : "script",
+        scriptIndex,
+        programIndex
+    );
+    if(info.usesLiterals){
+        fprintf(
+            filePtr,
+            "    NecroValue *literals = framePtr->funcPtr"
+            "->program.literals.literals._ptr;\n"
+        );
+    }
+    fprintf(
+        filePtr,
+        "    NecroValue *slots = framePtr->slots;\n"
+        "    NecroValue *sp = vmPtr->stackPtr;\n"
+        "    (void)slots;\n"
+        "\n"
+        "    /* carry on from where the frame left off */\n"
+        "    switch(framePtr->instructionPtr - code){\n"
+    );
+    for(size_t offset = 0; offset < codeSize; ++offset){
+        if(info.labels[offset]){
+            fprintf(
+                filePtr,
+                "        case %zu: goto op%zu;\n",
+                offset,
+                offset
+            );
+        }
+    }
+    fprintf(
+        filePtr,
+        "        default:\n"
+        "            pgError(\n"
+        "                \"bad resume of translated "
+        "Necro code; \"\n"
+        "                SRC_LOCATION\n"
+        "            );\n"
+        "            return necro_stepRuntimeError;\n"
+        "    }\n"
+    );
+
+    size_t offset = 0;
+    while(offset < codeSize){
+        uint8_t opcode = code[offset];
+        if(info.labels[offset]){
+            fprintf(filePtr, "op%zu:\n", offset);
+        }
+        fprintf(
+            filePtr,
+            "    /* line %u: %s */\n",
+            (unsigned)arrayListGet(uint16_t,
+                &(programPtr->lineNumbers),
+                offset
+            ),
+            opcodeNames[opcode]
+        );
+        writeInstruction(filePtr, code, offset);
+        offset += necroInstructionLength(opcode);
+    }
+    fprintf(filePtr, "}\n\n");
+    pgFree(info.labels);
+}
+
+/*
+ * Writes the translation of the specified script and
+ * its table of programs
+ */
+static void writeScript(
+    FILE *filePtr,
+    NecroObjectFunc *scriptPtr,
+    const char *scriptName,
+    size_t scriptIndex
+){
+    for(const char *charPtr = scriptName;
+        *charPtr;
+        ++charPtr
+    ){
+        assertFalse(
+            *charPtr == '"' || *charPtr == '\\',
+            "script name cannot be written to C; "
+            SRC_LOCATION
+        );
+    }
+
+    ArrayList funcList = arrayListMake(NecroObjectFunc*,
+        funcListInitCapacity
+    );
+    necroAotListFuncs(scriptPtr, &funcList);
+    for(size_t i = 0; i < funcList.size; ++i){
+        writeProgram(
+            filePtr,
+            arrayListGet(NecroObjectFunc*, &funcList, i),
+            scriptName,
+            scriptIndex,
+            i
+        );
+    }
+
+    fprintf(
+        filePtr,
+        "static const NecroAotProgram "
+        "necroAotScript%zuPrograms[] = {\n",
+        scriptIndex
+    );
+    for(size_t i = 0; i < funcList.size; ++i){
+        NecroProgram *programPtr = &(arrayListGet(
+            NecroObjectFunc*,
+            &funcList,
+            i
+        )->program);
+        fprintf(
+            filePtr,
+            "    {necroAotScript%zuProgram%zu, %zuu, "
+            "0x%08lxu},\n",
+            scriptIndex,
+            i,
+            programPtr->code.size,
+            (unsigned long)necroAotHashCode(programPtr)
+        );
+    }
+    fprintf(
+        filePtr,
+        "};\n"
+        "\n"
+        "static const NecroAotScript "
+        "necroAotScript%zu = {\n"
+        "    \"%s\",\n"
+        "    necroAotScript%zuPrograms,\n"
+        "    %zuu\n"
+        "};\n"
+        "\n",
+        scriptIndex,
+        scriptName,
+        scriptIndex,
+        funcList.size
+    );
+    arrayListFree(NecroObjectFunc*, &funcList);
+}
+
+int main(int argc, char **argv){
+    if(argc < 3){
+        fprintf(
+            stderr,
+            "usage: necro_aot <output.c> <script.nec>...\n"
+        );
+        return 1;
+    }
+
+    FILE *filePtr = fopen(argv[1], "w");
+    if(!filePtr){
+        pgWarning(argv[1]);
+        pgError("failed to open output; " SRC_LOCATION);
+        return 1;
+    }
+    fprintf(
+        filePtr,
+        "/*\n"
+        " * Ahead of time translation of Necro scripts, "
+        "written\n"
+        " * by necro_aot; build with NECRO_AOT defined "
+        "and do\n"
+        " * not edit\n"
+        " */\n"
+        "\n"
+        "#include \"Necro.h\"\n"
+        "#include \"PGUtil.h\"\n"
+        "\n"
+    );
+
+    NecroNativeFuncSet nativeFuncSet
+        = necroGameNativesMake();
+    int scriptCount = argc - 2;
+    for(int i = 0; i < scriptCount; ++i){
+        const char *fileName = argv[i + 2];
+        NecroCompiler compiler = necroCompilerMakeNatives(
+            NULL,
+            &nativeFuncSet
+        );
+        NecroObjectFunc *scriptPtr
+            = necroCompilerCompileScript(
+                &compiler,
+                fileName
+            );
+        necroCompilerFree(&compiler);
+        writeScript(
+            filePtr,
+            scriptPtr,
+            necroAotScriptName(fileName),
+            (size_t)i
+        );
+        necroObjectFree((NecroObject*)scriptPtr);
+    }
+
+    fprintf(filePtr, "void necroAotRegisterScripts(){\n");
+    for(int i = 0; i < scriptCount; ++i){
+        fprintf(
+            filePtr,
+            "    necroAotRegister(&necroAotScript%d);\n",
+            i
+        );
+    }
+    fprintf(filePtr, "}\n");
+    fclose(filePtr);
+    necroNativeFuncSetFree(&nativeFuncSet);
+    return 0;
+}
\ No newline at end of file
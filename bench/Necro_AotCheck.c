@@ -0,0 +1,353 @@
+/*
+ * Checks that ahead of time translated Necro scripts
+ * behave exactly like the interpreted scripts; built
+ * by the necro_aot_check target (configure with
+ * -DNECRO_BENCH=ON) together with the translation of
+ * necro_bench.nec, necro_aot.nec, and necro_game.nec.
+ *
+ *     necro_aot_check <script.nec>...
+ *
+ * Scripts are compiled and run against stubs of the
+ * natives of the game, as necro_aot compiles them.
+ * Each script is compiled once before the translated
+ * scripts are registered, so that it is interpreted,
+ * and once after, so that it is bound to its
+ * translation if there is one. Both are run to the
+ * end, resumed after every yield as the script system
+ * would, and the trace of each is recorded: the
+ * result, sleep, stack, and globals after every run.
+ * Prints whether each script was bound and whether
+ * its traces match as CSV on stdout, and exits with 1
+ * if any script was not bound or any trace differs;
+ * ctest runs it on every translated script. Profiled
+ * scripts are never bound, so with NECRO_PROFILE it
+ * only compares the traces and exits with the skip
+ * code ctest is given
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Constructure.h"
+#include "Necro.h"
+#include "Necro_GameNatives.h"
+#include "PGUtil.h"
+
+/* most runs of a script before it is cut off */
+#define maxRunCount 100000
+#define valueBufferSize 128
+#define globalListInitCapacity 16
+/* matches SKIP_RETURN_CODE of the ctest test */
+#define skipReturnCode 77
+
+/* the list globals are written to while traced */
+static ArrayList *globalListPtr = NULL;
+
+/* stubs of the natives of the game, as in necro_aot */
+static NecroNativeFuncSet nativeFuncSet;
+
+/*
+ * Appends a description of the specified value to the
+ * given trace
+ */
+static void appendValue(String *tracePtr, NecroValue value){
+    char buffer[valueBufferSize] = {0};
+    switch(necroValueGetType(value)){
+        case necro_bool:
+            snprintf(
+                buffer,
+                valueBufferSize,
+                "bool %d",
+                (int)necroAsBool(value)
+            );
+            break;
+        case necro_int:
+            snprintf(
+                buffer,
+                valueBufferSize,
+                "int %d",
+                necroAsInt(value)
+            );
+            break;
+        /* hex floats so that no bit goes unseen */
+        case necro_float:
+            snprintf(
+                buffer,
+                valueBufferSize,
+                "float %a",
+                (double)necroAsFloat(value)
+            );
+            break;
+        case necro_vector: {
+            Polar vector = necroAsVector(value);
+            snprintf(
+                buffer,
+                valueBufferSize,
+                "vector %a %a",
+                (double)vector.magnitude,
+                (double)vector.angle
+            );
+            break;
+        }
+        case necro_point: {
+            Point2D point = necroAsPoint(value);
+            snprintf(
+                buffer,
+                valueBufferSize,
+                "point %a %a",
+                (double)point.x,
+                (double)point.y
+            );
+            break;
+        }
+        case necro_object:
+            switch(necroObjectGetType(value)){
+                case necro_stringObject:
+                    stringAppendC(tracePtr, "string ");
+                    stringAppend(
+                        tracePtr,
+                        &(necroObjectAsString(value)
+                            ->string)
+                    );
+                    return;
+                case necro_funcObject: {
+                    NecroObjectFunc *funcPtr
+                        = necroObjectAsFunc(value);
+                    stringAppendC(tracePtr, "func ");
+                    if(funcPtr->namePtr){
+                        stringAppend(
+                            tracePtr,
+                            &(funcPtr->namePtr->string)
+                        );
+                    }
+                    return;
+                }
+                default:
+                    snprintf(buffer, valueBufferSize, "native");
+                    break;
+            }
+            break;
+        default:
+            snprintf(buffer, valueBufferSize, "invalid");
+            break;
+    }
+    stringAppendC(tracePtr, buffer);
+}
+
+/*
+ * Describes the specified global and pushes it to the
+ * global list; for use with hashmap apply
+ */
+static void pushGlobal(
+    NecroObjectString **namePtrPtr,
+    NecroValue *valuePtr
+){
+    String global = stringMakeC("  ");
+    stringAppend(&global, &((*namePtrPtr)->string));
+    stringAppendC(&global, " = ");
+    appendValue(&global, *valuePtr);
+    stringAppendC(&global, "\n");
+    arrayListPushBack(String, globalListPtr, global);
+}
+
+/* Compares two Strings by their characters for qsort */
+static int compareStrings(
+    const void *stringPtr1,
+    const void *stringPtr2
+){
+    return strcmp(
+        stringCharPtr((String*)stringPtr1),
+        stringCharPtr((String*)stringPtr2)
+    );
+}
+
+/*
+ * Appends the state of the specified virtual machine
+ * after a run with the given result to the given
+ * trace; globals are sorted by name since the
+ * hashmap has no order
+ */
+static void appendState(
+    String *tracePtr,
+    NecroVirtualMachine *vmPtr,
+    NecroInterpretResult result
+){
+    char buffer[valueBufferSize] = {0};
+    snprintf(
+        buffer,
+        valueBufferSize,
+        "run: result %d, sleep %d, frames %d\n",
+        (int)result,
+        vmPtr->sleepTicks,
+        vmPtr->frameCount
+    );
+    stringAppendC(tracePtr, buffer);
+    for(NecroValue *valuePtr = vmPtr->stack;
+        valuePtr < vmPtr->stackPtr;
+        ++valuePtr
+    ){
+        stringAppendC(tracePtr, "  [");
+        appendValue(tracePtr, *valuePtr);
+        stringAppendC(tracePtr, "]\n");
+    }
+
+    ArrayList globalList = arrayListMake(String,
+        globalListInitCapacity
+    );
+    globalListPtr = &globalList;
+    hashMapKeyValueApply(NecroObjectString*,
+        NecroValue,
+        &(vmPtr->globalsMap),
+        pushGlobal
+    );
+    globalListPtr = NULL;
+    qsort(
+        globalList._ptr,
+        globalList.size,
+        sizeof(String),
+        compareStrings
+    );
+    for(size_t i = 0; i < globalList.size; ++i){
+        String *globalPtr = arrayListGetPtr(String,
+            &globalList,
+            i
+        );
+        stringAppend(tracePtr, globalPtr);
+        stringFree(globalPtr);
+    }
+    arrayListFree(String, &globalList);
+}
+
+/*
+ * Runs the specified script to the end and returns
+ * its trace, which must be freed; the number of runs
+ * is written to the given pointer
+ */
+static String traceScript(
+    NecroObjectFunc *scriptPtr,
+    size_t *runCountPtr
+){
+    String trace = stringMakeC("");
+    NecroVirtualMachine vm = necroVirtualMachineMake(
+        &nativeFuncSet
+    );
+    NecroInterpretResult result
+        = necroVirtualMachineInterpret(&vm, scriptPtr);
+    appendState(&trace, &vm, result);
+    size_t runCount = 1;
+    while(result == necro_yielded
+        && runCount < maxRunCount
+    ){
+        result = necroVirtualMachineResume(&vm);
+        appendState(&trace, &vm, result);
+        ++runCount;
+    }
+    necroVirtualMachineFree(&vm);
+    *runCountPtr = runCount;
+    return trace;
+}
+
+/* Compiles the script with the specified file name */
+static NecroObjectFunc *compileScript(const char *fileName){
+    NecroCompiler compiler = necroCompilerMakeNatives(
+        NULL,
+        &nativeFuncSet
+    );
+    NecroObjectFunc *scriptPtr
+        = necroCompilerCompileScript(
+            &compiler,
+            fileName
+        );
+    necroCompilerFree(&compiler);
+    return scriptPtr;
+}
+
+int main(int argc, char **argv){
+    if(argc < 2){
+        fprintf(
+            stderr,
+            "usage: necro_aot_check <script.nec>...\n"
+        );
+        return 1;
+    }
+
+    nativeFuncSet = necroGameNativesMake();
+    int scriptCount = argc - 1;
+    NecroObjectFunc **interpretedScripts = pgAlloc(
+        scriptCount + 1,
+        sizeof(NecroObjectFunc*)
+    );
+    for(int i = 0; i < scriptCount; ++i){
+        interpretedScripts[i] = compileScript(argv[i + 1]);
+    }
+    necroAotRegisterScripts();
+
+    bool allPassed = true;
+    printf("script,bound,runs,match\n");
+    for(int i = 0; i < scriptCount; ++i){
+        const char *fileName = argv[i + 1];
+        NecroObjectFunc *translatedScriptPtr
+            = compileScript(fileName);
+
+        size_t interpretedRunCount = 0;
+        String interpretedTrace = traceScript(
+            interpretedScripts[i],
+            &interpretedRunCount
+        );
+        size_t translatedRunCount = 0;
+        String translatedTrace = traceScript(
+            translatedScriptPtr,
+            &translatedRunCount
+        );
+        bool match = interpretedRunCount
+                == translatedRunCount
+            && strcmp(
+                stringCharPtr(&interpretedTrace),
+                stringCharPtr(&translatedTrace)
+            ) == 0;
+        bool bound
+            = translatedScriptPtr->program.aotPtr != NULL;
+        #ifdef NECRO_PROFILE
+        allPassed = allPassed && match;
+        #else
+        allPassed = allPassed && bound && match;
+        #endif
+        printf(
+            "%s,%d,%zu,%d\n",
+            necroAotScriptName(fileName),
+            (int)bound,
+            translatedRunCount,
+            (int)match
+        );
+        if(!match){
+            fprintf(
+                stderr,
+                "interpreted trace:\n%s\n"
+                "translated trace:\n%s\n",
+                stringCharPtr(&interpretedTrace),
+                stringCharPtr(&translatedTrace)
+            );
+        }
+
+        stringFree(&interpretedTrace);
+        stringFree(&translatedTrace);
+        necroObjectFree((NecroObject*)interpretedScripts[i]);
+        necroObjectFree((NecroObject*)translatedScriptPtr);
+    }
+
+    pgFree(interpretedScripts);
+    necroAotClear();
+    necroNativeFuncSetFree(&nativeFuncSet);
+    #ifdef NECRO_PROFILE
+    necroProfilerFree();
+    if(allPassed){
+        fprintf(
+            stderr,
+            "profiled scripts are not bound; skipped\n"
+        );
+        return skipReturnCode;
+    }
+    #endif
+    return allPassed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+/*
+ * Headless benchmark for the Necro virtual machine;
+ * built by the necro_bench and necro_bench_switch
+ * targets (configure with -DNECRO_BENCH=ON), which
+ * differ only in the instruction dispatch used, and
+ * by necro_bench_aot, which runs the ahead of time
+ * translation of the script instead.
+ *
+ * Compiles the given script (necro_bench.nec by
+ * default) once, then repeatedly runs it on many
+ * virtual machines the way the script system resumes
+ * them each tick, and reports the 50th and 99th
+ * percentile of the per run time as CSV on stdout.
+ * Configured with -DNECRO_PROFILE=ON as well, it also
+ * writes the profile of the script to
+ * necro_profile.txt and necro_profile.folded
+ */
+
+#include <stdio.h>
+
+#include "Constructure.h"
+#include "Necro.h"
+#include "PGUtil.h"
+#include "Trifecta_Time.h"
+
+#ifndef NECRO_BENCH_SCRIPT
+#define NECRO_BENCH_SCRIPT "necro_bench.nec"
+#endif
+
+/* number of virtual machines run in turn */
+#define vmCount 64
+/* times every virtual machine runs the script */
+#define roundCount 20
+#define sampleCount (vmCount * roundCount)
+
+/* per run durations in nanoseconds */
+static uint64_t samples[sampleCount];
+static uint64_t sampleScratch[sampleCount];
+
+int main(int argc, char **argv){
+    const char *fileName = NECRO_BENCH_SCRIPT;
+    if(argc > 1){
+        fileName = argv[1];
+    }
+    #ifdef NECRO_AOT
+    necroAotRegisterScripts();
+    #endif
+
+    NecroCompiler compiler = necroCompilerMake();
+    NecroObjectFunc *programPtr
+        = necroCompilerCompileScript(
+            &compiler,
+            fileName
+        );
+    necroCompilerFree(&compiler);
+
+    NecroNativeFuncSet nativeFuncSet
+        = necroNativeFuncSetMake();
+    NecroVirtualMachine *vms = pgAlloc(
+        vmCount,
+        sizeof(NecroVirtualMachine)
+    );
+    for(size_t i = 0u; i < vmCount; ++i){
+        vms[i] = necroVirtualMachineMake(&nativeFuncSet);
+    }
+
+    /* warm up caches and the allocator */
+    for(size_t i = 0u; i < vmCount; ++i){
+        necroVirtualMachineInterpret(&vms[i], programPtr);
+    }
+
+    size_t count = 0u;
+    for(int round = 0; round < roundCount; ++round){
+        for(size_t i = 0u; i < vmCount; ++i){
+            TimePoint start = getCurrentTime();
+            NecroInterpretResult result
+                = necroVirtualMachineInterpret(
+                    &vms[i],
+                    programPtr
+                );
+            samples[count++] = (uint64_t)timePointDiffNano(
+                getCurrentTime(),
+                start
+            );
+            assertTrue(
+                result == necro_success,
+                "bench script did not succeed; "
+                SRC_LOCATION
+            );
+        }
+    }
+
+    radixSortKeys64(samples, sampleScratch, count);
+    printf("dispatch,runs,p50_ns_per_run,p99_ns_per_run\n");
+    printf(
+        "%s,%zu,%llu,%llu\n",
+        #if defined(NECRO_AOT)
+        "aot",
+        #elif defined(NECRO_SWITCH_DISPATCH)
+        "switch",
+        #else
+        "threaded",
+        #endif
+        count,
+        (unsigned long long)samples[count / 2u],
+        (unsigned long long)samples[(count * 99u) / 100u]
+    );
+
+    #ifdef NECRO_PROFILE
+    necroProfilerWriteReport(
+        "necro_profile.txt",
+        &nativeFuncSet
+    );
+    necroProfilerWriteFolded("necro_profile.folded");
+    #endif
+
+    for(size_t i = 0u; i < vmCount; ++i){
+        necroVirtualMachineFree(&vms[i]);
+    }
+    pgFree(vms);
+    necroNativeFuncSetFree(&nativeFuncSet);
+    necroObjectFree((NecroObject*)programPtr);
+    #ifdef NECRO_AOT
+    necroAotClear();
+    #endif
+    #ifdef NECRO_PROFILE
+    necroProfilerFree();
+    #endif
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "Necro_GameNatives.h"
+
+#include "NativeFuncList.h"
+
+/* Returns false in place of a bool native */
+static NecroValue stubBool(int argc, NecroValue *argv){
+    (void)argc;
+    (void)argv;
+    return necroBoolValue(false);
+}
+
+/* Returns 0 in place of an int or number native */
+static NecroValue stubInt(int argc, NecroValue *argv){
+    (void)argc;
+    (void)argv;
+    return necroIntValue(0);
+}
+
+/* Returns 0 in place of a float native */
+static NecroValue stubFloat(int argc, NecroValue *argv){
+    (void)argc;
+    (void)argv;
+    return necroFloatValue(0.0f);
+}
+
+/* Returns a zero vector in place of a vector native */
+static NecroValue stubVector(int argc, NecroValue *argv){
+    (void)argc;
+    (void)argv;
+    return necroVectorValue((Polar){0});
+}
+
+/* Returns the origin in place of a point native */
+static NecroValue stubPoint(int argc, NecroValue *argv){
+    (void)argc;
+    (void)argv;
+    return necroPointValue((Point2D){0});
+}
+
+/*
+ * Returns the first argument, or false if there is
+ * none, in place of a native of any return type
+ */
+static NecroValue stubAny(int argc, NecroValue *argv){
+    return argc > 0 ? argv[0] : necroBoolValue(false);
+}
+
+/*
+ * Returns the stub for a native with the signature
+ * described by the specified spec
+ */
+static NecroNativeFunc stubFor(const char *spec){
+    switch(necroNativeSignatureParse(spec).returnType){
+        case necro_nativeBool:
+            return stubBool;
+        case necro_nativeInt:
+        case necro_nativeNumber:
+            return stubInt;
+        case necro_nativeFloat:
+            return stubFloat;
+        case necro_nativeVector:
+            return stubVector;
+        case necro_nativePoint:
+            return stubPoint;
+        default:
+            return stubAny;
+    }
+}
+
+/*
+ * Constructs and returns by value a native func set
+ * with the names, order, and signatures of the natives
+ * of the game, so that scripts compiled against it
+ * get the same code as in the game; the natives are
+ * stubs which return a zero of their return type, or
+ * their first argument if it may be any type
+ */
+NecroNativeFuncSet necroGameNativesMake(){
+    NecroNativeFuncSet toRet = necroNativeFuncSetMake();
+    #define addStub(FUNC, NAME, SPEC) \
+        necroNativeFuncSetAddTyped( \
+            &toRet, \
+            #NAME, \
+            stubFor(SPEC), \
+            SPEC \
+        );
+    forEachNativeFunc(addStub)
+    #undef addStub
+    return toRet;
+}
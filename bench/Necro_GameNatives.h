@@ -0,0 +1,16 @@
+#ifndef NECRO_GAMENATIVES_H
+#define NECRO_GAMENATIVES_H
+
+#include "Necro.h"
+
+/*
+ * Constructs and returns by value a native func set
+ * with the names, order, and signatures of the natives
+ * of the game, so that scripts compiled against it
+ * get the same code as in the game; the natives are
+ * stubs which return a zero of their return type, or
+ * their first argument if it may be any type
+ */
+NecroNativeFuncSet necroGameNativesMake();
+
+#endif
@@ -0,0 +1,261 @@
+/*
+ * Reports how often each sequence of two to four
+ * Necro opcodes appears in the given scripts; built
+ * by the necro_ngrams target (configure with
+ * -DNECRO_BENCH=ON) to pick which sequences deserve
+ * a superinstruction.
+ *
+ * Every script and each function nested in it is
+ * compiled and optimized as usual but left unfused,
+ * so the counts show the sequences the optimizer
+ * could fuse. The most common sequences of each
+ * length are printed as CSV on stdout
+ */
+
+#include <stdio.h>
+
+#include "Constructure.h"
+#include "Necro.h"
+#include "PGUtil.h"
+
+/* longest sequence counted */
+#define maxGramLength 4
+/* sequences printed for each length */
+#define reportCount 20
+/* opcodes are packed into this many bits each */
+#define opcodeBits 6
+
+#define gramMapInitCapacity 1024
+
+/* printed name of each opcode */
+static const char *opcodeNames[] = {
+    [necro_literal] = "literal",
+    [necro_pop] = "pop",
+    [necro_defineGlobal] = "defineGlobal",
+    [necro_getGlobal] = "getGlobal",
+    [necro_setGlobal] = "setGlobal",
+    [necro_getLocal] = "getLocal",
+    [necro_setLocal] = "setLocal",
+    [necro_true] = "true",
+    [necro_false] = "false",
+    [necro_add] = "add",
+    [necro_subtract] = "subtract",
+    [necro_multiply] = "multiply",
+    [necro_divide] = "divide",
+    [necro_modulo] = "modulo",
+    [necro_negate] = "negate",
+    [necro_addVectors] = "addVectors",
+    [necro_subtractVectors] = "subtractVectors",
+    [necro_addPointVector] = "addPointVector",
+    [necro_subtractPointVector] = "subtractPointVector",
+    [necro_subtractPoints] = "subtractPoints",
+    [necro_multiplyVector] = "multiplyVector",
+    [necro_divideVector] = "divideVector",
+    [necro_equal] = "equal",
+    [necro_greater] = "greater",
+    [necro_less] = "less",
+    [necro_not] = "not",
+    [necro_makeVector] = "makeVector",
+    [necro_makePoint] = "makePoint",
+    [necro_getR] = "getR",
+    [necro_getTheta] = "getTheta",
+    [necro_getX] = "getX",
+    [necro_getY] = "getY",
+    [necro_setRGlobal] = "setRGlobal",
+    [necro_setThetaGlobal] = "setThetaGlobal",
+    [necro_setXGlobal] = "setXGlobal",
+    [necro_setYGlobal] = "setYGlobal",
+    [necro_setRLocal] = "setRLocal",
+    [necro_setThetaLocal] = "setThetaLocal",
+    [necro_setXLocal] = "setXLocal",
+    [necro_setYLocal] = "setYLocal",
+    [necro_print] = "print",
+    [necro_jump] = "jump",
+    [necro_jumpIfFalse] = "jumpIfFalse",
+    [necro_loop] = "loop",
+    [necro_call] = "call",
+    [necro_callNative] = "callNative",
+    [necro_callNativeFast] = "callNativeFast",
+    [necro_return] = "return",
+    [necro_yield] = "yield",
+    [necro_sleep] = "sleep",
+    [necro_end] = "end",
+    [necro_addLocalLiteral] = "addLocalLiteral",
+    [necro_lessLocalLiteralJump] = "lessLocalLiteralJump",
+    [necro_greaterLocalLiteralJump]
+        = "greaterLocalLiteralJump",
+    [necro_callPop] = "callPop",
+    [necro_pointDistance] = "pointDistance",
+    [necro_pointAngle] = "pointAngle",
+    [necro_callNativePop] = "callNativePop",
+    [necro_callNativeFastPop] = "callNativeFastPop",
+};
+#define opcodeCount \
+    (sizeof(opcodeNames) / sizeof(opcodeNames[0]))
+
+/*
+ * maps each packed sequence, tagged with its length
+ * in the bits above the opcodes, to its count
+ */
+static HashMap gramMap;
+/* total sequences counted for each length */
+static size_t gramTotals[maxGramLength + 1];
+
+/* count in the high half, packed sequence in the low */
+static ArrayList reportList;
+
+/*
+ * Counts the opcode sequences in the specified program
+ * and in the programs of the functions it defines
+ */
+static void countProgram(NecroProgram *programPtr){
+    uint8_t *codePtr = programPtr->code._ptr;
+    size_t codeSize = programPtr->code.size;
+    /* the last opcodes seen, most recent first */
+    uint8_t window[maxGramLength] = {0};
+    size_t seen = 0;
+
+    for(size_t offset = 0; offset < codeSize;){
+        uint8_t opcode = codePtr[offset];
+        size_t length = necroInstructionLength(opcode);
+        assertTrue(length > 0 && opcode < opcodeCount,
+            "unknown opcode; "
+            SRC_LOCATION
+        );
+        for(size_t i = maxGramLength - 1; i > 0; --i){
+            window[i] = window[i - 1];
+        }
+        window[0] = opcode;
+        ++seen;
+
+        int packed = 0;
+        for(size_t n = 1; n <= maxGramLength && n <= seen;
+            ++n
+        ){
+            packed |= window[n - 1]
+                << (opcodeBits * (maxGramLength - n));
+            if(n < 2){
+                continue;
+            }
+            int key = packed
+                | ((int)n << (opcodeBits * maxGramLength));
+            int count = 0;
+            if(hashMapHasKey(int, int, &gramMap, key)){
+                count = hashMapGet(int, int, &gramMap, key);
+            }
+            hashMapPut(int, int, &gramMap, key, count + 1);
+            ++gramTotals[n];
+        }
+        offset += length;
+    }
+
+    NecroLiterals *literalsPtr = &(programPtr->literals);
+    for(size_t i = 0; i < literalsPtr->literals.size; ++i){
+        NecroValue literal = necroLiteralsGet(literalsPtr, i);
+        if(necroIsObject(literal)
+            && necroObjectGetType(literal)
+                == necro_funcObject
+        ){
+            countProgram(
+                &(necroObjectAsFunc(literal)->program)
+            );
+        }
+    }
+}
+
+/* Adds the specified sequence count to the report */
+static void reportListAdd(int *keyPtr, int *countPtr){
+    uint64_t entry = (((uint64_t)*countPtr) << 32)
+        | (uint32_t)*keyPtr;
+    arrayListPushBack(uint64_t, &reportList, entry);
+}
+
+/*
+ * Prints the opcodes of the specified packed sequence
+ * in execution order; the most recent opcode is packed
+ * highest
+ */
+static void printSequence(int packed, size_t n){
+    for(size_t i = n; i > 0; --i){
+        int shift = opcodeBits * (maxGramLength - i);
+        uint8_t opcode
+            = (uint8_t)((packed >> shift)
+                & ((1 << opcodeBits) - 1));
+        printf(i == n ? "%s" : " %s", opcodeNames[opcode]);
+    }
+}
+
+int main(int argc, char **argv){
+    if(argc < 2){
+        fprintf(
+            stderr,
+            "usage: %s script.nec [script.nec ...]\n",
+            argv[0]
+        );
+        return 1;
+    }
+    assertTrue(opcodeCount <= (1 << opcodeBits),
+        "too many opcodes to pack; "
+        SRC_LOCATION
+    );
+    gramMap = hashMapMake(
+        int,
+        int,
+        gramMapInitCapacity,
+        intHash,
+        intEquals
+    );
+
+    for(int i = 1; i < argc; ++i){
+        NecroCompiler compiler = necroCompilerMake();
+        NecroObjectFunc *programPtr
+            = necroCompilerCompileScript(&compiler, argv[i]);
+        necroCompilerFree(&compiler);
+        countProgram(&(programPtr->program));
+        necroObjectFree((NecroObject*)programPtr);
+    }
+
+    reportList = arrayListMake(uint64_t, gramMapInitCapacity);
+    hashMapKeyValueApply(int, int, &gramMap, reportListAdd);
+    uint64_t *scratchPtr = pgAlloc(
+        reportList.size + 1,
+        sizeof(uint64_t)
+    );
+    radixSortKeys64(reportList._ptr, scratchPtr, reportList.size);
+    pgFree(scratchPtr);
+
+    printf("length,count,share,sequence\n");
+    for(size_t n = 2; n <= maxGramLength; ++n){
+        size_t printed = 0;
+        /* sorted ascending, so walk from the back */
+        for(size_t i = reportList.size;
+            i > 0 && printed < reportCount;
+            --i
+        ){
+            uint64_t entry = arrayListGet(uint64_t,
+                &reportList,
+                i - 1
+            );
+            int key = (int)(entry & 0xffffffffu);
+            size_t count = (size_t)(entry >> 32);
+            if((size_t)(key >> (opcodeBits * maxGramLength))
+                != n
+            ){
+                continue;
+            }
+            printf(
+                "%zu,%zu,%.4f,",
+                n,
+                count,
+                ((double)count) / gramTotals[n]
+            );
+            printSequence(key, n);
+            printf("\n");
+            ++printed;
+        }
+    }
+
+    arrayListFree(uint64_t, &reportList);
+    hashMapFree(int, int, &gramMap);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+/*
+ * Headless check of the Trifecta job system; built by
+ * the trifecta_jobs_check target (configure with
+ * -DTRIFECTA_BENCH=ON) and run by ctest.
+ *
+ * Runs a recursive fib, which nests tfJobRun() and
+ * tfJobWait() inside jobs, and a parallel sum split
+ * into chunks, and exits nonzero if either result
+ * differs from its serial answer
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "PGUtil.h"
+#include "Trifecta_Jobs.h"
+
+#define fibInput 22
+#define fibExpected 17711
+#define sumElementCount 1000000u
+#define sumChunkCount 64u
+/* repeated to catch wait or steal races */
+#define roundCount 8u
+
+/* The argument and result of a fib job */
+typedef struct FibJob{
+    int n;
+    int64_t result;
+} FibJob;
+
+/*
+ * Computes fib of the given job by running a job for
+ * each of the two smaller fibs and waiting on both
+ */
+static void fibJob(void *argPtr){
+    FibJob *fibPtr = argPtr;
+    if(fibPtr->n < 2){
+        fibPtr->result = fibPtr->n;
+        return;
+    }
+    FibJob smaller[2] = {
+        {.n = fibPtr->n - 1},
+        {.n = fibPtr->n - 2}
+    };
+    TFJobCounter counter;
+    tfJobCounterInit(&counter);
+    tfJobRun(fibJob, &(smaller[0]), &counter);
+    tfJobRun(fibJob, &(smaller[1]), &counter);
+    tfJobWait(&counter);
+    fibPtr->result = smaller[0].result
+        + smaller[1].result;
+}
+
+/* The range and result of a sum job */
+typedef struct SumJob{
+    const int64_t *elements;
+    size_t count;
+    int64_t result;
+} SumJob;
+
+/* Sums the range of the given job */
+static void sumJob(void *argPtr){
+    SumJob *sumPtr = argPtr;
+    int64_t result = 0;
+    for(size_t i = 0u; i < sumPtr->count; ++i){
+        result += sumPtr->elements[i];
+    }
+    sumPtr->result = result;
+}
+
+/* Returns true if fib of the input is as expected */
+static bool checkFib(){
+    FibJob fib = {.n = fibInput};
+    TFJobCounter counter;
+    tfJobCounterInit(&counter);
+    tfJobRun(fibJob, &fib, &counter);
+    tfJobWait(&counter);
+    if(fib.result != fibExpected){
+        printf(
+            "fib(%d) was %lld, expected %d\n",
+            fibInput,
+            (long long)fib.result,
+            fibExpected
+        );
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Returns true if the parallel sum of the given
+ * elements equals the given serial sum
+ */
+static bool checkSum(
+    const int64_t *elements,
+    int64_t serialSum
+){
+    enum{ chunkSize = sumElementCount / sumChunkCount };
+    SumJob sums[sumChunkCount];
+    TFJobCounter counter;
+    tfJobCounterInit(&counter);
+    for(size_t i = 0u; i < sumChunkCount; ++i){
+        sums[i].elements = elements + i * chunkSize;
+        /* the last chunk takes the remainder */
+        sums[i].count = (i == sumChunkCount - 1u)
+            ? sumElementCount - i * chunkSize
+            : chunkSize;
+        sums[i].result = 0;
+        tfJobRun(sumJob, &(sums[i]), &counter);
+    }
+    tfJobWait(&counter);
+
+    int64_t parallelSum = 0;
+    for(size_t i = 0u; i < sumChunkCount; ++i){
+        parallelSum += sums[i].result;
+    }
+    if(parallelSum != serialSum){
+        printf(
+            "parallel sum was %lld, expected %lld\n",
+            (long long)parallelSum,
+            (long long)serialSum
+        );
+        return false;
+    }
+    return true;
+}
+
+int main(){
+    /* at least two workers so jobs get stolen */
+    size_t workerCount = getProcessorCount() - 1u;
+    tfJobSystemInit(workerCount < 2u ? 2u : workerCount);
+
+    int64_t *elements = pgAlloc(
+        sumElementCount,
+        sizeof(*elements)
+    );
+    int64_t serialSum = 0;
+    for(size_t i = 0u; i < sumElementCount; ++i){
+        elements[i] = (int64_t)((i * 2654435761u) % 977u);
+        serialSum += elements[i];
+    }
+
+    bool fibSuccess = true;
+    bool sumSuccess = true;
+    for(size_t i = 0u; i < roundCount; ++i){
+        fibSuccess = fibSuccess && checkFib();
+        sumSuccess = sumSuccess
+            && checkSum(elements, serialSum);
+    }
+    printf("fib %s\n", fibSuccess ? "ok" : "FAILED");
+    printf("sum %s\n", sumSuccess ? "ok" : "FAILED");
+
+    pgFree(elements);
+    tfJobSystemDestroy();
+    return (fibSuccess && sumSuccess) ? 0 : 1;
+}
@@ -3,7 +3,7 @@
 void textInstructionDestructor(void *voidPtr){
     TextInstruction *textInstructionPtr = voidPtr;
 
-    if(textInstructionPtr->text._ptr){
+    if(wideStringIsMade(&(textInstructionPtr->text))){
         wideStringFree(&(textInstructionPtr->text));
     }
     memset(
@@ -26,7 +26,9 @@ void deathScriptsDestructor(void *voidPtr){
 
     #define freeStringIfAllocated(SLOT) \
         do{ \
-            if(deathScriptsPtr->scriptId##SLOT._ptr){ \
+            if(stringIsMade( \
+                &(deathScriptsPtr->scriptId##SLOT) \
+            )){ \
                 stringFree( \
                     &(deathScriptsPtr \
                         ->scriptId##SLOT) \
@@ -333,7 +333,7 @@ void dialogueInstructionFree(
     if(!instrPtr){
         return;
     }
-    if(instrPtr->data._ptr){
+    if(stringIsMade(&(instrPtr->data))){
         stringFree(&(instrPtr->data));
     }
     memset(instrPtr, 0, sizeof(*instrPtr));
@@ -141,7 +141,7 @@ static void updateMusic(Game *gamePtr){
             );
         if(!midiSequencePtr){
             pgWarning(
-                startMusicStringPtr->_ptr
+                stringCharPtr(startMusicStringPtr)
             );
             pgError(
                 "failed to find midi by name; "
@@ -220,7 +220,10 @@ void gameUpdate(Game *gamePtr){
         return;
     }
 
+    /* scene changes load and are not steady state */
+    pgAllocAllowBegin();
     updateSceneList(gamePtr);
+    pgAllocAllowEnd();
     updateInput(gamePtr);
     updateMusic(gamePtr);
     updateSettings(gamePtr);
@@ -17,6 +17,7 @@ void finalizeGameState(GameState *gameStatePtr){
         gameStatePtr->stage = 1;
     }
     gameStatePtr->prngSeed = currentTimeToPrngSeed();
+    gameStatePtr->prngVersion = prngStreamVersion;
 }
 
 /*
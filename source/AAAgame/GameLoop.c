@@ -3,6 +3,30 @@
 #include "Trifecta.h"
 #include "PGUtil.h"
 
+#ifdef PG_ALLOC_TRACKING
+/*
+ * Prints the allocation counters of the last update
+ * to stderr
+ */
+static void printAllocStats(){
+    PGAllocStats stats = pgAllocGetLastFrameStats();
+    fprintf(
+        stderr,
+        "update allocs %zu reallocs %zu frees %zu "
+        "(%zu bytes), forbidden %zu, live %zu "
+        "(%zu bytes, peak %zu)\n",
+        stats.allocCount,
+        stats.reallocCount,
+        stats.freeCount,
+        stats.bytesAllocated,
+        stats.forbiddenCount,
+        stats.liveCount,
+        stats.liveBytes,
+        stats.peakLiveBytes
+    );
+}
+#endif
+
 /* Constructs and returns a new GameLoop by value */
 GameLoop gameLoopMake(
     int updatesPerSecond,
@@ -37,6 +61,9 @@ void gameLoopRun(GameLoop *gameLoopPtr){
     TimePoint nextUpdate = getCurrentTime();
     int updatesWithoutFrame = 0;
     int timeCompareResult = 0;
+    #ifdef PG_ALLOC_TRACKING
+    int updatesSinceAllocPrint = 0;
+    #endif
 
     /* the actual game loop */
     gameLoopPtr->running = true;
@@ -56,9 +83,26 @@ void gameLoopRun(GameLoop *gameLoopPtr){
             nextUpdate
         );
 		if(timeCompareResult > 0){
+            /*
+             * steady state updates should not allocate;
+             * any which do are counted and warned of
+             */
+            pgAllocForbidBegin("game update");
 			(gameLoopPtr->updateFunc)(
                 gameLoopPtr->updateUserPtr
             );
+            pgAllocForbidEnd();
+            /* close the allocation counters per update */
+            pgAllocFrameMark();
+            #ifdef PG_ALLOC_TRACKING
+            /* show the counters about once a second */
+            if(++updatesSinceAllocPrint
+                >= gameLoopPtr->updatesPerSecond
+            ){
+                printAllocStats();
+                updatesSinceAllocPrint = 0;
+            }
+            #endif
             nextUpdate = addTimeNano(
                 nextUpdate,
                 nanoBetweenUpdates
@@ -94,6 +138,11 @@ void gameLoopRun(GameLoop *gameLoopPtr){
 			++updatesWithoutFrame;
 		}
     }
+
+    #ifdef PG_ALLOC_TRACKING
+    /* what is still live once the game stops */
+    pgAllocReportLive(stderr);
+    #endif
 }
 
 /* Stops running the specified GameLoop */
@@ -23,6 +23,18 @@ typedef enum Difficulty{
     game_lunatic = 3
 } Difficulty;
 
+/*
+ * The version of the stream of random numbers a seed
+ * produces; bump it whenever the same seed stops
+ * producing the same game, so that a game state
+ * recorded under an older stream, such as that of a
+ * replay, is rejected rather than played differently.
+ * Version 2: scripts run in parallel chunks, each
+ * drawing from a generator seeded from the scene
+ * generator in chunk order
+ */
+#define prngStreamVersion 2u
+
 /*
  * Stores information about the game being played
  * including whether it is practice mode and the
@@ -33,6 +45,8 @@ typedef struct GameState{
     Difficulty difficulty;
     int stage;
     uint32_t prngSeed;
+    /* the prngStreamVersion the seed was made under */
+    uint32_t prngVersion;
 } GameState;
 
 #endif
\ No newline at end of file
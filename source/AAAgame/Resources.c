@@ -1,9 +1,15 @@
 #include "Resources.h"
 
+#include "NativeFuncs.h"
+
 #define initImageCapacity 200
 #define initMidiCapacity 20
 #define initDialogueCapacity 20
 #define initScriptCapacity 200
+#define initIncludeCapacity 4
+#define initPendingScriptCapacity 50
+/* the allocation tag of loaded resources */
+#define allocTag "resources"
 
 /*
  * Constructs and returns a new (empty) ScriptResources
@@ -11,13 +17,21 @@
  */
 ScriptResources scriptResourcesMake(){
     ScriptResources toRet = {0};
-    toRet._compiler = necroCompilerMake();
+    toRet._pendingList = arrayListMake(String,
+        initPendingScriptCapacity
+    );
+    toRet._session = necroSessionMake();
+    toRet._nativeFuncSetPtr = getNativeFuncSet();
     toRet._scriptMap = hashMapMake(
         String, NecroObjectFunc*,
         initScriptCapacity,
         constructureStringHash,
         constructureStringEquals
     );
+    /* scripts compiled from now on use translations */
+    #ifdef NECRO_AOT
+    necroAotRegisterScripts();
+    #endif
     return toRet;
 }
 
@@ -36,7 +50,19 @@ static void freeScript(NecroObjectFunc** doublePtr){
 void scriptResourcesFree(
     ScriptResources *scriptResourcesPtr
 ){
-    necroCompilerFree(&(scriptResourcesPtr->_compiler));
+    necroSessionFree(&(scriptResourcesPtr->_session));
+    #ifdef NECRO_AOT
+    necroAotClear();
+    #endif
+
+    /* free pending list */
+    arrayListApply(String,
+        &(scriptResourcesPtr->_pendingList),
+        stringFree
+    );
+    arrayListFree(String,
+        &(scriptResourcesPtr->_pendingList)
+    );
 
     /* free script map */
     hashMapApply(String, NecroObjectFunc*,
@@ -182,36 +208,147 @@ static void loadDialogueIntoResources(
     );
 }
 
-/* Script loading callback (.un) */
+/*
+ * Script loading callback (.nec); only records the
+ * file so that every script in the directory can be
+ * compiled in parallel afterwards
+ */
 static void loadScriptIntoResources(
     const char *fileName,
     void *scriptResourcesVoidPtr
 ){
     ScriptResources *scriptResourcesPtr
         = scriptResourcesVoidPtr;
+    String pendingName = stringMakeC(fileName);
+    arrayListPushBack(String,
+        &(scriptResourcesPtr->_pendingList),
+        pendingName
+    );
+}
+
+/* A script to be compiled by a job */
+typedef struct ScriptJob{
+    const char *fileName;
+    /* shared by every job */
+    NecroSession *sessionPtr;
+    NecroNativeFuncSet *nativeFuncSetPtr;
+    NecroObjectFunc *scriptPtr;
+} ScriptJob;
+
+/*
+ * Compiles the script of the specified ScriptJob
+ * passed as a void ptr, or loads it from its bytecode
+ * cache if the cache is up to date; each job uses its
+ * own compiler, and every script owns its literals,
+ * so jobs share only the include session
+ */
+static void compileScriptJob(void *scriptJobVoidPtr){
+    ScriptJob *scriptJobPtr = scriptJobVoidPtr;
+    const char *fileName = scriptJobPtr->fileName;
+
+    /* the bytecode cache sits beside the source */
+    String cacheName = stringMakeC(fileName);
+    stringPushBack(&cacheName, 'b');
+
+    NecroObjectFunc *scriptPtr = necroBytecodeLoad(
+        stringCharPtr(&cacheName),
+        fileName,
+        scriptJobPtr->nativeFuncSetPtr
+    );
+    /* recompile if the cache is missing or stale */
+    if(!scriptPtr){
+        NecroCompiler compiler = necroCompilerMakeNatives(
+            scriptJobPtr->sessionPtr,
+            scriptJobPtr->nativeFuncSetPtr
+        );
+        ArrayList includeList = arrayListMake(String,
+            initIncludeCapacity
+        );
+        scriptPtr = necroCompilerCompileScriptIncludes(
+            &compiler,
+            fileName,
+            &includeList
+        );
+        if(!necroBytecodeSave(
+            stringCharPtr(&cacheName),
+            scriptPtr,
+            fileName,
+            &includeList,
+            scriptJobPtr->nativeFuncSetPtr
+        )){
+            pgWarning(stringCharPtr(&cacheName));
+            pgWarning("failed to write script cache");
+        }
+        arrayListApply(String, &includeList, stringFree);
+        arrayListFree(String, &includeList);
+        necroCompilerFree(&compiler);
+    }
+    stringFree(&cacheName);
+
+    scriptJobPtr->scriptPtr = scriptPtr;
+}
+
+/*
+ * Compiles every pending script of the specified
+ * ScriptResources on the job system, then registers
+ * them in the order they were found so that the
+ * result does not depend on which job finishes first
+ */
+static void scriptResourcesCompilePending(
+    ScriptResources *scriptResourcesPtr
+){
+    ArrayList *pendingListPtr
+        = &(scriptResourcesPtr->_pendingList);
     HashMap *scriptMapPtr
         = &(scriptResourcesPtr->_scriptMap);
-    NecroCompiler *compilerPtr
-        = &(scriptResourcesPtr->_compiler);
+    size_t scriptCount = pendingListPtr->size;
+    if(scriptCount == 0){
+        return;
+    }
 
-    NecroObjectFunc *scriptPtr = necroCompilerCompileScript(
-        compilerPtr,
-        fileName
+    ScriptJob *jobArray = pgAlloc(
+        scriptCount,
+        sizeof(*jobArray)
     );
-
-    String stringId = isolateFileName(fileName);
-    if(hashMapHasKeyPtr(String, NecroObjectFunc*,
-        scriptMapPtr,
-        &stringId
-    )){
-        pgWarning(fileName);
-        pgError("try to load multiple of same script");
+    tfJobSystemInit(0);
+    TFJobCounter counter = {0};
+    tfJobCounterInit(&counter);
+    for(size_t i = 0; i < scriptCount; ++i){
+        jobArray[i].fileName = stringCharPtr(
+            arrayListGetPtr(String, pendingListPtr, i)
+        );
+        jobArray[i].sessionPtr
+            = &(scriptResourcesPtr->_session);
+        jobArray[i].nativeFuncSetPtr
+            = scriptResourcesPtr->_nativeFuncSetPtr;
+        tfJobRun(
+            compileScriptJob,
+            &(jobArray[i]),
+            &counter
+        );
     }
-    hashMapPutPtr(String, NecroObjectFunc*,
-        scriptMapPtr,
-        &stringId,
-        &scriptPtr
-    );
+    tfJobWait(&counter);
+
+    for(size_t i = 0; i < scriptCount; ++i){
+        const char *fileName = jobArray[i].fileName;
+        String stringId = isolateFileName(fileName);
+        if(hashMapHasKeyPtr(String, NecroObjectFunc*,
+            scriptMapPtr,
+            &stringId
+        )){
+            pgWarning(fileName);
+            pgError("try to load multiple of same script");
+        }
+        hashMapPutPtr(String, NecroObjectFunc*,
+            scriptMapPtr,
+            &stringId,
+            &(jobArray[i].scriptPtr)
+        );
+    }
+
+    pgFree(jobArray);
+    arrayListApply(String, pendingListPtr, stringFree);
+    arrayListClear(String, pendingListPtr);
 }
 
 /*
@@ -219,6 +356,7 @@ static void loadScriptIntoResources(
  * object by value
  */
 Resources resourcesMake(){
+    pgAllocPushTag(allocTag);
     Resources toRet = {0};
     
     /* create maps */
@@ -298,21 +436,30 @@ Resources resourcesMake(){
         &scriptType
     );
 
+    pgAllocPopTag();
     return toRet;
 }
 
 /*
  * Nonrecursively loads all the files in the specified
- * directory into the given Resources object
+ * directory into the given Resources object; scripts
+ * are compiled in parallel on the job system, which
+ * is initialized if it has not been already
  */
 void resourcesLoadDirectory(
     Resources *resourcesPtr,
     char *directoryName
 ){
+    /* compile jobs carry the tag with them */
+    pgAllocPushTag(allocTag);
     blResourceLoaderParseDirectory(
         &(resourcesPtr->_loader),
         directoryName
     );
+    scriptResourcesCompilePending(
+        resourcesPtr->scriptResourcesPtr
+    );
+    pgAllocPopTag();
 }
 
 /*
@@ -9,8 +9,18 @@
 
 /* Stores file resources for scripts */
 typedef struct ScriptResources{
-    /* compiler for scripts */
-    NecroCompiler _compiler;
+    /*
+     * arraylist of String naming the script files
+     * found but not yet compiled
+     */
+    ArrayList _pendingList;
+    /* caches the files included by scripts */
+    NecroSession _session;
+    /*
+     * the natives scripts are compiled against, which
+     * script VMs must run with; not owned
+     */
+    NecroNativeFuncSet *_nativeFuncSetPtr;
     /* map of NecroObjectFunc* */
     HashMap _scriptMap;
 } ScriptResources;
@@ -50,7 +60,9 @@ Resources resourcesMake();
 
 /*
  * Nonrecursively loads all the files in the specified
- * directory into the given Resources object
+ * directory into the given Resources object; scripts
+ * are compiled in parallel on the job system, which
+ * is initialized if it has not been already
  */
 void resourcesLoadDirectory(
     Resources *resourcesPtr,
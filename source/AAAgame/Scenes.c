@@ -36,6 +36,7 @@ SceneMessages sceneMessagesMake(){
         Collision,
         10
     );
+    toRet.scriptTimers = scriptTimerWheelMake();
     return toRet;
 }
 
@@ -99,6 +100,7 @@ void sceneMessagesClear(
         &(messagesPtr->pickupCollisionList)
     );
     messagesPtr->userFlag1 = 0;
+    scriptTimerWheelClear(&(messagesPtr->scriptTimers));
 }
 
 /*
@@ -133,6 +135,7 @@ void sceneMessagesFree(
     arrayListFree(Collision,
         &(messagesPtr->pickupCollisionList)
     );
+    scriptTimerWheelFree(&(messagesPtr->scriptTimers));
     memset(
         messagesPtr,
         0,
@@ -9,6 +9,7 @@
 #include "GameBuilderCommand.h"
 #include "PlayerData.h"
 #include "Dialogue.h"
+#include "Scripts.h"
 
 /* used to identify the different kinds of scenes */
 typedef enum SceneId{
@@ -224,6 +225,12 @@ typedef struct SceneMessages{
      * communication
      */
     unsigned int userFlag1;
+
+    /*
+     * Timer wheel of the script VMs sleeping in a
+     * "wait for" statement, advanced by script system
+     */
+    ScriptTimerWheel scriptTimers;
 } SceneMessages;
 
 /*
@@ -1,5 +1,6 @@
 #include "Scripts.h"
-#include "Config.h"
+
+#include <stdatomic.h>
 
 /*
  * Used to form a singly linked list of virtual
@@ -19,8 +20,18 @@ typedef struct VMBlockHandle{
     int blockSize;
 } VMBlockHandle;
 
-/* The head of the VM pool */
-static VMNode *poolHeadPtr = NULL;
+/*
+ * The head of the list of idle VMs which keep the
+ * memory they grew while running
+ */
+static VMNode *warmHeadPtr = NULL;
+static int warmCount = 0;
+
+/* The head of the list of idle VMs holding no memory */
+static VMNode *coldHeadPtr = NULL;
+
+/* The number of VMs requested but not yet reclaimed */
+static int inUseCount = 0;
 
 /* list of VMBlockHandle */
 static ArrayList blockHandleList;
@@ -29,12 +40,44 @@ static bool initialized = false;
 
 static NecroNativeFuncSet *_nativeFuncSetPtr = NULL;
 
-#define initBlockSize config_gameMaxEntities
-#define growBlockSize 100
+/*
+ * guards the lists and counts above, since scripts on
+ * several threads request and reclaim VMs at once
+ */
+static atomic_flag poolLock = ATOMIC_FLAG_INIT;
+
+/* Acquires the VM pool lock */
+static void vmPoolLock(){
+    while(atomic_flag_test_and_set_explicit(
+        &poolLock,
+        memory_order_acquire
+    )){
+        /* spin */
+    }
+}
+
+/* Releases the VM pool lock */
+static void vmPoolUnlock(){
+    atomic_flag_clear_explicit(
+        &poolLock,
+        memory_order_release
+    );
+}
+
+#define initBlockSize 256
+#define growBlockSize 256
+/*
+ * idle VMs keep their memory while there are fewer of
+ * them than this or than the VMs in use
+ */
+#define minWarmCount 32
+/* the allocation tag of the memory of the VMs */
+#define allocTag "necro"
 
 /*
  * Allocates a new block of VMs of the specified size
- * and adds them to the pool
+ * and adds them to the pool; a new VM allocates
+ * nothing until it loads a program
  */
 static void addNewBlock(int size){
     assertTrue(
@@ -51,6 +94,7 @@ static void addNewBlock(int size){
         return;
     }
 
+    pgAllocPushTag(allocTag);
     /* allocate a new block of the requested size */
     VMBlockHandle blockHandle = {0};
     blockHandle.blockPtr
@@ -70,10 +114,11 @@ static void addNewBlock(int size){
         currentPtr->vm = necroVirtualMachineMake(
             _nativeFuncSetPtr
         );
-        currentPtr->next = poolHeadPtr;
-        poolHeadPtr = currentPtr;
+        currentPtr->next = coldHeadPtr;
+        coldHeadPtr = currentPtr;
         ++currentPtr;
     }
+    pgAllocPopTag();
 }
 
 /*
@@ -95,26 +140,44 @@ void vmPoolInit(
 
 /*
  * Returns a pointer to a fresh virtual machine from
- * the VM pool
+ * the VM pool, preferring one which kept its memory;
+ * may be called from several threads at once
  */
 NecroVirtualMachine *vmPoolRequest(){
     assertTrue(
         initialized,
         "vm pool not initialized; " SRC_LOCATION
     );
-    if(!poolHeadPtr){
-        addNewBlock(growBlockSize);
+    VMNode *nodePtr = NULL;
+    vmPoolLock();
+    if(warmHeadPtr){
+        nodePtr = warmHeadPtr;
+        warmHeadPtr = nodePtr->next;
+        --warmCount;
     }
-    VMNode *nodePtr = poolHeadPtr;
-    assertNotNull(
-        nodePtr,
-        "unexpected null head; " SRC_LOCATION
-    );
-    poolHeadPtr = nodePtr->next;
+    else{
+        if(!coldHeadPtr){
+            addNewBlock(growBlockSize);
+        }
+        nodePtr = coldHeadPtr;
+        assertNotNull(
+            nodePtr,
+            "unexpected null head; " SRC_LOCATION
+        );
+        coldHeadPtr = nodePtr->next;
+    }
+    ++inUseCount;
+    vmPoolUnlock();
     return &(nodePtr->vm);
 }
 
-/* Reclaims the specified VM pointer into the pool */
+/*
+ * Reclaims the specified VM pointer into the pool; the
+ * VM keeps its memory for reuse unless enough idle
+ * VMs already do, so the memory held by the pool
+ * shrinks back after a spike in use; may be called
+ * from several threads at once
+ */
 void vmPoolReclaim(NecroVirtualMachine *vmPtr){
     if(!vmPtr){
         return;
@@ -125,9 +188,21 @@ void vmPoolReclaim(NecroVirtualMachine *vmPtr){
     );
 
     VMNode *nodePtr = (VMNode*)vmPtr;
-    nodePtr->next = poolHeadPtr;
-    poolHeadPtr = nodePtr;
-    necroVirtualMachineReset(vmPtr);
+    vmPoolLock();
+    --inUseCount;
+    if(warmCount < minWarmCount || warmCount < inUseCount){
+        necroVirtualMachineReset(vmPtr);
+        nodePtr->next = warmHeadPtr;
+        warmHeadPtr = nodePtr;
+        ++warmCount;
+    }
+    else{
+        necroVirtualMachineFree(vmPtr);
+        *vmPtr = necroVirtualMachineMake(_nativeFuncSetPtr);
+        nodePtr->next = coldHeadPtr;
+        coldHeadPtr = nodePtr;
+    }
+    vmPoolUnlock();
 }
 
 /*
@@ -176,7 +251,10 @@ void vmPoolDestroy(){
     if(!initialized){
         return;
     }
-    poolHeadPtr = NULL;
+    warmHeadPtr = NULL;
+    warmCount = 0;
+    coldHeadPtr = NULL;
+    inUseCount = 0;
     arrayListApply(VMBlockHandle,
         &(blockHandleList),
         vmBlockHandleFree
@@ -186,4 +264,205 @@ void vmPoolDestroy(){
     );
     _nativeFuncSetPtr = NULL;
     initialized = false;
+}
+
+/* A virtual machine parked in a timer wheel */
+typedef struct ScriptTimer{
+    NecroVirtualMachine *vmPtr;
+    /* sleep id of the VM when it was parked */
+    uint32_t sleepId;
+    /* tick on which the VM should run again */
+    uint64_t wakeTick;
+    /* index plus one of the next timer in the slot */
+    int next;
+} ScriptTimer;
+
+#define timerListInitCapacity 64
+#define slotMask (SCRIPT_TIMER_SLOT_COUNT - 1)
+/* farthest tick away which the wheel can hold */
+#define maxTimerDelta \
+    ((((uint64_t)1) << (SCRIPT_TIMER_SLOT_BITS \
+        * SCRIPT_TIMER_LEVEL_COUNT)) - 1)
+
+/*
+ * Returns a pointer to the timer at the specified
+ * index plus one in the given timer wheel
+ */
+#define timerAt(WHEELPTR, INDEX) \
+    arrayListGetPtr(ScriptTimer, \
+        &((WHEELPTR)->_timerList), \
+        (INDEX) - 1 \
+    )
+
+/*
+ * Constructs and returns a new empty ScriptTimerWheel
+ * by value
+ */
+ScriptTimerWheel scriptTimerWheelMake(){
+    ScriptTimerWheel toRet = {0};
+    toRet._timerList = arrayListMake(ScriptTimer,
+        timerListInitCapacity
+    );
+    return toRet;
+}
+
+/*
+ * Links the timer at the specified index plus one into
+ * the slot of the given timer wheel for its wake tick;
+ * each level holds the timers which are too far away
+ * for the level below it
+ */
+static void scriptTimerWheelLink(
+    ScriptTimerWheel *wheelPtr,
+    int timerIndex
+){
+    ScriptTimer *timerPtr = timerAt(wheelPtr, timerIndex);
+    uint64_t wakeTick = timerPtr->wakeTick;
+    uint64_t delta = wakeTick - wheelPtr->currentTick;
+    /*
+     * timers too far away for the top level wait in
+     * its last slot and are linked again once that
+     * slot comes up
+     */
+    if(delta > maxTimerDelta){
+        delta = maxTimerDelta;
+        wakeTick = wheelPtr->currentTick + delta;
+    }
+    int level = 0;
+    while(level < SCRIPT_TIMER_LEVEL_COUNT - 1
+        && delta >> (SCRIPT_TIMER_SLOT_BITS * (level + 1))
+    ){
+        ++level;
+    }
+    int slot = (int)((wakeTick
+        >> (SCRIPT_TIMER_SLOT_BITS * level)) & slotMask);
+    timerPtr->next = wheelPtr->_slotHeads[level][slot];
+    wheelPtr->_slotHeads[level][slot] = timerIndex;
+}
+
+/*
+ * Parks the specified virtual machine in the given
+ * timer wheel if it yielded into a sleep; the VM is
+ * woken on the tick its sleep ends
+ */
+void scriptTimerWheelPark(
+    ScriptTimerWheel *wheelPtr,
+    NecroVirtualMachine *vmPtr
+){
+    if(vmPtr->sleepTicks <= 0){
+        return;
+    }
+    int timerIndex = wheelPtr->_freeHead;
+    if(timerIndex){
+        wheelPtr->_freeHead
+            = timerAt(wheelPtr, timerIndex)->next;
+    }
+    else{
+        arrayListPushBack(ScriptTimer,
+            &(wheelPtr->_timerList),
+            (ScriptTimer){0}
+        );
+        timerIndex = (int)wheelPtr->_timerList.size;
+    }
+    ScriptTimer *timerPtr = timerAt(wheelPtr, timerIndex);
+    timerPtr->vmPtr = vmPtr;
+    timerPtr->sleepId = vmPtr->sleepId;
+    /* the VM already spent the current tick yielding */
+    timerPtr->wakeTick = wheelPtr->currentTick
+        + vmPtr->sleepTicks + 1;
+    scriptTimerWheelLink(wheelPtr, timerIndex);
+}
+
+/*
+ * Moves the timers in the specified slot of the given
+ * level of the timer wheel down to the levels below
+ */
+static void scriptTimerWheelCascade(
+    ScriptTimerWheel *wheelPtr,
+    int level,
+    int slot
+){
+    int timerIndex = wheelPtr->_slotHeads[level][slot];
+    wheelPtr->_slotHeads[level][slot] = 0;
+    while(timerIndex){
+        int nextIndex = timerAt(wheelPtr, timerIndex)->next;
+        scriptTimerWheelLink(wheelPtr, timerIndex);
+        timerIndex = nextIndex;
+    }
+}
+
+/*
+ * Advances the specified timer wheel by one tick,
+ * waking each parked virtual machine whose sleep ends
+ * on the new tick
+ */
+void scriptTimerWheelAdvance(ScriptTimerWheel *wheelPtr){
+    uint64_t tick = ++(wheelPtr->currentTick);
+
+    /*
+     * whenever a level wraps around, the next slot of
+     * each level above it comes due; cascade from the
+     * top so timers can fall through several levels
+     */
+    for(int level = SCRIPT_TIMER_LEVEL_COUNT - 1;
+        level > 0;
+        --level
+    ){
+        int shift = SCRIPT_TIMER_SLOT_BITS * level;
+        if((tick & ((((uint64_t)1) << shift) - 1)) == 0){
+            scriptTimerWheelCascade(
+                wheelPtr,
+                level,
+                (int)((tick >> shift) & slotMask)
+            );
+        }
+    }
+
+    /* every timer left in the lowest slot is due */
+    int slot = (int)(tick & slotMask);
+    int timerIndex = wheelPtr->_slotHeads[0][slot];
+    wheelPtr->_slotHeads[0][slot] = 0;
+    while(timerIndex){
+        ScriptTimer *timerPtr
+            = timerAt(wheelPtr, timerIndex);
+        int nextIndex = timerPtr->next;
+        /*
+         * skip VMs reclaimed or put to sleep again since
+         * they were parked
+         */
+        if(timerPtr->vmPtr->sleepId == timerPtr->sleepId
+            && timerPtr->vmPtr->sleepTicks > 0
+        ){
+            necroVirtualMachineWake(timerPtr->vmPtr);
+        }
+        timerPtr->vmPtr = NULL;
+        timerPtr->next = wheelPtr->_freeHead;
+        wheelPtr->_freeHead = timerIndex;
+        timerIndex = nextIndex;
+    }
+}
+
+/*
+ * Removes every timer from the specified timer wheel
+ * without waking the parked virtual machines; should
+ * be called once they have been reclaimed
+ */
+void scriptTimerWheelClear(ScriptTimerWheel *wheelPtr){
+    memset(
+        wheelPtr->_slotHeads,
+        0,
+        sizeof(wheelPtr->_slotHeads)
+    );
+    arrayListClear(ScriptTimer, &(wheelPtr->_timerList));
+    wheelPtr->_freeHead = 0;
+    wheelPtr->currentTick = 0;
+}
+
+/*
+ * Frees the memory associated with the specified
+ * timer wheel
+ */
+void scriptTimerWheelFree(ScriptTimerWheel *wheelPtr){
+    arrayListFree(ScriptTimer, &(wheelPtr->_timerList));
+    memset(wheelPtr, 0, sizeof(*wheelPtr));
 }
\ No newline at end of file
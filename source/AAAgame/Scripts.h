@@ -15,6 +15,69 @@ typedef struct Scripts{
     NecroVirtualMachine *vm4;
 } Scripts;
 
+/* each level of a script timer wheel has 64 slots */
+#define SCRIPT_TIMER_SLOT_BITS 6
+#define SCRIPT_TIMER_SLOT_COUNT (1 << SCRIPT_TIMER_SLOT_BITS)
+/* 4 levels cover sleeps of up to 2^24 ticks at once */
+#define SCRIPT_TIMER_LEVEL_COUNT 4
+
+/*
+ * A hierarchical timer wheel of the virtual machines
+ * sleeping in a "wait for" statement; a parked VM is
+ * not resumed until the wheel wakes it, so the cost of
+ * a tick depends on the scripts which are awake
+ */
+typedef struct ScriptTimerWheel{
+    /* number of times the wheel has advanced */
+    uint64_t currentTick;
+    /*
+     * index plus one of the first timer in each slot
+     * of each level; 0 if the slot is empty
+     */
+    int _slotHeads[SCRIPT_TIMER_LEVEL_COUNT]
+        [SCRIPT_TIMER_SLOT_COUNT];
+    /* list of ScriptTimer */
+    ArrayList _timerList;
+    /* index plus one of the first unused timer */
+    int _freeHead;
+} ScriptTimerWheel;
+
+/*
+ * Constructs and returns a new empty ScriptTimerWheel
+ * by value
+ */
+ScriptTimerWheel scriptTimerWheelMake();
+
+/*
+ * Parks the specified virtual machine in the given
+ * timer wheel if it yielded into a sleep; the VM is
+ * woken on the tick its sleep ends
+ */
+void scriptTimerWheelPark(
+    ScriptTimerWheel *wheelPtr,
+    NecroVirtualMachine *vmPtr
+);
+
+/*
+ * Advances the specified timer wheel by one tick,
+ * waking each parked virtual machine whose sleep ends
+ * on the new tick
+ */
+void scriptTimerWheelAdvance(ScriptTimerWheel *wheelPtr);
+
+/*
+ * Removes every timer from the specified timer wheel
+ * without waking the parked virtual machines; should
+ * be called once they have been reclaimed
+ */
+void scriptTimerWheelClear(ScriptTimerWheel *wheelPtr);
+
+/*
+ * Frees the memory associated with the specified
+ * timer wheel
+ */
+void scriptTimerWheelFree(ScriptTimerWheel *wheelPtr);
+
 /*
  * Initializes the VM pool if it has not already
  * been initialized
@@ -25,11 +88,18 @@ void vmPoolInit(
 
 /*
  * Returns a pointer to a fresh virtual machine from
- * the VM pool
+ * the VM pool, preferring one which kept its memory;
+ * may be called from several threads at once
  */
 NecroVirtualMachine *vmPoolRequest();
 
-/* Reclaims the specified VM pointer into the pool */
+/*
+ * Reclaims the specified VM pointer into the pool; the
+ * VM keeps its memory for reuse unless enough idle
+ * VMs already do, so the memory held by the pool
+ * shrinks back after a spike in use; may be called
+ * from several threads at once
+ */
 void vmPoolReclaim(NecroVirtualMachine *vmPtr);
 
 /*
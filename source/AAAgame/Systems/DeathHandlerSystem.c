@@ -52,8 +52,9 @@ static void handleDeathScript(
         Scripts scripts = {0};
         #define addScriptIfStringAllocated(SLOT) \
             do{ \
-                if(deathScriptsPtr->scriptId##SLOT \
-                        ._ptr \
+                if(stringIsMade( \
+                        &(deathScriptsPtr->scriptId##SLOT) \
+                    ) \
                     && !stringIsEmpty( \
                         &(deathScriptsPtr \
                             ->scriptId##SLOT) \
@@ -22,7 +22,7 @@ static void setImage(
             ((Vector2D){0})
         );
     if(!(spriteInstr.spritePtr)){
-        pgWarning(spriteIdPtr->_ptr);
+        pgWarning(stringCharPtr(spriteIdPtr));
         pgError(
             "Failed to get sprite for dialogue; "
             SRC_LOCATION
@@ -97,8 +97,8 @@ static bool handleNextCommand(
 
     switch(instrPtr->command){
         case dialogue_error:
-            if(instrPtr->data._ptr){
-                pgWarning(instrPtr->data._ptr);
+            if(stringIsMade(&(instrPtr->data))){
+                pgWarning(stringCharPtr(&(instrPtr->data)));
             }
             pgError("dialogue error");
             return false;
@@ -178,10 +178,9 @@ static void initDialogue(
         &(gamePtr->messages.startDialogueString)
     );
     if(!dialoguePtr){
-        pgWarning(
-            gamePtr->messages.startDialogueString
-                ._ptr
-        );
+        pgWarning(stringCharPtr(
+            &(gamePtr->messages.startDialogueString)
+        ));
         pgError(
             "failed to get dialogue; "
             SRC_LOCATION
@@ -11,12 +11,15 @@
 
 /*
  * Declares a component list with the specified name
- * in the scope of the macro
+ * in the scope of the macro; the list is backed by
+ * stack storage for INITCAPACITY components and only
+ * spills to the heap beyond that
  */
 #define declareList(LISTNAME, INITCAPACITY) \
-    ArrayList LISTNAME = arrayListMake( \
+    declareInlineArrayList( \
         VecsComponentDataPair, \
-        (INITCAPACITY) \
+        LISTNAME, \
+        INITCAPACITY \
     )
 
 /*
@@ -94,7 +97,7 @@
             &nameString \
         ); \
         if(!spritePtr){ \
-            pgWarning(nameString._ptr); \
+            pgWarning(stringCharPtr(&nameString)); \
             pgError("failed to find sprite"); \
         }; \
         TFSpriteInstruction spriteInstruction \
@@ -1147,7 +1147,16 @@ static void initGame(Game *gamePtr, Scene *scenePtr){
         = gamePtr->messages.gameState;
     VecsWorld *worldPtr = &(scenePtr->ecsWorld);
     
-    /* create prng */
+    /*
+     * create prng; a seed made under another stream
+     * would not reproduce the game it was recorded for
+     */
+    if(gameState.prngVersion != prngStreamVersion){
+        pgError(
+            "game state is for another prng stream; "
+            SRC_LOCATION
+        );
+    }
     scenePtr->messages.prng
         = zmtMake(gameState.prngSeed);
     
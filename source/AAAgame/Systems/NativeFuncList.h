@@ -0,0 +1,131 @@
+#ifndef NATIVEFUNCLIST_H
+#define NATIVEFUNCLIST_H
+
+/*
+ * Lists every native func of the game in the order
+ * they are added to its native func set, each as
+ * ADD(FUNC, NAME, SPEC) with the C function, the name
+ * scripts call it by, and its signature spec (see
+ * necroNativeSignatureParse). Includes nothing, so
+ * that tools which compile the scripts of the game
+ * without linking it, such as necro_aot, see the same
+ * native indices and signatures as the game
+ */
+#define forEachNativeFunc(ADD) \
+    /* constants */ \
+    ADD(angleEpsilon, angleEpsilon, "f:") \
+    ADD(pointEpsilon, pointEpsilon, "f:") \
+    ADD(updatesPerSecond, updatesPerSecond, "i:") \
+    ADD(gameOffset, gameOffset, "v:") \
+    ADD(gameWidth, gameWidth, "f:") \
+    ADD(gameHeight, gameHeight, "f:") \
+    ADD(enemySpawnDist, enemySpawnDist, "f:") \
+    ADD(bossMidpoint, bossMidpoint, "p:") \
+    ADD(bossXLow, bossXLow, "f:") \
+    ADD(bossXHigh, bossXHigh, "f:") \
+    ADD(bossYLow, bossYLow, "f:") \
+    ADD(bossYHigh, bossYHigh, "f:") \
+    ADD(timeBeforePostDialogue, timeBeforePostDialogue, "i:") \
+    ADD(trapLifetime, trapLifetime, "i:") \
+    ADD(pi, pi, "f:") \
+    ADD(phi, phi, "f:") \
+    /* utility */ \
+    ADD(error, error, "b:s") \
+    ADD(warn, warn, "b:s") \
+    /* general queries */ \
+    ADD(isBossDead, isBossDead, "b:") \
+    ADD(isDialogueOver, isDialogueOver, "b:") \
+    ADD(isWin, isWin, "b:") \
+    ADD(getDifficulty, getDifficulty, "i:") \
+    ADD(getPlayerPos, getPlayerPos, "p:") \
+    /* entity graphics */ \
+    ADD(setVisible, setVisible, "b:") \
+    ADD(removeVisible, removeVisible, "b:") \
+    ADD(setRotateSpriteForward, setRotateSpriteForward, "b:") \
+    ADD(removeRotateSpriteForward, removeRotateSpriteForward, "b:") \
+    ADD(setSprite, setSprite, "b:s") \
+    ADD(setSpriteInstruction, setSpriteInstruction, "b:sivff") \
+    ADD(setDepth, setDepth, "b:i") \
+    ADD(setRotation, setRotation, "b:f") \
+    ADD(setScale, setScale, "b:f") \
+    /* entity queries */ \
+    ADD(getPosition, getPosition, "p:") \
+    ADD(getX, getX, "f:") \
+    ADD(getY, getY, "f:") \
+    ADD(getAngleToPlayer, getAngleToPlayer, "f:") \
+    ADD(getVelocity, getVelocity, "v:") \
+    ADD(getSpeed, getSpeed, "f:") \
+    ADD(getAngle, getAngle, "f:") \
+    ADD(getSpin, getSpin, "f:") \
+    ADD(isSpawning, isSpawning, "b:") \
+    ADD(getPlayerPower, getPlayerPower, "i:") \
+    ADD(isPlayerFocused, isPlayerFocused, "b:") \
+    /* entity mutators */ \
+    ADD(setCollidable, setCollidable, "b:") \
+    ADD(removeCollidable, removeCollidable, "b:") \
+    ADD(setHealth, setHealth, "b:i") \
+    ADD(removeHealth, removeHealth, "b:") \
+    ADD(setDamage, setDamage, "b:i") \
+    ADD(removeDamage, removeDamage, "b:") \
+    ADD(setClearable, setClearable, "b:") \
+    ADD(removeClearable, removeClearable, "b:") \
+    ADD(setInbound, setInbound, "b:f") \
+    ADD(removeInbound, removeInbound, "b:") \
+    ADD(setOutbound, setOutbound, "b:f") \
+    ADD(removeOutbound, removeOutbound, "b:") \
+    ADD(setPosition, setPosition, "b:p") \
+    ADD(removePosition, removePosition, "b:") \
+    ADD(setVelocity, setVelocity, "b:v") \
+    ADD(removeVelocity, removeVelocity, "b:") \
+    ADD(setSpeed, setSpeed, "b:f") \
+    ADD(setAngle, setAngle, "b:f") \
+    ADD(setSpin, setSpin, "b:f") \
+    ADD(removeSpin, removeSpin, "b:") \
+    ADD(die, die, "b:") \
+    ADD(removeEntity, removeEntity, "b:") \
+    /* scripting */ \
+    ADD(hasScript, hasScript, "b:i") \
+    ADD(addScript, addScript, "b:si") \
+    ADD(removeScript, removeScript, "b:i") \
+    ADD(removeSpawns, removeSpawns, "b:") \
+    ADD(addDeathScript, addDeathScript, "b:si") \
+    ADD(removeDeathScript, removeDeathScript, "b:i") \
+    /* math */ \
+    ADD(flipX, flipX, "a:a") \
+    ADD(flipY, flipY, "a:a") \
+    ADD(_pow, pow, "n:nn") \
+    ADD(_sin, sin, "f:f") \
+    ADD(_cos, cos, "f:f") \
+    ADD(_tan, tan, "f:f") \
+    ADD(_sec, sec, "f:f") \
+    ADD(_csc, csc, "f:f") \
+    ADD(_cot, cot, "f:f") \
+    ADD(arcsin, arcsin, "f:f") \
+    ADD(arccos, arccos, "f:f") \
+    ADD(arctan, arctan, "f:f") \
+    ADD(_max, max, "n:n*") \
+    ADD(_min, min, "n:n*") \
+    ADD(smallerAngleDiff, smallerAngleDiff, "f:ff") \
+    ADD(largerAngleDiff, largerAngleDiff, "f:ff") \
+    ADD(_abs, abs, "n:n") \
+    ADD(pointDist, pointDist, "f:pp") \
+    ADD(pointAngle, pointAngle, "f:pp") \
+    ADD(_toRadians, toRadians, "f:f") \
+    ADD(_toDegrees, toDegrees, "f:f") \
+    ADD(_random, random, "n:nn") \
+    ADD(chance, chance, "b:f") \
+    ADD(isPointOutOfBounds, isPointOutOfBounds, "b:pf") \
+    /* scene signaling */ \
+    ADD(addLife, addLife, "b:") \
+    ADD(addBomb, addBomb, "b:") \
+    ADD(flagBossDeath, flagBossDeath, "b:") \
+    ADD(flagBulletClear, flagBulletClear, "b:") \
+    ADD(flagWin, flagWin, "b:") \
+    ADD(endStage, endStage, "b:") \
+    ADD(startDialogue, startDialogue, "b:s") \
+    ADD(flagUser1, flagUser1, "b:") \
+    ADD(isFlagged1, isFlagged1, "b:") \
+    /* spawning */ \
+    ADD(spawn, spawn, "b:spvi|ssss")
+
+#endif
@@ -1,6 +1,7 @@
 #include "NativeFuncs.h"
 
 #include "GameCommand.h"
+#include "NativeFuncList.h"
 #include "Prototypes.h"
 
 static VecsComponentSet playerPosSet
@@ -12,10 +13,69 @@ static VecsComponentSet playerSet
 static NecroNativeFuncSet *nativeFuncSetPtr = NULL;
 static bool initialized = false;
 
+/*
+ * the context of the native funcs run by each thread;
+ * thread local since native funcs take no context
+ */
+static _Thread_local NativeContext *_contextPtr = NULL;
+
 /* used for native funcs that work on the entity */
-static Game *_gamePtr;
-static Scene *_scenePtr;
-static VecsEntity _entity;
+#define _gamePtr (_contextPtr->gamePtr)
+#define _scenePtr (_contextPtr->scenePtr)
+#define _entity (_contextPtr->entity)
+#define _snapshotPtr (_contextPtr->snapshotPtr)
+#define _orderBufferPtr (&(_contextPtr->orders))
+
+/* the kinds of changes buffered by a NativeContext */
+typedef enum NativeCommandType{
+    native_addLife,
+    native_addBomb,
+    native_flagBossDeath,
+    native_flagBulletClear,
+    native_flagWin,
+    native_flagUser1,
+    native_unflagBossDeath,
+    native_unflagDialogueEnd,
+    native_unflagWin,
+    native_die,
+    native_endStage,
+    native_startDialogue,
+    native_spawn
+} NativeCommandType;
+
+#define maxSpawnScripts 4
+
+/*
+ * A change a native func makes to state shared with
+ * other entities, which is buffered until the main
+ * thread applies it
+ */
+typedef struct NativeCommand{
+    NativeCommandType type;
+    /* the entity flagged as dead */
+    VecsEntity entity;
+    /* dialogue id, or prototype id of a spawn */
+    String id;
+    /* script ids of a spawn, which may be empty */
+    String scriptIds[maxSpawnScripts];
+    int scriptIdCount;
+    Point2D pos;
+    Polar vel;
+    int depthOffset;
+} NativeCommand;
+
+#define commandListInitCapacity 16
+#define orderBufferInitCapacity 16
+
+/*
+ * Pushes the specified command to the back of the
+ * command list of the context of the calling thread
+ */
+#define pushCommand(COMMAND) \
+    arrayListPushBack(NativeCommand, \
+        &(_contextPtr->_commandList), \
+        (COMMAND) \
+    )
 
 /* the actual native funcs */
 
@@ -34,18 +94,6 @@ static VecsEntity _entity;
 #define _trapLifetime 36
 #define _timeBeforePostDialogue 55
 
-/*
- * error if the arity given to the native function is
- * not as specified
- */
-#define assertArity(ARITY, MSG) \
-    do{ \
-        if(argc != (ARITY)){ \
-            pgWarning(MSG); \
-            pgError("arity mismatch"); \
-        } \
-    } while(false); \
-
 /*
  * Fills the component pointer of the specified name
  * and type with a pointer to the actual component
@@ -90,8 +138,9 @@ static VecsEntity _entity;
             *componentPtr = *(COMPONENTPTR); \
         } \
         else{ \
-            vecsWorldEntityQueueSetComponent( \
+            vecsOrderBufferQueueSetComponent( \
                 TYPENAME, \
+                _orderBufferPtr, \
                 &(_scenePtr->ecsWorld), \
                 _entity, \
                 (COMPONENTPTR) \
@@ -104,7 +153,8 @@ static VecsEntity _entity;
  * the entity
  */
 #define removeComponent(TYPENAME) \
-    vecsWorldEntityQueueRemoveComponent(TYPENAME, \
+    vecsOrderBufferQueueRemoveComponent(TYPENAME, \
+        _orderBufferPtr, \
         &(_scenePtr->ecsWorld), \
         _entity \
     )
@@ -131,7 +181,6 @@ static VecsEntity _entity;
         int argc, \
         NecroValue *argv \
     ){ \
-        assertArity(0, #FUNCNAME); \
         return necroFloatValue(VALUE); \
     }
 
@@ -140,7 +189,6 @@ static VecsEntity _entity;
         int argc, \
         NecroValue *argv \
     ){ \
-        assertArity(0, #FUNCNAME); \
         return necroIntValue(VALUE); \
     }
 
@@ -149,7 +197,6 @@ static VecsEntity _entity;
         int argc, \
         NecroValue *argv \
     ){ \
-        assertArity(0, #FUNCNAME); \
         return necroVectorValue(VALUE); \
     }
 
@@ -158,7 +205,6 @@ static VecsEntity _entity;
         int argc, \
         NecroValue *argv \
     ){ \
-        assertArity(0, #FUNCNAME); \
         return necroPointValue(VALUE); \
     }
 
@@ -251,7 +297,6 @@ DECLARE_FLOAT_CONST(phi, z_phi)
  * error message
  */
 static NecroValue error(int argc, NecroValue *argv){
-    assertArity(1, "error expects 1 string arg");
     pgWarning("SCRIPT ERROR");
     pgError(necroObjectAsCString(*argv));
     /* should never be reached */
@@ -260,7 +305,6 @@ static NecroValue error(int argc, NecroValue *argv){
 
 /* warns the specified message */
 static NecroValue warn(int argc, NecroValue *argv){
-    assertArity(1, "warn expects 1 string arg");
     pgWarning("SCRIPT WARNING");
     pgWarning(necroObjectAsCString(*argv));
     return necroBoolValue(false);
@@ -269,42 +313,51 @@ static NecroValue warn(int argc, NecroValue *argv){
 /* GENERAL QUERIES */
 
 /*
- * Returns true if the boss death flag was set and
- * unsets it, false otherwise
+ * Returns true if the boss death flag was set before
+ * the tick began and unsets it once the tick's
+ * scripts have run, false otherwise; every script
+ * asking on the same tick sees it
  */
 static NecroValue isBossDead(int argc, NecroValue *argv){
-    assertArity(0, "isBossDead expects no args");
-    if(_scenePtr->messages.bossDeathFlag){
-        _scenePtr->messages.bossDeathFlag = false;
+    if(_snapshotPtr->bossDeathFlag){
+        pushCommand(((NativeCommand){
+            .type = native_unflagBossDeath
+        }));
         return necroBoolValue(true);
     }
     return necroBoolValue(false);
 }
 
 /*
- * Returns true if the end dialogue flag was set and
- * unsets it, false otherwise
+ * Returns true if the end dialogue flag was set before
+ * the tick began and unsets it once the tick's
+ * scripts have run, false otherwise; every script
+ * asking on the same tick sees it
  */
 static NecroValue isDialogueOver(
     int argc,
     NecroValue *argv
 ){
-    assertArity(0, "isDialogueOver expects no args");
-    if(_gamePtr->messages.endDialogueFlag){
-        _gamePtr->messages.endDialogueFlag = false;
+    if(_snapshotPtr->endDialogueFlag){
+        pushCommand(((NativeCommand){
+            .type = native_unflagDialogueEnd
+        }));
         return necroBoolValue(true);
     }
     return necroBoolValue(false);
 }
 
 /*
- * Returns true if the win flag was set and unsets it,
- * false otherwise
+ * Returns true if the win flag was set before the
+ * tick began and unsets it once the tick's scripts
+ * have run, false otherwise; every script asking on
+ * the same tick sees it
  */
 static NecroValue isWin(int argc, NecroValue *argv){
-    assertArity(0, "isWin expects no args");
-    if(_scenePtr->messages.winFlag){
-        _scenePtr->messages.winFlag = false;
+    if(_snapshotPtr->winFlag){
+        pushCommand(((NativeCommand){
+            .type = native_unflagWin
+        }));
         return necroBoolValue(true);
     }
     return necroBoolValue(false);
@@ -315,7 +368,6 @@ static NecroValue isWin(int argc, NecroValue *argv){
  * 1 is normal, 2 is hard, and 3 is lunatic
  */
 static NecroValue getDifficulty(int argc, NecroValue *argv){
-    assertArity(0, "getDifficulty expects no args");
     return necroIntValue(
         _gamePtr->messages.gameState.difficulty
     );
@@ -327,34 +379,15 @@ static NecroValue getDifficulty(int argc, NecroValue *argv){
  * possible
  */
 static NecroValue getPlayerPos(int argc, NecroValue *argv){
-    assertArity(0, "getPlayerPos expects no args");
-
-    /* get players with position */
-    VecsQueryItr itr = vecsWorldRequestQueryItr(
-        &(_scenePtr->ecsWorld),
-        playerPosSet,
-        vecsEmptyComponentSet
-    );
-    /* if player exists, grab first one */
-    if(vecsQueryItrHasEntity(&itr)){
-        Position *positionPtr = vecsQueryItrGetPtr(
-            Position,
-            &itr
-        );
-        return necroPointValue(positionPtr->currentPos);
-    }
-    /* otherwise just return player spawn */
-    else{
-        return necroPointValue(config_playerSpawn);
-    }
+    return necroPointValue(_snapshotPtr->playerPos);
 }
 
 /* ENTITY GRAPHICS */
 
 /* Marks the entity as visible */
 static NecroValue setVisible(int argc, NecroValue *argv){
-    assertArity(0, "setVisible expects no args");
-    vecsWorldEntityQueueSetComponent(VisibleMarker,
+    vecsOrderBufferQueueSetComponent(VisibleMarker,
+        _orderBufferPtr,
         &(_scenePtr->ecsWorld),
         _entity,
         NULL
@@ -364,7 +397,6 @@ static NecroValue setVisible(int argc, NecroValue *argv){
 
 /* Unmarks the entity as visible */
 static NecroValue removeVisible(int argc, NecroValue *argv){
-    assertArity(0, "removeVisible expects no args");
     removeComponent(VisibleMarker);
     return necroBoolValue(false);
 }
@@ -374,12 +406,9 @@ static NecroValue setRotateSpriteForward(
     int argc,
     NecroValue *argv
 ){
-    assertArity(
-        0,
-        "setRotateSpriteForward expects no args"
-    );
-    vecsWorldEntityQueueSetComponent(
+    vecsOrderBufferQueueSetComponent(
         RotateSpriteForwardMarker,
+        _orderBufferPtr,
         &(_scenePtr->ecsWorld),
         _entity,
         NULL
@@ -392,10 +421,6 @@ static NecroValue removeRotateSpriteForward(
     int argc,
     NecroValue *argv
 ){
-    assertArity(
-        0,
-        "removeRotateSpriteForward expects no args"
-    );
     removeComponent(RotateSpriteForwardMarker);
     return necroBoolValue(false);
 }
@@ -404,7 +429,6 @@ static NecroValue removeRotateSpriteForward(
  * Set the sprite of the entity to the requested image
  */
 static NecroValue setSprite(int argc, NecroValue *argv){
-    assertArity(1, "setSprite expects 1 string arg");
     String *stringPtr
         = &(necroObjectAsString(*argv)->string);
     TFSprite *spritePtr = resourcesGetSprite(
@@ -412,7 +436,7 @@ static NecroValue setSprite(int argc, NecroValue *argv){
         stringPtr
     );
     if(!spritePtr){
-        pgWarning(stringPtr->_ptr);
+        pgWarning(stringCharPtr(stringPtr));
         pgError("failed to get sprite;" SRC_LOCATION);
     }
 
@@ -437,13 +461,6 @@ static NecroValue setSpriteInstruction(
     int argc,
     NecroValue *argv
 ){
-    assertArity(
-        5,
-        "usage: setSpriteInstruction("
-        "string id, int depth, vector offset, number "
-        "rotation, number scale)"
-    );
-
     /* build the sprite instruction */
     SpriteInstruction spriteInstr = {0};
     String *stringPtr
@@ -453,24 +470,19 @@ static NecroValue setSpriteInstruction(
         stringPtr
     );
     if(!spriteInstr.spritePtr){
-        pgWarning(stringPtr->_ptr);
+        pgWarning(stringCharPtr(stringPtr));
         pgError("failed to get sprite;" SRC_LOCATION);
     }
     spriteInstr.depth = necroAsInt(argv[1]);
     spriteInstr.offset = polarToVector(
         necroAsVector(argv[2])
     );
-    spriteInstr.rotation = getValueAsNumber(
-        argv[3],
-        "rotation should be a number; " SRC_LOCATION
-    );
-    spriteInstr.scale = getValueAsNumber(
-        argv[4],
-        "scale should be a number; " SRC_LOCATION
-    );
+    spriteInstr.rotation = necroAsFloat(argv[3]);
+    spriteInstr.scale = necroAsFloat(argv[4]);
 
     /* queue a set command */
-    vecsWorldEntityQueueSetComponent(SpriteInstruction,
+    vecsOrderBufferQueueSetComponent(SpriteInstruction,
+        _orderBufferPtr,
         &(_scenePtr->ecsWorld),
         _entity,
         &spriteInstr
@@ -481,7 +493,6 @@ static NecroValue setSpriteInstruction(
 
 /* Sets the depth of the entity sprite */
 static NecroValue setDepth(int argc, NecroValue *argv){
-    assertArity(1, "setDepth expects 1 int arg");
     int depth = necroAsInt(*argv);
 
     SpriteInstruction *spriteInstrPtr = NULL;
@@ -497,11 +508,7 @@ static NecroValue setDepth(int argc, NecroValue *argv){
 
 /* Sets the rotation of the entity sprite */
 static NecroValue setRotation(int argc, NecroValue *argv){
-    assertArity(1, "setRotation expects 1 float arg");
-    float rotation = getValueAsNumber(
-        *argv,
-        "set rotation expects a number; " SRC_LOCATION
-    );
+    float rotation = necroAsFloat(*argv);
 
     SpriteInstruction *spriteInstrPtr = NULL;
     fillComponentPtr(SpriteInstruction,
@@ -516,11 +523,7 @@ static NecroValue setRotation(int argc, NecroValue *argv){
 
 /* Sets the scale of the entity sprite */
 static NecroValue setScale(int argc, NecroValue *argv){
-    assertArity(1, "setScale expects 1 float arg");
-    float scale = getValueAsNumber(
-        *argv,
-        "set scale expects a number; " SRC_LOCATION
-    );
+    float scale = necroAsFloat(*argv);
 
     SpriteInstruction *spriteInstrPtr = NULL;
     fillComponentPtr(SpriteInstruction,
@@ -541,8 +544,6 @@ static NecroValue getPosition(
     int argc,
     NecroValue *argv
 ){
-    assertArity(0, "getPosition expects no args");
-
     Position *positionPtr = NULL;
     fillComponentPtr(Position,
         positionPtr,
@@ -555,8 +556,6 @@ static NecroValue getPosition(
 
 /* Returns the x coordinate of the entity */
 static NecroValue getX(int argc, NecroValue *argv){
-    assertArity(0, "getX expects no args");
-
     Point2D position
         = necroAsPoint(getPosition(0, NULL));
     return necroFloatValue(position.x);
@@ -564,8 +563,6 @@ static NecroValue getX(int argc, NecroValue *argv){
 
 /* Returns the y coordinate of the entity */
 static NecroValue getY(int argc, NecroValue *argv){
-    assertArity(0, "getY expects no args");
-
     Point2D position
         = necroAsPoint(getPosition(0, NULL));
     return necroFloatValue(position.y);
@@ -576,7 +573,6 @@ static NecroValue getAngleToPlayer(
     int argc,
     NecroValue *argv
 ){
-    assertArity(0, "getAngleToPlayer expects no args");
     
     Point2D playerPos
         = necroAsPoint(getPlayerPos(0, NULL));
@@ -593,8 +589,6 @@ static NecroValue getAngleToPlayer(
  * vector)
  */
 static NecroValue getVelocity(int argc, NecroValue *argv){
-    assertArity(0, "getVelocity expects no args");
-
     Velocity *velocityPtr = NULL;
     fillComponentPtr(Velocity,
         velocityPtr,
@@ -610,8 +604,6 @@ static NecroValue getVelocity(int argc, NecroValue *argv){
  * its velocity
  */
 static NecroValue getSpeed(int argc, NecroValue *argv){
-    assertArity(0, "getSpeed expects no args");
-
     Polar velocity
         = necroAsVector(getVelocity(0, NULL));
     return necroFloatValue(velocity.magnitude);
@@ -622,8 +614,6 @@ static NecroValue getSpeed(int argc, NecroValue *argv){
  * its velocity
  */
 static NecroValue getAngle(int argc, NecroValue *argv){
-    assertArity(0, "getAngle expects no args");
-
     Polar velocity
         = necroAsVector(getVelocity(0, NULL));
     return necroFloatValue(velocity.angle);
@@ -631,8 +621,6 @@ static NecroValue getAngle(int argc, NecroValue *argv){
 
 /* Returns the sprite spin of the entity */
 static NecroValue getSpin(int argc, NecroValue *argv){
-    assertArity(0, "getSpin expects no args");
-
     SpriteSpin *spinPtr = NULL;
     fillComponentPtr(SpriteSpin,
         spinPtr,
@@ -649,8 +637,6 @@ static NecroValue getSpin(int argc, NecroValue *argv){
  * slots 3 and 4
  */
 static NecroValue isSpawning(int argc, NecroValue *argv){
-    assertArity(0, "isSpawning expects no args");
-
     Scripts *scriptsPtr = NULL;
     fillComponentPtr(Scripts,
         scriptsPtr,
@@ -667,31 +653,15 @@ static NecroValue isSpawning(int argc, NecroValue *argv){
 
 /* Returns the current power of the player */
 static NecroValue getPlayerPower(int argc, NecroValue *argv){
-    assertArity(0, "getPlayerPower expects no args");
-
-    /* get players */
-    VecsQueryItr itr = vecsWorldRequestQueryItr(
-        &(_scenePtr->ecsWorld),
-        playerSet,
-        vecsEmptyComponentSet
-    );
-    /* if player exists, grab first one */
-    if(vecsQueryItrHasEntity(&itr)){
-        PlayerData *playerDataPtr = vecsQueryItrGetPtr(
-            PlayerData,
-            &itr
-        );
-        return necroIntValue(playerDataPtr->power);
-    }
     /* error if no player exists */
-    else{
+    if(!_snapshotPtr->playerPresent){
         pgError(
             "failed to find player for "
             "getPlayerPower; "
             SRC_LOCATION
         );
-        return necroBoolValue(false);
     }
+    return necroIntValue(_snapshotPtr->playerPower);
 }
 
 /*
@@ -702,34 +672,15 @@ static NecroValue isPlayerFocused(
     int argc,
     NecroValue *argv
 ){
-    assertArity(0, "isPlayerFocused expects no args");
-
-    /*
-     * search game commands for a focus command, since
-     * the player would have to press down the focus
-     * button on every frame including the current one
-     * to be focused
-     */
-    ArrayList *gameCommandsPtr
-        = &(_scenePtr->messages.gameCommands);
-    for(size_t i = 0; i < gameCommandsPtr->size; ++i){
-        GameCommand command = arrayListGet(GameCommand,
-            gameCommandsPtr,
-            i
-        );
-        if(command == game_focus){
-            return necroBoolValue(true);
-        }
-    }
-    return necroBoolValue(false);
+    return necroBoolValue(_snapshotPtr->playerFocused);
 }
 
 /* ENTITY MUTATORS */
 
 /* Marks the entity as collidable */
 static NecroValue setCollidable(int argc, NecroValue *argv){
-    assertArity(0, "setCollidable expects no args");
-    vecsWorldEntityQueueSetComponent(CollidableMarker,
+    vecsOrderBufferQueueSetComponent(CollidableMarker,
+        _orderBufferPtr,
         &(_scenePtr->ecsWorld),
         _entity,
         NULL
@@ -742,14 +693,12 @@ static NecroValue removeCollidable(
     int argc,
     NecroValue *argv
 ){
-    assertArity(0, "removeCollidable expects no args");
     removeComponent(CollidableMarker);
     return necroBoolValue(false);
 }
 
 /* Sets the entity health to the specified value */
 static NecroValue setHealth(int argc, NecroValue *argv){
-    assertArity(1, "setHealth expects int arg");
     int health = necroAsInt(*argv);
     setComponent(Health, &health);
     return necroBoolValue(false);
@@ -757,14 +706,12 @@ static NecroValue setHealth(int argc, NecroValue *argv){
 
 /* Removes the entity's health component entirely */
 static NecroValue removeHealth(int argc, NecroValue *argv){
-    assertArity(0, "removeHealth expects 0 args");
     removeComponent(Health);
     return necroBoolValue(false);
 }
 
 /* Sets the entity damage to the specified value */
 static NecroValue setDamage(int argc, NecroValue *argv){
-    assertArity(1, "setDamage expects int arg");
     int damage = necroAsInt(*argv);
     setComponent(Damage, &damage);
     return necroBoolValue(false);
@@ -772,15 +719,14 @@ static NecroValue setDamage(int argc, NecroValue *argv){
 
 /* Removes the entity's damage component entirely */
 static NecroValue removeDamage(int argc, NecroValue *argv){
-    assertArity(0, "removeDamage expects 0 args");
     removeComponent(Damage);
     return necroBoolValue(false);
 }
 
 /* Marks the entity as clearable */
 static NecroValue setClearable(int argc, NecroValue *argv){
-    assertArity(0, "setClearable expects no args");
-    vecsWorldEntityQueueSetComponent(ClearableMarker,
+    vecsOrderBufferQueueSetComponent(ClearableMarker,
+        _orderBufferPtr,
         &(_scenePtr->ecsWorld),
         _entity,
         NULL
@@ -793,50 +739,38 @@ static NecroValue removeClearable(
     int argc,
     NecroValue *argv
 ){
-    assertArity(0, "removeClearable expects no args");
     removeComponent(ClearableMarker);
     return necroBoolValue(false);
 }
 
 /* Sets the entity inbound to the specified value */
 static NecroValue setInbound(int argc, NecroValue *argv){
-    assertArity(1, "setInbound expects float arg");
-    float inbound = getValueAsNumber(
-        *argv,
-        "set inbound expects a number; " SRC_LOCATION
-    );
+    float inbound = necroAsFloat(*argv);
     setComponent(Inbound, &inbound);
     return necroBoolValue(false);
 }
 
 /* Removes the entity's inbound component entirely */
 static NecroValue removeInbound(int argc, NecroValue *argv){
-    assertArity(0, "removeInbound expects 0 args");
     removeComponent(Inbound);
     return necroBoolValue(false);
 }
 
 /* Sets the entity outbound to the specified value */
 static NecroValue setOutbound(int argc, NecroValue *argv){
-    assertArity(1, "setOutbound expects float arg");
-    float outbound = getValueAsNumber(
-        *argv,
-        "set outbound expects a number; " SRC_LOCATION
-    );
+    float outbound = necroAsFloat(*argv);
     setComponent(Outbound, &outbound);
     return necroBoolValue(false);
 }
 
 /* Removes the entity's outbound component entirely */
 static NecroValue removeOutbound(int argc, NecroValue *argv){
-    assertArity(0, "removeOutbound expects 0 args");
     removeComponent(Outbound);
     return necroBoolValue(false);
 }
 
 /* Sets the entity position to the specified value */
 static NecroValue setPosition(int argc, NecroValue *argv){
-    assertArity(1, "setPosition expects point arg");
     Point2D point = necroAsPoint(*argv);
     /*
      * by using the point for both frames, essentially
@@ -851,14 +785,12 @@ static NecroValue setPosition(int argc, NecroValue *argv){
 
 /* Removes the entity's position component entirely */
 static NecroValue removePosition(int argc, NecroValue *argv){
-    assertArity(0, "removePosition expects 0 args");
     removeComponent(Position);
     return necroBoolValue(false);
 }
 
 /* Sets the entity velocity to the specified value */
 static NecroValue setVelocity(int argc, NecroValue *argv){
-    assertArity(1, "setVelocity expects vector arg");
     Velocity velocity = necroAsVector(*argv);
     setComponent(Velocity, &velocity);
     return necroBoolValue(false);
@@ -866,18 +798,13 @@ static NecroValue setVelocity(int argc, NecroValue *argv){
 
 /* Removes the entity's velocity component entirely */
 static NecroValue removeVelocity(int argc, NecroValue *argv){
-    assertArity(0, "removeVelocity expects 0 args");
     removeComponent(Velocity);
     return necroBoolValue(false);
 }
 
 /* Sets the entity speed to the specified value */
 static NecroValue setSpeed(int argc, NecroValue *argv){
-    assertArity(1, "setSpeed expects float arg");
-    float speed = getValueAsNumber(
-        *argv,
-        "set speed expects a number; " SRC_LOCATION
-    );
+    float speed = necroAsFloat(*argv);
 
     Velocity *velocityPtr = NULL;
     fillComponentPtr(Velocity,
@@ -893,11 +820,7 @@ static NecroValue setSpeed(int argc, NecroValue *argv){
 
 /* Sets the entity angle to the specified value */
 static NecroValue setAngle(int argc, NecroValue *argv){
-    assertArity(1, "setAngle expects float arg");
-    float angle = getValueAsNumber(
-        *argv,
-        "set angle expects a number; " SRC_LOCATION
-    );
+    float angle = necroAsFloat(*argv);
 
     Velocity *velocityPtr = NULL;
     fillComponentPtr(Velocity,
@@ -915,11 +838,7 @@ static NecroValue setAngle(int argc, NecroValue *argv){
  * Sets the entity sprite spin to the specified value
  */
 static NecroValue setSpin(int argc, NecroValue *argv){
-    assertArity(1, "setSpin expects float arg");
-    SpriteSpin spin = getValueAsNumber(
-        *argv,
-        "set spin expects a number; " SRC_LOCATION
-    );
+    SpriteSpin spin = necroAsFloat(*argv);
     setComponent(SpriteSpin, &spin);
     return necroBoolValue(false);
 }
@@ -928,18 +847,16 @@ static NecroValue setSpin(int argc, NecroValue *argv){
  * Removes the entity's sprite spin component entirely
  */
 static NecroValue removeSpin(int argc, NecroValue *argv){
-    assertArity(0, "removeSpin expects 0 args");
     removeComponent(SpriteSpin);
     return necroBoolValue(false);
 }
 
 /* Flags the entity as dead */
 static NecroValue die(int argc, NecroValue *argv){
-    assertArity(0, "die expects 0 args");
-    arrayListPushBack(VecsEntity,
-        &(_scenePtr->messages.deaths),
-        _entity
-    );
+    pushCommand(((NativeCommand){
+        .type = native_die,
+        .entity = _entity
+    }));
     return necroBoolValue(false);
 }
 
@@ -948,8 +865,8 @@ static NecroValue die(int argc, NecroValue *argv){
  * the death system
  */
 static NecroValue removeEntity(int argc, NecroValue *argv){
-    assertArity(0, "removeEntity expects 0 args");
-    vecsWorldEntityQueueRemoveEntity(
+    vecsOrderBufferQueueRemoveEntity(
+        _orderBufferPtr,
         &(_scenePtr->ecsWorld),
         _entity
     );
@@ -963,8 +880,6 @@ static NecroValue removeEntity(int argc, NecroValue *argv){
  * specified VM slot, false otherwise
  */
 static NecroValue hasScript(int argc, NecroValue *argv){
-    assertArity(1, "usage: hasScript(slot)");
-
     /* get the slot */
     int slot = necroAsInt(*argv);
     if(slot < 1 || slot > 4){
@@ -1008,8 +923,6 @@ static NecroValue hasScript(int argc, NecroValue *argv){
  * in slots 3 and 4
  */
 static NecroValue addScript(int argc, NecroValue *argv){
-    assertArity(2, "usage: addScript(scriptId, slot)");
-
     /* get the script */
     String *stringPtr
         = &(necroObjectAsString(argv[0])->string);
@@ -1018,7 +931,7 @@ static NecroValue addScript(int argc, NecroValue *argv){
         stringPtr
     );
     if(!scriptPtr){
-        pgWarning(stringPtr->_ptr);
+        pgWarning(stringCharPtr(stringPtr));
         pgError("failed to get script; " SRC_LOCATION);
     }
 
@@ -1090,8 +1003,6 @@ static NecroValue addScript(int argc, NecroValue *argv){
  * UB IF ATTEMPTING TO REMOVE SELF
  */
 static NecroValue removeScript(int argc, NecroValue *argv){
-    assertArity(1, "usage: removeScript(slot)");
-
     /* get the slot */
     int slot = necroAsInt(*argv);
     if(slot < 1 || slot > 4){
@@ -1156,8 +1067,6 @@ static NecroValue removeScript(int argc, NecroValue *argv){
  * SELF
  */
 static NecroValue removeSpawns(int argc, NecroValue *argv){
-    assertArity(0, "removeSpawns expects 0 args");
-
     /* get the script component */
     Scripts *scriptsPtr = NULL;
     fillComponentPtr(Scripts,
@@ -1196,11 +1105,6 @@ static NecroValue removeSpawns(int argc, NecroValue *argv){
  * are typically used for spawns
  */
 static NecroValue addDeathScript(int argc, NecroValue *argv){
-    assertArity(
-        2,
-        "usage: addDeathScript(scriptId, slot)"
-    );
-
     /* get the script Id */
     String *stringPtr
         = &(necroObjectAsString(argv[0])->string);
@@ -1233,9 +1137,9 @@ static NecroValue addDeathScript(int argc, NecroValue *argv){
          */
         #define loadDeathScript(SLOT) \
             do{ \
-                if(!deathScriptsPtr->scriptId##SLOT \
-                    ._ptr \
-                ){ \
+                if(!stringIsMade( \
+                    &(deathScriptsPtr->scriptId##SLOT) \
+                )){ \
                     deathScriptsPtr->scriptId##SLOT \
                         = stringCopy(stringPtr); \
                     return necroBoolValue(true); \
@@ -1300,7 +1204,8 @@ static NecroValue addDeathScript(int argc, NecroValue *argv){
                 );
                 break;
         }
-        vecsWorldEntityQueueAddComponent(DeathScripts,
+        vecsOrderBufferQueueAddComponent(DeathScripts,
+            _orderBufferPtr,
             &(_scenePtr->ecsWorld),
             _entity,
             &deathScripts
@@ -1321,8 +1226,6 @@ static NecroValue removeDeathScript(
     int argc,
     NecroValue *argv
 ){
-    assertArity(1, "usage: removeDeathScript(slot)");
-
     int slot = necroAsInt(*argv);
     if(slot < 1 || slot > 4){
         pgError(
@@ -1355,9 +1258,9 @@ static NecroValue removeDeathScript(
      */
     #define removeDeathScript(SLOT) \
         do{ \
-            if(deathScriptsPtr->scriptId##SLOT \
-                ._ptr \
-            ){ \
+            if(stringIsMade( \
+                &(deathScriptsPtr->scriptId##SLOT) \
+            )){ \
                 stringFree( \
                     &(deathScriptsPtr \
                         ->scriptId##SLOT) \
@@ -1403,11 +1306,6 @@ static NecroValue removeDeathScript(
  * axis
  */
 static NecroValue flipX(int argc, NecroValue *argv){
-    assertArity(
-        1,
-        "flipX expects float or vector arg"
-    );
-
     NecroValue value = *argv;
     if(necroIsFloat(value)){
         float floatValue = necroAsFloat(value);
@@ -1433,11 +1331,6 @@ static NecroValue flipX(int argc, NecroValue *argv){
  * axis
  */
 static NecroValue flipY(int argc, NecroValue *argv){
-    assertArity(
-        1,
-        "flipY expects float or vector arg"
-    );
-
     NecroValue value = *argv;
     if(necroIsFloat(value)){
         float floatValue = necroAsFloat(value);
@@ -1465,11 +1358,6 @@ static NecroValue flipY(int argc, NecroValue *argv){
  * the result will also be a float)
  */
 static NecroValue _pow(int argc, NecroValue *argv){
-    assertArity(
-        2,
-        "usage: pow(base, exponent)"
-    );
-
     NecroValue baseValue = argv[0];
     NecroValue expValue = argv[1];
 
@@ -1517,13 +1405,7 @@ static NecroValue _pow(int argc, NecroValue *argv){
  * float and returns a float, works in radians
  */
 static NecroValue _sin(int argc, NecroValue *argv){
-    assertArity(1, "sin expects 1 number arg");
-
-    float arg = getValueAsNumber(
-        *argv,
-        "arg of sin() function should be number; "
-        SRC_LOCATION
-    );
+    float arg = necroAsFloat(*argv);
     return necroFloatValue(sinf(arg));
 }
 
@@ -1532,13 +1414,7 @@ static NecroValue _sin(int argc, NecroValue *argv){
  * float and returns a float, works in radians
  */
 static NecroValue _cos(int argc, NecroValue *argv){
-    assertArity(1, "cos expects 1 number arg");
-
-    float arg = getValueAsNumber(
-        *argv,
-        "arg of cos() function should be number; "
-        SRC_LOCATION
-    );
+    float arg = necroAsFloat(*argv);
     return necroFloatValue(cosf(arg));
 }
 
@@ -1547,13 +1423,7 @@ static NecroValue _cos(int argc, NecroValue *argv){
  * float and returns a float, works in radians
  */
 static NecroValue _tan(int argc, NecroValue *argv){
-    assertArity(1, "tan expects 1 number arg");
-
-    float arg = getValueAsNumber(
-        *argv,
-        "arg of tan() function should be number; "
-        SRC_LOCATION
-    );
+    float arg = necroAsFloat(*argv);
     return necroFloatValue(tanf(arg));
 }
 
@@ -1562,13 +1432,7 @@ static NecroValue _tan(int argc, NecroValue *argv){
  * float and returns a float, works in radians
  */
 static NecroValue _sec(int argc, NecroValue *argv){
-    assertArity(1, "sec expects 1 number arg");
-
-    float arg = getValueAsNumber(
-        *argv,
-        "arg of sec() function should be number; "
-        SRC_LOCATION
-    );
+    float arg = necroAsFloat(*argv);
     float cos = cosf(arg);
     if(cos == 0.0f){
         pgError("cannot compute sec; divide by 0");
@@ -1581,13 +1445,7 @@ static NecroValue _sec(int argc, NecroValue *argv){
  * float and returns a float, works in radians
  */
 static NecroValue _csc(int argc, NecroValue *argv){
-    assertArity(1, "csc expects 1 number arg");
-
-    float arg = getValueAsNumber(
-        *argv,
-        "arg of csc() function should be number; "
-        SRC_LOCATION
-    );
+    float arg = necroAsFloat(*argv);
     float sin = sinf(arg);
     if(sin == 0.0f){
         pgError("cannot compute csc; divide by 0");
@@ -1600,13 +1458,7 @@ static NecroValue _csc(int argc, NecroValue *argv){
  * float and returns a float, works in radians
  */
 static NecroValue _cot(int argc, NecroValue *argv){
-    assertArity(1, "cot expects 1 number arg");
-
-    float arg = getValueAsNumber(
-        *argv,
-        "arg of cot() function should be number; "
-        SRC_LOCATION
-    );
+    float arg = necroAsFloat(*argv);
     float tan = tanf(arg);
     if(tan == 0.0f){
         pgError("cannot compute cot; divide by 0");
@@ -1619,13 +1471,7 @@ static NecroValue _cot(int argc, NecroValue *argv){
  * float and returns a float, works in radians
  */
 static NecroValue arcsin(int argc, NecroValue *argv){
-    assertArity(1, "arcsin expects 1 number arg");
-
-    float arg = getValueAsNumber(
-        *argv,
-        "arg of arcsin() function should be number; "
-        SRC_LOCATION
-    );
+    float arg = necroAsFloat(*argv);
     return necroFloatValue(asinf(arg));
 }
 
@@ -1634,13 +1480,7 @@ static NecroValue arcsin(int argc, NecroValue *argv){
  * float and returns a float, works in radians
  */
 static NecroValue arccos(int argc, NecroValue *argv){
-    assertArity(1, "arccos expects 1 number arg");
-
-    float arg = getValueAsNumber(
-        *argv,
-        "arg of arccos() function should be number; "
-        SRC_LOCATION
-    );
+    float arg = necroAsFloat(*argv);
     return necroFloatValue(acosf(arg));
 }
 
@@ -1649,13 +1489,7 @@ static NecroValue arccos(int argc, NecroValue *argv){
  * float and returns a float, works in radians
  */
 static NecroValue arctan(int argc, NecroValue *argv){
-    assertArity(1, "arctan expects 1 number arg");
-
-    float arg = getValueAsNumber(
-        *argv,
-        "arg of arctan() function should be number; "
-        SRC_LOCATION
-    );
+    float arg = necroAsFloat(*argv);
     return necroFloatValue(atanf(arg));
 }
 
@@ -1666,9 +1500,6 @@ static NecroValue arctan(int argc, NecroValue *argv){
 static NecroValue _max(int argc, NecroValue *argv){
     static const char* notNumberErrMsg
         = "args of max() should all be numbers";
-    if(argc <= 0){
-        pgError("max should have at least 1 arg");
-    }
     float maxValue = getValueAsNumber(
         *argv,
         notNumberErrMsg
@@ -1694,9 +1525,6 @@ static NecroValue _max(int argc, NecroValue *argv){
 static NecroValue _min(int argc, NecroValue *argv){
     static const char* notNumberErrMsg
         = "args of min() should all be numbers";
-    if(argc <= 0){
-        pgError("min should have at least 1 arg");
-    }
     float minValue = getValueAsNumber(
         *argv,
         notNumberErrMsg
@@ -1723,22 +1551,8 @@ static NecroValue smallerAngleDiff(
     int argc,
     NecroValue *argv
 ){
-    static const char* notNumberErrMsg
-        = "args of smallerAngleDiff() should all be "
-            "numbers";
-    assertArity(
-        2,
-        "usage: smallerAngleDiff(from, to)"
-    );
-
-    float from = getValueAsNumber(
-        argv[0],
-        notNumberErrMsg
-    );
-    float to = getValueAsNumber(
-        argv[1],
-        notNumberErrMsg
-    );
+    float from = necroAsFloat(argv[0]);
+    float to = necroAsFloat(argv[1]);
     return necroFloatValue(
         angleSmallerDifference(from, to)
     );
@@ -1752,22 +1566,8 @@ static NecroValue largerAngleDiff(
     int argc,
     NecroValue *argv
 ){
-    static const char* notNumberErrMsg
-        = "args of largerAngleDiff() should all be "
-            "numbers";
-    assertArity(
-        2,
-        "usage: largerAngleDiff(from, to)"
-    );
-
-    float from = getValueAsNumber(
-        argv[0],
-        notNumberErrMsg
-    );
-    float to = getValueAsNumber(
-        argv[1],
-        notNumberErrMsg
-    );
+    float from = necroAsFloat(argv[0]);
+    float to = necroAsFloat(argv[1]);
     return necroFloatValue(
         angleLargerDifference(from, to)
     );
@@ -1778,8 +1578,6 @@ static NecroValue largerAngleDiff(
  * integer or a float depending on its type
  */
 static NecroValue _abs(int argc, NecroValue *argv){
-    assertArity(1, "abs expects 1 number arg");
-
     NecroValue value = *argv;
     if(necroIsInt(value)){
         return necroIntValue(abs(necroAsInt(value)));
@@ -1798,8 +1596,6 @@ static NecroValue _abs(int argc, NecroValue *argv){
 
 /* Returns the distance between two points */
 static NecroValue pointDist(int argc, NecroValue *argv){
-    assertArity(2, "pointDist expects 2 point args");
-
     Point2D pointA = necroAsPoint(argv[0]);
     Point2D pointB = necroAsPoint(argv[1]);
 
@@ -1813,8 +1609,6 @@ static NecroValue pointDist(int argc, NecroValue *argv){
  * in degrees
  */
 static NecroValue pointAngle(int argc, NecroValue *argv){
-    assertArity(2, "pointAngle expects 2 point args");
-
     Point2D pointA = necroAsPoint(argv[0]);
     Point2D pointB = necroAsPoint(argv[1]);
 
@@ -1826,12 +1620,7 @@ static NecroValue pointAngle(int argc, NecroValue *argv){
  * and returns the result as a float
  */
 static NecroValue _toRadians(int argc, NecroValue *argv){
-    assertArity(1, "toRadians expects 1 number arg");
-    float degrees = getValueAsNumber(
-        *argv,
-        "toRadians expects a number; "
-        SRC_LOCATION
-    );
+    float degrees = necroAsFloat(*argv);
     return necroFloatValue(toRadians(degrees));
 }
 
@@ -1840,12 +1629,7 @@ static NecroValue _toRadians(int argc, NecroValue *argv){
  * and returns the result as a float
  */
 static NecroValue _toDegrees(int argc, NecroValue *argv){
-    assertArity(1, "toDegrees expects 1 number arg");
-    float radians = getValueAsNumber(
-        *argv,
-        "toDegrees expects a number; "
-        SRC_LOCATION
-    );
+    float radians = necroAsFloat(*argv);
     return necroFloatValue(toDegrees(radians));
 }
 
@@ -1856,12 +1640,7 @@ static NecroValue _toDegrees(int argc, NecroValue *argv){
  * otherwise calculates a random float
  */
 static NecroValue _random(int argc, NecroValue *argv){
-    assertArity(
-        2,
-        "usage: random(number min, number max)"
-    );
-
-    ZMT *prngPtr = &(_scenePtr->messages.prng);
+    ZMT *prngPtr = &(_contextPtr->prng);
     
     NecroValue minValue = argv[0];
     NecroValue maxValue = argv[1];
@@ -1901,14 +1680,8 @@ static NecroValue _random(int argc, NecroValue *argv){
  * bounds
  */
 static NecroValue chance(int argc, NecroValue *argv){
-    assertArity(1, "chance() expects 1 float arg");
-
-    ZMT *prngPtr = &(_scenePtr->messages.prng);
+    ZMT *prngPtr = &(_contextPtr->prng);
 
-    assertTrue(
-        necroIsFloat(*argv),
-        "chance expects a float; " SRC_LOCATION
-    );
     float chance = necroAsFloat(*argv);
 
     if(chance < 0.0f || chance > 1.0f){
@@ -1936,15 +1709,8 @@ static NecroValue isPointOutOfBounds(
     int argc,
     NecroValue *argv
 ){
-    assertArity(
-        2,
-        "usage: isPointOutOfBounds(point, bound)"
-    );
     Point2D point = necroAsPoint(argv[0]);
-    float bound = getValueAsNumber(
-        argv[1],
-        "bound should be a number; " SRC_LOCATION
-    );
+    float bound = necroAsFloat(argv[1]);
     return necroBoolValue(isOutOfBounds(point, bound));
 }
 
@@ -1955,8 +1721,7 @@ static NecroValue isPointOutOfBounds(
  * on the same tick will have an extra effect
  */
 static NecroValue addLife(int argc, NecroValue *argv){
-    assertArity(0, "addLife expects 0 args");
-    ++(_scenePtr->messages.livesToAdd);
+    pushCommand(((NativeCommand){.type = native_addLife}));
     return necroBoolValue(false);
 }
 
@@ -1965,8 +1730,7 @@ static NecroValue addLife(int argc, NecroValue *argv){
  * on the same tick will have an extra effect
  */
 static NecroValue addBomb(int argc, NecroValue *argv){
-    assertArity(0, "addBomb expects 0 args");
-    ++(_scenePtr->messages.bombsToAdd);
+    pushCommand(((NativeCommand){.type = native_addBomb}));
     return necroBoolValue(false);
 }
 
@@ -1975,8 +1739,9 @@ static NecroValue addBomb(int argc, NecroValue *argv){
  * same tick has no extra effect
  */
 static NecroValue flagBossDeath(int argc, NecroValue *argv){
-    assertArity(0, "flagBossDeath expects 0 args");
-    _scenePtr->messages.bossDeathFlag = true;
+    pushCommand(((NativeCommand){
+        .type = native_flagBossDeath
+    }));
     return necroBoolValue(false);
 }
 
@@ -1988,8 +1753,9 @@ static NecroValue flagBulletClear(
     int argc,
     NecroValue *argv
 ){
-    assertArity(0, "flagBulletClear expects 0 args");
-    _scenePtr->messages.clearFlag = true;
+    pushCommand(((NativeCommand){
+        .type = native_flagBulletClear
+    }));
     return necroBoolValue(false);
 }
 
@@ -1998,19 +1764,17 @@ static NecroValue flagBulletClear(
  * same tick has no extra effect
  */
 static NecroValue flagWin(int argc, NecroValue *argv){
-    assertArity(0, "flagWin expects 0 args");
-    _scenePtr->messages.winFlag = true;
+    pushCommand(((NativeCommand){.type = native_flagWin}));
     return necroBoolValue(false);
 }
 
 /*
  * Ends the current stage and either advances to the
  * next stage, goes back to the menu, or enters the
- * credits scene depending on the game state
+ * credits scene depending on the game state; applied
+ * once the tick's scripts have run
  */
-static NecroValue endStage(int argc, NecroValue *argv){
-    assertArity(0, "endStage expects 0 args");
-    
+static void applyEndStage(){
     GameState *gameStatePtr
         = &(_gamePtr->messages.gameState);
 
@@ -2106,7 +1870,14 @@ static NecroValue endStage(int argc, NecroValue *argv){
             "practice; " SRC_LOCATION
         );
     }
+}
 
+/*
+ * Ends the current stage once the tick's scripts have
+ * run
+ */
+static NecroValue endStage(int argc, NecroValue *argv){
+    pushCommand(((NativeCommand){.type = native_endStage}));
     return necroBoolValue(false);
 }
 
@@ -2114,20 +1885,25 @@ static NecroValue endStage(int argc, NecroValue *argv){
  * Displays the dialogue with the specified string Id
  */
 static NecroValue startDialogue(int argc, NecroValue *argv){
-    assertArity(1, "startDialogue expects string arg");
     String *stringPtr
         = &(necroObjectAsString(*argv)->string);
-    
+    pushCommand(((NativeCommand){
+        .type = native_startDialogue,
+        .id = stringCopy(stringPtr)
+    }));
+    return necroBoolValue(false);
+}
+
+/* Displays the dialogue of the specified command */
+static void applyStartDialogue(NativeCommand *commandPtr){
     arrayListPushBack(SceneId,
         &(_gamePtr->messages.sceneEntryList),
         scene_dialogue
     );
     stringCopyInto(
         &(_gamePtr->messages.startDialogueString),
-        stringPtr
+        &(commandPtr->id)
     );
-
-    return necroBoolValue(false);
 }
 
 /*
@@ -2140,9 +1916,9 @@ static NecroValue startDialogue(int argc, NecroValue *argv){
  * see it next tick
  */
 static NecroValue flagUser1(int argc, NecroValue *argv){
-    assertArity(0, "flagUser1 expects no args");
-
-    _scenePtr->messages.userFlag1 |= 2;
+    pushCommand(((NativeCommand){
+        .type = native_flagUser1
+    }));
     return necroBoolValue(false);
 }
 
@@ -2151,8 +1927,6 @@ static NecroValue flagUser1(int argc, NecroValue *argv){
  * false otherwise
  */
 static NecroValue isFlagged1(int argc, NecroValue *argv){
-    assertArity(0, "isFlagged1 expects no args");
-
     return necroBoolValue(
         _scenePtr->messages.userFlag1 & 1
     );
@@ -2161,7 +1935,8 @@ static NecroValue isFlagged1(int argc, NecroValue *argv){
 /* SPAWNING */
 
 /*
- * Queues a new entity to be spawned:
+ * Queues a new entity to be spawned once the tick's
+ * scripts have run:
  * spawn(
  *      String prototypeId,
  *      Point pos,
@@ -2171,46 +1946,29 @@ static NecroValue isFlagged1(int argc, NecroValue *argv){
  * )
  */
 static NecroValue spawn(int argc, NecroValue *argv){
-    static const char *usageMsg
-        = "spawn(String prototypeId, Point position, "
-            "Vector velocity, int depthOffset, "
-            "OPTIONAL String scriptId1, 2, 3, 4)";
-    if(argc < 4 || argc > 8){
-        pgError(usageMsg);
-    }
-
-    String *prototypeIdPtr
-        = &(necroObjectAsString(argv[0])->string);
-    Point2D pos = necroAsPoint(argv[1]);
-    Polar vel = necroAsVector(argv[2]);
-    int depthOffset = necroAsInt(argv[3]);
-
-    String *scriptId1Ptr = NULL;
-    String *scriptId2Ptr = NULL;
-    String *scriptId3Ptr = NULL;
-    String *scriptId4Ptr = NULL;
-    switch(argc){
-        case 8:
-            scriptId4Ptr
-                = &(necroObjectAsString(argv[7])->string);
-            /* fallthrough */
-        case 7:
-            scriptId3Ptr
-                = &(necroObjectAsString(argv[6])->string);
-            /* fallthrough */
-        case 6:
-            scriptId2Ptr
-                = &(necroObjectAsString(argv[5])->string);
-            /* fallthrough */
-        case 5:
-            scriptId1Ptr
-                = &(necroObjectAsString(argv[4])->string);
-            /* fallthrough */
-        default:
-            break;
-            /* do nothing */
+    NativeCommand command = {
+        .type = native_spawn,
+        .id = stringCopy(
+            &(necroObjectAsString(argv[0])->string)
+        ),
+        .pos = necroAsPoint(argv[1]),
+        .vel = necroAsVector(argv[2]),
+        .depthOffset = necroAsInt(argv[3])
+    };
+    /* copy the ids; scripts may collect the strings */
+    for(int i = 4; i < argc; ++i){
+        command.scriptIds[command.scriptIdCount]
+            = stringCopy(
+                &(necroObjectAsString(argv[i])->string)
+            );
+        ++command.scriptIdCount;
     }
+    pushCommand(command);
+    return necroBoolValue(false);
+}
 
+/* Spawns the entity of the specified command */
+static void applySpawn(NativeCommand *commandPtr){
     declareList(componentList, 10);
 
     /*
@@ -2220,45 +1978,39 @@ static NecroValue spawn(int argc, NecroValue *argv){
     applyPrototype(
         _gamePtr,
         _scenePtr,
-        prototypeIdPtr,
+        &(commandPtr->id),
         &componentList,
-        depthOffset
+        commandPtr->depthOffset
     );
 
-    addPosition(&componentList, pos);
-    addVelocity(&componentList, vel);
+    addPosition(&componentList, commandPtr->pos);
+    addVelocity(&componentList, commandPtr->vel);
 
     /* add scripts if needed */
-    if(argc > 4){
+    if(commandPtr->scriptIdCount > 0){
         Scripts scripts = {0};
-
-        #define loadScriptIfStringIdValid(SLOT) \
-            do{ \
-                if((scriptId##SLOT##Ptr) \
-                    && !stringIsEmpty( \
-                        scriptId##SLOT##Ptr \
-                    ) \
-                ){ \
-                    scripts.vm##SLOT \
-                        = vmPoolRequest(); \
-                    NecroObjectFunc *scriptPtr \
-                        = resourcesGetScript( \
-                            _gamePtr->resourcesPtr, \
-                            scriptId##SLOT##Ptr \
-                        ); \
-                    necroVirtualMachineLoad( \
-                        scripts.vm##SLOT, \
-                        scriptPtr \
-                    ); \
-                } \
-            } while(false)
-
-        loadScriptIfStringIdValid(1);
-        loadScriptIfStringIdValid(2);
-        loadScriptIfStringIdValid(3);
-        loadScriptIfStringIdValid(4);
-
-        #undef loadScriptIfStringIdValid
+        NecroVirtualMachine **vmPtrs[maxSpawnScripts] = {
+            &(scripts.vm1),
+            &(scripts.vm2),
+            &(scripts.vm3),
+            &(scripts.vm4)
+        };
+        for(int i = 0; i < commandPtr->scriptIdCount; ++i){
+            String *scriptIdPtr
+                = &(commandPtr->scriptIds[i]);
+            if(stringIsEmpty(scriptIdPtr)){
+                continue;
+            }
+            *(vmPtrs[i]) = vmPoolRequest();
+            NecroObjectFunc *scriptPtr = resourcesGetScript(
+                _gamePtr->resourcesPtr,
+                scriptIdPtr
+            );
+            necroVirtualMachineLoad(
+                *(vmPtrs[i]),
+                scriptPtr
+            );
+        }
 
         /*
          * only add scripts if at least one VM is
@@ -2275,11 +2027,8 @@ static NecroValue spawn(int argc, NecroValue *argv){
         &componentList,
         _scenePtr
     );
-
-    return necroBoolValue(false);
 }
 
-#undef assertArity
 #undef fillComponentPtr
 #undef setComponent
 #undef removeComponent
@@ -2314,146 +2063,21 @@ static void init(){
             = pgAlloc(1, sizeof(*nativeFuncSetPtr));
         *nativeFuncSetPtr = necroNativeFuncSetMake();
 
-        #define addNativeFunc(FUNCNAME) \
-            necroNativeFuncSetAdd( \
-                nativeFuncSetPtr, \
-                #FUNCNAME, \
-                FUNCNAME \
-            );
-        #define addNativeFuncWithName(FUNC, NAME) \
-            necroNativeFuncSetAdd( \
+        /*
+         * each native is added with its signature, which
+         * scripts are checked against before it runs, so
+         * natives need not check their own arguments; the
+         * natives and their order are in NativeFuncList.h
+         */
+        #define addNativeFunc(FUNC, NAME, SPEC) \
+            necroNativeFuncSetAddTyped( \
                 nativeFuncSetPtr, \
                 #NAME, \
-                FUNC \
+                FUNC, \
+                SPEC \
             );
-
-        /* constants */
-        addNativeFunc(angleEpsilon);
-        addNativeFunc(pointEpsilon);
-        addNativeFunc(updatesPerSecond);
-        addNativeFunc(gameOffset);
-        addNativeFunc(gameWidth);
-        addNativeFunc(gameHeight);
-        addNativeFunc(enemySpawnDist);
-        addNativeFunc(bossMidpoint);
-        addNativeFunc(bossXLow);
-        addNativeFunc(bossXHigh);
-        addNativeFunc(bossYLow);
-        addNativeFunc(bossYHigh);
-        addNativeFunc(timeBeforePostDialogue);
-        addNativeFunc(trapLifetime);
-        addNativeFunc(pi);
-        addNativeFunc(phi);
-
-        /* utility */
-        addNativeFunc(error);
-        addNativeFunc(warn);
-
-        /* general queries */
-        addNativeFunc(isBossDead);
-        addNativeFunc(isDialogueOver);
-        addNativeFunc(isWin);
-        addNativeFunc(getDifficulty);
-        addNativeFunc(getPlayerPos);
-
-        /* entity graphics */
-        addNativeFunc(setVisible);
-        addNativeFunc(removeVisible);
-        addNativeFunc(setRotateSpriteForward);
-        addNativeFunc(removeRotateSpriteForward);
-        addNativeFunc(setSprite);
-        addNativeFunc(setSpriteInstruction);
-        addNativeFunc(setDepth);
-        addNativeFunc(setRotation);
-        addNativeFunc(setScale);
-
-        /* entity queries */
-        addNativeFunc(getPosition);
-        addNativeFunc(getX);
-        addNativeFunc(getY);
-        addNativeFunc(getAngleToPlayer);
-        addNativeFunc(getVelocity);
-        addNativeFunc(getSpeed);
-        addNativeFunc(getAngle);
-        addNativeFunc(getSpin);
-        addNativeFunc(isSpawning);
-        addNativeFunc(getPlayerPower)
-        addNativeFunc(isPlayerFocused);
-
-        /* entity mutators */
-        addNativeFunc(setCollidable);
-        addNativeFunc(removeCollidable);
-        addNativeFunc(setHealth);
-        addNativeFunc(removeHealth);
-        addNativeFunc(setDamage);
-        addNativeFunc(removeDamage);
-        addNativeFunc(setClearable);
-        addNativeFunc(removeClearable);
-        addNativeFunc(setInbound);
-        addNativeFunc(removeInbound);
-        addNativeFunc(setOutbound);
-        addNativeFunc(removeOutbound);
-        addNativeFunc(setPosition);
-        addNativeFunc(removePosition);
-        addNativeFunc(setVelocity);
-        addNativeFunc(removeVelocity);
-        addNativeFunc(setSpeed);
-        addNativeFunc(setAngle);
-        addNativeFunc(setSpin);
-        addNativeFunc(removeSpin);
-        addNativeFunc(die);
-        addNativeFunc(removeEntity);
-
-        /* scripting */
-        addNativeFunc(hasScript);
-        addNativeFunc(addScript);
-        addNativeFunc(removeScript);
-        addNativeFunc(removeSpawns);
-        addNativeFunc(addDeathScript);
-        addNativeFunc(removeDeathScript);
-
-        /* math */
-        addNativeFunc(flipX);
-        addNativeFunc(flipY);
-        addNativeFuncWithName(_pow, pow);
-        addNativeFuncWithName(_sin, sin);
-        addNativeFuncWithName(_cos, cos);
-        addNativeFuncWithName(_tan, tan);
-        addNativeFuncWithName(_sec, sec);
-        addNativeFuncWithName(_csc, csc);
-        addNativeFuncWithName(_cot, cot);
-        addNativeFunc(arcsin);
-        addNativeFunc(arccos);
-        addNativeFunc(arctan);
-        addNativeFuncWithName(_max, max);
-        addNativeFuncWithName(_min, min);
-        addNativeFunc(smallerAngleDiff);
-        addNativeFunc(largerAngleDiff);
-        addNativeFuncWithName(_abs, abs);
-        addNativeFunc(pointDist);
-        addNativeFunc(pointAngle);
-        addNativeFuncWithName(_toRadians, toRadians);
-        addNativeFuncWithName(_toDegrees, toDegrees);
-        addNativeFuncWithName(_random, random);
-        addNativeFunc(chance);
-        addNativeFunc(isPointOutOfBounds);
-
-        /* scene signaling */
-        addNativeFunc(addLife);
-        addNativeFunc(addBomb);
-        addNativeFunc(flagBossDeath);
-        addNativeFunc(flagBulletClear);
-        addNativeFunc(flagWin);
-        addNativeFunc(endStage);
-        addNativeFunc(startDialogue);
-        addNativeFunc(flagUser1);
-        addNativeFunc(isFlagged1);
-
-        /* spawning */
-        addNativeFunc(spawn);
-        
+        forEachNativeFunc(addNativeFunc)
         #undef addNativeFunc
-        #undef addNativeFuncWithName
         
         registerSystemDestructor(destroy);
         
@@ -2470,17 +2094,236 @@ NecroNativeFuncSet *getNativeFuncSet(){
     return nativeFuncSetPtr;
 }
 
-/* Sets the game pointer for native funcs */
-void setGameForNativeFuncs(Game *gamePtr){
-    _gamePtr = gamePtr;
+/*
+ * Takes and returns a snapshot of the specified game
+ * and scene by value; must be called from the main
+ * thread
+ */
+NativeSnapshot nativeSnapshotTake(
+    Game *gamePtr,
+    Scene *scenePtr
+){
+    NativeSnapshot toRet = {
+        .playerPos = config_playerSpawn,
+        .bossDeathFlag = scenePtr->messages.bossDeathFlag,
+        .endDialogueFlag
+            = gamePtr->messages.endDialogueFlag,
+        .winFlag = scenePtr->messages.winFlag
+    };
+
+    /* get players with position */
+    VecsQueryItr itr = vecsWorldRequestQueryItr(
+        &(scenePtr->ecsWorld),
+        playerPosSet,
+        vecsEmptyComponentSet
+    );
+    /* if player exists, grab first one */
+    if(vecsQueryItrHasEntity(&itr)){
+        toRet.playerPos = vecsQueryItrGetPtr(
+            Position,
+            &itr
+        )->currentPos;
+    }
+
+    /* get players */
+    itr = vecsWorldRequestQueryItr(
+        &(scenePtr->ecsWorld),
+        playerSet,
+        vecsEmptyComponentSet
+    );
+    if(vecsQueryItrHasEntity(&itr)){
+        toRet.playerPresent = true;
+        toRet.playerPower = vecsQueryItrGetPtr(
+            PlayerData,
+            &itr
+        )->power;
+    }
+
+    /*
+     * search game commands for a focus command, since
+     * the player would have to press down the focus
+     * button on every frame including the current one
+     * to be focused
+     */
+    ArrayList *gameCommandsPtr
+        = &(scenePtr->messages.gameCommands);
+    for(size_t i = 0; i < gameCommandsPtr->size; ++i){
+        GameCommand command = arrayListGet(GameCommand,
+            gameCommandsPtr,
+            i
+        );
+        if(command == game_focus){
+            toRet.playerFocused = true;
+            break;
+        }
+    }
+    return toRet;
+}
+
+/* Constructs and returns a new NativeContext by value */
+NativeContext nativeContextMake(){
+    /* make sure the lazy init is not raced later */
+    init();
+    /* the generator is only reseeded once made */
+    return (NativeContext){
+        .prng = zmtMake(0),
+        .orders = vecsOrderBufferMake(
+            orderBufferInitCapacity
+        ),
+        ._commandList = arrayListMake(NativeCommand,
+            commandListInitCapacity
+        )
+    };
+}
+
+/*
+ * Readies the specified context for a tick of the
+ * given game and scene; random native funcs draw from
+ * a generator seeded with the given seed
+ */
+void nativeContextBegin(
+    NativeContext *contextPtr,
+    Game *gamePtr,
+    Scene *scenePtr,
+    const NativeSnapshot *snapshotPtr,
+    uint32_t seed
+){
+    contextPtr->gamePtr = gamePtr;
+    contextPtr->scenePtr = scenePtr;
+    contextPtr->snapshotPtr = snapshotPtr;
+    zmtSeed(&(contextPtr->prng), seed);
+}
+
+/*
+ * Frees the strings held by the specified command;
+ * for use with arraylist apply
+ */
+static void nativeCommandFree(NativeCommand *commandPtr){
+    switch(commandPtr->type){
+        case native_spawn:
+            for(int i = 0;
+                i < commandPtr->scriptIdCount;
+                ++i
+            ){
+                stringFree(&(commandPtr->scriptIds[i]));
+            }
+            /* fallthrough */
+        case native_startDialogue:
+            stringFree(&(commandPtr->id));
+            break;
+        default:
+            /* do nothing */
+            break;
+    }
+}
+
+/* Applies the specified command */
+static void nativeCommandApply(NativeCommand *commandPtr){
+    switch(commandPtr->type){
+        case native_addLife:
+            ++(_scenePtr->messages.livesToAdd);
+            break;
+        case native_addBomb:
+            ++(_scenePtr->messages.bombsToAdd);
+            break;
+        case native_flagBossDeath:
+            _scenePtr->messages.bossDeathFlag = true;
+            break;
+        case native_flagBulletClear:
+            _scenePtr->messages.clearFlag = true;
+            break;
+        case native_flagWin:
+            _scenePtr->messages.winFlag = true;
+            break;
+        case native_flagUser1:
+            _scenePtr->messages.userFlag1 |= 2;
+            break;
+        case native_unflagBossDeath:
+            _scenePtr->messages.bossDeathFlag = false;
+            break;
+        case native_unflagDialogueEnd:
+            _gamePtr->messages.endDialogueFlag = false;
+            break;
+        case native_unflagWin:
+            _scenePtr->messages.winFlag = false;
+            break;
+        case native_die:
+            arrayListPushBack(VecsEntity,
+                &(_scenePtr->messages.deaths),
+                commandPtr->entity
+            );
+            break;
+        case native_endStage:
+            applyEndStage();
+            break;
+        case native_startDialogue:
+            applyStartDialogue(commandPtr);
+            break;
+        case native_spawn:
+            applySpawn(commandPtr);
+            break;
+        default:
+            pgError(
+                "unexpected default native command; "
+                SRC_LOCATION
+            );
+            break;
+    }
+    nativeCommandFree(commandPtr);
 }
 
-/* Sets the scene pointer for native funcs */
-void setSceneForNativeFuncs(Scene *scenePtr){
-    _scenePtr = scenePtr;
+/*
+ * Applies the changes buffered in the specified
+ * context in the order they were made and empties it;
+ * must be called from the main thread
+ */
+void nativeContextApply(NativeContext *contextPtr){
+    /* the apply funcs use the main thread's context */
+    NativeContext *prevContextPtr = _contextPtr;
+    _contextPtr = contextPtr;
+    arrayListApply(NativeCommand,
+        &(contextPtr->_commandList),
+        nativeCommandApply
+    );
+    arrayListClear(NativeCommand,
+        &(contextPtr->_commandList)
+    );
+    vecsWorldAppendOrders(
+        &(contextPtr->scenePtr->ecsWorld),
+        &(contextPtr->orders)
+    );
+    _contextPtr = prevContextPtr;
 }
 
-/* Sets the entity for native funcs */
+/*
+ * Frees the memory associated with the specified
+ * context
+ */
+void nativeContextFree(NativeContext *contextPtr){
+    arrayListApply(NativeCommand,
+        &(contextPtr->_commandList),
+        nativeCommandFree
+    );
+    arrayListFree(NativeCommand,
+        &(contextPtr->_commandList)
+    );
+    vecsOrderBufferFree(&(contextPtr->orders));
+    zmtFree(&(contextPtr->prng));
+    memset(contextPtr, 0, sizeof(*contextPtr));
+}
+
+/*
+ * Sets the context of the native funcs run by the
+ * calling thread
+ */
+void setContextForNativeFuncs(NativeContext *contextPtr){
+    _contextPtr = contextPtr;
+}
+
+/*
+ * Sets the entity of the context of the native funcs
+ * run by the calling thread
+ */
 void setEntityForNativeFuncs(VecsEntity entity){
     _entity = entity;
 }
\ No newline at end of file
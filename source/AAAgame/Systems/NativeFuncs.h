@@ -9,13 +9,92 @@
  */
 NecroNativeFuncSet *getNativeFuncSet();
 
-/* Sets the game pointer for native funcs */
-void setGameForNativeFuncs(Game *gamePtr);
+/*
+ * Game state read by native funcs which is taken once
+ * before any script runs on a tick, so that scripts
+ * on every thread see the same values
+ */
+typedef struct NativeSnapshot{
+    /* player spawn if there is no player */
+    Point2D playerPos;
+    bool playerPresent;
+    int playerPower;
+    bool playerFocused;
+    bool bossDeathFlag;
+    bool endDialogueFlag;
+    bool winFlag;
+} NativeSnapshot;
+
+/*
+ * The context native funcs run in; each thread running
+ * scripts has its own, which buffers the changes the
+ * scripts make to state shared with other entities
+ * until it is applied on the main thread
+ */
+typedef struct NativeContext{
+    Game *gamePtr;
+    Scene *scenePtr;
+    /* the entity whose script is running */
+    VecsEntity entity;
+    /* shared by every context of a tick; read only */
+    const NativeSnapshot *snapshotPtr;
+    /* used by the random native funcs */
+    ZMT prng;
+    /* ECS orders queued by the scripts */
+    VecsOrderBuffer orders;
+    /* list of NativeCommand, applied in order */
+    ArrayList _commandList;
+} NativeContext;
+
+/*
+ * Takes and returns a snapshot of the specified game
+ * and scene by value; must be called from the main
+ * thread
+ */
+NativeSnapshot nativeSnapshotTake(
+    Game *gamePtr,
+    Scene *scenePtr
+);
+
+/* Constructs and returns a new NativeContext by value */
+NativeContext nativeContextMake();
+
+/*
+ * Readies the specified context for a tick of the
+ * given game and scene; random native funcs draw from
+ * a generator seeded with the given seed
+ */
+void nativeContextBegin(
+    NativeContext *contextPtr,
+    Game *gamePtr,
+    Scene *scenePtr,
+    const NativeSnapshot *snapshotPtr,
+    uint32_t seed
+);
+
+/*
+ * Applies the changes buffered in the specified
+ * context in the order they were made and empties it;
+ * must be called from the main thread
+ */
+void nativeContextApply(NativeContext *contextPtr);
 
-/* Sets the scene pointer for native funcs */
-void setSceneForNativeFuncs(Scene *scenePtr);
+/*
+ * Frees the memory associated with the specified
+ * context
+ */
+void nativeContextFree(NativeContext *contextPtr);
 
-/* Sets the entity for native funcs */
+/*
+ * Sets the context of the native funcs run by the
+ * calling thread
+ */
+void setContextForNativeFuncs(NativeContext *contextPtr);
+
+/*
+ * Sets the entity of the context of the native funcs
+ * run by the calling thread
+ */
 void setEntityForNativeFuncs(VecsEntity handle);
 
 #endif
\ No newline at end of file
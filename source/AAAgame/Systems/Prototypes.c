@@ -1840,16 +1840,16 @@ void applyPrototype(
         prototypeIdPtr,
         "null prototype Id passed;" SRC_LOCATION
     );
-    assertNotNull(
-        prototypeIdPtr->_ptr,
-        "prototype string holds null;" SRC_LOCATION
+    assertTrue(
+        stringIsMade(prototypeIdPtr),
+        "prototype string not made;" SRC_LOCATION
     );
     
     if(!hashMapHasKey(char*, PrototypeFunction,
         &(prototypeFunctionMap),
-        prototypeIdPtr->_ptr
+        stringCharPtr(prototypeIdPtr)
     )){
-        pgWarning(prototypeIdPtr->_ptr);
+        pgWarning(stringCharPtr(prototypeIdPtr));
         pgError(
             "failed to find prototype; " SRC_LOCATION
         );
@@ -1858,7 +1858,7 @@ void applyPrototype(
         char*,
         PrototypeFunction,
         &(prototypeFunctionMap),
-        prototypeIdPtr->_ptr
+        stringCharPtr(prototypeIdPtr)
     );
 
     prototypeFunction(
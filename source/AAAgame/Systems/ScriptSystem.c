@@ -11,10 +11,94 @@ static VecsComponentSet accept
     = vecsComponentSetFromId(VecsEntityId)
     | vecsComponentSetFromId(ScriptsId);
 
-/* runs a specified VM */
-#define runVM(VMPTRNAME) \
+/*
+ * entities are split into chunks of this many, each
+ * run as one job; fixed so that the chunks, and so
+ * the results, do not depend on the number of threads
+ */
+#define chunkSize 64
+#define entityListInitCapacity 256
+#define chunkListInitCapacity 8
+#define parkListInitCapacity 16
+/* the allocation tag of running scripts */
+#define allocTag "necro"
+
+/* An entity whose scripts are to be run */
+typedef struct ScriptEntity{
+    VecsEntity entity;
+    Scripts *scriptsPtr;
+} ScriptEntity;
+
+/*
+ * A VM which yielded into a sleep and is to be parked
+ * in the timer wheel once every script has run
+ */
+typedef struct ParkedVM{
+    NecroVirtualMachine *vmPtr;
+    /* sleep id of the VM when it yielded */
+    uint32_t sleepId;
+} ParkedVM;
+
+/* The scripts of the entities run by a single job */
+typedef struct ScriptChunk{
+    /* the context for the native funcs of the job */
+    NativeContext context;
+    /* list of ParkedVM */
+    ArrayList parkList;
+    ScriptEntity *entities;
+    size_t entityCount;
+} ScriptChunk;
+
+/* list of ScriptEntity, rebuilt every tick */
+static ArrayList entityList;
+/* list of ScriptChunk, kept between ticks */
+static ArrayList chunkList;
+static bool initialized = false;
+
+/* destroys the script system */
+static void destroy(){
+    if(initialized){
+        for(size_t i = 0; i < chunkList.size; ++i){
+            ScriptChunk *chunkPtr = arrayListGetPtr(
+                ScriptChunk,
+                &chunkList,
+                i
+            );
+            nativeContextFree(&(chunkPtr->context));
+            arrayListFree(ParkedVM,
+                &(chunkPtr->parkList)
+            );
+        }
+        arrayListFree(ScriptChunk, &chunkList);
+        arrayListFree(ScriptEntity, &entityList);
+        initialized = false;
+    }
+}
+
+/* inits the script system */
+static void init(){
+    if(!initialized){
+        entityList = arrayListMake(ScriptEntity,
+            entityListInitCapacity
+        );
+        chunkList = arrayListMake(ScriptChunk,
+            chunkListInitCapacity
+        );
+
+        registerSystemDestructor(destroy);
+
+        initialized = true;
+    }
+}
+
+/*
+ * runs a specified VM unless it is asleep; a VM which
+ * yields into a sleep is pushed to the specified list
+ * of VMs to park
+ */
+#define runVM(VMPTRNAME, PARKLISTPTR) \
     do{ \
-        if(VMPTRNAME){ \
+        if(VMPTRNAME && VMPTRNAME->sleepTicks == 0){ \
             NecroInterpretResult result \
                 = necroVirtualMachineResume( \
                     VMPTRNAME \
@@ -25,6 +109,15 @@ static VecsComponentSet accept
                     VMPTRNAME = NULL; \
                     break; \
                 case necro_yielded: \
+                    if(VMPTRNAME->sleepTicks > 0){ \
+                        arrayListPushBack(ParkedVM, \
+                            PARKLISTPTR, \
+                            ((ParkedVM){ \
+                                VMPTRNAME, \
+                                VMPTRNAME->sleepId \
+                            }) \
+                        ); \
+                    } \
                     break; \
                 case necro_runtimeError: \
                     pgError( \
@@ -36,33 +129,29 @@ static VecsComponentSet accept
         } \
     } while(false)
 
-/* runs scripts on entities */
-void scriptSystem(Game *gamePtr, Scene *scenePtr){
-    setGameForNativeFuncs(gamePtr);
-    setSceneForNativeFuncs(scenePtr);
+/*
+ * Runs the scripts of the entities of the specified
+ * ScriptChunk; changes to state shared with other
+ * chunks are buffered in the chunk. Can run on any
+ * thread of the job system
+ */
+static void runScriptChunk(void *argPtr){
+    ScriptChunk *chunkPtr = argPtr;
+    NativeContext *contextPtr = &(chunkPtr->context);
+    setContextForNativeFuncs(contextPtr);
 
-    /* get entities with position and velocity */
-    VecsQueryItr itr = vecsWorldRequestQueryItr(
-        &(scenePtr->ecsWorld),
-        accept,
-        vecsEmptyComponentSet
-    );
-    while(vecsQueryItrHasEntity(&itr)){
-        VecsEntity entity = vecsQueryItrGet(VecsEntity,
-            &itr
-        );
+    for(size_t i = 0; i < chunkPtr->entityCount; ++i){
+        VecsEntity entity = chunkPtr->entities[i].entity;
+        Scripts *scriptsPtr
+            = chunkPtr->entities[i].scriptsPtr;
 
         setEntityForNativeFuncs(entity);
 
-        Scripts *scriptsPtr = vecsQueryItrGetPtr(
-            Scripts,
-            &itr
-        );
-        
-        runVM(scriptsPtr->vm1);
-        runVM(scriptsPtr->vm2);
-        runVM(scriptsPtr->vm3);
-        runVM(scriptsPtr->vm4);
+        ArrayList *parkListPtr = &(chunkPtr->parkList);
+        runVM(scriptsPtr->vm1, parkListPtr);
+        runVM(scriptsPtr->vm2, parkListPtr);
+        runVM(scriptsPtr->vm3, parkListPtr);
+        runVM(scriptsPtr->vm4, parkListPtr);
 
         /*
          * if all scripts are gone, remove the
@@ -73,15 +162,153 @@ void scriptSystem(Game *gamePtr, Scene *scenePtr){
             && !scriptsPtr->vm3
             && !scriptsPtr->vm4
         ){
-            vecsWorldEntityQueueRemoveComponent(
-                Scripts,
-                &(scenePtr->ecsWorld),
+            vecsOrderBufferQueueRemoveComponent(Scripts,
+                &(contextPtr->orders),
+                &(contextPtr->scenePtr->ecsWorld),
                 entity
             );
         }
+    }
+
+    setContextForNativeFuncs(NULL);
+}
+
+/*
+ * runs scripts on entities; the entities are split
+ * into chunks which run on the job system, and what
+ * the chunks change outside their own entities is
+ * applied afterwards in chunk order, so the result
+ * is the same however many threads there are
+ */
+void scriptSystem(Game *gamePtr, Scene *scenePtr){
+    init();
+    /* the chunk jobs carry the tag with them */
+    pgAllocPushTag(allocTag);
 
+    /* wake the VMs whose sleep ends this tick */
+    ScriptTimerWheel *wheelPtr
+        = &(scenePtr->messages.scriptTimers);
+    scriptTimerWheelAdvance(wheelPtr);
+
+    /* get entities with scripts */
+    arrayListClear(ScriptEntity, &entityList);
+    VecsQueryItr itr = vecsWorldRequestQueryItr(
+        &(scenePtr->ecsWorld),
+        accept,
+        vecsEmptyComponentSet
+    );
+    while(vecsQueryItrHasEntity(&itr)){
+        ScriptEntity scriptEntity = {
+            .entity = vecsQueryItrGet(VecsEntity, &itr),
+            .scriptsPtr = vecsQueryItrGetPtr(
+                Scripts,
+                &itr
+            )
+        };
+        arrayListPushBack(ScriptEntity,
+            &entityList,
+            scriptEntity
+        );
         vecsQueryItrAdvance(&itr);
     }
 
+    /* make more chunks if needed */
+    size_t chunkCount
+        = (entityList.size + chunkSize - 1) / chunkSize;
+    while(chunkList.size < chunkCount){
+        ScriptChunk chunk = {
+            .context = nativeContextMake(),
+            .parkList = arrayListMake(ParkedVM,
+                parkListInitCapacity
+            )
+        };
+        arrayListPushBack(ScriptChunk, &chunkList, chunk);
+    }
+
+    /*
+     * ready the chunks; each draws random numbers from
+     * its own generator seeded in chunk order
+     */
+    NativeSnapshot snapshot = nativeSnapshotTake(
+        gamePtr,
+        scenePtr
+    );
+    ScriptEntity *entities = entityList._ptr;
+    for(size_t i = 0; i < chunkCount; ++i){
+        ScriptChunk *chunkPtr = arrayListGetPtr(
+            ScriptChunk,
+            &chunkList,
+            i
+        );
+        nativeContextBegin(
+            &(chunkPtr->context),
+            gamePtr,
+            scenePtr,
+            &snapshot,
+            zmtRandUInt(&(scenePtr->messages.prng))
+        );
+        size_t begin = i * chunkSize;
+        chunkPtr->entities = entities + begin;
+        chunkPtr->entityCount = entityList.size - begin;
+        if(chunkPtr->entityCount > chunkSize){
+            chunkPtr->entityCount = chunkSize;
+        }
+    }
+
+    /* run the chunks, on this thread if just one */
+    if(chunkCount == 1){
+        runScriptChunk(arrayListGetPtr(ScriptChunk,
+            &chunkList,
+            0
+        ));
+    }
+    else if(chunkCount > 1){
+        /* starting the job system is one time setup */
+        pgAllocAllowBegin();
+        tfJobSystemInit(0);
+        pgAllocAllowEnd();
+        TFJobCounter counter = {0};
+        tfJobCounterInit(&counter);
+        for(size_t i = 0; i < chunkCount; ++i){
+            tfJobRun(
+                runScriptChunk,
+                arrayListGetPtr(ScriptChunk,
+                    &chunkList,
+                    i
+                ),
+                &counter
+            );
+        }
+        tfJobWait(&counter);
+    }
+
+    /* apply what the chunks changed in chunk order */
+    for(size_t i = 0; i < chunkCount; ++i){
+        ScriptChunk *chunkPtr = arrayListGetPtr(
+            ScriptChunk,
+            &chunkList,
+            i
+        );
+        /*
+         * skip VMs reclaimed or put to sleep again
+         * since they yielded
+         */
+        for(size_t j = 0; j < chunkPtr->parkList.size; ++j){
+            ParkedVM parked = arrayListGet(ParkedVM,
+                &(chunkPtr->parkList),
+                j
+            );
+            if(parked.vmPtr->sleepId == parked.sleepId){
+                scriptTimerWheelPark(
+                    wheelPtr,
+                    parked.vmPtr
+                );
+            }
+        }
+        arrayListClear(ParkedVM, &(chunkPtr->parkList));
+        nativeContextApply(&(chunkPtr->context));
+    }
+
     vecsWorldHandleOrders(&(scenePtr->ecsWorld));
+    pgAllocPopTag();
 }
\ No newline at end of file
@@ -200,6 +200,14 @@ int main(){
             programPtr
         );
     printf("result: %d\n", result);
+    #ifdef NECRO_PROFILE
+    necroProfilerWriteReport(
+        "necro_profile.txt",
+        &nativeFuncSet
+    );
+    necroProfilerWriteFolded("necro_profile.folded");
+    necroProfilerFree();
+    #endif
     necroVirtualMachineFree(&vm);
     return 0;
 }
@@ -49,7 +49,8 @@ bool cStringEquals(
 
 /* hash func for Constructure Strings */
 size_t constructureStringHash(const void *stringPtr){
-    const char *charPtr = ((String*)stringPtr)->_ptr;
+    const char *charPtr
+        = stringCharPtr((const String*)stringPtr);
     NULL_TERMINATED_STRING_HASH_ALGORITHM(charPtr);
 }
 
@@ -66,7 +67,9 @@ size_t constructureWideStringHash(
     const void *wideStringPtr
 ){
     const wchar_t *charPtr
-        = ((WideString*)wideStringPtr)->_ptr;
+        = wideStringCharPtr(
+            (const WideString*)wideStringPtr
+        );
     NULL_TERMINATED_STRING_HASH_ALGORITHM(charPtr);
 }
 
@@ -86,7 +89,9 @@ size_t constructureString16Hash(
     const void *string16Ptr
 ){
     const char16_t *charPtr
-        = ((String16*)string16Ptr)->_ptr;
+        = string16CharPtr(
+            (const String16*)string16Ptr
+        );
     NULL_TERMINATED_STRING_HASH_ALGORITHM(charPtr);
 }
 
@@ -103,7 +108,9 @@ size_t constructureString32Hash(
     const void *string32Ptr
 ){
     const char32_t *charPtr
-        = ((String32*)string32Ptr)->_ptr;
+        = string32CharPtr(
+            (const String32*)string32Ptr
+        );
     NULL_TERMINATED_STRING_HASH_ALGORITHM(charPtr);
 }
 
@@ -5,6 +5,9 @@
 #include "Constructure_ArrayList.h"
 #include "Constructure_Bitset.h"
 #include "Constructure_HashMap.h"
+#include "Constructure_PagedSparseSet.h"
+#include "Constructure_RadixSort.h"
+#include "Constructure_RingBuffer.h"
 #include "Constructure_SparseSet.h"
 #include "Constructure_String.h"
 
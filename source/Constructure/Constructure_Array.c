@@ -10,13 +10,14 @@ Array _arrayMake(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     assertTrue(
         size > 0u, 
         "size cannot be 0; " SRC_LOCATION
     );
     Array toRet = {0};
-    toRet._ptr = pgAlloc(size, elementSize);
+    toRet._ptr = pgAllocAt(size, elementSize, allocSite);
     toRet.size = size;
 
     #ifdef _DEBUG
@@ -36,6 +37,7 @@ Array _arrayCopy(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     #ifdef _DEBUG
     _arrayPtrTypeCheck(typeName, toCopyPtr);
@@ -43,7 +45,11 @@ Array _arrayCopy(
 
     Array toRet = {0};
     toRet.size = toCopyPtr->size;
-    toRet._ptr = pgAlloc(toRet.size, elementSize);
+    toRet._ptr = pgAllocAt(
+        toRet.size,
+        elementSize,
+        allocSite
+    );
     /* may overflow */
     memcpy(
         toRet._ptr, 
@@ -40,6 +40,7 @@ Array _arrayMake(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -48,14 +49,19 @@ Array _arrayMake(
  * and size and returns it by value
  */
 #define arrayMake(TYPENAME, SIZE) \
-    _arrayMake(SIZE, sizeof(TYPENAME))
+    _arrayMake(SIZE, sizeof(TYPENAME) PG_ALLOC_SITE_ARG)
 #else
 /* 
  * Creates an array on the heap of the specified type 
  * and size and returns it by value
  */
 #define arrayMake(TYPENAME, SIZE) \
-    _arrayMake(SIZE, sizeof(TYPENAME), #TYPENAME)
+    _arrayMake( \
+        SIZE, \
+        sizeof(TYPENAME), \
+        #TYPENAME \
+        PG_ALLOC_SITE_ARG \
+    )
 #endif
 
 /*
@@ -68,6 +74,7 @@ Array _arrayCopy(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -76,7 +83,11 @@ Array _arrayCopy(
  * of the specified type and returns it by value
  */
 #define arrayCopy(TYPENAME, TOCOPYPTR) \
-    _arrayCopy(sizeof(TYPENAME), TOCOPYPTR)
+    _arrayCopy( \
+        sizeof(TYPENAME), \
+        TOCOPYPTR \
+        PG_ALLOC_SITE_ARG \
+    )
 #else
 /*
  * Makes a one level deep copy of the given array
@@ -87,6 +98,7 @@ Array _arrayCopy(
         sizeof(TYPENAME), \
         TOCOPYPTR, \
         #TYPENAME \
+        PG_ALLOC_SITE_ARG \
     )
 #endif
 
@@ -7,6 +7,7 @@ ArrayList _arrayListMake(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     assertTrue(
         initCapacity > 0, 
@@ -15,7 +16,55 @@ ArrayList _arrayListMake(
     );
     ArrayList toRet = {0};
     toRet._capacity = initCapacity;
-    toRet._ptr = pgAlloc(initCapacity, elementSize);
+    toRet._ptr = pgAllocAt(
+        initCapacity,
+        elementSize,
+        allocSite
+    );
+    toRet.size = 0u;
+
+    #ifdef _DEBUG
+    toRet._typeName = typeName;
+    #endif
+
+    return toRet;
+}
+
+/*
+ * Creates an arraylist which stores its elements in
+ * the given caller-provided buffer until the buffer
+ * capacity is exceeded, at which point the elements
+ * spill to the heap; the buffer must outlive the
+ * arraylist and the arraylist must not be moved
+ * into a longer lived scope while inline
+ */
+ArrayList _arrayListMakeInline(
+    void *bufferPtr,
+    size_t bufferCapacity,
+    size_t elementSize
+    #ifdef _DEBUG 
+    , const char *typeName 
+    #endif
+){
+    assertNotNull(
+        bufferPtr, 
+        "bufferPtr cannot be NULL; "
+        SRC_LOCATION
+    );
+    assertTrue(
+        bufferCapacity > 0, 
+        "bufferCapacity cannot be 0; "
+        SRC_LOCATION
+    );
+    assertTrue(
+        elementSize > 0,
+        "elementSize cannot be 0; "
+        SRC_LOCATION
+    );
+    ArrayList toRet = {0};
+    toRet._capacity = bufferCapacity;
+    toRet._ptr = bufferPtr;
+    toRet._inlinePtr = bufferPtr;
     toRet.size = 0u;
 
     #ifdef _DEBUG
@@ -35,17 +84,20 @@ ArrayList _arrayListCopy(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     #ifdef _DEBUG
     _arrayListPtrTypeCheck(typeName, toCopyPtr);
     #endif
 
+    /* copies always live on the heap */
     ArrayList toRet = {0};
     toRet.size = toCopyPtr->size;
     toRet._capacity = toCopyPtr->_capacity;
-    toRet._ptr = pgAlloc(
+    toRet._ptr = pgAllocAt(
         toRet._capacity, 
-        elementSize
+        elementSize,
+        allocSite
     );
     /* may overflow */
     memcpy(
@@ -102,6 +154,7 @@ void _arrayListClear(
 bool _arrayListGrowIfNeeded(
     ArrayList *arrayListPtr,
     size_t elementSize
+    PG_ALLOC_SITE_PARAM
 ){
     enum{ growRatio = 2u };
 
@@ -110,10 +163,29 @@ bool _arrayListGrowIfNeeded(
     ){
         arrayListPtr->_capacity *= growRatio;
         ++(arrayListPtr->_capacity);
-        arrayListPtr->_ptr = pgRealloc(
+        /* spill from inline storage to the heap */
+        if(arrayListIsInline(arrayListPtr)){
+            arrayListPtr->_ptr = pgAllocAt(
+                arrayListPtr->_capacity,
+                elementSize,
+                allocSite
+            );
+            if(!(arrayListPtr->_ptr)){
+                return false;
+            }
+            /* memcpy safe; blocks are distinct */
+            memcpy(
+                arrayListPtr->_ptr,
+                arrayListPtr->_inlinePtr,
+                arrayListPtr->size * elementSize
+            );
+            return true;
+        }
+        arrayListPtr->_ptr = pgReallocAt(
             arrayListPtr->_ptr,
             arrayListPtr->_capacity,
-            elementSize
+            elementSize,
+            allocSite
         );
         if(!(arrayListPtr->_ptr)){
             return false;
@@ -133,6 +205,7 @@ void _arrayListPushBackPtr(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     #ifdef _DEBUG
     _arrayListPtrTypeCheck(
@@ -145,6 +218,7 @@ void _arrayListPushBackPtr(
         _arrayListGrowIfNeeded(
             arrayListPtr, 
             elementSize
+            PG_ALLOC_SITE_FORWARD
         ),
         "failed to grow for pushback; "
         SRC_LOCATION
@@ -179,7 +253,7 @@ void _arrayListPopBack(
     );
     #endif
 
-    assertFalse(
+    hotAssertFalse(
         arrayListIsEmpty(arrayListPtr),
         "empty in popback; " SRC_LOCATION
     );
@@ -247,7 +321,7 @@ void *_arrayListGetPtr(
     );
     #endif
 
-    assertTrue(
+    hotAssertTrue(
         index < arrayListPtr->size,
         "bad index; " SRC_LOCATION
     );
@@ -270,6 +344,7 @@ void _arrayListSetPtr(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     #ifdef _DEBUG
     _arrayListPtrTypeCheck(
@@ -288,6 +363,7 @@ void _arrayListSetPtr(
             _arrayListGrowIfNeeded(
                 arrayListPtr, 
                 elementSize
+                PG_ALLOC_SITE_FORWARD
             ),
             "failed to grow for set; "
             SRC_LOCATION
@@ -319,6 +395,7 @@ void _arrayListInsertPtr(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     #ifdef _DEBUG
     _arrayListPtrTypeCheck(
@@ -336,6 +413,7 @@ void _arrayListInsertPtr(
         _arrayListGrowIfNeeded(
             arrayListPtr, 
             elementSize
+            PG_ALLOC_SITE_FORWARD
         ),
         "failed to grow for insert; "
         SRC_LOCATION
@@ -385,7 +463,7 @@ void *_arrayListFrontPtr(
     );
     #endif
 
-    assertFalse(
+    hotAssertFalse(
         arrayListIsEmpty(arrayListPtr),
         "empty in front; " SRC_LOCATION
     );
@@ -410,7 +488,7 @@ void *_arrayListBackPtr(
     );
     #endif
 
-    assertFalse(
+    hotAssertFalse(
         arrayListIsEmpty(arrayListPtr),
         "empty in back; " SRC_LOCATION
     );
@@ -436,7 +514,14 @@ void _arrayListFree(
     );
     #endif
 
-    pgFree(arrayListPtr->_ptr);
+    /* inline storage is owned by the caller */
+    if(arrayListIsInline(arrayListPtr)){
+        arrayListPtr->_ptr = NULL;
+    }
+    else{
+        pgFree(arrayListPtr->_ptr);
+    }
+    arrayListPtr->_inlinePtr = NULL;
     arrayListPtr->size = 0u;
     arrayListPtr->_capacity = 0u;
 }
\ No newline at end of file
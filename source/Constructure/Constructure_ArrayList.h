@@ -8,6 +8,12 @@ typedef struct ArrayList{
     void *_ptr;
     size_t size;
     size_t _capacity;
+    /*
+     * Caller-provided inline storage, or NULL; the
+     * arraylist does not own this block and only
+     * spills to the heap once it is exceeded
+     */
+    void *_inlinePtr;
 
     #ifdef _DEBUG
     /* 
@@ -41,6 +47,7 @@ ArrayList _arrayListMake(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -49,7 +56,11 @@ ArrayList _arrayListMake(
  * and capacity and returns it by value
  */
 #define arrayListMake(TYPENAME, INIT_CAPACITY) \
-    _arrayListMake(INIT_CAPACITY, sizeof(TYPENAME))
+    _arrayListMake( \
+        INIT_CAPACITY, \
+        sizeof(TYPENAME) \
+        PG_ALLOC_SITE_ARG \
+    )
 #else
 /* 
  * Creates an arraylist of the specified type 
@@ -60,9 +71,84 @@ ArrayList _arrayListMake(
         INIT_CAPACITY, \
         sizeof(TYPENAME), \
         #TYPENAME \
+        PG_ALLOC_SITE_ARG \
+    )
+#endif
+
+/*
+ * Creates an arraylist which stores its elements in
+ * the given caller-provided buffer until the buffer
+ * capacity is exceeded, at which point the elements
+ * spill to the heap; the buffer must outlive the
+ * arraylist and the arraylist must not be moved
+ * into a longer lived scope while inline
+ */
+ArrayList _arrayListMakeInline(
+    void *bufferPtr,
+    size_t bufferCapacity,
+    size_t elementSize
+    #ifdef _DEBUG 
+    , const char *typeName 
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Creates an arraylist of the specified type which
+ * uses the given array as inline storage and
+ * returns it by value
+ */
+#define arrayListMakeInline(TYPENAME, BUFFER) \
+    _arrayListMakeInline( \
+        _Generic(&((BUFFER)[0]), \
+            TYPENAME*: BUFFER \
+        ), \
+        sizeof(BUFFER) / sizeof(TYPENAME), \
+        sizeof(TYPENAME) \
+    )
+#else
+/*
+ * Creates an arraylist of the specified type which
+ * uses the given array as inline storage and
+ * returns it by value
+ */
+#define arrayListMakeInline(TYPENAME, BUFFER) \
+    _arrayListMakeInline( \
+        _Generic(&((BUFFER)[0]), \
+            TYPENAME*: BUFFER \
+        ), \
+        sizeof(BUFFER) / sizeof(TYPENAME), \
+        sizeof(TYPENAME), \
+        #TYPENAME \
     )
 #endif
 
+/*
+ * Declares a local arraylist named LISTNAME of the
+ * specified type backed by a local array holding
+ * INLINECAPACITY elements
+ */
+#define declareInlineArrayList( \
+    TYPENAME, \
+    LISTNAME, \
+    INLINECAPACITY \
+) \
+    TYPENAME LISTNAME##InlineBuffer[INLINECAPACITY]; \
+    ArrayList LISTNAME = arrayListMakeInline( \
+        TYPENAME, \
+        LISTNAME##InlineBuffer \
+    )
+
+/*
+ * Returns true if the given arraylist currently
+ * stores its elements in inline storage, false
+ * otherwise
+ */
+#define arrayListIsInline(ARRAYLISTPTR) \
+    ((ARRAYLISTPTR)->_inlinePtr \
+        && (ARRAYLISTPTR)->_ptr \
+            == (ARRAYLISTPTR)->_inlinePtr)
+
 /*
  * Makes a one level deep copy of the given
  * arraylist and returns it by value
@@ -73,6 +159,7 @@ ArrayList _arrayListCopy(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -82,7 +169,11 @@ ArrayList _arrayListCopy(
  * it by value
  */
 #define arrayListCopy(TYPENAME, TOCOPYPTR) \
-    _arrayListCopy(sizeof(TYPENAME), TOCOPYPTR)
+    _arrayListCopy( \
+        sizeof(TYPENAME), \
+        TOCOPYPTR \
+        PG_ALLOC_SITE_ARG \
+    )
 #else
 /*
  * Makes a one level deep copy of the given
@@ -94,6 +185,7 @@ ArrayList _arrayListCopy(
         sizeof(TYPENAME), \
         TOCOPYPTR, \
         #TYPENAME \
+        PG_ALLOC_SITE_ARG \
     )
 #endif
 
@@ -141,6 +233,7 @@ void _arrayListClear(
 bool _arrayListGrowIfNeeded(
     ArrayList *arrayListPtr,
     size_t elementSize
+    PG_ALLOC_SITE_PARAM
 );
 
 /* 
@@ -154,6 +247,7 @@ void _arrayListPushBackPtr(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -172,6 +266,7 @@ void _arrayListPushBackPtr(
             ARRAYLISTPTR, \
             ELEMENTPTR, \
             sizeof(TYPENAME) \
+            PG_ALLOC_SITE_ARG \
         ) \
     )
 #else
@@ -191,6 +286,7 @@ void _arrayListPushBackPtr(
             ELEMENTPTR, \
             sizeof(TYPENAME), \
             #TYPENAME \
+            PG_ALLOC_SITE_ARG \
         ) \
     )
 #endif
@@ -214,6 +310,7 @@ void _arrayListPushBackPtr(
             _arrayListGrowIfNeeded( \
                 ARRAYLISTPTR, \
                 sizeof(ELEMENT) \
+                PG_ALLOC_SITE_ARG \
             ), \
             "failed to grow for pushback; " \
             SRC_LOCATION \
@@ -242,6 +339,7 @@ void _arrayListPushBackPtr(
             _arrayListGrowIfNeeded( \
                 ARRAYLISTPTR, \
                 sizeof(ELEMENT) \
+                PG_ALLOC_SITE_ARG \
             ), \
             "failed to grow for pushback; " \
             SRC_LOCATION \
@@ -326,6 +424,18 @@ void _arrayListErase(
     )
 #endif
 
+/*
+ * Returns a void pointer to the element of the given
+ * arraylist at the given index with no checks
+ */
+#define _arrayListElementPtr( \
+    ARRAYLISTPTR, \
+    INDEX, \
+    ELEMENTSIZE \
+) \
+    ((void*)(((char*)((ARRAYLISTPTR)->_ptr)) \
+        + ((INDEX) * (ELEMENTSIZE))))
+
 /*
  * Returns a pointer to the element of the given
  * arraylist at the given index
@@ -339,7 +449,19 @@ void *_arrayListGetPtr(
     #endif
 );
 
-#ifndef _DEBUG
+#ifndef PG_HOT_CHECKS_ENABLED
+/*
+ * Returns a pointer to the element of the given
+ * arraylist of the specified type at the
+ * given index; unchecked, so indexes directly
+ */
+#define arrayListGetPtr( \
+    TYPENAME, \
+    ARRAYLISTPTR, \
+    INDEX \
+) \
+    (((TYPENAME*)((ARRAYLISTPTR)->_ptr)) + (INDEX))
+#elif !defined(_DEBUG)
 /*
  * Returns a pointer to the element of the given
  * arraylist of the specified type at the
@@ -405,6 +527,7 @@ void _arrayListSetPtr(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -425,6 +548,7 @@ void _arrayListSetPtr(
             INDEX, \
             ELEMENTPTR, \
             sizeof(TYPENAME) \
+            PG_ALLOC_SITE_ARG \
         ) \
     )
 #else
@@ -446,6 +570,7 @@ void _arrayListSetPtr(
             ELEMENTPTR, \
             sizeof(TYPENAME), \
             #TYPENAME \
+            PG_ALLOC_SITE_ARG \
         ) \
     )
 #endif
@@ -476,6 +601,7 @@ void _arrayListSetPtr(
                 _arrayListGrowIfNeeded( \
                     ARRAYLISTPTR, \
                     sizeof(TYPENAME) \
+                    PG_ALLOC_SITE_ARG \
                 ), \
                 "failed to grow for set; " \
                 SRC_LOCATION \
@@ -511,6 +637,7 @@ void _arrayListSetPtr(
                 _arrayListGrowIfNeeded( \
                     ARRAYLISTPTR, \
                     sizeof(TYPENAME) \
+                    PG_ALLOC_SITE_ARG \
                 ), \
                 "failed to grow for set; " \
                 SRC_LOCATION \
@@ -535,6 +662,7 @@ void _arrayListInsertPtr(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -555,6 +683,7 @@ void _arrayListInsertPtr(
             INDEX, \
             ELEMENTPTR, \
             sizeof(TYPENAME) \
+            PG_ALLOC_SITE_ARG \
         ) \
     )
 #else
@@ -576,6 +705,7 @@ void _arrayListInsertPtr(
             ELEMENTPTR, \
             sizeof(TYPENAME), \
             #TYPENAME \
+            PG_ALLOC_SITE_ARG \
         ) \
     )
 #endif
@@ -605,6 +735,7 @@ void _arrayListInsertPtr(
             _arrayListGrowIfNeeded( \
                 (ARRAYLISTPTR), \
                 sizeof(ELEMENT) \
+                PG_ALLOC_SITE_ARG \
             ), \
             "failed to grow for insert; " \
             SRC_LOCATION \
@@ -650,6 +781,7 @@ void _arrayListInsertPtr(
             _arrayListGrowIfNeeded( \
                 (ARRAYLISTPTR), \
                 sizeof(ELEMENT) \
+                PG_ALLOC_SITE_ARG \
             ), \
             "failed to grow for insert; " \
             SRC_LOCATION \
@@ -683,7 +815,18 @@ void *_arrayListFrontPtr(
     #endif
 );
 
-#ifndef _DEBUG
+#ifndef PG_HOT_CHECKS_ENABLED
+/*
+ * Returns a pointer to the front element of 
+ * the given arraylist of the specified type;
+ * unchecked, so reads the storage directly
+ */
+#define arrayListFrontPtr( \
+    TYPENAME, \
+    ARRAYLISTPTR \
+) \
+    ((TYPENAME*)((ARRAYLISTPTR)->_ptr))
+#elif !defined(_DEBUG)
 /*
  * Returns a pointer to the front element of 
  * the given arraylist of the specified type
@@ -22,6 +22,86 @@
 /* The block with all bits set */
 #define fullBlock (~((BlockType)0))
 
+/* use the widest vector extension enabled */
+#if defined(__AVX2__)
+#include <immintrin.h>
+/* Number of blocks in one vector */
+#define vectorBlocks (256 / blockSize)
+#define vectorLoad(PTR) \
+    _mm256_loadu_si256((const __m256i*)(PTR))
+#define vectorStore(PTR, VECTOR) \
+    _mm256_storeu_si256((__m256i*)(PTR), VECTOR)
+#define vectorAnd(DEST, SRC) _mm256_and_si256(DEST, SRC)
+#define vectorOr(DEST, SRC) _mm256_or_si256(DEST, SRC)
+#define vectorXor(DEST, SRC) _mm256_xor_si256(DEST, SRC)
+/* intrinsic complements its first operand */
+#define vectorAndNot(DEST, SRC) \
+    _mm256_andnot_si256(SRC, DEST)
+#elif defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+/* Number of blocks in one vector */
+#define vectorBlocks (128 / blockSize)
+#define vectorLoad(PTR) \
+    _mm_loadu_si128((const __m128i*)(PTR))
+#define vectorStore(PTR, VECTOR) \
+    _mm_storeu_si128((__m128i*)(PTR), VECTOR)
+#define vectorAnd(DEST, SRC) _mm_and_si128(DEST, SRC)
+#define vectorOr(DEST, SRC) _mm_or_si128(DEST, SRC)
+#define vectorXor(DEST, SRC) _mm_xor_si128(DEST, SRC)
+/* intrinsic complements its first operand */
+#define vectorAndNot(DEST, SRC) _mm_andnot_si128(SRC, DEST)
+#endif
+
+#ifdef vectorBlocks
+/*
+ * Applies the given vector op to as many whole
+ * vectors of blocks as fit, advancing the index
+ */
+#define vectorLoop(VECTOROP, DESTPTR, SRCPTR, COUNT, I) \
+    for(; (I) + vectorBlocks <= (COUNT); \
+        (I) += vectorBlocks \
+    ){ \
+        vectorStore( \
+            (DESTPTR) + (I), \
+            VECTOROP( \
+                vectorLoad((DESTPTR) + (I)), \
+                vectorLoad((SRCPTR) + (I)) \
+            ) \
+        ); \
+    }
+#else
+#define vectorLoop(VECTOROP, DESTPTR, SRCPTR, COUNT, I)
+#endif
+
+#define scalarAnd(DEST, SRC) ((DEST) & (SRC))
+#define scalarOr(DEST, SRC) ((DEST) | (SRC))
+#define scalarXor(DEST, SRC) ((DEST) ^ (SRC))
+#define scalarAndNot(DEST, SRC) ((DEST) & ~(SRC))
+
+/*
+ * Defines a function which applies a bitwise op to
+ * the first count blocks of the destination with
+ * those of the source, vectorized where possible
+ */
+#define blockOpFunc(FUNCNAME, VECTOROP, SCALAROP) \
+    static void FUNCNAME( \
+        BlockType *destPtr, \
+        const BlockType *srcPtr, \
+        size_t count \
+    ){ \
+        size_t i = 0; \
+        vectorLoop(VECTOROP, destPtr, srcPtr, count, i) \
+        for(; i < count; ++i){ \
+            destPtr[i] = SCALAROP(destPtr[i], srcPtr[i]); \
+        } \
+    }
+
+blockOpFunc(blocksAnd, vectorAnd, scalarAnd)
+blockOpFunc(blocksOr, vectorOr, scalarOr)
+blockOpFunc(blocksXor, vectorXor, scalarXor)
+blockOpFunc(blocksAndNot, vectorAndNot, scalarAndNot)
+
 /* Constructs and returns a new bitset by value */
 Bitset bitsetMake(size_t initBitCapacity){
     Bitset toRet = {0};
@@ -206,15 +286,53 @@ bool bitsetAny(Bitset *bitsetPtr){
     return false;
 }
 
-/* Returns the number of bits set in the given block */
-static size_t blockCount(BlockType block){
-    /* Kernighan's algorithm */
-    size_t count = 0;
-    while(block != 0){
-        block = block & (block - 1);
-        ++count;
+/*
+ * Returns the number of bits set in the given blocks
+ */
+static size_t blocksCount(
+    const BlockType *blocks,
+    size_t count
+){
+    size_t toRet = 0;
+    size_t i = 0;
+    #if defined(__AVX2__)
+    /* nibble lookup popcount, summed per 64 bits */
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+    );
+    const __m256i lowMask = _mm256_set1_epi8(0x0F);
+    __m256i sums = _mm256_setzero_si256();
+    for(; i + vectorBlocks <= count; i += vectorBlocks){
+        __m256i vector = vectorLoad(blocks + i);
+        __m256i lowCounts = _mm256_shuffle_epi8(
+            lookup,
+            _mm256_and_si256(vector, lowMask)
+        );
+        __m256i highCounts = _mm256_shuffle_epi8(
+            lookup,
+            _mm256_and_si256(
+                _mm256_srli_epi16(vector, 4),
+                lowMask
+            )
+        );
+        sums = _mm256_add_epi64(
+            sums,
+            _mm256_sad_epu8(
+                _mm256_add_epi8(lowCounts, highCounts),
+                _mm256_setzero_si256()
+            )
+        );
+    }
+    toRet += (size_t)_mm256_extract_epi64(sums, 0)
+        + (size_t)_mm256_extract_epi64(sums, 1)
+        + (size_t)_mm256_extract_epi64(sums, 2)
+        + (size_t)_mm256_extract_epi64(sums, 3);
+    #endif
+    for(; i < count; ++i){
+        toRet += popCount32(blocks[i]);
     }
-    return count;
+    return toRet;
 }
 
 /* 
@@ -226,16 +344,10 @@ size_t bitsetCount(Bitset *bitsetPtr){
         &(bitsetPtr->_blockArray)
     );
 
-    /* count number of set bits in each block */
-    size_t count = 0;
-    for(size_t i = 0;
-        i < bitsetPtr->_blockArray.size;
-        ++i
-    ){
-        count += blockCount(frontPtr[i]);
-    }
-
-    return count;
+    return blocksCount(
+        frontPtr,
+        bitsetPtr->_blockArray.size
+    );
 }
 
 /*
@@ -269,21 +381,8 @@ int bitsetFirstSet(Bitset *bitsetPtr){
     }
 
     /* find first set bit in the block */
-    BlockType firstSetBlock
-        = frontPtr[firstSetBlockIndex];
-    size_t firstSetBitSubIndex = 0;
-    for(firstSetBitSubIndex = 0;
-        firstSetBitSubIndex < blockSize;
-        ++firstSetBitSubIndex
-    ){
-        if(getBit(firstSetBlock, firstSetBitSubIndex)){
-            break;
-        }
-    }
-    assertFalse(
-        firstSetBitSubIndex == blockSize,
-        "failed to find first bit when block was set"
-        SRC_LOCATION
+    size_t firstSetBitSubIndex = countTrailingZeros32(
+        frontPtr[firstSetBlockIndex]
     );
 
     /* calculate total index and return */
@@ -380,25 +479,8 @@ int bitsetFirstUnset(Bitset *bitsetPtr){
     }
 
     /* find first unset bit in the block */
-    BlockType firstNonFullBlock
-        = frontPtr[firstNonFullBlockIndex];
-    size_t firstUnsetBitSubIndex = 0;
-    for(firstUnsetBitSubIndex = 0;
-        firstUnsetBitSubIndex < blockSize;
-        ++firstUnsetBitSubIndex
-    ){
-        if(!getBit(
-            firstNonFullBlock,
-            firstUnsetBitSubIndex
-        )){
-            break;
-        }
-    }
-    assertFalse(
-        firstUnsetBitSubIndex == blockSize,
-        "failed to find first unset bit when block "
-        "was not full"
-        SRC_LOCATION
+    size_t firstUnsetBitSubIndex = countTrailingZeros32(
+        ~frontPtr[firstNonFullBlockIndex]
     );
 
     /* calculate total index and return */
@@ -460,9 +542,7 @@ void bitsetAnd(Bitset *bitsetPtr, Bitset *otherPtr){
      * bitsets; we can use rightBlockCount since
      * we pad with 0 blocks in case left < right
      */
-    for(size_t i = 0; i < rightBlockCount; ++i){
-        frontPtr[i] &= otherFrontPtr[i];
-    }
+    blocksAnd(frontPtr, otherFrontPtr, rightBlockCount);
 }
 
 /* 
@@ -510,9 +590,7 @@ void bitsetOr(Bitset *bitsetPtr, Bitset *otherPtr){
      * bitsets; we can use rightBlockCount since
      * we pad with 0 blocks in case left < right
      */
-    for(size_t i = 0; i < rightBlockCount; ++i){
-        frontPtr[i] |= otherFrontPtr[i];
-    }
+    blocksOr(frontPtr, otherFrontPtr, rightBlockCount);
 }
 
 /* 
@@ -560,9 +638,39 @@ void bitsetXor(Bitset *bitsetPtr, Bitset *otherPtr){
      * bitsets; we can use rightBlockCount since
      * we pad with 0 blocks in case left < right
      */
-    for(size_t i = 0; i < rightBlockCount; ++i){
-        frontPtr[i] ^= otherFrontPtr[i];
-    }
+    blocksXor(frontPtr, otherFrontPtr, rightBlockCount);
+}
+
+/*
+ * Sets the first bitset to the result of performing
+ * bitwise AND with the complement of the second
+ */
+void bitsetAndNot(Bitset *bitsetPtr, Bitset *otherPtr){
+    size_t leftBlockCount
+        = bitsetPtr->_blockArray.size;
+    size_t rightBlockCount
+        = otherPtr->_blockArray.size;
+
+    /*
+     * blocks past the end of the second bitset are
+     * ANDed with all ones, leaving them the same;
+     * likewise extra blocks in the second would only
+     * clear bits which are already zero
+     */
+    size_t commonBlockCount
+        = leftBlockCount < rightBlockCount
+            ? leftBlockCount
+            : rightBlockCount;
+
+    BlockType *frontPtr = arrayListFrontPtr(BlockType,
+        &(bitsetPtr->_blockArray)
+    );
+    BlockType *otherFrontPtr = arrayListFrontPtr(
+        BlockType,
+        &(otherPtr->_blockArray)
+    );
+
+    blocksAndNot(frontPtr, otherFrontPtr, commonBlockCount);
 }
 
 /* Performs left shift on the given bitset */
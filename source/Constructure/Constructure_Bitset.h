@@ -2,6 +2,7 @@
 #define CONSTRUCTURE_BITSET
 
 #include "Constructure_ArrayList.h"
+#include "ZMath_Bitwise.h"
 
 /* 
  * A bitset stores an unbounded set of bit flags
@@ -99,6 +100,44 @@ void bitsetOr(Bitset *bitsetPtr, Bitset *otherPtr);
  */
 void bitsetXor(Bitset *bitsetPtr, Bitset *otherPtr);
 
+/*
+ * Sets the first bitset to the result of performing
+ * bitwise AND with the complement of the second
+ */
+void bitsetAndNot(Bitset *bitsetPtr, Bitset *otherPtr);
+
+/*
+ * Calls the given function with the index of each
+ * set bit in the given bitset in ascending order;
+ * the function takes a size_t and must not modify
+ * the bitset
+ */
+#define bitsetForEachSet(BITSETPTR, FUNC) \
+    do{ \
+        const uint32_t *_bitsetBlocks \
+            = (const uint32_t*) \
+                ((BITSETPTR)->_blockArray._ptr); \
+        for( \
+            size_t _bitsetBlockIndex = 0u; \
+            _bitsetBlockIndex \
+                < (BITSETPTR)->_blockArray.size; \
+            ++_bitsetBlockIndex \
+        ){ \
+            uint32_t _bitsetBlock \
+                = _bitsetBlocks[_bitsetBlockIndex]; \
+            while(_bitsetBlock){ \
+                FUNC( \
+                    (_bitsetBlockIndex * 32u) \
+                    + countTrailingZeros32( \
+                        _bitsetBlock \
+                    ) \
+                ); \
+                _bitsetBlock \
+                    = clearLowestBit(_bitsetBlock); \
+            } \
+        } \
+    } while(false)
+
 /* Performs left shift on the given bitset */
 void bitsetLeftShift(
     Bitset *bitsetPtr,
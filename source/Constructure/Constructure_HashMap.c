@@ -38,6 +38,7 @@ HashMap _hashMapMake(
     , const char *keyTypeName
     , const char *valueTypeName
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     assertTrue(
         initCapacity > 0, 
@@ -46,7 +47,11 @@ HashMap _hashMapMake(
     );
     HashMap toRet = {0};
     toRet._capacity = initCapacity;
-    toRet._ptr = pgAlloc(initCapacity, slotSize);
+    toRet._ptr = pgAllocAt(
+        initCapacity,
+        slotSize,
+        allocSite
+    );
     toRet.size = 0u;
     toRet._touchedCount = 0u;
     toRet._hashFunc = hashFunc;
@@ -71,6 +76,7 @@ HashMap _hashMapCopy(
     , const char *keyTypeName
     , const char *valueTypeName
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     #ifdef _DEBUG
     _hashMapPtrTypeCheck(
@@ -85,9 +91,10 @@ HashMap _hashMapCopy(
     toRet._touchedCount 
         = toCopyPtr->_touchedCount;
     toRet._capacity = toCopyPtr->_capacity;
-    toRet._ptr = pgAlloc(
+    toRet._ptr = pgAllocAt(
         toRet._capacity,
-        slotSize
+        slotSize,
+        allocSite
     );
     /* may overflow */
     memcpy(
@@ -122,6 +129,7 @@ void _hashMapAddAllFrom(
     , const char *keyTypeName
     , const char *valueTypeName
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     #ifdef _DEBUG
     _hashMapPtrTypeCheck(
@@ -170,6 +178,7 @@ void _hashMapAddAllFrom(
                     , keyTypeName
                     , valueTypeName
                     #endif
+                    PG_ALLOC_SITE_FORWARD
                 );
             }
         }
@@ -281,6 +290,7 @@ void *_findEmptySlotToInsert(
 rehashReturnCode _hashMapRehashIfNeeded(
     HashMap *hashMapPtr,
     size_t slotSize
+    PG_ALLOC_SITE_PARAM
 ){
     enum{ growRatio = 2u };
 
@@ -304,7 +314,11 @@ rehashReturnCode _hashMapRehashIfNeeded(
      * allocate new array; also important to
      * zero it
      */
-    void *newPtr = pgAlloc(newCapacity, slotSize);
+    void *newPtr = pgAllocAt(
+        newCapacity,
+        slotSize,
+        allocSite
+    );
     /* return false if allocation failed */
     if(!newPtr){
         return _hashMapError;
@@ -559,6 +573,7 @@ void _hashMapPutPtr(
     , const char *keyTypeName
     , const char *valueTypeName
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     #ifdef _DEBUG
     _hashMapPtrTypeCheck(
@@ -614,6 +629,7 @@ void _hashMapPutPtr(
         switch(_hashMapRehashIfNeeded(
             hashMapPtr, 
             slotSize
+            PG_ALLOC_SITE_FORWARD
         )){
             /* case 2a: rehash */
             case _hashMapRehash:
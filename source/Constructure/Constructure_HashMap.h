@@ -161,6 +161,7 @@ HashMap _hashMapMake(
     , const char *keyTypeName
     , const char *valueTypeName
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -180,6 +181,7 @@ HashMap _hashMapMake(
         HASHFUNC, \
         EQUALSFUNC, \
         _slotSize(KEYTYPENAME, VALUETYPENAME) \
+        PG_ALLOC_SITE_ARG \
     )
 
 #else
@@ -201,6 +203,7 @@ HashMap _hashMapMake(
         _slotSize(KEYTYPENAME, VALUETYPENAME), \
         #KEYTYPENAME, \
         #VALUETYPENAME \
+        PG_ALLOC_SITE_ARG \
     )
 #endif
 
@@ -215,6 +218,7 @@ HashMap _hashMapCopy(
     , const char *keyTypeName
     , const char *valueTypeName
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -231,6 +235,7 @@ HashMap _hashMapCopy(
     _hashMapCopy( \
         _slotSize(KEYTYPENAME, VALUETYPENAME), \
         TOCOPYPTR \
+        PG_ALLOC_SITE_ARG \
     )
 #else
 /*
@@ -248,6 +253,7 @@ HashMap _hashMapCopy(
         TOCOPYPTR, \
         #KEYTYPENAME, \
         #VALUETYPENAME \
+        PG_ALLOC_SITE_ARG \
     )
 #endif
 
@@ -265,6 +271,7 @@ void _hashMapAddAllFrom(
     , const char *keyTypeName
     , const char *valueTypeName
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -286,6 +293,7 @@ void _hashMapAddAllFrom(
         _slotSize(KEYTYPENAME, VALUETYPENAME), \
         sizeof(KEYTYPENAME), \
         sizeof(VALUETYPENAME) \
+        PG_ALLOC_SITE_ARG \
     )
 #else
 /*
@@ -308,6 +316,7 @@ void _hashMapAddAllFrom(
         sizeof(VALUETYPENAME), \
         #KEYTYPENAME, \
         #VALUETYPENAME \
+        PG_ALLOC_SITE_ARG \
     )
 #endif
 
@@ -398,6 +407,7 @@ void *_findEmptySlotToInsert(
 rehashReturnCode _hashMapRehashIfNeeded(
     HashMap *hashMapPtr,
     size_t slotSize
+    PG_ALLOC_SITE_PARAM
 );
 
 /*
@@ -651,6 +661,7 @@ void _hashMapPutPtr(
     , const char *keyTypeName
     , const char *valueTypeName
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -677,6 +688,7 @@ void _hashMapPutPtr(
         _slotSize(KEYTYPENAME, VALUETYPENAME), \
         sizeof(KEYTYPENAME), \
         sizeof(VALUETYPENAME) \
+        PG_ALLOC_SITE_ARG \
     )
 #else
 /*
@@ -704,6 +716,7 @@ void _hashMapPutPtr(
         sizeof(VALUETYPENAME), \
         #KEYTYPENAME, \
         #VALUETYPENAME \
+        PG_ALLOC_SITE_ARG \
     )
 #endif
 
@@ -0,0 +1,462 @@
+#include "Constructure_PagedSparseSet.h"
+
+/* max size_t will signal invalid index */
+#define invalidSparseIndex (~((size_t)0u))
+
+/*
+ * Returns a pointer to the sparse entry for the given
+ * index, or NULL if its page has not been allocated
+ */
+static size_t *_pagedSparseSetEntryPtr(
+    const PagedSparseSet *setPtr,
+    size_t sparseIndex
+){
+    size_t *pagePtr = setPtr->_pagePtrs[
+        sparseIndex / pagedSparseSetPageSize
+    ];
+    if(!pagePtr){
+        return NULL;
+    }
+    return &(pagePtr[
+        sparseIndex % pagedSparseSetPageSize
+    ]);
+}
+
+/*
+ * Returns a pointer to the sparse entry for the given
+ * index, allocating its page if needed
+ */
+static size_t *_pagedSparseSetEntryPtrAlloc(
+    PagedSparseSet *setPtr,
+    size_t sparseIndex
+    PG_ALLOC_SITE_PARAM
+){
+    size_t pageIndex
+        = sparseIndex / pagedSparseSetPageSize;
+    size_t *pagePtr = setPtr->_pagePtrs[pageIndex];
+    if(!pagePtr){
+        /* init new page to invalid */
+        pagePtr = pgAllocAt(
+            pagedSparseSetPageSize,
+            sizeof(size_t),
+            allocSite
+        );
+        memset(
+            pagePtr,
+            0xFF,
+            pagedSparseSetPageSize * sizeof(size_t)
+        );
+        setPtr->_pagePtrs[pageIndex] = pagePtr;
+    }
+    return &(pagePtr[
+        sparseIndex % pagedSparseSetPageSize
+    ]);
+}
+
+/*
+ * Creates a paged sparse set and returns it by value;
+ * no sparse pages are allocated until first use
+ */
+PagedSparseSet _pagedSparseSetMake(
+    size_t sparseCapacity,
+    size_t initDenseCapacity,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+    PG_ALLOC_SITE_PARAM
+){
+    assertTrue(
+        sparseCapacity > 0u,
+        "sparseCapacity cannot be 0; " SRC_LOCATION
+    );
+    assertTrue(
+        initDenseCapacity > 0u,
+        "init dense capacity cannot be 0; "
+        SRC_LOCATION
+    );
+
+    PagedSparseSet toRet = {0};
+
+    if(initDenseCapacity > sparseCapacity){
+        initDenseCapacity = sparseCapacity;
+    }
+
+    /* allocate page directory; pages start NULL */
+    toRet._pageCount = (
+        (sparseCapacity + pagedSparseSetPageSize - 1)
+            / pagedSparseSetPageSize
+    );
+    toRet._pagePtrs = pgAllocAt(
+        toRet._pageCount,
+        sizeof(*(toRet._pagePtrs)),
+        allocSite
+    );
+    for(size_t i = 0u; i < toRet._pageCount; ++i){
+        toRet._pagePtrs[i] = NULL;
+    }
+
+    /* allocate dense */
+    toRet._densePtr = pgAllocAt(
+        initDenseCapacity,
+        elementSize,
+        allocSite
+    );
+
+    /* allocate reflect */
+    toRet._reflectPtr = pgAllocAt(
+        initDenseCapacity,
+        sizeof(*(toRet._reflectPtr)),
+        allocSite
+    );
+
+    toRet.sparseCapacity = sparseCapacity;
+    toRet._denseCapacity = initDenseCapacity;
+    toRet._size = 0u;
+
+    #ifdef _DEBUG
+    toRet._typeName = typeName;
+    #endif
+
+    return toRet;
+}
+
+/*
+ * Clears the given paged sparse set, removing all key
+ * associations; only sparse entries of present
+ * elements are touched, and pages stay allocated
+ */
+void _pagedSparseSetClear(
+    PagedSparseSet *setPtr
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _pagedSparseSetPtrTypeCheck(typeName, setPtr);
+    #endif
+
+    /* invalidate sparse keys via reflect */
+    for(size_t i = 0u; i < setPtr->_size; ++i){
+        *_pagedSparseSetEntryPtr(
+            setPtr,
+            setPtr->_reflectPtr[i]
+        ) = invalidSparseIndex;
+    }
+
+    setPtr->_size = 0u;
+}
+
+/*
+ * Returns true if the given paged sparse set contains
+ * an element associated with the specified index,
+ * false otherwise
+ */
+bool _pagedSparseSetContains(
+    const PagedSparseSet *setPtr,
+    size_t sparseIndex
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _pagedSparseSetPtrTypeCheck(typeName, setPtr);
+    #endif
+
+    if(sparseIndex >= setPtr->sparseCapacity){
+        return false;
+    }
+    size_t *entryPtr = _pagedSparseSetEntryPtr(
+        setPtr,
+        sparseIndex
+    );
+    return entryPtr && *entryPtr != invalidSparseIndex;
+}
+
+/*
+ * Returns a pointer to the element associated with
+ * the given index in the given paged sparse set, or
+ * NULL if no such element exists
+ */
+void *_pagedSparseSetGetPtr(
+    PagedSparseSet *setPtr,
+    size_t sparseIndex,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _pagedSparseSetPtrTypeCheck(typeName, setPtr);
+    #endif
+
+    /* error if bad index*/
+    assertTrue(
+        sparseIndex < setPtr->sparseCapacity,
+        "bad index; " SRC_LOCATION
+    );
+
+    size_t *entryPtr = _pagedSparseSetEntryPtr(
+        setPtr,
+        sparseIndex
+    );
+    if(!entryPtr || *entryPtr == invalidSparseIndex){
+        return NULL;
+    }
+    assertTrue(*entryPtr < setPtr->_size,
+        "index gotten is larger than size "
+        "but is also not the invalid index; "
+        SRC_LOCATION
+    );
+    return voidPtrAdd(
+        setPtr->_densePtr,
+        elementSize * (*entryPtr)
+    );
+}
+
+/*
+ * Grows the given paged sparse set if it is at
+ * capacity; returns false as error code, true
+ * otherwise
+ */
+static bool _pagedSparseSetGrowIfNeeded(
+    PagedSparseSet *setPtr,
+    size_t elementSize
+    PG_ALLOC_SITE_PARAM
+){
+    enum{ growRatio = 2u };
+
+    /*
+     * error out if size is >= sparse capacity; should
+     * never occur
+     */
+    if(setPtr->_size >= setPtr->sparseCapacity){
+        return false;
+    }
+    if(setPtr->_size == setPtr->_denseCapacity){
+        setPtr->_denseCapacity *= growRatio;
+        ++(setPtr->_denseCapacity);
+        if(setPtr->_denseCapacity
+            > setPtr->sparseCapacity
+        ){
+            setPtr->_denseCapacity
+                = setPtr->sparseCapacity;
+        }
+        /* realloc the dense array */
+        setPtr->_densePtr = pgReallocAt(
+            setPtr->_densePtr,
+            setPtr->_denseCapacity,
+            elementSize,
+            allocSite
+        );
+        if(!(setPtr->_densePtr)){
+            return false;
+        }
+        /* realloc the reflect array */
+        setPtr->_reflectPtr = pgReallocAt(
+            setPtr->_reflectPtr,
+            setPtr->_denseCapacity,
+            sizeof(*(setPtr->_reflectPtr)),
+            allocSite
+        );
+        if(!(setPtr->_reflectPtr)){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Copies the specified value into the element
+ * associated with the given index in the given
+ * paged sparse set
+ */
+void _pagedSparseSetSetPtr(
+    PagedSparseSet *setPtr,
+    size_t sparseIndex,
+    const void *valuePtr,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+    PG_ALLOC_SITE_PARAM
+){
+    #ifdef _DEBUG
+    _pagedSparseSetPtrTypeCheck(typeName, setPtr);
+    #endif
+
+    /* error if bad index*/
+    assertTrue(
+        sparseIndex < setPtr->sparseCapacity,
+        "bad index; " SRC_LOCATION
+    );
+
+    size_t *entryPtr = _pagedSparseSetEntryPtrAlloc(
+        setPtr,
+        sparseIndex
+        PG_ALLOC_SITE_FORWARD
+    );
+
+    /*
+     * if the sparse index had a previous value,
+     * then overwrite it
+     */
+    if(*entryPtr != invalidSparseIndex){
+        /* memcpy safe; elements shouldn't overlap */
+        memcpy(
+            voidPtrAdd(
+                setPtr->_densePtr,
+                elementSize * (*entryPtr)
+            ),
+            valuePtr,
+            elementSize
+        );
+        return;
+    }
+
+    /* grow dense and reflect arrays if needed */
+    assertTrue(
+        _pagedSparseSetGrowIfNeeded(
+            setPtr,
+            elementSize
+            PG_ALLOC_SITE_FORWARD
+        ),
+        "paged sparse set failed to grow; " SRC_LOCATION
+    );
+
+    /* copy the value into dense */
+    /* memcpy safe; elements shouldn't overlap */
+    memcpy(
+        voidPtrAdd(
+            setPtr->_densePtr,
+            elementSize * setPtr->_size
+        ),
+        valuePtr,
+        elementSize
+    );
+    /* set reflect */
+    setPtr->_reflectPtr[setPtr->_size] = sparseIndex;
+
+    /* set sparse */
+    *entryPtr = setPtr->_size;
+    ++(setPtr->_size);
+}
+
+/*
+ * Removes the element associated with the given index
+ * from the given paged sparse set; returns true if
+ * successful, false otherwise
+ */
+bool _pagedSparseSetRemove(
+    PagedSparseSet *setPtr,
+    size_t sparseIndex,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _pagedSparseSetPtrTypeCheck(typeName, setPtr);
+    #endif
+
+    /* error if bad sparse index*/
+    assertTrue(
+        sparseIndex < setPtr->sparseCapacity,
+        "bad index; " SRC_LOCATION
+    );
+
+    size_t *entryPtr = _pagedSparseSetEntryPtr(
+        setPtr,
+        sparseIndex
+    );
+    if(!entryPtr || *entryPtr >= setPtr->_size){
+        return false;
+    }
+    size_t denseIndex = *entryPtr;
+
+    /* invalidate sparse for the element to remove */
+    *entryPtr = invalidSparseIndex;
+
+    --(setPtr->_size);
+    /* if not removing end, swap in last element */
+    if(denseIndex != setPtr->_size){
+        size_t sparseIndexOfEnd
+            = setPtr->_reflectPtr[setPtr->_size];
+        /* overwrite value */
+        memcpy(
+            voidPtrAdd(
+                setPtr->_densePtr,
+                denseIndex * elementSize
+            ),
+            voidPtrAdd(
+                setPtr->_densePtr,
+                setPtr->_size * elementSize
+            ),
+            elementSize
+        );
+        /* overwrite reflect */
+        setPtr->_reflectPtr[denseIndex]
+            = sparseIndexOfEnd;
+        /* change sparse entry for previous end */
+        *_pagedSparseSetEntryPtr(
+            setPtr,
+            sparseIndexOfEnd
+        ) = denseIndex;
+    }
+    return true;
+}
+
+/*
+ * Creates an iterator over the dense elements of the
+ * given paged sparse set; use with the sparse set
+ * iterator functions
+ */
+SparseSetItr _pagedSparseSetItr(
+    PagedSparseSet *setPtr
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _pagedSparseSetPtrTypeCheck(typeName, setPtr);
+    #endif
+
+    SparseSetItr toRet = {
+        setPtr->_densePtr,
+        setPtr->_reflectPtr,
+        setPtr->_size,
+        0
+        #ifdef _DEBUG
+        ,typeName
+        #endif
+    };
+
+    return toRet;
+}
+
+/* Frees the given paged sparse set */
+void _pagedSparseSetFree(
+    PagedSparseSet *setPtr
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _pagedSparseSetPtrTypeCheck(typeName, setPtr);
+    #endif
+
+    for(size_t i = 0u; i < setPtr->_pageCount; ++i){
+        if(setPtr->_pagePtrs[i]){
+            pgFree(setPtr->_pagePtrs[i]);
+        }
+    }
+    pgFree(setPtr->_pagePtrs);
+    pgFree(setPtr->_densePtr);
+    pgFree(setPtr->_reflectPtr);
+
+    setPtr->_pageCount = 0u;
+    setPtr->sparseCapacity = 0u;
+    setPtr->_denseCapacity = 0u;
+    setPtr->_size = 0u;
+}
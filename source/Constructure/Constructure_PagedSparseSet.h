@@ -0,0 +1,429 @@
+#ifndef CONSTRUCTURE_PAGEDSPARSESET_H
+#define CONSTRUCTURE_PAGEDSPARSESET_H
+
+#include "PGUtil.h"
+#include "Constructure_SparseSet.h"
+
+/* number of sparse entries held by a single page */
+#define pagedSparseSetPageSize 4096
+
+/*
+ * A paged sparse set maps size_t to elements like a
+ * sparse set, but allocates its sparse array in
+ * pages on first use, so large and mostly empty
+ * index spaces stay cheap
+ */
+typedef struct PagedSparseSet{
+    /* page directory; NULL for unallocated pages */
+    size_t **_pagePtrs;
+    /* Number of entries in the page directory */
+    size_t _pageCount;
+
+    void *_densePtr;
+    /* need a mapping of dense to sparse for remove */
+    size_t *_reflectPtr;
+    /* The number of sparse indices supported */
+    size_t sparseCapacity;
+    /* Internal capacity of dense and reflect arrays */
+    size_t _denseCapacity;
+    /* Current number of elements*/
+    size_t _size;
+
+    #ifdef _DEBUG
+    /*
+     * Should only ever point to a string literal,
+     * thus should not be freed
+     */
+    const char *_typeName;
+    #endif
+} PagedSparseSet;
+
+#ifdef _DEBUG
+/*
+ * Asserts that the given type matches that of the
+ * given paged sparse set pointer
+ */
+#define _pagedSparseSetPtrTypeCheck(TYPENAME, SETPTR) \
+    assertStringEqual( \
+        TYPENAME, \
+        (SETPTR)->_typeName, \
+        "bad paged sparse set type; " SRC_LOCATION \
+    )
+#endif
+
+/*
+ * Creates a paged sparse set and returns it by value;
+ * no sparse pages are allocated until first use
+ */
+PagedSparseSet _pagedSparseSetMake(
+    size_t sparseCapacity,
+    size_t initDenseCapacity,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+    PG_ALLOC_SITE_PARAM
+);
+
+#ifndef _DEBUG
+/*
+ * Creates a paged sparse set of the specified type
+ * and returns it by value
+ */
+#define pagedSparseSetMake( \
+    TYPENAME, \
+    SPARSECAPACITY, \
+    INITDENSECAPACITY \
+) \
+    _pagedSparseSetMake( \
+        SPARSECAPACITY, \
+        INITDENSECAPACITY, \
+        sizeof(TYPENAME) \
+        PG_ALLOC_SITE_ARG \
+    )
+#else
+/*
+ * Creates a paged sparse set of the specified type
+ * and returns it by value
+ */
+#define pagedSparseSetMake( \
+    TYPENAME, \
+    SPARSECAPACITY, \
+    INITDENSECAPACITY \
+) \
+    _pagedSparseSetMake( \
+        SPARSECAPACITY, \
+        INITDENSECAPACITY, \
+        sizeof(TYPENAME), \
+        #TYPENAME \
+        PG_ALLOC_SITE_ARG \
+    )
+#endif
+
+/*
+ * Clears the given paged sparse set, removing all key
+ * associations; only sparse entries of present
+ * elements are touched, and pages stay allocated
+ */
+void _pagedSparseSetClear(
+    PagedSparseSet *setPtr
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Clears the given paged sparse set of the specified
+ * type, removing all key associations
+ */
+#define pagedSparseSetClear(TYPENAME, SETPTR) \
+    _pagedSparseSetClear(SETPTR)
+#else
+/*
+ * Clears the given paged sparse set of the specified
+ * type, removing all key associations
+ */
+#define pagedSparseSetClear(TYPENAME, SETPTR) \
+    _pagedSparseSetClear(SETPTR, #TYPENAME)
+#endif
+
+/*
+ * Returns true if the given paged sparse set contains
+ * an element associated with the specified index,
+ * false otherwise
+ */
+bool _pagedSparseSetContains(
+    const PagedSparseSet *setPtr,
+    size_t sparseIndex
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Returns true if the given paged sparse set of the
+ * specified type contains an element associated
+ * with the specified index, false otherwise
+ */
+#define pagedSparseSetContains( \
+    TYPENAME, \
+    SETPTR, \
+    SPARSEINDEX \
+) \
+    _pagedSparseSetContains(SETPTR, SPARSEINDEX)
+#else
+/*
+ * Returns true if the given paged sparse set of the
+ * specified type contains an element associated
+ * with the specified index, false otherwise
+ */
+#define pagedSparseSetContains( \
+    TYPENAME, \
+    SETPTR, \
+    SPARSEINDEX \
+) \
+    _pagedSparseSetContains( \
+        SETPTR, \
+        SPARSEINDEX, \
+        #TYPENAME \
+    )
+#endif
+
+/*
+ * Returns a pointer to the element associated with
+ * the given index in the given paged sparse set, or
+ * NULL if no such element exists
+ */
+void *_pagedSparseSetGetPtr(
+    PagedSparseSet *setPtr,
+    size_t sparseIndex,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Returns a pointer to the element associated with
+ * the given index in the given paged sparse set of
+ * the specified type, or NULL if no such element
+ * exists
+ */
+#define pagedSparseSetGetPtr( \
+    TYPENAME, \
+    SETPTR, \
+    SPARSEINDEX \
+) \
+    ((TYPENAME*)_pagedSparseSetGetPtr( \
+        SETPTR, \
+        SPARSEINDEX, \
+        sizeof(TYPENAME) \
+    ))
+#else
+/*
+ * Returns a pointer to the element associated with
+ * the given index in the given paged sparse set of
+ * the specified type, or NULL if no such element
+ * exists
+ */
+#define pagedSparseSetGetPtr( \
+    TYPENAME, \
+    SETPTR, \
+    SPARSEINDEX \
+) \
+    ((TYPENAME*)_pagedSparseSetGetPtr( \
+        SETPTR, \
+        SPARSEINDEX, \
+        sizeof(TYPENAME), \
+        #TYPENAME \
+    ))
+#endif
+
+/*
+ * Returns the value of the element associated with
+ * the given index in the given paged sparse set of
+ * the specified type
+ */
+#define pagedSparseSetGet(TYPENAME, SETPTR, SPARSEINDEX) \
+    ( \
+        (TYPENAME) \
+        (*pagedSparseSetGetPtr( \
+            TYPENAME, \
+            SETPTR, \
+            SPARSEINDEX \
+        )) \
+    )
+
+/*
+ * Copies the specified value into the element
+ * associated with the given index in the given
+ * paged sparse set
+ */
+void _pagedSparseSetSetPtr(
+    PagedSparseSet *setPtr,
+    size_t sparseIndex,
+    const void *valuePtr,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+    PG_ALLOC_SITE_PARAM
+);
+
+#ifndef _DEBUG
+/*
+ * Copies the specified value into the element
+ * associated with the given index in the given
+ * paged sparse set of the specified type
+ */
+#define pagedSparseSetSetPtr( \
+    TYPENAME, \
+    SETPTR, \
+    SPARSEINDEX, \
+    VALUEPTR \
+) \
+    _Generic(*VALUEPTR, \
+        TYPENAME: _pagedSparseSetSetPtr( \
+            SETPTR, \
+            SPARSEINDEX, \
+            VALUEPTR, \
+            sizeof(TYPENAME) \
+            PG_ALLOC_SITE_ARG \
+        ) \
+    )
+#else
+/*
+ * Copies the specified value into the element
+ * associated with the given index in the given
+ * paged sparse set of the specified type
+ */
+#define pagedSparseSetSetPtr( \
+    TYPENAME, \
+    SETPTR, \
+    SPARSEINDEX, \
+    VALUEPTR \
+) \
+    _Generic(*VALUEPTR, \
+        TYPENAME: _pagedSparseSetSetPtr( \
+            SETPTR, \
+            SPARSEINDEX, \
+            VALUEPTR, \
+            sizeof(TYPENAME), \
+            #TYPENAME \
+            PG_ALLOC_SITE_ARG \
+        ) \
+    )
+#endif
+
+/*
+ * Sets the element associated with the given index
+ * in the given paged sparse set of the specified type
+ * to the given value
+ */
+#define pagedSparseSetSet( \
+    TYPENAME, \
+    SETPTR, \
+    SPARSEINDEX, \
+    VALUE \
+) \
+    do{ \
+        TYPENAME _pagedSparseSetValue = (VALUE); \
+        pagedSparseSetSetPtr( \
+            TYPENAME, \
+            SETPTR, \
+            SPARSEINDEX, \
+            &_pagedSparseSetValue \
+        ); \
+    } while(false)
+
+/*
+ * Removes the element associated with the given index
+ * from the given paged sparse set; returns true if
+ * successful, false otherwise
+ */
+bool _pagedSparseSetRemove(
+    PagedSparseSet *setPtr,
+    size_t sparseIndex,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Removes the element associated with the given index
+ * from the given paged sparse set of the specified
+ * type; returns true if successful, false otherwise
+ */
+#define pagedSparseSetRemove( \
+    TYPENAME, \
+    SETPTR, \
+    SPARSEINDEX \
+) \
+    _pagedSparseSetRemove( \
+        SETPTR, \
+        SPARSEINDEX, \
+        sizeof(TYPENAME) \
+    )
+#else
+/*
+ * Removes the element associated with the given index
+ * from the given paged sparse set of the specified
+ * type; returns true if successful, false otherwise
+ */
+#define pagedSparseSetRemove( \
+    TYPENAME, \
+    SETPTR, \
+    SPARSEINDEX \
+) \
+    _pagedSparseSetRemove( \
+        SETPTR, \
+        SPARSEINDEX, \
+        sizeof(TYPENAME), \
+        #TYPENAME \
+    )
+#endif
+
+/*
+ * Returns the number of elements in the given paged
+ * sparse set
+ */
+#define pagedSparseSetSize(SETPTR) ((SETPTR)->_size)
+
+/*
+ * Creates an iterator over the dense elements of the
+ * given paged sparse set; use with the sparse set
+ * iterator functions
+ */
+SparseSetItr _pagedSparseSetItr(
+    PagedSparseSet *setPtr
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Creates an iterator over the given paged sparse set
+ * of the specified type
+ */
+#define pagedSparseSetItr(TYPENAME, SETPTR) \
+    _pagedSparseSetItr(SETPTR)
+#else
+/*
+ * Creates an iterator over the given paged sparse set
+ * of the specified type
+ */
+#define pagedSparseSetItr(TYPENAME, SETPTR) \
+    _pagedSparseSetItr(SETPTR, #TYPENAME)
+#endif
+
+/* Frees the given paged sparse set */
+void _pagedSparseSetFree(
+    PagedSparseSet *setPtr
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Frees the given paged sparse set of the specified
+ * type
+ */
+#define pagedSparseSetFree(TYPENAME, SETPTR) \
+    _pagedSparseSetFree(SETPTR)
+#else
+/*
+ * Frees the given paged sparse set of the specified
+ * type
+ */
+#define pagedSparseSetFree(TYPENAME, SETPTR) \
+    _pagedSparseSetFree(SETPTR, #TYPENAME)
+#endif
+
+#endif
@@ -0,0 +1,234 @@
+#include "Constructure_RadixSort.h"
+
+#include <string.h>
+
+/* sorts one byte of the key per pass */
+#define radixBits 8
+#define radixBuckets (1 << radixBits)
+#define radixMask (radixBuckets - 1)
+
+/*
+ * Turns the given histogram into exclusive prefix
+ * sums; returns false if every element falls into
+ * the same bucket, in which case the pass can be
+ * skipped, true otherwise
+ */
+static bool histogramToOffsets(
+    size_t *histogramPtr,
+    size_t count
+){
+    size_t sum = 0u;
+    for(size_t i = 0u; i < radixBuckets; ++i){
+        if(histogramPtr[i] == count){
+            return false;
+        }
+        size_t bucketCount = histogramPtr[i];
+        histogramPtr[i] = sum;
+        sum += bucketCount;
+    }
+    return true;
+}
+
+/*
+ * Defines a radix sort over an array of ELEMTYPE
+ * whose KEYTYPE key is read with the given macro;
+ * histograms for every digit are built in a single
+ * read pass, then each digit is scattered in turn
+ */
+#define radixSortFunc(FUNCNAME, ELEMTYPE, KEYTYPE, GETKEY) \
+    void FUNCNAME( \
+        ELEMTYPE *elementsPtr, \
+        ELEMTYPE *scratchPtr, \
+        size_t count \
+    ){ \
+        enum{ digitCount = sizeof(KEYTYPE) }; \
+        if(count <= 1u){ \
+            return; \
+        } \
+        size_t histograms[digitCount][radixBuckets]; \
+        memset(histograms, 0, sizeof(histograms)); \
+        for(size_t i = 0u; i < count; ++i){ \
+            KEYTYPE key = GETKEY(elementsPtr[i]); \
+            for(size_t d = 0u; d < digitCount; ++d){ \
+                ++histograms[d][ \
+                    (key >> (d * radixBits)) & radixMask \
+                ]; \
+            } \
+        } \
+        ELEMTYPE *sourcePtr = elementsPtr; \
+        ELEMTYPE *destPtr = scratchPtr; \
+        for(size_t d = 0u; d < digitCount; ++d){ \
+            size_t *offsetsPtr = histograms[d]; \
+            if(!histogramToOffsets(offsetsPtr, count)){ \
+                continue; \
+            } \
+            size_t shift = d * radixBits; \
+            for(size_t i = 0u; i < count; ++i){ \
+                size_t digit = (GETKEY(sourcePtr[i]) \
+                    >> shift) & radixMask; \
+                destPtr[offsetsPtr[digit]++] \
+                    = sourcePtr[i]; \
+            } \
+            ELEMTYPE *tempPtr = sourcePtr; \
+            sourcePtr = destPtr; \
+            destPtr = tempPtr; \
+        } \
+        /* odd number of passes leaves it in scratch */ \
+        if(sourcePtr != elementsPtr){ \
+            memcpy( \
+                elementsPtr, \
+                sourcePtr, \
+                count * sizeof(ELEMTYPE) \
+            ); \
+        } \
+    }
+
+#define keyOfKey(ELEMENT) (ELEMENT)
+#define keyOfPair(ELEMENT) ((ELEMENT).key)
+
+/* Sorts the given array of 32 bit keys ascending */
+radixSortFunc(radixSortKeys32, uint32_t, uint32_t, keyOfKey)
+
+/* Sorts the given array of 64 bit keys ascending */
+radixSortFunc(radixSortKeys64, uint64_t, uint64_t, keyOfKey)
+
+/*
+ * Sorts the given array of 32 bit key-index pairs
+ * ascending by key
+ */
+radixSortFunc(
+    radixSortPairs32,
+    RadixPair32,
+    uint32_t,
+    keyOfPair
+)
+
+/*
+ * Sorts the given array of 64 bit key-index pairs
+ * ascending by key
+ */
+radixSortFunc(
+    radixSortPairs64,
+    RadixPair64,
+    uint64_t,
+    keyOfPair
+)
+
+/*
+ * Maps a float to an unsigned key which sorts in the
+ * same order; NaNs sort to the extremes
+ */
+uint32_t radixKeyFromFloat(float value){
+    uint32_t bits = 0u;
+    memcpy(&bits, &value, sizeof(bits));
+    /* flip all bits of negatives, sign of positives */
+    uint32_t mask = (uint32_t)(-(int32_t)(bits >> 31u))
+        | 0x80000000u;
+    return bits ^ mask;
+}
+
+/*
+ * Maps a double to an unsigned key which sorts in
+ * the same order; NaNs sort to the extremes
+ */
+uint64_t radixKeyFromDouble(double value){
+    uint64_t bits = 0u;
+    memcpy(&bits, &value, sizeof(bits));
+    /* flip all bits of negatives, sign of positives */
+    uint64_t mask = (uint64_t)(-(int64_t)(bits >> 63u))
+        | 0x8000000000000000ull;
+    return bits ^ mask;
+}
+
+/* Reads the unsigned key of the given width */
+static uint64_t readKey(
+    const void *elementPtr,
+    size_t keyOffset,
+    size_t keySize
+){
+    const char *keyPtr
+        = ((const char*)elementPtr) + keyOffset;
+    if(keySize == sizeof(uint32_t)){
+        uint32_t key = 0u;
+        memcpy(&key, keyPtr, sizeof(key));
+        return key;
+    }
+    uint64_t key = 0u;
+    memcpy(&key, keyPtr, sizeof(key));
+    return key;
+}
+
+/*
+ * Stably sorts the given array of elements ascending
+ * by the unsigned key of the specified width (4 or 8
+ * bytes) found at the given offset in each element
+ */
+void _radixSortElements(
+    void *elementsPtr,
+    void *scratchPtr,
+    size_t count,
+    size_t elementSize,
+    size_t keyOffset,
+    size_t keySize
+){
+    assertTrue(
+        keySize == sizeof(uint32_t)
+            || keySize == sizeof(uint64_t),
+        "radix sort key must be 4 or 8 bytes; "
+        SRC_LOCATION
+    );
+    assertTrue(
+        keyOffset + keySize <= elementSize,
+        "radix sort key outside element; "
+        SRC_LOCATION
+    );
+    if(count <= 1u){
+        return;
+    }
+
+    size_t histograms[sizeof(uint64_t)][radixBuckets];
+    memset(histograms, 0, sizeof(histograms));
+    const char *readPtr = elementsPtr;
+    for(size_t i = 0u; i < count; ++i){
+        uint64_t key = readKey(readPtr, keyOffset, keySize);
+        for(size_t d = 0u; d < keySize; ++d){
+            ++histograms[d][
+                (key >> (d * radixBits)) & radixMask
+            ];
+        }
+        readPtr += elementSize;
+    }
+
+    char *sourcePtr = elementsPtr;
+    char *destPtr = scratchPtr;
+    for(size_t d = 0u; d < keySize; ++d){
+        size_t *offsetsPtr = histograms[d];
+        if(!histogramToOffsets(offsetsPtr, count)){
+            continue;
+        }
+        size_t shift = d * radixBits;
+        for(size_t i = 0u; i < count; ++i){
+            const char *elementPtr
+                = sourcePtr + (i * elementSize);
+            size_t digit = (readKey(
+                elementPtr,
+                keyOffset,
+                keySize
+            ) >> shift) & radixMask;
+            /* memcpy safe; buffers are distinct */
+            memcpy(
+                destPtr
+                    + (offsetsPtr[digit]++ * elementSize),
+                elementPtr,
+                elementSize
+            );
+        }
+        char *tempPtr = sourcePtr;
+        sourcePtr = destPtr;
+        destPtr = tempPtr;
+    }
+    /* odd number of passes leaves it in scratch */
+    if(sourcePtr != (char*)elementsPtr){
+        memcpy(elementsPtr, sourcePtr, count * elementSize);
+    }
+}
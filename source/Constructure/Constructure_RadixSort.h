@@ -0,0 +1,131 @@
+#ifndef CONSTRUCTURE_RADIXSORT_H
+#define CONSTRUCTURE_RADIXSORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "PGUtil.h"
+
+/*
+ * The radix sorts below are least significant digit
+ * first and thus stable; each takes a scratch buffer
+ * supplied by the caller which must be able to hold
+ * as many elements as are being sorted. The sorted
+ * result always ends up in the original buffer
+ */
+
+/* A 32 bit sort key paired with a payload index */
+typedef struct RadixPair32{
+    uint32_t key;
+    uint32_t index;
+} RadixPair32;
+
+/* A 64 bit sort key paired with a payload index */
+typedef struct RadixPair64{
+    uint64_t key;
+    uint64_t index;
+} RadixPair64;
+
+/*
+ * Maps a signed 32 bit integer to an unsigned key
+ * which sorts in the same order
+ */
+#define radixKeyFromInt32(VALUE) \
+    ((uint32_t)(VALUE) ^ 0x80000000u)
+
+/*
+ * Maps a signed 64 bit integer to an unsigned key
+ * which sorts in the same order
+ */
+#define radixKeyFromInt64(VALUE) \
+    ((uint64_t)(VALUE) ^ 0x8000000000000000ull)
+
+/*
+ * Maps a float to an unsigned key which sorts in the
+ * same order; NaNs sort to the extremes
+ */
+uint32_t radixKeyFromFloat(float value);
+
+/*
+ * Maps a double to an unsigned key which sorts in
+ * the same order; NaNs sort to the extremes
+ */
+uint64_t radixKeyFromDouble(double value);
+
+/* Sorts the given array of 32 bit keys ascending */
+void radixSortKeys32(
+    uint32_t *keysPtr,
+    uint32_t *scratchPtr,
+    size_t count
+);
+
+/* Sorts the given array of 64 bit keys ascending */
+void radixSortKeys64(
+    uint64_t *keysPtr,
+    uint64_t *scratchPtr,
+    size_t count
+);
+
+/*
+ * Sorts the given array of 32 bit key-index pairs
+ * ascending by key
+ */
+void radixSortPairs32(
+    RadixPair32 *pairsPtr,
+    RadixPair32 *scratchPtr,
+    size_t count
+);
+
+/*
+ * Sorts the given array of 64 bit key-index pairs
+ * ascending by key
+ */
+void radixSortPairs64(
+    RadixPair64 *pairsPtr,
+    RadixPair64 *scratchPtr,
+    size_t count
+);
+
+/*
+ * Stably sorts the given array of elements ascending
+ * by the unsigned key of the specified width (4 or 8
+ * bytes) found at the given offset in each element
+ */
+void _radixSortElements(
+    void *elementsPtr,
+    void *scratchPtr,
+    size_t count,
+    size_t elementSize,
+    size_t keyOffset,
+    size_t keySize
+);
+
+/*
+ * Stably sorts the given array of elements of the
+ * specified type ascending by the given member,
+ * which must be a uint32_t or uint64_t
+ */
+#define radixSortElements( \
+    TYPENAME, \
+    ELEMENTSPTR, \
+    SCRATCHPTR, \
+    COUNT, \
+    KEYMEMBER \
+) \
+    _radixSortElements( \
+        _Generic(ELEMENTSPTR, \
+            TYPENAME*: ELEMENTSPTR \
+        ), \
+        _Generic(SCRATCHPTR, \
+            TYPENAME*: SCRATCHPTR \
+        ), \
+        COUNT, \
+        sizeof(TYPENAME), \
+        offsetof(TYPENAME, KEYMEMBER), \
+        _Generic(((TYPENAME*)0)->KEYMEMBER, \
+            uint32_t: sizeof(uint32_t), \
+            uint64_t: sizeof(uint64_t) \
+        ) \
+    )
+
+#endif
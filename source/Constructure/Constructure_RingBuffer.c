@@ -0,0 +1,575 @@
+#include "Constructure_RingBuffer.h"
+
+/* Returns the smallest power of two >= the given value */
+static size_t _ringBufferRoundCapacity(size_t capacity){
+    size_t toRet = 1u;
+    while(toRet < capacity){
+        toRet <<= 1u;
+    }
+    return toRet;
+}
+
+/*
+ * Copies the given elements into the ring storage
+ * starting at the given index, wrapping around the
+ * end of the storage if needed
+ */
+static void _ringBufferCopyIn(
+    void *ringPtr,
+    size_t capacity,
+    size_t startIndex,
+    const void *elementsPtr,
+    size_t count,
+    size_t elementSize
+){
+    size_t firstCount = capacity - startIndex;
+    if(firstCount > count){
+        firstCount = count;
+    }
+    /* memcpy safe; ring and caller do not overlap */
+    memcpy(
+        voidPtrAdd(ringPtr, startIndex * elementSize),
+        elementsPtr,
+        firstCount * elementSize
+    );
+    if(firstCount < count){
+        memcpy(
+            ringPtr,
+            voidPtrAdd(
+                (void*)elementsPtr,
+                firstCount * elementSize
+            ),
+            (count - firstCount) * elementSize
+        );
+    }
+}
+
+/*
+ * Copies elements out of the ring storage starting
+ * at the given index, wrapping around the end of the
+ * storage if needed
+ */
+static void _ringBufferCopyOut(
+    const void *ringPtr,
+    size_t capacity,
+    size_t startIndex,
+    void *outPtr,
+    size_t count,
+    size_t elementSize
+){
+    size_t firstCount = capacity - startIndex;
+    if(firstCount > count){
+        firstCount = count;
+    }
+    /* memcpy safe; ring and caller do not overlap */
+    memcpy(
+        outPtr,
+        voidPtrAdd(
+            (void*)ringPtr,
+            startIndex * elementSize
+        ),
+        firstCount * elementSize
+    );
+    if(firstCount < count){
+        memcpy(
+            voidPtrAdd(outPtr, firstCount * elementSize),
+            ringPtr,
+            (count - firstCount) * elementSize
+        );
+    }
+}
+
+/*
+ * Creates an spsc ring buffer holding at least the
+ * specified number of elements and returns it by
+ * value
+ */
+SpscRingBuffer _spscRingBufferMake(
+    size_t capacity,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+    PG_ALLOC_SITE_PARAM
+){
+    assertTrue(
+        capacity > 0u,
+        "capacity cannot be 0; " SRC_LOCATION
+    );
+
+    SpscRingBuffer toRet = {0};
+    toRet._capacity = _ringBufferRoundCapacity(capacity);
+    toRet._mask = toRet._capacity - 1u;
+    toRet._ptr = pgAllocAt(
+        toRet._capacity,
+        elementSize,
+        allocSite
+    );
+    atomic_init(&(toRet._tail), 0u);
+    atomic_init(&(toRet._head), 0u);
+    toRet._cachedHead = 0u;
+    toRet._cachedTail = 0u;
+
+    #ifdef _DEBUG
+    toRet._typeName = typeName;
+    #endif
+
+    return toRet;
+}
+
+/*
+ * Copies up to the specified number of elements onto
+ * the back of the given spsc ring buffer; returns the
+ * number of elements pushed. Producer thread only
+ */
+size_t _spscRingBufferPushBatch(
+    SpscRingBuffer *bufferPtr,
+    const void *elementsPtr,
+    size_t count,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _ringBufferPtrTypeCheck(typeName, bufferPtr);
+    #endif
+
+    /* only this thread writes tail */
+    size_t tail = atomic_load_explicit(
+        &(bufferPtr->_tail),
+        memory_order_relaxed
+    );
+    size_t freeCount = bufferPtr->_capacity
+        - (tail - bufferPtr->_cachedHead);
+    /* only touch the consumer line if needed */
+    if(freeCount < count){
+        bufferPtr->_cachedHead = atomic_load_explicit(
+            &(bufferPtr->_head),
+            memory_order_acquire
+        );
+        freeCount = bufferPtr->_capacity
+            - (tail - bufferPtr->_cachedHead);
+        if(freeCount < count){
+            count = freeCount;
+        }
+    }
+    if(count == 0u){
+        return 0u;
+    }
+
+    _ringBufferCopyIn(
+        bufferPtr->_ptr,
+        bufferPtr->_capacity,
+        tail & bufferPtr->_mask,
+        elementsPtr,
+        count,
+        elementSize
+    );
+    /* publish the elements to the consumer */
+    atomic_store_explicit(
+        &(bufferPtr->_tail),
+        tail + count,
+        memory_order_release
+    );
+    return count;
+}
+
+/*
+ * Moves up to the specified number of elements off
+ * the front of the given spsc ring buffer into the
+ * given array; returns the number of elements popped.
+ * Consumer thread only
+ */
+size_t _spscRingBufferPopBatch(
+    SpscRingBuffer *bufferPtr,
+    void *outPtr,
+    size_t maxCount,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _ringBufferPtrTypeCheck(typeName, bufferPtr);
+    #endif
+
+    /* only this thread writes head */
+    size_t head = atomic_load_explicit(
+        &(bufferPtr->_head),
+        memory_order_relaxed
+    );
+    size_t readyCount = bufferPtr->_cachedTail - head;
+    /* only touch the producer line if needed */
+    if(readyCount < maxCount){
+        bufferPtr->_cachedTail = atomic_load_explicit(
+            &(bufferPtr->_tail),
+            memory_order_acquire
+        );
+        readyCount = bufferPtr->_cachedTail - head;
+        if(readyCount < maxCount){
+            maxCount = readyCount;
+        }
+    }
+    if(maxCount == 0u){
+        return 0u;
+    }
+
+    _ringBufferCopyOut(
+        bufferPtr->_ptr,
+        bufferPtr->_capacity,
+        head & bufferPtr->_mask,
+        outPtr,
+        maxCount,
+        elementSize
+    );
+    /* hand the slots back to the producer */
+    atomic_store_explicit(
+        &(bufferPtr->_head),
+        head + maxCount,
+        memory_order_release
+    );
+    return maxCount;
+}
+
+/*
+ * Returns the number of elements in the given spsc
+ * ring buffer; only a snapshot when called while
+ * other threads are using the buffer
+ */
+size_t spscRingBufferSize(SpscRingBuffer *bufferPtr){
+    size_t head = atomic_load_explicit(
+        &(bufferPtr->_head),
+        memory_order_acquire
+    );
+    size_t tail = atomic_load_explicit(
+        &(bufferPtr->_tail),
+        memory_order_acquire
+    );
+    return tail - head;
+}
+
+/* Frees the given spsc ring buffer */
+void _spscRingBufferFree(
+    SpscRingBuffer *bufferPtr
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _ringBufferPtrTypeCheck(typeName, bufferPtr);
+    #endif
+
+    pgFree(bufferPtr->_ptr);
+    bufferPtr->_capacity = 0u;
+    bufferPtr->_mask = 0u;
+    atomic_store(&(bufferPtr->_tail), 0u);
+    atomic_store(&(bufferPtr->_head), 0u);
+    bufferPtr->_cachedHead = 0u;
+    bufferPtr->_cachedTail = 0u;
+}
+
+/*
+ * Creates an mpsc ring buffer holding at least the
+ * specified number of elements and returns it by
+ * value
+ */
+MpscRingBuffer _mpscRingBufferMake(
+    size_t capacity,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+    PG_ALLOC_SITE_PARAM
+){
+    assertTrue(
+        capacity > 0u,
+        "capacity cannot be 0; " SRC_LOCATION
+    );
+
+    MpscRingBuffer toRet = {0};
+    toRet._capacity = _ringBufferRoundCapacity(capacity);
+    toRet._mask = toRet._capacity - 1u;
+    toRet._ptr = pgAllocAt(
+        toRet._capacity,
+        elementSize,
+        allocSite
+    );
+    toRet._sequencePtr = pgAllocAt(
+        toRet._capacity,
+        sizeof(*(toRet._sequencePtr)),
+        allocSite
+    );
+    /* every slot starts writable for its first lap */
+    for(size_t i = 0u; i < toRet._capacity; ++i){
+        atomic_init(&(toRet._sequencePtr[i]), i);
+    }
+    atomic_init(&(toRet._tail), 0u);
+    atomic_init(&(toRet._head), 0u);
+
+    #ifdef _DEBUG
+    toRet._typeName = typeName;
+    #endif
+
+    return toRet;
+}
+
+/*
+ * Copies the specified element onto the back of the
+ * given mpsc ring buffer; returns false if the buffer
+ * was full, true otherwise. Any thread
+ */
+bool _mpscRingBufferPushPtr(
+    MpscRingBuffer *bufferPtr,
+    const void *elementPtr,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _ringBufferPtrTypeCheck(typeName, bufferPtr);
+    #endif
+
+    size_t tail = atomic_load_explicit(
+        &(bufferPtr->_tail),
+        memory_order_relaxed
+    );
+    size_t index = 0u;
+    while(true){
+        index = tail & bufferPtr->_mask;
+        size_t sequence = atomic_load_explicit(
+            &(bufferPtr->_sequencePtr[index]),
+            memory_order_acquire
+        );
+        intptr_t difference
+            = (intptr_t)(sequence - tail);
+        /* slot is free for this lap; try to claim it */
+        if(difference == 0){
+            if(atomic_compare_exchange_weak_explicit(
+                &(bufferPtr->_tail),
+                &tail,
+                tail + 1u,
+                memory_order_relaxed,
+                memory_order_relaxed
+            )){
+                break;
+            }
+            /* tail was reloaded by the failed exchange */
+        }
+        /* slot still holds the previous lap; full */
+        else if(difference < 0){
+            return false;
+        }
+        /* another producer claimed it; reload */
+        else{
+            tail = atomic_load_explicit(
+                &(bufferPtr->_tail),
+                memory_order_relaxed
+            );
+        }
+    }
+
+    /* memcpy safe; ring and caller do not overlap */
+    memcpy(
+        voidPtrAdd(bufferPtr->_ptr, index * elementSize),
+        elementPtr,
+        elementSize
+    );
+    /* publish the slot to the consumer */
+    atomic_store_explicit(
+        &(bufferPtr->_sequencePtr[index]),
+        tail + 1u,
+        memory_order_release
+    );
+    return true;
+}
+
+/*
+ * Copies up to the specified number of elements onto
+ * the back of the given mpsc ring buffer as one
+ * contiguous run; returns the number of elements
+ * pushed. Any thread
+ */
+size_t _mpscRingBufferPushBatch(
+    MpscRingBuffer *bufferPtr,
+    const void *elementsPtr,
+    size_t count,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _ringBufferPtrTypeCheck(typeName, bufferPtr);
+    #endif
+
+    if(count == 0u){
+        return 0u;
+    }
+
+    size_t tail = atomic_load_explicit(
+        &(bufferPtr->_tail),
+        memory_order_relaxed
+    );
+    while(true){
+        /*
+         * the consumer releases slots before advancing
+         * head, so every slot below head + capacity is
+         * known to be writable
+         */
+        size_t head = atomic_load_explicit(
+            &(bufferPtr->_head),
+            memory_order_acquire
+        );
+        intptr_t usedCount
+            = (intptr_t)(tail - head);
+        /* tail went stale while others pushed */
+        if(usedCount < 0){
+            tail = atomic_load_explicit(
+                &(bufferPtr->_tail),
+                memory_order_relaxed
+            );
+            continue;
+        }
+        /* head may lag slots already handed back */
+        if((size_t)usedCount >= bufferPtr->_capacity){
+            return 0u;
+        }
+        size_t freeCount
+            = bufferPtr->_capacity - (size_t)usedCount;
+        if(freeCount < count){
+            count = freeCount;
+        }
+        /* claim the whole run at once */
+        if(atomic_compare_exchange_weak_explicit(
+            &(bufferPtr->_tail),
+            &tail,
+            tail + count,
+            memory_order_relaxed,
+            memory_order_relaxed
+        )){
+            break;
+        }
+    }
+
+    _ringBufferCopyIn(
+        bufferPtr->_ptr,
+        bufferPtr->_capacity,
+        tail & bufferPtr->_mask,
+        elementsPtr,
+        count,
+        elementSize
+    );
+    /* publish each slot to the consumer */
+    for(size_t i = 0u; i < count; ++i){
+        atomic_store_explicit(
+            &(bufferPtr->_sequencePtr[
+                (tail + i) & bufferPtr->_mask
+            ]),
+            tail + i + 1u,
+            memory_order_release
+        );
+    }
+    return count;
+}
+
+/*
+ * Moves up to the specified number of elements off
+ * the front of the given mpsc ring buffer into the
+ * given array; returns the number of elements popped.
+ * Consumer thread only
+ */
+size_t _mpscRingBufferPopBatch(
+    MpscRingBuffer *bufferPtr,
+    void *outPtr,
+    size_t maxCount,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _ringBufferPtrTypeCheck(typeName, bufferPtr);
+    #endif
+
+    /* only this thread writes head */
+    size_t head = atomic_load_explicit(
+        &(bufferPtr->_head),
+        memory_order_relaxed
+    );
+    size_t popCount = 0u;
+    while(popCount < maxCount){
+        size_t position = head + popCount;
+        size_t index = position & bufferPtr->_mask;
+        size_t sequence = atomic_load_explicit(
+            &(bufferPtr->_sequencePtr[index]),
+            memory_order_acquire
+        );
+        /* stop at the first slot not yet published */
+        if(sequence != position + 1u){
+            break;
+        }
+        /* memcpy safe; ring and caller do not overlap */
+        memcpy(
+            voidPtrAdd(outPtr, popCount * elementSize),
+            voidPtrAdd(
+                bufferPtr->_ptr,
+                index * elementSize
+            ),
+            elementSize
+        );
+        /* make the slot writable for the next lap */
+        atomic_store_explicit(
+            &(bufferPtr->_sequencePtr[index]),
+            position + bufferPtr->_capacity,
+            memory_order_release
+        );
+        ++popCount;
+    }
+    if(popCount > 0u){
+        atomic_store_explicit(
+            &(bufferPtr->_head),
+            head + popCount,
+            memory_order_release
+        );
+    }
+    return popCount;
+}
+
+/*
+ * Returns the number of elements in the given mpsc
+ * ring buffer; only a snapshot when called while
+ * other threads are using the buffer
+ */
+size_t mpscRingBufferSize(MpscRingBuffer *bufferPtr){
+    size_t head = atomic_load_explicit(
+        &(bufferPtr->_head),
+        memory_order_acquire
+    );
+    size_t tail = atomic_load_explicit(
+        &(bufferPtr->_tail),
+        memory_order_acquire
+    );
+    /* claimed slots may not be published yet */
+    return tail > head ? tail - head : 0u;
+}
+
+/* Frees the given mpsc ring buffer */
+void _mpscRingBufferFree(
+    MpscRingBuffer *bufferPtr
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+){
+    #ifdef _DEBUG
+    _ringBufferPtrTypeCheck(typeName, bufferPtr);
+    #endif
+
+    pgFree(bufferPtr->_ptr);
+    pgFree(bufferPtr->_sequencePtr);
+    bufferPtr->_capacity = 0u;
+    bufferPtr->_mask = 0u;
+    atomic_store(&(bufferPtr->_tail), 0u);
+    atomic_store(&(bufferPtr->_head), 0u);
+}
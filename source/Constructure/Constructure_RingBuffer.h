@@ -0,0 +1,570 @@
+#ifndef CONSTRUCTURE_RINGBUFFER_H
+#define CONSTRUCTURE_RINGBUFFER_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "PGUtil.h"
+
+/* padding used to keep hot indices on separate lines */
+#define ringBufferCacheLineSize 64
+
+/*
+ * A bounded lock-free queue for handing elements from
+ * exactly one producer thread to exactly one consumer
+ * thread; capacity is rounded up to a power of two.
+ * Must not be moved once shared between threads
+ */
+typedef struct SpscRingBuffer{
+    void *_ptr;
+    size_t _capacity;
+    size_t _mask;
+
+    #ifdef _DEBUG
+    /*
+     * Should only ever point to a string literal,
+     * thus should not be freed
+     */
+    const char *_typeName;
+    #endif
+
+    char _pad0[ringBufferCacheLineSize];
+    /* producer side; index of the next write */
+    atomic_size_t _tail;
+    /* producer copy of head to avoid cache misses */
+    size_t _cachedHead;
+
+    char _pad1[ringBufferCacheLineSize];
+    /* consumer side; index of the next read */
+    atomic_size_t _head;
+    /* consumer copy of tail to avoid cache misses */
+    size_t _cachedTail;
+
+    char _pad2[ringBufferCacheLineSize];
+} SpscRingBuffer;
+
+/*
+ * A bounded lock-free queue for handing elements from
+ * any number of producer threads to exactly one
+ * consumer thread; capacity is rounded up to a power
+ * of two. Must not be moved once shared between
+ * threads
+ */
+typedef struct MpscRingBuffer{
+    void *_ptr;
+    /*
+     * per slot sequence numbers; a slot for index i
+     * is writable when its sequence is i and
+     * readable when its sequence is i + 1
+     */
+    atomic_size_t *_sequencePtr;
+    size_t _capacity;
+    size_t _mask;
+
+    #ifdef _DEBUG
+    /*
+     * Should only ever point to a string literal,
+     * thus should not be freed
+     */
+    const char *_typeName;
+    #endif
+
+    char _pad0[ringBufferCacheLineSize];
+    /* shared by producers; index of the next write */
+    atomic_size_t _tail;
+
+    char _pad1[ringBufferCacheLineSize];
+    /* consumer side; index of the next read */
+    atomic_size_t _head;
+
+    char _pad2[ringBufferCacheLineSize];
+} MpscRingBuffer;
+
+#ifdef _DEBUG
+/*
+ * Asserts that the given type matches that of the
+ * given ring buffer pointer
+ */
+#define _ringBufferPtrTypeCheck(TYPENAME, BUFFERPTR) \
+    assertStringEqual( \
+        TYPENAME, \
+        (BUFFERPTR)->_typeName, \
+        "bad ring buffer type; " SRC_LOCATION \
+    )
+#endif
+
+/*
+ * Creates an spsc ring buffer holding at least the
+ * specified number of elements and returns it by
+ * value
+ */
+SpscRingBuffer _spscRingBufferMake(
+    size_t capacity,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+    PG_ALLOC_SITE_PARAM
+);
+
+#ifndef _DEBUG
+/*
+ * Creates an spsc ring buffer of the specified type
+ * and capacity and returns it by value
+ */
+#define spscRingBufferMake(TYPENAME, CAPACITY) \
+    _spscRingBufferMake( \
+        CAPACITY, \
+        sizeof(TYPENAME) \
+        PG_ALLOC_SITE_ARG \
+    )
+#else
+/*
+ * Creates an spsc ring buffer of the specified type
+ * and capacity and returns it by value
+ */
+#define spscRingBufferMake(TYPENAME, CAPACITY) \
+    _spscRingBufferMake( \
+        CAPACITY, \
+        sizeof(TYPENAME), \
+        #TYPENAME \
+        PG_ALLOC_SITE_ARG \
+    )
+#endif
+
+/*
+ * Copies up to the specified number of elements onto
+ * the back of the given spsc ring buffer; returns the
+ * number of elements pushed. Producer thread only
+ */
+size_t _spscRingBufferPushBatch(
+    SpscRingBuffer *bufferPtr,
+    const void *elementsPtr,
+    size_t count,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Copies up to the specified number of elements onto
+ * the back of the given spsc ring buffer of the
+ * specified type; returns the number pushed
+ */
+#define spscRingBufferPushBatch( \
+    TYPENAME, \
+    BUFFERPTR, \
+    ELEMENTSPTR, \
+    COUNT \
+) \
+    _Generic(*ELEMENTSPTR, \
+        TYPENAME: _spscRingBufferPushBatch( \
+            BUFFERPTR, \
+            ELEMENTSPTR, \
+            COUNT, \
+            sizeof(TYPENAME) \
+        ) \
+    )
+#else
+/*
+ * Copies up to the specified number of elements onto
+ * the back of the given spsc ring buffer of the
+ * specified type; returns the number pushed
+ */
+#define spscRingBufferPushBatch( \
+    TYPENAME, \
+    BUFFERPTR, \
+    ELEMENTSPTR, \
+    COUNT \
+) \
+    _Generic(*ELEMENTSPTR, \
+        TYPENAME: _spscRingBufferPushBatch( \
+            BUFFERPTR, \
+            ELEMENTSPTR, \
+            COUNT, \
+            sizeof(TYPENAME), \
+            #TYPENAME \
+        ) \
+    )
+#endif
+
+/*
+ * Copies the specified element onto the back of the
+ * given spsc ring buffer of the specified type;
+ * returns false if the buffer was full, true
+ * otherwise. Producer thread only
+ */
+#define spscRingBufferPushPtr( \
+    TYPENAME, \
+    BUFFERPTR, \
+    ELEMENTPTR \
+) \
+    (spscRingBufferPushBatch( \
+        TYPENAME, \
+        BUFFERPTR, \
+        ELEMENTPTR, \
+        1u \
+    ) == 1u)
+
+/*
+ * Moves up to the specified number of elements off
+ * the front of the given spsc ring buffer into the
+ * given array; returns the number of elements popped.
+ * Consumer thread only
+ */
+size_t _spscRingBufferPopBatch(
+    SpscRingBuffer *bufferPtr,
+    void *outPtr,
+    size_t maxCount,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Moves up to the specified number of elements off
+ * the front of the given spsc ring buffer of the
+ * specified type; returns the number popped
+ */
+#define spscRingBufferPopBatch( \
+    TYPENAME, \
+    BUFFERPTR, \
+    OUTPTR, \
+    MAXCOUNT \
+) \
+    _Generic(*OUTPTR, \
+        TYPENAME: _spscRingBufferPopBatch( \
+            BUFFERPTR, \
+            OUTPTR, \
+            MAXCOUNT, \
+            sizeof(TYPENAME) \
+        ) \
+    )
+#else
+/*
+ * Moves up to the specified number of elements off
+ * the front of the given spsc ring buffer of the
+ * specified type; returns the number popped
+ */
+#define spscRingBufferPopBatch( \
+    TYPENAME, \
+    BUFFERPTR, \
+    OUTPTR, \
+    MAXCOUNT \
+) \
+    _Generic(*OUTPTR, \
+        TYPENAME: _spscRingBufferPopBatch( \
+            BUFFERPTR, \
+            OUTPTR, \
+            MAXCOUNT, \
+            sizeof(TYPENAME), \
+            #TYPENAME \
+        ) \
+    )
+#endif
+
+/*
+ * Moves the front element of the given spsc ring
+ * buffer of the specified type into the given
+ * pointer; returns false if the buffer was empty,
+ * true otherwise. Consumer thread only
+ */
+#define spscRingBufferPopPtr(TYPENAME, BUFFERPTR, OUTPTR) \
+    (spscRingBufferPopBatch( \
+        TYPENAME, \
+        BUFFERPTR, \
+        OUTPTR, \
+        1u \
+    ) == 1u)
+
+/*
+ * Returns the number of elements in the given spsc
+ * ring buffer; only a snapshot when called while
+ * other threads are using the buffer
+ */
+size_t spscRingBufferSize(SpscRingBuffer *bufferPtr);
+
+/* Frees the given spsc ring buffer */
+void _spscRingBufferFree(
+    SpscRingBuffer *bufferPtr
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Frees the given spsc ring buffer of the specified
+ * type
+ */
+#define spscRingBufferFree(TYPENAME, BUFFERPTR) \
+    _spscRingBufferFree(BUFFERPTR)
+#else
+/*
+ * Frees the given spsc ring buffer of the specified
+ * type
+ */
+#define spscRingBufferFree(TYPENAME, BUFFERPTR) \
+    _spscRingBufferFree(BUFFERPTR, #TYPENAME)
+#endif
+
+/*
+ * Creates an mpsc ring buffer holding at least the
+ * specified number of elements and returns it by
+ * value
+ */
+MpscRingBuffer _mpscRingBufferMake(
+    size_t capacity,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+    PG_ALLOC_SITE_PARAM
+);
+
+#ifndef _DEBUG
+/*
+ * Creates an mpsc ring buffer of the specified type
+ * and capacity and returns it by value
+ */
+#define mpscRingBufferMake(TYPENAME, CAPACITY) \
+    _mpscRingBufferMake( \
+        CAPACITY, \
+        sizeof(TYPENAME) \
+        PG_ALLOC_SITE_ARG \
+    )
+#else
+/*
+ * Creates an mpsc ring buffer of the specified type
+ * and capacity and returns it by value
+ */
+#define mpscRingBufferMake(TYPENAME, CAPACITY) \
+    _mpscRingBufferMake( \
+        CAPACITY, \
+        sizeof(TYPENAME), \
+        #TYPENAME \
+        PG_ALLOC_SITE_ARG \
+    )
+#endif
+
+/*
+ * Copies the specified element onto the back of the
+ * given mpsc ring buffer; returns false if the buffer
+ * was full, true otherwise. Any thread
+ */
+bool _mpscRingBufferPushPtr(
+    MpscRingBuffer *bufferPtr,
+    const void *elementPtr,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Copies the specified element onto the back of the
+ * given mpsc ring buffer of the specified type;
+ * returns false if the buffer was full
+ */
+#define mpscRingBufferPushPtr( \
+    TYPENAME, \
+    BUFFERPTR, \
+    ELEMENTPTR \
+) \
+    _Generic(*ELEMENTPTR, \
+        TYPENAME: _mpscRingBufferPushPtr( \
+            BUFFERPTR, \
+            ELEMENTPTR, \
+            sizeof(TYPENAME) \
+        ) \
+    )
+#else
+/*
+ * Copies the specified element onto the back of the
+ * given mpsc ring buffer of the specified type;
+ * returns false if the buffer was full
+ */
+#define mpscRingBufferPushPtr( \
+    TYPENAME, \
+    BUFFERPTR, \
+    ELEMENTPTR \
+) \
+    _Generic(*ELEMENTPTR, \
+        TYPENAME: _mpscRingBufferPushPtr( \
+            BUFFERPTR, \
+            ELEMENTPTR, \
+            sizeof(TYPENAME), \
+            #TYPENAME \
+        ) \
+    )
+#endif
+
+/*
+ * Copies up to the specified number of elements onto
+ * the back of the given mpsc ring buffer as one
+ * contiguous run; returns the number of elements
+ * pushed. Any thread
+ */
+size_t _mpscRingBufferPushBatch(
+    MpscRingBuffer *bufferPtr,
+    const void *elementsPtr,
+    size_t count,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Copies up to the specified number of elements onto
+ * the back of the given mpsc ring buffer of the
+ * specified type; returns the number pushed
+ */
+#define mpscRingBufferPushBatch( \
+    TYPENAME, \
+    BUFFERPTR, \
+    ELEMENTSPTR, \
+    COUNT \
+) \
+    _Generic(*ELEMENTSPTR, \
+        TYPENAME: _mpscRingBufferPushBatch( \
+            BUFFERPTR, \
+            ELEMENTSPTR, \
+            COUNT, \
+            sizeof(TYPENAME) \
+        ) \
+    )
+#else
+/*
+ * Copies up to the specified number of elements onto
+ * the back of the given mpsc ring buffer of the
+ * specified type; returns the number pushed
+ */
+#define mpscRingBufferPushBatch( \
+    TYPENAME, \
+    BUFFERPTR, \
+    ELEMENTSPTR, \
+    COUNT \
+) \
+    _Generic(*ELEMENTSPTR, \
+        TYPENAME: _mpscRingBufferPushBatch( \
+            BUFFERPTR, \
+            ELEMENTSPTR, \
+            COUNT, \
+            sizeof(TYPENAME), \
+            #TYPENAME \
+        ) \
+    )
+#endif
+
+/*
+ * Moves up to the specified number of elements off
+ * the front of the given mpsc ring buffer into the
+ * given array; returns the number of elements popped.
+ * Consumer thread only
+ */
+size_t _mpscRingBufferPopBatch(
+    MpscRingBuffer *bufferPtr,
+    void *outPtr,
+    size_t maxCount,
+    size_t elementSize
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Moves up to the specified number of elements off
+ * the front of the given mpsc ring buffer of the
+ * specified type; returns the number popped
+ */
+#define mpscRingBufferPopBatch( \
+    TYPENAME, \
+    BUFFERPTR, \
+    OUTPTR, \
+    MAXCOUNT \
+) \
+    _Generic(*OUTPTR, \
+        TYPENAME: _mpscRingBufferPopBatch( \
+            BUFFERPTR, \
+            OUTPTR, \
+            MAXCOUNT, \
+            sizeof(TYPENAME) \
+        ) \
+    )
+#else
+/*
+ * Moves up to the specified number of elements off
+ * the front of the given mpsc ring buffer of the
+ * specified type; returns the number popped
+ */
+#define mpscRingBufferPopBatch( \
+    TYPENAME, \
+    BUFFERPTR, \
+    OUTPTR, \
+    MAXCOUNT \
+) \
+    _Generic(*OUTPTR, \
+        TYPENAME: _mpscRingBufferPopBatch( \
+            BUFFERPTR, \
+            OUTPTR, \
+            MAXCOUNT, \
+            sizeof(TYPENAME), \
+            #TYPENAME \
+        ) \
+    )
+#endif
+
+/*
+ * Moves the front element of the given mpsc ring
+ * buffer of the specified type into the given
+ * pointer; returns false if the buffer was empty,
+ * true otherwise. Consumer thread only
+ */
+#define mpscRingBufferPopPtr(TYPENAME, BUFFERPTR, OUTPTR) \
+    (mpscRingBufferPopBatch( \
+        TYPENAME, \
+        BUFFERPTR, \
+        OUTPTR, \
+        1u \
+    ) == 1u)
+
+/*
+ * Returns the number of elements in the given mpsc
+ * ring buffer; only a snapshot when called while
+ * other threads are using the buffer
+ */
+size_t mpscRingBufferSize(MpscRingBuffer *bufferPtr);
+
+/* Frees the given mpsc ring buffer */
+void _mpscRingBufferFree(
+    MpscRingBuffer *bufferPtr
+    #ifdef _DEBUG
+    , const char *typeName
+    #endif
+);
+
+#ifndef _DEBUG
+/*
+ * Frees the given mpsc ring buffer of the specified
+ * type
+ */
+#define mpscRingBufferFree(TYPENAME, BUFFERPTR) \
+    _mpscRingBufferFree(BUFFERPTR)
+#else
+/*
+ * Frees the given mpsc ring buffer of the specified
+ * type
+ */
+#define mpscRingBufferFree(TYPENAME, BUFFERPTR) \
+    _mpscRingBufferFree(BUFFERPTR, #TYPENAME)
+#endif
+
+#endif
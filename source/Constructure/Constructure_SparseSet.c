@@ -11,6 +11,7 @@ SparseSet _sparseSetMake(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     assertTrue(
         sparseCapacity > 0u, 
@@ -29,9 +30,10 @@ SparseSet _sparseSetMake(
     }
 
     /* init sparse to invalid */
-    toRet._sparsePtr = pgAlloc(
+    toRet._sparsePtr = pgAllocAt(
         sparseCapacity, 
-        sizeof(size_t)
+        sizeof(size_t),
+        allocSite
     );
     memset(
         toRet._sparsePtr, 
@@ -40,15 +42,17 @@ SparseSet _sparseSetMake(
     );
 
     /* allocate dense */
-    toRet._densePtr = pgAlloc(
+    toRet._densePtr = pgAllocAt(
         initDenseCapacity,
-        elementSize
+        elementSize,
+        allocSite
     );
 
     /* allocate reflect */
-    toRet._reflectPtr = pgAlloc(
+    toRet._reflectPtr = pgAllocAt(
         initDenseCapacity,
-        sizeof(*(toRet._reflectPtr))
+        sizeof(*(toRet._reflectPtr)),
+        allocSite
     );
 
     toRet.sparseCapacity = sparseCapacity;
@@ -72,6 +76,7 @@ SparseSet _sparseSetCopy(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     #ifdef _DEBUG
     _sparseSetPtrTypeCheck(typeName, toCopyPtr);
@@ -81,17 +86,20 @@ SparseSet _sparseSetCopy(
     toRet.sparseCapacity = toCopyPtr->sparseCapacity;
     toRet._denseCapacity = toCopyPtr->_denseCapacity;
     toRet._size = toCopyPtr->_size;
-    toRet._sparsePtr = pgAlloc(
+    toRet._sparsePtr = pgAllocAt(
         toRet.sparseCapacity,
-        sizeof(size_t)
+        sizeof(size_t),
+        allocSite
     );
-    toRet._densePtr = pgAlloc(
+    toRet._densePtr = pgAllocAt(
         toRet._denseCapacity,
-        elementSize
+        elementSize,
+        allocSite
     );
-    toRet._reflectPtr = pgAlloc(
+    toRet._reflectPtr = pgAllocAt(
         toRet._denseCapacity,
-        sizeof(size_t)
+        sizeof(size_t),
+        allocSite
     );
 
     /* may overflow */
@@ -225,6 +233,7 @@ void *_sparseSetGetPtr(
 bool _sparseSetGrowIfNeeded(
     SparseSet *setPtr,
     size_t elementSize
+    PG_ALLOC_SITE_PARAM
 ){
     enum{ growRatio = 2u };
 
@@ -250,19 +259,21 @@ bool _sparseSetGrowIfNeeded(
                 = setPtr->sparseCapacity;
         }
         /* realloc the dense array */
-        setPtr->_densePtr = pgRealloc(
+        setPtr->_densePtr = pgReallocAt(
             setPtr->_densePtr,
             setPtr->_denseCapacity,
-            elementSize
+            elementSize,
+            allocSite
         );
         if(!(setPtr->_densePtr)){
             return false;
         }
         /* realloc the reflect array */
-        setPtr->_reflectPtr = pgRealloc(
+        setPtr->_reflectPtr = pgReallocAt(
             setPtr->_reflectPtr,
             setPtr->_denseCapacity,
-            sizeof(*(setPtr->_reflectPtr))
+            sizeof(*(setPtr->_reflectPtr)),
+            allocSite
         );
         if(!(setPtr->_reflectPtr)){
             return false;
@@ -285,6 +296,7 @@ void _sparseSetSetPtr(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 ){
     #ifdef _DEBUG
     _sparseSetPtrTypeCheck(typeName, setPtr);
@@ -316,7 +328,11 @@ void _sparseSetSetPtr(
 
     /* grow dense and reflect arrays if needed */
     assertTrue(
-        _sparseSetGrowIfNeeded(setPtr, elementSize),
+        _sparseSetGrowIfNeeded(
+            setPtr,
+            elementSize
+            PG_ALLOC_SITE_FORWARD
+        ),
         "sparse set failed to grow; " SRC_LOCATION
     );
 
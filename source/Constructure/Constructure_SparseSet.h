@@ -57,6 +57,7 @@ SparseSet _sparseSetMake(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -73,6 +74,7 @@ SparseSet _sparseSetMake(
         SPARSECAPACITY, \
         INITDENSECAPACITY, \
         sizeof(TYPENAME) \
+        PG_ALLOC_SITE_ARG \
     )
 #else
 /* 
@@ -89,6 +91,7 @@ SparseSet _sparseSetMake(
         INITDENSECAPACITY, \
         sizeof(TYPENAME), \
         #TYPENAME \
+        PG_ALLOC_SITE_ARG \
     )
 #endif
 
@@ -102,6 +105,7 @@ SparseSet _sparseSetCopy(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -111,7 +115,11 @@ SparseSet _sparseSetCopy(
  * it by value
  */
 #define sparseSetCopy(TYPENAME, TOCOPYPTR) \
-    _sparseSetCopy(sizeof(TYPENAME), TOCOPYPTR)
+    _sparseSetCopy( \
+        sizeof(TYPENAME), \
+        TOCOPYPTR \
+        PG_ALLOC_SITE_ARG \
+    )
 #else
 /*
  * Makes a one level deep copy of the given
@@ -123,6 +131,7 @@ SparseSet _sparseSetCopy(
         sizeof(TYPENAME), \
         TOCOPYPTR, \
         #TYPENAME \
+        PG_ALLOC_SITE_ARG \
     )
 #endif
 
@@ -268,6 +277,7 @@ void *_sparseSetGetPtr(
 bool _sparseSetGrowIfNeeded(
     SparseSet *setPtr,
     size_t elementSize
+    PG_ALLOC_SITE_PARAM
 );
 
 /* 
@@ -283,6 +293,7 @@ void _sparseSetSetPtr(
     #ifdef _DEBUG 
     , const char *typeName 
     #endif
+    PG_ALLOC_SITE_PARAM
 );
 
 #ifndef _DEBUG
@@ -297,12 +308,13 @@ void _sparseSetSetPtr(
     SPARSEINDEX, \
     VALUEPTR \
 ) \
-    _Generic(*ELEMENTPTR, \
+    _Generic(*VALUEPTR, \
         TYPENAME: _sparseSetSetPtr( \
             SETPTR, \
             SPARSEINDEX, \
             VALUEPTR, \
             sizeof(TYPENAME) \
+            PG_ALLOC_SITE_ARG \
         ) \
     )
 #else
@@ -324,6 +336,7 @@ void _sparseSetSetPtr(
             VALUEPTR, \
             sizeof(TYPENAME), \
             #TYPENAME \
+            PG_ALLOC_SITE_ARG \
         ) \
     )
 #endif
@@ -362,6 +375,7 @@ void _sparseSetSetPtr(
             _sparseSetGrowIfNeeded( \
                 SETPTR, \
                 sizeof(TYPENAME) \
+                PG_ALLOC_SITE_ARG \
             ), \
             "sparse set failed to grow; " \
             SRC_LOCATION \
@@ -406,6 +420,7 @@ void _sparseSetSetPtr(
             _sparseSetGrowIfNeeded( \
                 SETPTR, \
                 sizeof(TYPENAME) \
+                PG_ALLOC_SITE_ARG \
             ), \
             "sparse set failed to grow; " \
             SRC_LOCATION \
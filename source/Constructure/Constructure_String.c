@@ -2,6 +2,10 @@
 
 #include "ZMath.h"
 
+/* Evaluates to a pointer to the chars of a string */
+#define getChars(STRINGPTR) \
+    _constructureStringChars(STRINGPTR)
+
 /*
  * Unlike the generic containers in the rest
  * of Constructure, the String types will
@@ -40,6 +44,84 @@ size_t _##PREFIX##CLength( \
     return charCount; \
 } \
 \
+/* \
+ * Sets the capacity of the given unmade string \
+ * to fit the requested number of characters \
+ * including the null terminator, allocating \
+ * only if they do not fit inline \
+ */ \
+static void _##PREFIX##Reserve( \
+    TYPENAME *stringPtr, \
+    size_t capacity \
+){ \
+    size_t inlineCapacity \
+        = _constructureStringInlineCapacity( \
+            stringPtr \
+        ); \
+    if(capacity <= inlineCapacity){ \
+        stringPtr->_capacity = inlineCapacity; \
+        return; \
+    } \
+    stringPtr->_capacity = capacity; \
+    stringPtr->_storage._ptr = (CHARTYPE *)pgAlloc( \
+        capacity, \
+        sizeof(CHARTYPE) \
+    ); \
+} \
+\
+/* \
+ * Grows the given string to the specified \
+ * capacity, moving it from inline storage to \
+ * the heap if needed; returns false as error \
+ * code, true otherwise \
+ */ \
+static bool _##PREFIX##Realloc( \
+    TYPENAME *stringPtr, \
+    size_t newCapacity \
+){ \
+    if(newCapacity <= stringPtr->_capacity){ \
+        return true; \
+    } \
+    size_t inlineCapacity \
+        = _constructureStringInlineCapacity( \
+            stringPtr \
+        ); \
+    /* only an unmade string can be below inline */ \
+    if(newCapacity <= inlineCapacity){ \
+        stringPtr->_capacity = inlineCapacity; \
+        return true; \
+    } \
+    if(_constructureStringIsInline(stringPtr)){ \
+        /* promote inline chars to the heap */ \
+        CHARTYPE *heapPtr = (CHARTYPE *)pgAlloc( \
+            newCapacity, \
+            sizeof(CHARTYPE) \
+        ); \
+        if(!heapPtr){ \
+            return false; \
+        } \
+        memcpy( \
+            heapPtr, \
+            stringPtr->_storage._inline, \
+            sizeof(stringPtr->_storage._inline) \
+        ); \
+        stringPtr->_storage._ptr = heapPtr; \
+    } \
+    else{ \
+        CHARTYPE *heapPtr = (CHARTYPE *)pgRealloc( \
+            stringPtr->_storage._ptr, \
+            newCapacity, \
+            sizeof(CHARTYPE) \
+        ); \
+        if(!heapPtr){ \
+            return false; \
+        } \
+        stringPtr->_storage._ptr = heapPtr; \
+    } \
+    stringPtr->_capacity = newCapacity; \
+    return true; \
+} \
+\
 /* \
  * Creates a string copy of the given null \
  * terminated C string of the character type \
@@ -51,12 +133,9 @@ TYPENAME PREFIX##MakeC( \
     TYPENAME toRet = {0}; \
     toRet.length \
         = _##PREFIX##CLength(cStringPtr); \
-    toRet._capacity = lengthIncludingNull( \
-        toRet.length \
-    ); \
-    toRet._ptr = (CHARTYPE *)pgAlloc( \
-        toRet._capacity,  \
-        sizeof(CHARTYPE) \
+    _##PREFIX##Reserve( \
+        &toRet, \
+        lengthIncludingNull(toRet.length) \
     ); \
 \
     /*  \
@@ -65,9 +144,10 @@ TYPENAME PREFIX##MakeC( \
      * are already stored \
      */ \
     memcpy( \
-        toRet._ptr,  \
+        getChars(&toRet),  \
         cStringPtr,  \
-        toRet._capacity * sizeof(CHARTYPE) \
+        lengthIncludingNull(toRet.length) \
+            * sizeof(CHARTYPE) \
     ); \
     return toRet; \
 } \
@@ -90,12 +170,9 @@ TYPENAME PREFIX##MakeCLength( \
         toCopyLength, \
         maxCharsCopied \
     ); \
-    toRet._capacity = lengthIncludingNull( \
-        toRet.length \
-    ); \
-    toRet._ptr = (CHARTYPE *)pgAlloc( \
-        toRet._capacity,  \
-        sizeof(CHARTYPE) \
+    _##PREFIX##Reserve( \
+        &toRet, \
+        lengthIncludingNull(toRet.length) \
     ); \
 \
     /*  \
@@ -104,7 +181,7 @@ TYPENAME PREFIX##MakeCLength( \
      * are already stored \
      */ \
     memcpy( \
-        toRet._ptr,  \
+        getChars(&toRet),  \
         cStringPtr,  \
         toRet.length * sizeof(CHARTYPE) \
     ); \
@@ -121,16 +198,14 @@ TYPENAME PREFIX##MakeCharC( \
 ){ \
     TYPENAME toRet = {0}; \
     toRet.length = strlen(cStringPtr); \
-    toRet._capacity = lengthIncludingNull( \
-        toRet.length \
-    ); \
-    toRet._ptr = (CHARTYPE *)pgAlloc( \
-        toRet._capacity,  \
-        sizeof(CHARTYPE) \
+    _##PREFIX##Reserve( \
+        &toRet, \
+        lengthIncludingNull(toRet.length) \
     ); \
     /* copy chars 1 by 1 into possibly larger type */ \
+    CHARTYPE *charPtr = getChars(&toRet); \
     for(size_t i = 0; i < toRet.length; ++i){ \
-        toRet._ptr[i] = cStringPtr[i]; \
+        charPtr[i] = cStringPtr[i]; \
     } \
     return toRet; \
 } \
@@ -152,16 +227,14 @@ TYPENAME PREFIX##MakeCharCLength( \
         toCopyLength, \
         maxCharsCopied \
     ); \
-    toRet._capacity = lengthIncludingNull( \
-        toRet.length \
-    ); \
-    toRet._ptr = (CHARTYPE *)pgAlloc( \
-        toRet._capacity,  \
-        sizeof(CHARTYPE) \
+    _##PREFIX##Reserve( \
+        &toRet, \
+        lengthIncludingNull(toRet.length) \
     ); \
     /* copy chars 1 by 1 into possibly larger type */ \
+    CHARTYPE *charPtr = getChars(&toRet); \
     for(size_t i = 0; i < toRet.length; ++i){ \
-        toRet._ptr[i] = cStringPtr[i]; \
+        charPtr[i] = cStringPtr[i]; \
     } \
     return toRet; \
 } \
@@ -181,11 +254,7 @@ TYPENAME PREFIX##MakeAndReserve( \
     ); \
     TYPENAME toRet = {0}; \
     toRet.length = 0u; \
-    toRet._capacity = initCapacity; \
-    toRet._ptr = (CHARTYPE *)pgAlloc( \
-        toRet._capacity,  \
-        sizeof(CHARTYPE) \
-    ); \
+    _##PREFIX##Reserve(&toRet, initCapacity); \
     return toRet; \
 } \
 \
@@ -212,14 +281,11 @@ TYPENAME PREFIX##Copy( \
 \
     /*  \
      * allocate just enough space for  \
-     * the copy  \
+     * the copy if it does not fit inline \
      */ \
-    toRet._capacity = lengthIncludingNull( \
-        toRet.length \
-    ); \
-    toRet._ptr = (CHARTYPE *)pgAlloc( \
-        toRet._capacity,  \
-        sizeof(CHARTYPE) \
+    _##PREFIX##Reserve( \
+        &toRet, \
+        lengthIncludingNull(toRet.length) \
     ); \
 \
     /*  \
@@ -228,9 +294,10 @@ TYPENAME PREFIX##Copy( \
      * are already stored \
      */ \
     memcpy( \
-        toRet._ptr,  \
-        toCopyPtr->_ptr,  \
-        toRet._capacity * sizeof(CHARTYPE) \
+        getChars(&toRet),  \
+        getChars(toCopyPtr),  \
+        lengthIncludingNull(toRet.length) \
+            * sizeof(CHARTYPE) \
     ); \
 \
     return toRet; \
@@ -245,16 +312,14 @@ void PREFIX##CopyInto( \
     const TYPENAME *srcPtr \
 ){ \
     /* allocate more space if needed */ \
-    if(destPtr->_capacity <= srcPtr->length){ \
-        destPtr->_capacity = lengthIncludingNull( \
-            srcPtr->length \
-        ); \
-        destPtr->_ptr = (CHARTYPE *)pgRealloc( \
-            destPtr->_ptr, \
-            destPtr->_capacity, \
-            sizeof(CHARTYPE) \
-        ); \
-    } \
+    assertTrue( \
+        _##PREFIX##Realloc( \
+            destPtr, \
+            lengthIncludingNull(srcPtr->length) \
+        ), \
+        "failed to grow for CopyInto; " \
+        SRC_LOCATION \
+    ); \
 \
     /*  \
      * use memcpy instead of a custom \
@@ -262,9 +327,10 @@ void PREFIX##CopyInto( \
      * are already stored \
      */ \
     memcpy( \
-        destPtr->_ptr,  \
-        srcPtr->_ptr,  \
-        srcPtr->_capacity * sizeof(CHARTYPE) \
+        getChars(destPtr),  \
+        getChars(srcPtr),  \
+        lengthIncludingNull(srcPtr->length) \
+            * sizeof(CHARTYPE) \
     ); \
     destPtr->length = srcPtr->length; \
 } \
@@ -287,7 +353,7 @@ void PREFIX##Clear( \
     TYPENAME *stringPtr \
 ){ \
     memset( \
-        stringPtr->_ptr, \
+        getChars(stringPtr), \
         0u, \
         stringPtr->_capacity * sizeof(CHARTYPE) \
     ); \
@@ -304,17 +370,10 @@ bool _##PREFIX##GrowToFitNewLength( \
     TYPENAME *stringPtr \
 ){ \
     if(stringPtr->length >= stringPtr->_capacity){ \
-        stringPtr->_capacity = lengthIncludingNull( \
-            stringPtr->length \
-        ); \
-        stringPtr->_ptr = (CHARTYPE *)pgRealloc( \
-            stringPtr->_ptr, \
-            stringPtr->_capacity, \
-            sizeof(CHARTYPE) \
+        return _##PREFIX##Realloc( \
+            stringPtr, \
+            lengthIncludingNull(stringPtr->length) \
         ); \
-        if(!(stringPtr->_ptr)){ \
-            return false; \
-        } \
     } \
     return true; \
 } \
@@ -331,16 +390,10 @@ bool _##PREFIX##GrowIfNeeded( \
     if(lengthIncludingNull(stringPtr->length) \
         >= stringPtr->_capacity \
     ){ \
-        stringPtr->_capacity *= growRatio; \
-        ++(stringPtr->_capacity); \
-        stringPtr->_ptr = (CHARTYPE *)pgRealloc( \
-            stringPtr->_ptr, \
-            stringPtr->_capacity, \
-            sizeof(CHARTYPE) \
+        return _##PREFIX##Realloc( \
+            stringPtr, \
+            (stringPtr->_capacity * growRatio) + 1u \
         ); \
-        if(!(stringPtr->_ptr)){ \
-            return false; \
-        } \
     } \
     return true;   \
 } \
@@ -357,7 +410,7 @@ void _##PREFIX##PrependHelper( \
     size_t toPrependLength \
 ){ \
     assertFalse( \
-        stringPtr->_ptr == toPrependPtr, \
+        getChars(stringPtr) == toPrependPtr, \
         "do not pass in the same string; " \
         SRC_LOCATION \
     ); \
@@ -377,15 +430,15 @@ void _##PREFIX##PrependHelper( \
     ); \
 \
     memmove( \
-        stringPtr->_ptr + toPrependLength, \
-        stringPtr->_ptr, \
+        getChars(stringPtr) + toPrependLength, \
+        getChars(stringPtr), \
         /* copy null */ \
         lengthIncludingNull(originalLength) \
             * sizeof(CHARTYPE) \
     ); \
     /* use memcpy; length is known */ \
     memcpy( \
-        stringPtr->_ptr,  \
+        getChars(stringPtr),  \
         toPrependPtr, \
         /* do not copy null */ \
         toPrependLength * sizeof(CHARTYPE) \
@@ -428,7 +481,7 @@ void PREFIX##Prepend( \
 \
    _##PREFIX##PrependHelper( \
         stringPtr, \
-        toPrependPtr->_ptr, \
+        getChars(toPrependPtr), \
         toPrependPtr->length \
     ); \
 } \
@@ -445,7 +498,7 @@ void _##PREFIX##AppendHelper( \
     size_t toAppendLength \
 ){ \
     assertFalse( \
-        stringPtr->_ptr == toAppendPtr, \
+        getChars(stringPtr) == toAppendPtr, \
         "do not pass in the same string; " \
         SRC_LOCATION \
     ); \
@@ -466,7 +519,7 @@ void _##PREFIX##AppendHelper( \
 \
     /* use memcpy; length is known */ \
     memcpy( \
-        stringPtr->_ptr + originalLength, \
+        getChars(stringPtr) + originalLength, \
         toAppendPtr, \
         /* copy null */ \
         lengthIncludingNull(toAppendLength) \
@@ -510,7 +563,7 @@ void PREFIX##Append( \
 \
     _##PREFIX##AppendHelper( \
         stringPtr, \
-        toAppendPtr->_ptr, \
+        getChars(toAppendPtr), \
         toAppendPtr->length \
     ); \
 } \
@@ -528,7 +581,7 @@ void _##PREFIX##WriteNull( \
         SRC_LOCATION \
     ); \
 \
-    (stringPtr->_ptr)[stringPtr->length] = 0u; \
+    getChars(stringPtr)[stringPtr->length] = 0u; \
 } \
 \
 /* \
@@ -546,7 +599,7 @@ void PREFIX##PushBack( \
     ); \
 \
     /* overwrite current null terminator */ \
-    (stringPtr->_ptr)[stringPtr->length] = toPush; \
+    getChars(stringPtr)[stringPtr->length] = toPush; \
     ++(stringPtr->length); \
 \
     /* write new null terminator */ \
@@ -588,8 +641,8 @@ void PREFIX##EraseChar( \
     /* move all later characters 1 forward */ \
     /* length is 1 if we remove back */ \
     memmove( \
-        stringPtr->_ptr + index, \
-        stringPtr->_ptr + (index + 1u), \
+        getChars(stringPtr) + index, \
+        getChars(stringPtr) + (index + 1u), \
         /* move null terminator forward also */ \
         sizeof(CHARTYPE) * lengthIncludingNull( \
             stringPtr->length - index \
@@ -610,7 +663,7 @@ CHARTYPE PREFIX##CharAt( \
         "bad index; " SRC_LOCATION \
     ); \
 \
-    return (stringPtr->_ptr)[index]; \
+    return getChars(stringPtr)[index]; \
 } \
 \
 /* \
@@ -625,7 +678,7 @@ CHARTYPE PREFIX##Front( \
         "empty in Front; " SRC_LOCATION \
     ); \
 \
-    return (stringPtr->_ptr)[0u]; \
+    return getChars(stringPtr)[0u]; \
 } \
 \
 /* \
@@ -640,7 +693,7 @@ CHARTYPE PREFIX##Back( \
         "empty in Back; " SRC_LOCATION \
     ); \
 \
-    return (stringPtr->_ptr)[ \
+    return getChars(stringPtr)[ \
         stringPtr->length - 1u \
     ]; \
 } \
@@ -660,7 +713,7 @@ void PREFIX##SetChar( \
         "bad index; " SRC_LOCATION \
     ); \
 \
-    (stringPtr->_ptr)[index] = newValue; \
+    getChars(stringPtr)[index] = newValue; \
 } \
 \
 /* \
@@ -687,8 +740,8 @@ void PREFIX##InsertChar( \
     /* move all later characters 1 back */ \
     /* length is 1 if we insert as new back */ \
     memmove( \
-        stringPtr->_ptr + (index + 1u), \
-        stringPtr->_ptr + index, \
+        getChars(stringPtr) + (index + 1u), \
+        getChars(stringPtr) + index, \
         /* move null terminator back also */ \
         sizeof(CHARTYPE) * lengthIncludingNull( \
             stringPtr->length - index \
@@ -697,7 +750,7 @@ void PREFIX##InsertChar( \
     ++(stringPtr->length); \
 \
     /* insert the new character */ \
-    (stringPtr->_ptr)[index] = toInsert;     \
+    getChars(stringPtr)[index] = toInsert;     \
 } \
 \
 /* \
@@ -715,7 +768,7 @@ void _##PREFIX##InsertHelper( \
     size_t toInsertLength \
 ){ \
     assertFalse( \
-        stringPtr->_ptr == toInsertPtr, \
+        getChars(stringPtr) == toInsertPtr, \
         "do not pass in the same string; " \
         SRC_LOCATION \
     ); \
@@ -745,9 +798,9 @@ void _##PREFIX##InsertHelper( \
      */ \
     /* length is 1 if we insert at the back */ \
     memmove( \
-        stringPtr->_ptr  \
+        getChars(stringPtr)  \
             + (startingIndex + toInsertLength), \
-        stringPtr->_ptr + startingIndex, \
+        getChars(stringPtr) + startingIndex, \
         /* move null terminator back also */ \
         sizeof(CHARTYPE) * lengthIncludingNull( \
             originalLength - startingIndex \
@@ -757,7 +810,7 @@ void _##PREFIX##InsertHelper( \
     /* copy in the insertion */ \
     /* use memmove just to be safe */ \
     memmove( \
-        stringPtr->_ptr + (startingIndex), \
+        getChars(stringPtr) + (startingIndex), \
         toInsertPtr, \
         toInsertLength * sizeof(CHARTYPE) \
     ); \
@@ -806,7 +859,7 @@ void PREFIX##Insert( \
     _##PREFIX##InsertHelper( \
         stringPtr, \
         startingIndex, \
-        toInsertPtr->_ptr, \
+        getChars(toInsertPtr), \
         toInsertPtr->length \
     ); \
 } \
@@ -827,7 +880,7 @@ size_t PREFIX##IndexOfChar( \
         i < stringPtr->length;  \
         ++i \
     ){ \
-        if((stringPtr->_ptr)[i] == toFind){ \
+        if(getChars(stringPtr)[i] == toFind){ \
             return i; \
         } \
     } \
@@ -860,7 +913,7 @@ size_t PREFIX##LastIndexOfChar( \
         i != SIZE_MAX; \
         --i \
     ){ \
-        if((stringPtr->_ptr)[i] == toFind){ \
+        if(getChars(stringPtr)[i] == toFind){ \
             return i; \
         } \
     } \
@@ -895,10 +948,10 @@ size_t _##PREFIX##IndexOfHelper( \
         ++i \
     ){ \
         /* check if the first character matches*/ \
-        if((stringPtr->_ptr[i]) == *targetPtr){ \
+        if(getChars(stringPtr)[i] == *targetPtr){ \
             /* check every other character */ \
             for(j = 1u; j < subLength; ++j){ \
-                if(stringPtr->_ptr[i + j]  \
+                if(getChars(stringPtr)[i + j]  \
                     != targetPtr[j] \
                 ){ \
                     break; \
@@ -944,7 +997,7 @@ size_t PREFIX##IndexOf( \
 ){ \
     return _##PREFIX##IndexOfHelper( \
         stringPtr, \
-        targetPtr->_ptr, \
+        getChars(targetPtr), \
         targetPtr->length \
     ); \
 } \
@@ -981,10 +1034,10 @@ size_t _##PREFIX##LastIndexOfHelper( \
         --i \
     ){ \
         /* check if the first character matches*/ \
-        if((stringPtr->_ptr[i]) == *targetPtr){ \
+        if(getChars(stringPtr)[i] == *targetPtr){ \
             /* check every other character */ \
             for(j = 1u; j < subLength; ++j){ \
-                if(stringPtr->_ptr[i + j]  \
+                if(getChars(stringPtr)[i + j]  \
                     != targetPtr[j] \
                 ){ \
                     break; \
@@ -1030,7 +1083,7 @@ size_t PREFIX##LastIndexOf( \
 ){ \
     return _##PREFIX##LastIndexOfHelper( \
         stringPtr, \
-        targetPtr->_ptr, \
+        getChars(targetPtr), \
         targetPtr->length \
     ); \
 } \
@@ -1044,7 +1097,7 @@ bool PREFIX##BeginsWithChar( \
     CHARTYPE toTest \
 ){ \
     return stringPtr->length > 0u  \
-        && stringPtr->_ptr[0u] == toTest; \
+        && getChars(stringPtr)[0u] == toTest; \
 } \
 \
 /* \
@@ -1056,7 +1109,7 @@ bool PREFIX##EndsWithChar( \
     CHARTYPE toTest \
 ){ \
     return stringPtr->length > 0u && ( \
-        stringPtr->_ptr[stringPtr->length - 1u] \
+        getChars(stringPtr)[stringPtr->length - 1u] \
             == toTest \
     ); \
 } \
@@ -1079,7 +1132,7 @@ bool _##PREFIX##BeginsWithHelper( \
     } \
 \
     for(size_t i = 0u; i < toTestLength; ++i){ \
-        if(stringPtr->_ptr[i] != toTestPtr[i]){ \
+        if(getChars(stringPtr)[i] != toTestPtr[i]){ \
             return false; \
         } \
     } \
@@ -1114,7 +1167,7 @@ bool PREFIX##BeginsWith( \
 ){ \
     return _##PREFIX##BeginsWithHelper( \
         stringPtr, \
-        toTestPtr->_ptr, \
+        getChars(toTestPtr), \
         toTestPtr->length \
     ); \
 } \
@@ -1144,7 +1197,7 @@ bool _##PREFIX##EndsWithHelper( \
         i < toTestLength;  \
         ++i, ++checkIndex \
     ){ \
-        if(stringPtr->_ptr[checkIndex]  \
+        if(getChars(stringPtr)[checkIndex]  \
             != toTestPtr[i] \
         ){ \
             return false; \
@@ -1181,7 +1234,7 @@ bool PREFIX##EndsWith( \
 ){ \
     return _##PREFIX##EndsWithHelper( \
         stringPtr, \
-        toTestPtr->_ptr, \
+        getChars(toTestPtr), \
         toTestPtr->length \
     ); \
 } \
@@ -1222,11 +1275,13 @@ TYPENAME PREFIX##Substring( \
     ); \
     toRet.length = subLength; \
 \
-    for(size_t i = 0u; i < subLength; ++i){ \
-        toRet._ptr[i] = stringPtr->_ptr[ \
-            startIndexInclusive + i \
-        ]; \
-    } \
+    /* memcpy safe; strings do not overlap */ \
+    memcpy( \
+        getChars(&toRet), \
+        getChars(stringPtr) \
+            + startIndexInclusive, \
+        subLength * sizeof(CHARTYPE) \
+    ); \
 \
     return toRet; \
 } \
@@ -1282,8 +1337,8 @@ int PREFIX##Compare( \
     const TYPENAME *stringPtr2 \
 ){ \
     return _##PREFIX##CCompare( \
-        stringPtr1->_ptr, \
-        stringPtr2->_ptr \
+        getChars(stringPtr1), \
+        getChars(stringPtr2) \
     ); \
 } \
 \
@@ -1307,8 +1362,8 @@ bool PREFIX##Equals( \
      * map 0 to true (1) and !0 to false (0) \
      */ \
     return !_##PREFIX##CCompare( \
-        stringPtr1->_ptr, \
-        stringPtr2->_ptr \
+        getChars(stringPtr1), \
+        getChars(stringPtr2) \
     ); \
 } \
 \
@@ -1316,7 +1371,9 @@ bool PREFIX##Equals( \
 void PREFIX##Free( \
     TYPENAME *strPtr \
 ){ \
-    pgFree(strPtr->_ptr); \
+    if(!_constructureStringIsInline(strPtr)){ \
+        pgFree(strPtr->_storage._ptr); \
+    } \
     strPtr->length = 0u; \
     strPtr->_capacity = 0u; \
 }
@@ -19,6 +19,41 @@
 #define lengthIncludingNull(length) \
     (length + ((unsigned char)1u))
 
+/*
+ * Number of bytes of character storage held inside
+ * every string struct; strings which fit, including
+ * the null terminator, are not heap allocated. Each
+ * inline byte past the size of the pointer it shares
+ * storage with grows every struct embedding a string
+ */
+#define constructureStringInlineBytes 16
+
+/*
+ * Evaluates to the number of characters, including
+ * the null terminator, which a string of any type
+ * can hold inline
+ */
+#define _constructureStringInlineCapacity(STRINGPTR) \
+    (constructureStringInlineBytes \
+        / sizeof(*((STRINGPTR)->_storage._inline)))
+
+/*
+ * Evaluates to true if the given string of any type
+ * stores its characters inline, false if on the heap
+ */
+#define _constructureStringIsInline(STRINGPTR) \
+    ((STRINGPTR)->_capacity \
+        <= _constructureStringInlineCapacity(STRINGPTR))
+
+/*
+ * Evaluates to a pointer to the characters of the
+ * given string of any type
+ */
+#define _constructureStringChars(STRINGPTR) \
+    (_constructureStringIsInline(STRINGPTR) \
+        ? (STRINGPTR)->_storage._inline \
+        : (STRINGPTR)->_storage._ptr)
+
 /*
  * Unlike the generic containers in the rest
  * of Constructure, the String types will
@@ -35,15 +70,23 @@
 \
 /* \
  * A wrapper for a continguous null terminated \
- * fixed width character array on the heap \
+ * fixed width character array, stored inline \
+ * when short and on the heap otherwise \
  */ \
 typedef struct TYPENAME{ \
-    /* null terminated */ \
-    CHARTYPE *_ptr; \
+    /* null terminated; do not access directly */ \
+    union{ \
+        CHARTYPE *_ptr; \
+        CHARTYPE _inline[ \
+            constructureStringInlineBytes \
+                / sizeof(CHARTYPE) \
+        ]; \
+    } _storage; \
 \
     /* does not include null terminator */ \
     size_t length; \
 \
+    /* inline capacity unless on the heap */ \
     size_t _capacity; \
 } TYPENAME; \
 \
@@ -568,7 +611,35 @@ bool PREFIX##Equals( \
 /* Frees the given string */ \
 void PREFIX##Free( \
     TYPENAME *strPtr \
-);
+); \
+\
+/* \
+ * Returns true if the given string has been made \
+ * and not freed since, false otherwise \
+ */ \
+static inline bool PREFIX##IsMade( \
+    const TYPENAME *stringPtr \
+){ \
+    return stringPtr->_capacity != 0u; \
+} \
+\
+/* \
+ * Returns a pointer to the null terminated chars \
+ * of the given string, or to an empty string if \
+ * the string was never made or was freed \
+ */ \
+static inline CHARTYPE *PREFIX##CharPtr( \
+    const TYPENAME *stringPtr \
+){ \
+    static CHARTYPE emptyChars[1] = {0}; \
+    if(!PREFIX##IsMade(stringPtr)){ \
+        return emptyChars; \
+    } \
+    /* chars are writable, as the old _ptr was */ \
+    return (CHARTYPE *)_constructureStringChars( \
+        stringPtr \
+    ); \
+}
 
 /* end of macro */
 
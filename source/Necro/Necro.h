@@ -1,13 +1,19 @@
 #ifndef NECRO_H
 #define NECRO_H
 
+#include "Necro_Aot.h"
+#include "Necro_Bytecode.h"
 #include "Necro_Compiler.h"
 #include "Necro_Instruction.h"
 #include "Necro_Lexer.h"
+#include "Necro_Heap.h"
 #include "Necro_Literals.h"
 #include "Necro_NativeFuncSet.h"
 #include "Necro_Object.h"
+#include "Necro_Optimizer.h"
+#include "Necro_Profiler.h"
 #include "Necro_Program.h"
+#include "Necro_Session.h"
 #include "Necro_Value.h"
 #include "Necro_VirtualMachine.h"
 
@@ -0,0 +1,230 @@
+#include "Necro_Aot.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "PGUtil.h"
+
+#define scriptListInitCapacity 16
+#define funcListInitCapacity 8
+
+/* FNV-1a parameters for the code hash */
+#define hashOffsetBasis 2166136261u
+#define hashPrime 16777619u
+
+/* arraylist of const NecroAotScript*, every script */
+static ArrayList scriptList;
+static bool initialized = false;
+/* guards everything above */
+static atomic_flag lock = ATOMIC_FLAG_INIT;
+
+/* Acquires the registry lock */
+static void necroAotLock(){
+    while(atomic_flag_test_and_set_explicit(
+        &lock,
+        memory_order_acquire
+    )){
+        /* spin */
+    }
+}
+
+/* Releases the registry lock */
+static void necroAotUnlock(){
+    atomic_flag_clear_explicit(&lock, memory_order_release);
+}
+
+/*
+ * Returns the part of the specified file name past
+ * its last directory separator, which is what
+ * translated scripts are registered under
+ */
+const char *necroAotScriptName(const char *fileName){
+    const char *namePtr = fileName;
+    for(const char *charPtr = fileName;
+        *charPtr;
+        ++charPtr
+    ){
+        if(*charPtr == '/' || *charPtr == '\\'){
+            namePtr = charPtr + 1;
+        }
+    }
+    return namePtr;
+}
+
+/*
+ * Returns the hash of the code of the specified
+ * program which its translation must match
+ */
+uint32_t necroAotHashCode(NecroProgram *programPtr){
+    uint32_t hash = hashOffsetBasis;
+    uint8_t *codePtr = programPtr->code._ptr;
+    for(size_t i = 0; i < programPtr->code.size; ++i){
+        hash ^= codePtr[i];
+        hash *= hashPrime;
+    }
+    return hash;
+}
+
+/*
+ * Pushes the specified script and every function
+ * defined in it, however deeply nested, to the back
+ * of the given arraylist of NecroObjectFunc*; the
+ * script comes first and each function comes before
+ * the functions defined in it
+ */
+void necroAotListFuncs(
+    NecroObjectFunc *scriptPtr,
+    ArrayList *funcListPtr
+){
+    arrayListPushBack(NecroObjectFunc*,
+        funcListPtr,
+        scriptPtr
+    );
+    NecroLiterals *literalsPtr
+        = &(scriptPtr->program.literals);
+    for(size_t i = 0; i < literalsPtr->literals.size; ++i){
+        NecroValue literal = necroLiteralsGet(literalsPtr, i);
+        if(necroIsObject(literal)
+            && necroObjectGetType(literal)
+                == necro_funcObject
+        ){
+            necroAotListFuncs(
+                necroObjectAsFunc(literal),
+                funcListPtr
+            );
+        }
+    }
+}
+
+/*
+ * Returns the registered script with the specified
+ * name, or NULL if there is none; the lock must be
+ * held
+ */
+static const NecroAotScript *necroAotFind(
+    const char *name
+){
+    if(!initialized){
+        return NULL;
+    }
+    for(size_t i = 0; i < scriptList.size; ++i){
+        const NecroAotScript *aotScriptPtr = arrayListGet(
+            const NecroAotScript*,
+            &scriptList,
+            i
+        );
+        if(strcmp(aotScriptPtr->name, name) == 0){
+            return aotScriptPtr;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Registers the specified translated script, which
+ * must live until the registry is cleared; scripts
+ * bound so far are not affected
+ */
+void necroAotRegister(const NecroAotScript *aotScriptPtr){
+    necroAotLock();
+    if(!initialized){
+        scriptList = arrayListMake(const NecroAotScript*,
+            scriptListInitCapacity
+        );
+        initialized = true;
+    }
+    const NecroAotScript *foundPtr = necroAotFind(
+        aotScriptPtr->name
+    );
+    if(!foundPtr){
+        arrayListPushBack(const NecroAotScript*,
+            &scriptList,
+            aotScriptPtr
+        );
+    }
+    necroAotUnlock();
+
+    /* registering the same script again is harmless */
+    if(foundPtr && foundPtr != aotScriptPtr){
+        pgWarning(aotScriptPtr->name);
+        pgError(
+            "duplicate translated script name; "
+            SRC_LOCATION
+        );
+    }
+}
+
+/*
+ * Binds every program of the specified script, which
+ * was compiled from the file with the given name, to
+ * its registered translation; returns true if bound,
+ * or false if there is no translation or it was made
+ * from different code, in which case the script is
+ * left to be interpreted
+ */
+bool necroAotBind(
+    NecroObjectFunc *scriptPtr,
+    const char *fileName
+){
+    #ifdef NECRO_PROFILE
+    return false;
+    #else
+    necroAotLock();
+    const NecroAotScript *aotScriptPtr = necroAotFind(
+        necroAotScriptName(fileName)
+    );
+    necroAotUnlock();
+    if(!aotScriptPtr){
+        return false;
+    }
+
+    ArrayList funcList = arrayListMake(NecroObjectFunc*,
+        funcListInitCapacity
+    );
+    necroAotListFuncs(scriptPtr, &funcList);
+    bool matches
+        = funcList.size == aotScriptPtr->programCount;
+    for(size_t i = 0; matches && i < funcList.size; ++i){
+        NecroProgram *programPtr = &(arrayListGet(
+            NecroObjectFunc*,
+            &funcList,
+            i
+        )->program);
+        const NecroAotProgram *aotProgramPtr
+            = &(aotScriptPtr->programs[i]);
+        matches = programPtr->code.size
+                == aotProgramPtr->codeSize
+            && necroAotHashCode(programPtr)
+                == aotProgramPtr->codeHash;
+    }
+    if(matches){
+        for(size_t i = 0; i < funcList.size; ++i){
+            arrayListGet(NecroObjectFunc*, &funcList, i)
+                ->program.aotPtr
+                    = &(aotScriptPtr->programs[i]);
+        }
+    }
+    else{
+        pgWarning(fileName);
+        pgWarning(
+            "translated script is out of date; "
+            "interpreting it instead"
+        );
+    }
+    arrayListFree(NecroObjectFunc*, &funcList);
+    return matches;
+    #endif
+}
+
+/*
+ * Clears the registry of translated scripts; scripts
+ * already bound keep their translations
+ */
+void necroAotClear(){
+    necroAotLock();
+    if(initialized){
+        arrayListFree(const NecroAotScript*, &scriptList);
+        initialized = false;
+    }
+    necroAotUnlock();
+}
\ No newline at end of file
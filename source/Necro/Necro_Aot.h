@@ -0,0 +1,166 @@
+#ifndef NECRO_AOT_H
+#define NECRO_AOT_H
+
+/*
+ * Ahead of time translation of Necro programs to C.
+ * The necro_aot tool translates compiled scripts into
+ * a C source whose functions each run one program the
+ * way the virtual machine would; built into the game
+ * with NECRO_AOT defined, that source registers its
+ * scripts here. A script compiled or loaded from its
+ * bytecode afterwards is bound to the translation of
+ * the same name if its code has not changed since,
+ * and every other script is interpreted as usual.
+ * Profiled builds never bind, so that the profiler
+ * still counts every instruction
+ */
+
+#include "Constructure.h"
+
+#include "Necro_Object.h"
+#include "Necro_VirtualMachine.h"
+
+/*
+ * Runs the program of the specified call frame, which
+ * must be the top one of the given virtual machine,
+ * from its instruction pointer until it pushes or
+ * pops a frame, yields, or ends; never returns
+ * necro_stepContinue
+ */
+typedef NecroStepResult (*NecroAotFunc)(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+);
+
+/* The translation of a single program */
+typedef struct NecroAotProgram{
+    NecroAotFunc func;
+    /* size and hash of the code it was made from */
+    size_t codeSize;
+    uint32_t codeHash;
+} NecroAotProgram;
+
+/*
+ * The translation of a script; its programs are in
+ * the order given by necroAotListFuncs
+ */
+typedef struct NecroAotScript{
+    /* file name of the script, without directories */
+    const char *name;
+    const NecroAotProgram *programs;
+    size_t programCount;
+} NecroAotScript;
+
+/*
+ * Returns the part of the specified file name past
+ * its last directory separator, which is what
+ * translated scripts are registered under
+ */
+const char *necroAotScriptName(const char *fileName);
+
+/*
+ * Returns the hash of the code of the specified
+ * program which its translation must match
+ */
+uint32_t necroAotHashCode(NecroProgram *programPtr);
+
+/*
+ * Pushes the specified script and every function
+ * defined in it, however deeply nested, to the back
+ * of the given arraylist of NecroObjectFunc*; the
+ * script comes first and each function comes before
+ * the functions defined in it
+ */
+void necroAotListFuncs(
+    NecroObjectFunc *scriptPtr,
+    ArrayList *funcListPtr
+);
+
+/*
+ * Registers the specified translated script, which
+ * must live until the registry is cleared; scripts
+ * bound so far are not affected
+ */
+void necroAotRegister(const NecroAotScript *aotScriptPtr);
+
+/*
+ * Binds every program of the specified script, which
+ * was compiled from the file with the given name, to
+ * its registered translation; returns true if bound,
+ * or false if there is no translation or it was made
+ * from different code, in which case the script is
+ * left to be interpreted
+ */
+bool necroAotBind(
+    NecroObjectFunc *scriptPtr,
+    const char *fileName
+);
+
+/*
+ * Clears the registry of translated scripts; scripts
+ * already bound keep their translations
+ */
+void necroAotClear();
+
+#ifdef NECRO_AOT
+/*
+ * Registers every script in the translated source the
+ * program is built with; defined in that source
+ */
+void necroAotRegisterScripts();
+#endif
+
+/*
+ * Helpers for translated code, which keeps the top of
+ * the stack of its virtual machine in the local sp,
+ * the slots of its call frame in the local slots, and
+ * the code of its program in the local code
+ */
+
+/*
+ * Pushes the specified value onto the stack in
+ * translated code, growing the stack if it is full
+ */
+#define necroAotPush(VALUE) \
+    do{ \
+        if(sp == vmPtr->stackEndPtr){ \
+            vmPtr->stackPtr = sp; \
+            necroVirtualMachineStackPush(vmPtr, (VALUE)); \
+            sp = vmPtr->stackPtr; \
+            slots = framePtr->slots; \
+        } \
+        else{ \
+            *(sp++) = (VALUE); \
+        } \
+    } while(false)
+
+/*
+ * Has the virtual machine step the instruction at the
+ * specified offset in translated code; returns from
+ * the translated function unless the frame carries on
+ */
+#define necroAotStep(OFFSET) \
+    do{ \
+        vmPtr->stackPtr = sp; \
+        framePtr->instructionPtr = code + (OFFSET); \
+        NecroStepResult stepResult \
+            = necroVirtualMachineStep(vmPtr, framePtr); \
+        if(stepResult != necro_stepContinue){ \
+            return stepResult; \
+        } \
+        sp = vmPtr->stackPtr; \
+        slots = framePtr->slots; \
+    } while(false)
+
+/*
+ * Returns the specified result from translated code,
+ * leaving the frame at the given offset
+ */
+#define necroAotExit(OFFSET, RESULT) \
+    do{ \
+        vmPtr->stackPtr = sp; \
+        framePtr->instructionPtr = code + (OFFSET); \
+        return (RESULT); \
+    } while(false)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,832 @@
+#include "Necro_Bytecode.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+/* map bytecode files rather than reading them */
+#define NECRO_BYTECODE_MMAP
+#endif
+
+#include "Necro_Aot.h"
+#include "Necro_Instruction.h"
+#include "Necro_Profiler.h"
+
+/*
+ * A bytecode file is written in the byte order of the
+ * machine which made it and holds, in order:
+ *   the magic bytes "NECB"
+ *   u32 format version
+ *   u64 hash of the natives it was compiled against,
+ *       the source file, and its includes
+ *   u32 include count, then each include name
+ *   the script func
+ * A func is its i32 arity, i32 depth, u8 whether it
+ * has a name and then the name, u32 code size, the
+ * code, a u16 line number per code byte, u32 literal
+ * count, and then each literal as a u8 kind followed
+ * by its payload; strings are a u32 length and their
+ * characters, and nested funcs recurse
+ */
+
+static const char magic[4] = {'N', 'E', 'C', 'B'};
+/*
+ * bump whenever this format or the instruction set
+ * changes so that stale files are recompiled
+ */
+#define formatVersion 5u
+
+#define bufferInitCapacity 1024
+/* bytes hashed at a time */
+#define hashChunkSize 4096
+
+/* FNV-1a 64 bit parameters */
+#define hashOffsetBasis 14695981039346656037ull
+#define hashPrime 1099511628211ull
+
+/* The kinds of literal stored in a bytecode file */
+typedef enum _NecroBytecodeLiteralKind{
+    _necroBytecodeInt,
+    _necroBytecodeFloat,
+    _necroBytecodeBool,
+    _necroBytecodeVector,
+    _necroBytecodePoint,
+    _necroBytecodeString,
+    _necroBytecodeFunc,
+} _NecroBytecodeLiteralKind;
+
+/* Reads from a bytecode file loaded in memory */
+typedef struct _NecroBytecodeReader{
+    const uint8_t *ptr;
+    size_t size;
+    size_t offset;
+    /* set once any read runs past the end */
+    bool failed;
+} _NecroBytecodeReader;
+
+/*
+ * Folds the specified bytes into the given FNV-1a
+ * hash
+ */
+static void hashBytes(
+    uint64_t *hashPtr,
+    const void *voidPtr,
+    size_t size
+){
+    const uint8_t *bytePtr = voidPtr;
+    for(size_t i = 0; i < size; ++i){
+        *hashPtr ^= bytePtr[i];
+        *hashPtr *= hashPrime;
+    }
+}
+
+/*
+ * Folds the contents of the specified file into the
+ * given hash; returns false if the file could not be
+ * read
+ */
+static bool hashFile(uint64_t *hashPtr, const char *fileName){
+    FILE *filePtr = fopen(fileName, "rb");
+    if(!filePtr){
+        return false;
+    }
+    uint8_t chunk[hashChunkSize];
+    size_t bytesRead = 0;
+    while((bytesRead = fread(
+        chunk,
+        1,
+        hashChunkSize,
+        filePtr
+    )) > 0){
+        hashBytes(hashPtr, chunk, bytesRead);
+    }
+    bool success = !ferror(filePtr);
+    fclose(filePtr);
+    return success;
+}
+
+/*
+ * Folds an include file name and the contents of
+ * that file into the given hash; returns false if
+ * the file could not be read
+ */
+static bool hashInclude(
+    uint64_t *hashPtr,
+    const char *fileName
+){
+    /* include the terminator to separate names */
+    hashBytes(hashPtr, fileName, strlen(fileName) + 1);
+    return hashFile(hashPtr, fileName);
+}
+
+/*
+ * Folds the name and signature of every native in
+ * the specified nullable native function set into the
+ * given hash, since compiled calls to natives refer
+ * to them by index and are checked against their
+ * signatures
+ */
+static void hashNatives(
+    uint64_t *hashPtr,
+    NecroNativeFuncSet *nativeFuncSetPtr
+){
+    uint32_t count = nativeFuncSetPtr
+        ? (uint32_t)nativeFuncSetPtr
+            ->_nameNativeFuncPairs.size
+        : 0;
+    hashBytes(hashPtr, &count, sizeof(count));
+    for(uint32_t i = 0; i < count; ++i){
+        _NecroNameNativeFuncPair *pairPtr
+            = necroNativeFuncSetGetPair(
+                nativeFuncSetPtr,
+                i
+            );
+        hashBytes(
+            hashPtr,
+            pairPtr->_name,
+            strlen(pairPtr->_name) + 1
+        );
+        const NecroNativeSignature *signaturePtr
+            = pairPtr->_signaturePtr;
+        uint8_t hasSignature = signaturePtr != NULL;
+        hashBytes(hashPtr, &hasSignature, 1);
+        if(!signaturePtr){
+            continue;
+        }
+        /* field by field so that padding is skipped */
+        int32_t fields[] = {
+            (int32_t)signaturePtr->returnType,
+            (int32_t)signaturePtr->paramCount,
+            (int32_t)signaturePtr->minArity,
+            (int32_t)signaturePtr->variadic
+        };
+        hashBytes(hashPtr, fields, sizeof(fields));
+        for(int j = 0; j < signaturePtr->paramCount; ++j){
+            int32_t paramType
+                = (int32_t)signaturePtr->paramTypes[j];
+            hashBytes(hashPtr, &paramType, sizeof(paramType));
+        }
+    }
+}
+
+/*
+ * Appends the specified bytes to the back of the
+ * given arraylist of uint8_t
+ */
+static void writeBytes(
+    ArrayList *bufferPtr,
+    const void *voidPtr,
+    size_t size
+){
+    const uint8_t *bytePtr = voidPtr;
+    for(size_t i = 0; i < size; ++i){
+        arrayListPushBack(uint8_t, bufferPtr, bytePtr[i]);
+    }
+}
+
+/*
+ * Appends the specified value to the back of the
+ * given arraylist of uint8_t
+ */
+#define writeValue(BUFFERPTR, TYPENAME, VALUE) \
+    do{ \
+        TYPENAME _value = (VALUE); \
+        writeBytes((BUFFERPTR), &_value, sizeof(_value)); \
+    } while(false)
+
+/*
+ * Appends the specified characters as a length
+ * prefixed string to the given arraylist of uint8_t
+ */
+static void writeString(
+    ArrayList *bufferPtr,
+    const char *chars,
+    size_t length
+){
+    writeValue(bufferPtr, uint32_t, (uint32_t)length);
+    writeBytes(bufferPtr, chars, length);
+}
+
+/*
+ * Appends the specified func and every func nested in
+ * it to the given arraylist of uint8_t
+ */
+static void writeFunc(
+    ArrayList *bufferPtr,
+    NecroObjectFunc *funcPtr
+){
+    writeValue(bufferPtr, int32_t, funcPtr->arity);
+    writeValue(bufferPtr, int32_t, funcPtr->depth);
+    writeValue(bufferPtr, uint8_t, funcPtr->namePtr != NULL);
+    if(funcPtr->namePtr){
+        writeString(
+            bufferPtr,
+            stringCharPtr(&(funcPtr->namePtr->string)),
+            funcPtr->namePtr->string.length
+        );
+    }
+
+    NecroProgram *programPtr = &(funcPtr->program);
+    writeValue(bufferPtr, uint32_t,
+        (uint32_t)programPtr->code.size
+    );
+    writeBytes(
+        bufferPtr,
+        programPtr->code._ptr,
+        programPtr->code.size
+    );
+    writeBytes(
+        bufferPtr,
+        programPtr->lineNumbers._ptr,
+        programPtr->lineNumbers.size * sizeof(uint16_t)
+    );
+
+    NecroLiterals *literalsPtr = &(programPtr->literals);
+    writeValue(bufferPtr, uint32_t,
+        (uint32_t)literalsPtr->literals.size
+    );
+    for(size_t i = 0; i < literalsPtr->literals.size; ++i){
+        NecroValue literal = necroLiteralsGet(literalsPtr, i);
+        switch(necroValueGetType(literal)){
+            case necro_int:
+                writeValue(bufferPtr, uint8_t,
+                    _necroBytecodeInt
+                );
+                writeValue(bufferPtr, int32_t,
+                    necroAsInt(literal)
+                );
+                break;
+            case necro_float:
+                writeValue(bufferPtr, uint8_t,
+                    _necroBytecodeFloat
+                );
+                writeValue(bufferPtr, float,
+                    necroAsFloat(literal)
+                );
+                break;
+            case necro_bool:
+                writeValue(bufferPtr, uint8_t,
+                    _necroBytecodeBool
+                );
+                writeValue(bufferPtr, uint8_t,
+                    necroAsBool(literal)
+                );
+                break;
+            case necro_vector: {
+                Polar vector = necroAsVector(literal);
+                writeValue(bufferPtr, uint8_t,
+                    _necroBytecodeVector
+                );
+                writeValue(bufferPtr, float, vector.magnitude);
+                writeValue(bufferPtr, float, vector.angle);
+                break;
+            }
+            case necro_point: {
+                Point2D point = necroAsPoint(literal);
+                writeValue(bufferPtr, uint8_t,
+                    _necroBytecodePoint
+                );
+                writeValue(bufferPtr, float, point.x);
+                writeValue(bufferPtr, float, point.y);
+                break;
+            }
+            case necro_object:
+                if(necroIsString(literal)){
+                    NecroObjectString *stringPtr
+                        = necroObjectAsString(literal);
+                    writeValue(bufferPtr, uint8_t,
+                        _necroBytecodeString
+                    );
+                    writeString(
+                        bufferPtr,
+                        stringCharPtr(&(stringPtr->string)),
+                        stringPtr->string.length
+                    );
+                    break;
+                }
+                writeValue(bufferPtr, uint8_t,
+                    _necroBytecodeFunc
+                );
+                writeFunc(bufferPtr, necroObjectAsFunc(literal));
+                break;
+            default:
+                pgError(
+                    "unexpected literal type; "
+                    SRC_LOCATION
+                );
+        }
+    }
+}
+
+/*
+ * Writes the specified compiled script to the
+ * bytecode file with the given name, keyed by the
+ * contents of the source file it was compiled from,
+ * of the files named by the given arraylist of String
+ * which it includes, and by the given nullable set of
+ * natives it was compiled against; returns true on
+ * success
+ */
+bool necroBytecodeSave(
+    const char *fileName,
+    NecroObjectFunc *scriptPtr,
+    const char *sourceFileName,
+    ArrayList *includeListPtr,
+    NecroNativeFuncSet *nativeFuncSetPtr
+){
+    assertNotNull(
+        scriptPtr,
+        "null script passed to save; "
+        SRC_LOCATION
+    );
+    uint64_t hash = hashOffsetBasis;
+    hashNatives(&hash, nativeFuncSetPtr);
+    if(!hashFile(&hash, sourceFileName)){
+        return false;
+    }
+    for(size_t i = 0; i < includeListPtr->size; ++i){
+        if(!hashInclude(
+            &hash,
+            stringCharPtr(arrayListGetPtr(String,
+                includeListPtr,
+                i
+            ))
+        )){
+            return false;
+        }
+    }
+
+    ArrayList buffer = arrayListMake(uint8_t,
+        bufferInitCapacity
+    );
+    writeBytes(&buffer, magic, sizeof(magic));
+    writeValue(&buffer, uint32_t, formatVersion);
+    writeValue(&buffer, uint64_t, hash);
+    writeValue(&buffer, uint32_t,
+        (uint32_t)includeListPtr->size
+    );
+    for(size_t i = 0; i < includeListPtr->size; ++i){
+        String *namePtr = arrayListGetPtr(String,
+            includeListPtr,
+            i
+        );
+        writeString(
+            &buffer,
+            stringCharPtr(namePtr),
+            namePtr->length
+        );
+    }
+    writeFunc(&buffer, scriptPtr);
+
+    bool success = false;
+    FILE *filePtr = fopen(fileName, "wb");
+    if(filePtr){
+        success = fwrite(
+            buffer._ptr,
+            1,
+            buffer.size,
+            filePtr
+        ) == buffer.size;
+        success &= (fclose(filePtr) == 0);
+        /* never leave a partial file behind */
+        if(!success){
+            remove(fileName);
+        }
+    }
+    arrayListFree(uint8_t, &buffer);
+    return success;
+}
+
+/*
+ * Copies the specified number of bytes from the given
+ * reader; returns false and marks the reader failed
+ * if not enough remain
+ */
+static bool readBytes(
+    _NecroBytecodeReader *readerPtr,
+    void *destPtr,
+    size_t size
+){
+    if(readerPtr->failed
+        || size > readerPtr->size - readerPtr->offset
+    ){
+        readerPtr->failed = true;
+        return false;
+    }
+    memcpy(destPtr, readerPtr->ptr + readerPtr->offset, size);
+    readerPtr->offset += size;
+    return true;
+}
+
+/*
+ * Reads a value of the specified type from the given
+ * reader; yields 0 if the reader has failed
+ */
+#define readValue(READERPTR, TYPENAME, OUTPTR) \
+    do{ \
+        *(OUTPTR) = (TYPENAME){0}; \
+        readBytes((READERPTR), (OUTPTR), sizeof(TYPENAME)); \
+    } while(false)
+
+/*
+ * Reads a length prefixed string from the given
+ * reader, setting the pointer to its characters
+ * inside the file; returns false on failure
+ */
+static bool readString(
+    _NecroBytecodeReader *readerPtr,
+    const char **charsPtrPtr,
+    uint32_t *lengthPtr
+){
+    readValue(readerPtr, uint32_t, lengthPtr);
+    if(readerPtr->failed
+        || *lengthPtr > readerPtr->size - readerPtr->offset
+    ){
+        readerPtr->failed = true;
+        return false;
+    }
+    *charsPtrPtr = (const char*)(
+        readerPtr->ptr + readerPtr->offset
+    );
+    readerPtr->offset += *lengthPtr;
+    return true;
+}
+
+/*
+ * Returns true if every native call in the code of
+ * the specified program names a native in the given
+ * nullable set and, if its arguments go unchecked,
+ * passes a number of them its signature accepts;
+ * warns and returns false otherwise, since the
+ * virtual machine trusts these operands
+ */
+static bool checkNativeCalls(
+    NecroProgram *programPtr,
+    NecroNativeFuncSet *nativeFuncSetPtr
+){
+    uint8_t *code = programPtr->code._ptr;
+    size_t codeSize = programPtr->code.size;
+    size_t nativeCount = nativeFuncSetPtr
+        ? nativeFuncSetPtr->_nameNativeFuncPairs.size
+        : 0;
+    size_t offset = 0;
+    while(offset < codeSize){
+        uint8_t opcode = code[offset];
+        size_t length = necroInstructionLength(opcode);
+        if(length == 0 || offset + length > codeSize){
+            pgWarning("bad instruction in Necro bytecode");
+            return false;
+        }
+        bool isUnchecked = opcode == necro_callNativeFast
+            || opcode == necro_callNativeFastPop;
+        if(isUnchecked
+            || opcode == necro_callNative
+            || opcode == necro_callNativePop
+        ){
+            uint8_t index = code[offset + 1];
+            int numArgs = code[offset + 2];
+            if(index >= nativeCount){
+                pgWarning(
+                    "Necro bytecode calls a native "
+                    "which does not exist"
+                );
+                return false;
+            }
+            NecroNativeSignature *signaturePtr
+                = necroNativeFuncSetGetPair(
+                    nativeFuncSetPtr,
+                    index
+                )->_signaturePtr;
+            if(isUnchecked && (!signaturePtr
+                || !necroNativeSignatureAcceptsArity(
+                    signaturePtr,
+                    numArgs
+                ))
+            ){
+                pgWarning(
+                    "Necro bytecode calls a native "
+                    "with a bad number of arguments"
+                );
+                return false;
+            }
+        }
+        offset += length;
+    }
+    return true;
+}
+
+/*
+ * Reads a func and every func nested in it from the
+ * given reader and returns it as a pointer to a newly
+ * allocated NecroObjectFunc; the enclosing func
+ * pointer is nullable. Native calls are checked
+ * against the given nullable set of natives. Returns
+ * NULL on failure
+ */
+static NecroObjectFunc *readFunc(
+    _NecroBytecodeReader *readerPtr,
+    NecroObjectFunc *enclosingPtr,
+    NecroNativeFuncSet *nativeFuncSetPtr
+){
+    int32_t arity = 0;
+    int32_t depth = 0;
+    uint8_t hasName = 0;
+    readValue(readerPtr, int32_t, &arity);
+    readValue(readerPtr, int32_t, &depth);
+    readValue(readerPtr, uint8_t, &hasName);
+    if(readerPtr->failed){
+        return NULL;
+    }
+    NecroObjectFunc *funcPtr = necroObjectFuncMake(
+        enclosingPtr,
+        depth
+    );
+    funcPtr->arity = arity;
+    NecroProgram *programPtr = &(funcPtr->program);
+    HashMap *stringMapPtr
+        = programPtr->literals.stringMapPtr;
+
+    const char *chars = NULL;
+    uint32_t length = 0;
+    if(hasName){
+        if(!readString(readerPtr, &chars, &length)){
+            goto fail;
+        }
+        funcPtr->namePtr = necroObjectStringCopy(
+            chars,
+            length,
+            NULL,
+            stringMapPtr
+        );
+    }
+
+    uint32_t codeSize = 0;
+    readValue(readerPtr, uint32_t, &codeSize);
+    size_t lineNumbersOffset = readerPtr->offset + codeSize;
+    if(readerPtr->failed
+        || codeSize > readerPtr->size
+        || (size_t)codeSize * (1 + sizeof(uint16_t))
+            > readerPtr->size - readerPtr->offset
+    ){
+        readerPtr->failed = true;
+        goto fail;
+    }
+    for(uint32_t i = 0; i < codeSize; ++i){
+        uint16_t lineNumber = 0;
+        memcpy(
+            &lineNumber,
+            readerPtr->ptr + lineNumbersOffset
+                + (i * sizeof(uint16_t)),
+            sizeof(uint16_t)
+        );
+        necroProgramPushBackCode(
+            programPtr,
+            readerPtr->ptr[readerPtr->offset + i],
+            lineNumber
+        );
+    }
+    readerPtr->offset += (size_t)codeSize
+        * (1 + sizeof(uint16_t));
+    if(!checkNativeCalls(programPtr, nativeFuncSetPtr)){
+        readerPtr->failed = true;
+        goto fail;
+    }
+
+    uint32_t literalCount = 0;
+    readValue(readerPtr, uint32_t, &literalCount);
+    for(uint32_t i = 0; i < literalCount; ++i){
+        uint8_t kind = 0;
+        readValue(readerPtr, uint8_t, &kind);
+        if(readerPtr->failed){
+            goto fail;
+        }
+        NecroValue literal = {0};
+        switch(kind){
+            case _necroBytecodeInt: {
+                int32_t intValue = 0;
+                readValue(readerPtr, int32_t, &intValue);
+                literal = necroIntValue(intValue);
+                break;
+            }
+            case _necroBytecodeFloat: {
+                float floatValue = 0;
+                readValue(readerPtr, float, &floatValue);
+                literal = necroFloatValue(floatValue);
+                break;
+            }
+            case _necroBytecodeBool: {
+                uint8_t boolValue = 0;
+                readValue(readerPtr, uint8_t, &boolValue);
+                literal = necroBoolValue(boolValue != 0);
+                break;
+            }
+            case _necroBytecodeVector: {
+                Polar vector = {0};
+                readValue(readerPtr, float, &(vector.magnitude));
+                readValue(readerPtr, float, &(vector.angle));
+                literal = necroVectorValue(vector);
+                break;
+            }
+            case _necroBytecodePoint: {
+                Point2D point = {0};
+                readValue(readerPtr, float, &(point.x));
+                readValue(readerPtr, float, &(point.y));
+                literal = necroPointValue(point);
+                break;
+            }
+            case _necroBytecodeString:
+                if(!readString(readerPtr, &chars, &length)){
+                    goto fail;
+                }
+                /* interned into the shared string map */
+                literal = necroObjectValue(
+                    necroObjectStringCopy(
+                        chars,
+                        length,
+                        NULL,
+                        stringMapPtr
+                    )
+                );
+                break;
+            case _necroBytecodeFunc: {
+                NecroObjectFunc *nestedPtr = readFunc(
+                    readerPtr,
+                    funcPtr,
+                    nativeFuncSetPtr
+                );
+                if(!nestedPtr){
+                    goto fail;
+                }
+                literal = necroObjectValue(nestedPtr);
+                break;
+            }
+            default:
+                readerPtr->failed = true;
+                break;
+        }
+        if(readerPtr->failed){
+            goto fail;
+        }
+        necroProgramPushBackLiteral(programPtr, literal);
+    }
+    if(!readerPtr->failed){
+        return funcPtr;
+    }
+
+fail:
+    readerPtr->failed = true;
+    necroObjectFree((NecroObject*)funcPtr);
+    return NULL;
+}
+
+/*
+ * Parses a whole bytecode file held in memory and
+ * returns the script it holds, or NULL if the file is
+ * malformed or stale
+ */
+static NecroObjectFunc *parseBytecode(
+    const uint8_t *ptr,
+    size_t size,
+    const char *sourceFileName,
+    NecroNativeFuncSet *nativeFuncSetPtr
+){
+    _NecroBytecodeReader reader = {ptr, size, 0, false};
+    char fileMagic[sizeof(magic)] = {0};
+    uint32_t version = 0;
+    uint64_t storedHash = 0;
+    uint32_t includeCount = 0;
+    readBytes(&reader, fileMagic, sizeof(fileMagic));
+    readValue(&reader, uint32_t, &version);
+    readValue(&reader, uint64_t, &storedHash);
+    readValue(&reader, uint32_t, &includeCount);
+    if(reader.failed
+        || memcmp(fileMagic, magic, sizeof(magic)) != 0
+        || version != formatVersion
+    ){
+        return NULL;
+    }
+
+    uint64_t hash = hashOffsetBasis;
+    hashNatives(&hash, nativeFuncSetPtr);
+    if(!hashFile(&hash, sourceFileName)){
+        return NULL;
+    }
+    /* include names are not null terminated in file */
+    String includeName = stringMakeEmpty();
+    bool readable = true;
+    for(uint32_t i = 0; i < includeCount && readable; ++i){
+        const char *chars = NULL;
+        uint32_t length = 0;
+        if(!readString(&reader, &chars, &length)){
+            readable = false;
+            break;
+        }
+        stringFree(&includeName);
+        includeName = stringMakeCLength(chars, length);
+        readable = hashInclude(
+            &hash,
+            stringCharPtr(&includeName)
+        );
+    }
+    stringFree(&includeName);
+    if(!readable || hash != storedHash){
+        return NULL;
+    }
+
+    NecroObjectFunc *scriptPtr = readFunc(
+        &reader,
+        NULL,
+        nativeFuncSetPtr
+    );
+    if(scriptPtr && reader.offset != reader.size){
+        necroObjectFree((NecroObject*)scriptPtr);
+        scriptPtr = NULL;
+    }
+    return scriptPtr;
+}
+
+/*
+ * Loads the compiled script stored in the bytecode
+ * file with the given name and returns it as a
+ * pointer to a newly allocated NecroObjectFunc;
+ * returns NULL if the file is missing, malformed, or
+ * was not made from the current contents of the
+ * specified source file and its includes or against
+ * the given nullable set of natives, or if any of its
+ * native calls does not fit that set
+ */
+NecroObjectFunc *necroBytecodeLoad(
+    const char *fileName,
+    const char *sourceFileName,
+    NecroNativeFuncSet *nativeFuncSetPtr
+){
+    NecroObjectFunc *scriptPtr = NULL;
+
+    #ifdef NECRO_BYTECODE_MMAP
+    int fileDescriptor = open(fileName, O_RDONLY);
+    if(fileDescriptor < 0){
+        return NULL;
+    }
+    struct stat fileStat = {0};
+    if(fstat(fileDescriptor, &fileStat) == 0
+        && fileStat.st_size > 0
+    ){
+        size_t size = (size_t)fileStat.st_size;
+        void *mappedPtr = mmap(
+            NULL,
+            size,
+            PROT_READ,
+            MAP_PRIVATE,
+            fileDescriptor,
+            0
+        );
+        if(mappedPtr != MAP_FAILED){
+            scriptPtr = parseBytecode(
+                mappedPtr,
+                size,
+                sourceFileName,
+                nativeFuncSetPtr
+            );
+            munmap(mappedPtr, size);
+        }
+    }
+    close(fileDescriptor);
+    #else
+    FILE *filePtr = fopen(fileName, "rb");
+    if(!filePtr){
+        return NULL;
+    }
+    fseek(filePtr, 0, SEEK_END);
+    long fileSize = ftell(filePtr);
+    rewind(filePtr);
+    if(fileSize > 0){
+        uint8_t *bufferPtr = pgAlloc(fileSize, 1);
+        if(fread(bufferPtr, 1, fileSize, filePtr)
+            == (size_t)fileSize
+        ){
+            scriptPtr = parseBytecode(
+                bufferPtr,
+                (size_t)fileSize,
+                sourceFileName,
+                nativeFuncSetPtr
+            );
+        }
+        pgFree(bufferPtr);
+    }
+    fclose(filePtr);
+    #endif
+
+    if(scriptPtr){
+        necroAotBind(scriptPtr, sourceFileName);
+    }
+    #ifdef NECRO_PROFILE
+    if(scriptPtr){
+        necroProfilerNameScript(scriptPtr, sourceFileName);
+    }
+    #endif
+    return scriptPtr;
+}
\ No newline at end of file
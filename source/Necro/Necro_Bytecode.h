@@ -0,0 +1,42 @@
+#ifndef NECRO_BYTECODE_H
+#define NECRO_BYTECODE_H
+
+#include "Constructure.h"
+
+#include "Necro_Object.h"
+#include "Necro_NativeFuncSet.h"
+
+/*
+ * Writes the specified compiled script to the
+ * bytecode file with the given name, keyed by the
+ * contents of the source file it was compiled from,
+ * of the files named by the given arraylist of String
+ * which it includes, and by the given nullable set of
+ * natives it was compiled against; returns true on
+ * success
+ */
+bool necroBytecodeSave(
+    const char *fileName,
+    NecroObjectFunc *scriptPtr,
+    const char *sourceFileName,
+    ArrayList *includeListPtr,
+    NecroNativeFuncSet *nativeFuncSetPtr
+);
+
+/*
+ * Loads the compiled script stored in the bytecode
+ * file with the given name and returns it as a
+ * pointer to a newly allocated NecroObjectFunc;
+ * returns NULL if the file is missing, malformed, or
+ * was not made from the current contents of the
+ * specified source file and its includes or against
+ * the given nullable set of natives, or if any of its
+ * native calls does not fit that set
+ */
+NecroObjectFunc *necroBytecodeLoad(
+    const char *fileName,
+    const char *sourceFileName,
+    NecroNativeFuncSet *nativeFuncSetPtr
+);
+
+#endif
\ No newline at end of file
@@ -2,6 +2,10 @@
 
 #include <stdio.h>
 
+#include "Necro_Aot.h"
+#include "Necro_Optimizer.h"
+#include "Necro_Profiler.h"
+
 #define maxParams 255
 #define lexerStackInitCapacity 8
 #define globalsTableInitCapacity 30
@@ -10,6 +14,9 @@
 /* define for verbose compiler output for debugging */
 /* #define COMPILER_VERBOSE */
 
+/* define to skip the bytecode optimizer */
+/* #define NECRO_NO_OPTIMIZE */
+
 /*
  * Represents the precedence hiearchy of the grammar 
  * of Necro from lowest to highest
@@ -288,6 +295,37 @@ NecroCompiler necroCompilerMake(){
     return toRet;
 }
 
+/*
+ * Constructs and returns a new NecroCompiler by value
+ * which takes the files it includes from the given
+ * NecroSession, which must outlive it
+ */
+NecroCompiler necroCompilerMakeSession(
+    NecroSession *sessionPtr
+){
+    NecroCompiler toRet = necroCompilerMake();
+    toRet.sessionPtr = sessionPtr;
+    return toRet;
+}
+
+/*
+ * Constructs and returns a new NecroCompiler by value
+ * which takes the files it includes from the given
+ * nullable NecroSession and lets scripts call the
+ * natives in the given nullable NecroNativeFuncSet;
+ * both must outlive it
+ */
+NecroCompiler necroCompilerMakeNatives(
+    NecroSession *sessionPtr,
+    NecroNativeFuncSet *nativeFuncSetPtr
+){
+    NecroCompiler toRet = necroCompilerMakeSession(
+        sessionPtr
+    );
+    toRet.nativeFuncSetPtr = nativeFuncSetPtr;
+    return toRet;
+}
+
 /*
  * Throws an error for the specified token with the
  * given message
@@ -304,7 +342,8 @@ static void necroCompilerError(
     compilerPtr->inPanicMode = true;
 
     #define bufferSize 50
-    static char buffer[bufferSize] = {0};
+    /* thread local since scripts compile in parallel */
+    static _Thread_local char buffer[bufferSize] = {0};
     snprintf(
         buffer,
         bufferSize - 1,
@@ -540,6 +579,12 @@ static NecroObjectFunc *necroCompilerEnd(
     }
     NecroObjectFunc *toRet 
         = compilerPtr->currentFuncCompilerPtr->funcPtr;
+
+    #ifndef NECRO_NO_OPTIMIZE
+    if(!(compilerPtr->hadError)){
+        necroOptimizerRun(&(toRet->program));
+    }
+    #endif
     
     #ifdef COMPILER_VERBOSE
     if(!(compilerPtr->hadError)){
@@ -673,6 +718,8 @@ static void necroCompilerExpressionPrecedence(
         return;
     }
     bool canAssign = precedence <= necro_precAssign;
+    /* parse funcs set the type if they know it */
+    compilerPtr->exprType = necro_nativeAny;
     prefixFunc(compilerPtr, canAssign);
 
     /*
@@ -713,6 +760,7 @@ void necroCompilerNumber(
             value = necroIntValue(atoi(
                 compilerPtr->prevToken.startPtr
             ));
+            compilerPtr->exprType = necro_nativeInt;
             break;
         case necro_tokenFloat:
             value = necroFloatValue(
@@ -721,6 +769,7 @@ void necroCompilerNumber(
                     NULL
                 )
             );
+            compilerPtr->exprType = necro_nativeFloat;
             break;
         default:
             pgError(
@@ -759,12 +808,14 @@ void necroCompilerUnary(
                 compilerPtr,
                 necro_not
             );
+            compilerPtr->exprType = necro_nativeBool;
             break;
         case necro_tokenMinus:
             necroCompilerWriteByte(
                 compilerPtr,
                 necro_negate
             );
+            /* negation keeps the type of the operand */
             break;
         default:
             /* do nothing */
@@ -772,6 +823,125 @@ void necroCompilerUnary(
     }
 }
 
+/*
+ * Returns the type of the result of the specified
+ * binary operator on operands of the given types, or
+ * any if it is not known
+ */
+static NecroNativeType necroCompilerBinaryType(
+    NecroTokenType operatorType,
+    NecroNativeType leftType,
+    NecroNativeType rightType
+){
+    bool bothInts = leftType == necro_nativeInt
+        && rightType == necro_nativeInt;
+    bool rightNumber = rightType == necro_nativeInt
+        || rightType == necro_nativeFloat;
+    bool bothNumbers = rightNumber
+        && (leftType == necro_nativeInt
+            || leftType == necro_nativeFloat);
+    switch(operatorType){
+        case necro_tokenPlus:
+        case necro_tokenMinus:
+            /* vector or point plus or minus vector */
+            if(rightType == necro_nativeVector
+                && (leftType == necro_nativeVector
+                    || leftType == necro_nativePoint)
+            ){
+                return leftType;
+            }
+            if(operatorType == necro_tokenMinus
+                && leftType == necro_nativePoint
+                && rightType == necro_nativePoint
+            ){
+                return necro_nativeVector;
+            }
+            break;
+        case necro_tokenStar:
+        case necro_tokenSlash:
+            if(leftType == necro_nativeVector
+                && rightNumber
+            ){
+                return necro_nativeVector;
+            }
+            break;
+        case necro_tokenPercent:
+            return bothInts
+                ? necro_nativeInt
+                : necro_nativeAny;
+        default:
+            /* equality and comparisons */
+            return necro_nativeBool;
+    }
+    /* otherwise, arithmetic on numbers */
+    if(bothInts){
+        return necro_nativeInt;
+    }
+    return bothNumbers
+        ? necro_nativeFloat
+        : necro_nativeAny;
+}
+
+/*
+ * Returns the typed vector opcode for the specified
+ * arithmetic operator on operands of the given types,
+ * or the given generic opcode if there is none
+ */
+static NecroInstruction necroCompilerVectorOpcode(
+    NecroTokenType operatorType,
+    NecroNativeType leftType,
+    NecroNativeType rightType,
+    NecroInstruction genericOpcode
+){
+    bool rightNumber = rightType == necro_nativeInt
+        || rightType == necro_nativeFloat;
+    switch(operatorType){
+        case necro_tokenPlus:
+            if(rightType == necro_nativeVector){
+                if(leftType == necro_nativeVector){
+                    return necro_addVectors;
+                }
+                if(leftType == necro_nativePoint){
+                    return necro_addPointVector;
+                }
+            }
+            break;
+        case necro_tokenMinus:
+            if(rightType == necro_nativeVector){
+                if(leftType == necro_nativeVector){
+                    return necro_subtractVectors;
+                }
+                if(leftType == necro_nativePoint){
+                    return necro_subtractPointVector;
+                }
+            }
+            if(rightType == necro_nativePoint
+                && leftType == necro_nativePoint
+            ){
+                return necro_subtractPoints;
+            }
+            break;
+        case necro_tokenStar:
+            if(leftType == necro_nativeVector
+                && rightNumber
+            ){
+                return necro_multiplyVector;
+            }
+            break;
+        case necro_tokenSlash:
+            if(leftType == necro_nativeVector
+                && rightNumber
+            ){
+                return necro_divideVector;
+            }
+            break;
+        default:
+            /* do nothing */
+            break;
+    }
+    return genericOpcode;
+}
+
 /*
  * Parses the next infix binary operator for the
  * specified compiler
@@ -786,6 +956,7 @@ void necroCompilerBinary(
      */
     NecroTokenType operatorType
         = compilerPtr->prevToken.type;
+    NecroNativeType leftType = compilerPtr->exprType;
     
     const NecroParseRule *rulePtr
         = getRule(operatorType);
@@ -793,29 +964,55 @@ void necroCompilerBinary(
         compilerPtr,
         rulePtr->precedence + 1
     );
+    NecroNativeType rightType = compilerPtr->exprType;
+    compilerPtr->exprType = necroCompilerBinaryType(
+        operatorType,
+        leftType,
+        rightType
+    );
     switch(operatorType){
         case necro_tokenPlus:
             necroCompilerWriteByte(
                 compilerPtr,
-                necro_add
+                necroCompilerVectorOpcode(
+                    operatorType,
+                    leftType,
+                    rightType,
+                    necro_add
+                )
             );
             break;
         case necro_tokenMinus:
             necroCompilerWriteByte(
                 compilerPtr,
-                necro_subtract
+                necroCompilerVectorOpcode(
+                    operatorType,
+                    leftType,
+                    rightType,
+                    necro_subtract
+                )
             );
             break;
         case necro_tokenStar:
             necroCompilerWriteByte(
                 compilerPtr,
-                necro_multiply
+                necroCompilerVectorOpcode(
+                    operatorType,
+                    leftType,
+                    rightType,
+                    necro_multiply
+                )
             );
             break;
         case necro_tokenSlash:
             necroCompilerWriteByte(
                 compilerPtr,
-                necro_divide
+                necroCompilerVectorOpcode(
+                    operatorType,
+                    leftType,
+                    rightType,
+                    necro_divide
+                )
             );
             break;
         case necro_tokenPercent:
@@ -966,15 +1163,34 @@ void necroCompilerIncludeDeclaration(
         &fileNameString,
         &(int){0} /* dummy */
     );
+    if(compilerPtr->includeListPtr){
+        String fileNameCopy = stringMakeC(
+            stringCharPtr(&fileNameString)
+        );
+        arrayListPushBackPtr(String,
+            compilerPtr->includeListPtr,
+            &fileNameCopy
+        );
+    }
 
     /* add a new lexer for the included file */
     arrayListPushBackPtr(NecroLexer,
         &(compilerPtr->lexerStack),
         &(compilerPtr->lexer)
     );
-    compilerPtr->lexer = necroLexerMake(
-        fileNameString._ptr
-    );
+    if(compilerPtr->sessionPtr){
+        compilerPtr->lexer = necroLexerMakeReplay(
+            necroSessionGetTokens(
+                compilerPtr->sessionPtr,
+                stringCharPtr(&fileNameString)
+            )
+        );
+    }
+    else{
+        compilerPtr->lexer = necroLexerMake(
+            stringCharPtr(&fileNameString)
+        );
+    }
 
 end:
     /*
@@ -1114,6 +1330,27 @@ static void necroCompilerDeclareVariable(
     );
 }
 
+/*
+ * Returns the index of the native function with the
+ * specified name, which is of the given length, in the
+ * native function set of the specified compiler, or
+ * -1 if there is no such native
+ */
+static int necroCompilerFindNative(
+    NecroCompiler *compilerPtr,
+    const char *name,
+    int length
+){
+    if(!(compilerPtr->nativeFuncSetPtr)){
+        return -1;
+    }
+    return necroNativeFuncSetFind(
+        compilerPtr->nativeFuncSetPtr,
+        name,
+        length
+    );
+}
+
 /*
  * Registers the global with the given name into the
  * global table; error if global is already defined
@@ -1135,6 +1372,17 @@ static void necroCompilerRegisterGlobal(
             "redefinition of global variable"
         );
     }
+    /* natives are globals of the virtual machine */
+    if(necroCompilerFindNative(
+        compilerPtr,
+        stringCharPtr(&(namePtr->string)),
+        (int)namePtr->string.length
+    ) != -1){
+        necroCompilerErrorPrev(
+            compilerPtr,
+            "redefinition of native function"
+        );
+    }
 
     hashMapPutPtr(NecroObjectString*, NecroGlobal,
         &(compilerPtr->globalsTable),
@@ -1732,11 +1980,25 @@ void necroCompilerYieldStatement(
 
 /*
  * Parses the next wait statement for the specified
- * compiler
+ * compiler; "wait for" followed by a number of ticks
+ * sleeps for that long, otherwise the statement
+ * yields until its condition is true
  */
 void necroCompilerWaitStatement(
     NecroCompiler *compilerPtr
 ){
+    /* match a sleep for a number of ticks */
+    if(necroCompilerMatch(compilerPtr, necro_tokenFor)){
+        necroCompilerExpression(compilerPtr);
+        necroCompilerConsume(
+            compilerPtr,
+            necro_tokenSemicolon,
+            "Expect ';' after wait statement"
+        );
+        necroCompilerWriteByte(compilerPtr, necro_sleep);
+        return;
+    }
+
     /* save index before the condition check */
     int loopStartIndex
         = necroCompilerGetCurrentProgram(compilerPtr)
@@ -1938,6 +2200,117 @@ void necroCompilerCall(
         necro_call,
         numArgs
     );
+    compilerPtr->exprType = necro_nativeAny;
+}
+
+/*
+ * Parses a call to the native function at the
+ * specified index in the native function set of the
+ * given compiler, from its '('; errors if the call
+ * does not fit the signature of the native. The call
+ * skips checking its arguments at run time if all of
+ * them are proven to be of the declared types
+ */
+static void necroCompilerNativeCall(
+    NecroCompiler *compilerPtr,
+    int nativeIndex
+){
+    const NecroNativeSignature *signaturePtr
+        = necroNativeFuncSetGetPair(
+            compilerPtr->nativeFuncSetPtr,
+            nativeIndex
+        )->_signaturePtr;
+    bool proven = signaturePtr != NULL;
+    uint8_t numArgs = 0;
+
+    necroCompilerConsume(
+        compilerPtr,
+        necro_tokenLeftParen,
+        "Expect '(' before native args"
+    );
+    if(!necroCompilerCheckType(
+        compilerPtr,
+        necro_tokenRightParen
+    )){
+        do{
+            necroCompilerExpression(compilerPtr);
+            if(numArgs == maxParams){
+                necroCompilerErrorPrev(
+                    compilerPtr,
+                    "too many arguments"
+                );
+            }
+            if(signaturePtr
+                && (numArgs < signaturePtr->paramCount
+                    || signaturePtr->variadic)
+            ){
+                NecroNativeType paramType
+                    = necroNativeSignatureParamType(
+                        signaturePtr,
+                        numArgs
+                    );
+                NecroNativeType argType
+                    = compilerPtr->exprType;
+                bool isNumber
+                    = argType == necro_nativeInt
+                        || argType == necro_nativeFloat;
+                if(paramType == necro_nativeAny
+                    || paramType == argType
+                    || (paramType == necro_nativeNumber
+                        && isNumber)
+                ){
+                    /* proven to fit */
+                }
+                /*
+                 * ints passed as floats need converting
+                 * and numbers may be either
+                 */
+                else if(argType == necro_nativeAny
+                    || (paramType == necro_nativeFloat
+                        && argType == necro_nativeInt)
+                    || (argType == necro_nativeNumber
+                        && (paramType == necro_nativeInt
+                            || paramType
+                                == necro_nativeFloat))
+                ){
+                    proven = false;
+                }
+                else{
+                    necroCompilerErrorPrev(
+                        compilerPtr,
+                        "wrong type of argument to native"
+                    );
+                }
+            }
+            ++numArgs;
+        } while(necroCompilerMatch(
+            compilerPtr,
+            necro_tokenComma
+        ));
+    }
+    necroCompilerConsume(
+        compilerPtr,
+        necro_tokenRightParen,
+        "Expect ')' after args"
+    );
+    if(signaturePtr && !necroNativeSignatureAcceptsArity(
+        signaturePtr,
+        numArgs
+    )){
+        necroCompilerErrorPrev(
+            compilerPtr,
+            "wrong number of arguments to native"
+        );
+    }
+    necroCompilerWriteBytes(
+        compilerPtr,
+        proven ? necro_callNativeFast : necro_callNative,
+        (uint8_t)nativeIndex
+    );
+    necroCompilerWriteByte(compilerPtr, numArgs);
+    compilerPtr->exprType = signaturePtr
+        ? signaturePtr->returnType
+        : necro_nativeAny;
 }
 
 /*
@@ -2012,7 +2385,7 @@ static NecroLocalLocation necroCompilerResolveLocal(
 /*
  * Returns true if the global variable specified by
  * necro string is mutable, false otherwise; error if
- * no such global exists
+ * no such global exists. Natives are immutable
  */
 static bool necroCompilerIsGlobalMutable(
     NecroCompiler *compilerPtr,
@@ -2025,6 +2398,13 @@ static bool necroCompilerIsGlobalMutable(
         &(compilerPtr->globalsTable),
         &(namePtr)
     )){
+        if(necroCompilerFindNative(
+            compilerPtr,
+            stringCharPtr(&(namePtr->string)),
+            (int)namePtr->string.length
+        ) != -1){
+            return false;
+        }
         necroCompilerErrorPrev(
             compilerPtr,
             "unrecognized global variable"
@@ -2070,6 +2450,31 @@ static void necroCompilerNamedVariable(
     bool isLocal = (arg != -1);
     bool mutable = false;
 
+    /*
+     * natives which are called straight away are
+     * called by index, unless they do not fit in the
+     * byte of the instruction
+     */
+    if(!isLocal && necroCompilerCheckType(
+        compilerPtr,
+        necro_tokenLeftParen
+    )){
+        int nativeIndex = necroCompilerFindNative(
+            compilerPtr,
+            varName.startPtr,
+            varName.length
+        );
+        if(nativeIndex != -1
+            && nativeIndex <= UINT8_MAX
+        ){
+            necroCompilerNativeCall(
+                compilerPtr,
+                nativeIndex
+            );
+            return;
+        }
+    }
+
     /* if variable was resolved to a local */
     if(isLocal){
         getOp = necro_getLocal;
@@ -2179,6 +2584,7 @@ static void necroCompilerNamedVariable(
                     localLocation.accessJumps
                 );
             }
+            compilerPtr->exprType = necro_nativeAny;
         }
         /* otherwise member get */
         else{
@@ -2197,6 +2603,7 @@ static void necroCompilerNamedVariable(
                 compilerPtr,
                 memberGetOp
             );
+            compilerPtr->exprType = necro_nativeFloat;
         }
     }
     /* if following token is :=, assignment */
@@ -2381,6 +2788,7 @@ void necroCompilerLambda(
             necroObjectValue(funcPtr)
         )
     );
+    compilerPtr->exprType = necro_nativeAny;
 }
 
 /*
@@ -2408,6 +2816,7 @@ void necroCompilerString(
             )
         )
     );
+    compilerPtr->exprType = necro_nativeString;
 }
 
 /*
@@ -2429,6 +2838,7 @@ void necroCompilerAnd(
             compilerPtr,
             necro_jumpIfFalse
         );
+    NecroNativeType leftType = compilerPtr->exprType;
     necroCompilerWriteByte(compilerPtr, necro_pop);
     necroCompilerExpressionPrecedence(
         compilerPtr,
@@ -2438,6 +2848,10 @@ void necroCompilerAnd(
         compilerPtr,
         endJumpInstructionIndex
     );
+    /* either side may be the result */
+    if(leftType != compilerPtr->exprType){
+        compilerPtr->exprType = necro_nativeAny;
+    }
 }
 
 /*
@@ -2465,6 +2879,7 @@ void necroCompilerOr(
         compilerPtr,
         elseJumpInstructionIndex
     );
+    NecroNativeType leftType = compilerPtr->exprType;
     necroCompilerWriteByte(compilerPtr, necro_pop);
     necroCompilerExpressionPrecedence(
         compilerPtr,
@@ -2474,6 +2889,10 @@ void necroCompilerOr(
         compilerPtr,
         endJumpInstructionIndex
     );
+    /* either side may be the result */
+    if(leftType != compilerPtr->exprType){
+        compilerPtr->exprType = necro_nativeAny;
+    }
 }
 
 /*
@@ -2503,6 +2922,7 @@ void necroCompilerBool(
             );
             return;
     }
+    compilerPtr->exprType = necro_nativeBool;
 }
 
 /* Parses a vector for the specified compiler */
@@ -2535,6 +2955,7 @@ void necroCompilerVector(
         compilerPtr,
         necro_makeVector
     );
+    compilerPtr->exprType = necro_nativeVector;
 }
 
 /* Parses a point for the specified compiler */
@@ -2567,6 +2988,7 @@ void necroCompilerPoint(
         compilerPtr,
         necro_makePoint
     );
+    compilerPtr->exprType = necro_nativePoint;
 }
 
 /*
@@ -2617,6 +3039,7 @@ void necroCompilerDot(
             break;
     }
     necroCompilerWriteByte(compilerPtr, instruction);
+    compilerPtr->exprType = necro_nativeFloat;
 
     /* for set operations, see NamedVariable */
 }
@@ -2661,7 +3084,13 @@ void necroCompilerReset(NecroCompiler *compilerPtr){
     );
     necroCompilerFreeIncludedFileNames(compilerPtr);
 
+    /* the session and natives outlive the reset */
+    NecroSession *sessionPtr = compilerPtr->sessionPtr;
+    NecroNativeFuncSet *nativeFuncSetPtr
+        = compilerPtr->nativeFuncSetPtr;
     memset(compilerPtr, 0, sizeof(*compilerPtr));
+    compilerPtr->sessionPtr = sessionPtr;
+    compilerPtr->nativeFuncSetPtr = nativeFuncSetPtr;
     compilerPtr->hadError = false;
     compilerPtr->inPanicMode = false;
     compilerPtr->lexerStack = arrayListMake(
@@ -2713,9 +3142,28 @@ void necroCompilerFree(NecroCompiler *compilerPtr){
 NecroObjectFunc *necroCompilerCompileScript(
     NecroCompiler *compilerPtr,
     const char *fileName
+){
+    return necroCompilerCompileScriptIncludes(
+        compilerPtr,
+        fileName,
+        NULL
+    );
+}
+
+/*
+ * compiles the specified Necro source file like
+ * necroCompilerCompileScript and also pushes the name
+ * of every file it includes, in order, to the back of
+ * the given arraylist of String
+ */
+NecroObjectFunc *necroCompilerCompileScriptIncludes(
+    NecroCompiler *compilerPtr,
+    const char *fileName,
+    ArrayList *includeListPtr
 ){
     /* reset the compiler; nulls the funcPtr also */
     necroCompilerReset(compilerPtr);
+    compilerPtr->includeListPtr = includeListPtr;
     /* freed when the compiler is freed below */
     compilerPtr->lexer = necroLexerMake(fileName);
 
@@ -2760,6 +3208,14 @@ NecroObjectFunc *necroCompilerCompileScript(
     }
 
     necroCompilerReset(compilerPtr);
-    
+
+    if(toRet){
+        necroAotBind(toRet, fileName);
+    }
+    #ifdef NECRO_PROFILE
+    if(toRet){
+        necroProfilerNameScript(toRet, fileName);
+    }
+    #endif
     return toRet;
 }
\ No newline at end of file
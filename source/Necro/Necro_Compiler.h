@@ -7,6 +7,8 @@
 #include "Necro_Program.h"
 #include "Necro_Instruction.h"
 #include "Necro_Object.h"
+#include "Necro_NativeFuncSet.h"
+#include "Necro_Session.h"
 
 #define _uint8_t_count (UINT8_MAX + 1)
 
@@ -80,6 +82,29 @@ typedef struct NecroCompiler{
      * recursive or cyclical includes
      */
     HashMap includedFileNames;
+    /*
+     * nullable arraylist of String which receives the
+     * name of every file included by the script being
+     * compiled; not owned
+     */
+    ArrayList *includeListPtr;
+    /*
+     * nullable session from which included files are
+     * taken; not owned
+     */
+    NecroSession *sessionPtr;
+    /*
+     * nullable set of the native functions which
+     * scripts may call; calls to them are checked
+     * against their signatures. The virtual machine
+     * must run scripts with the same set; not owned
+     */
+    NecroNativeFuncSet *nativeFuncSetPtr;
+    /*
+     * the type of the value of the expression just
+     * parsed, if known; any otherwise
+     */
+    NecroNativeType exprType;
     bool hadError;
     bool inPanicMode;
 } NecroCompiler;
@@ -89,6 +114,27 @@ typedef struct NecroCompiler{
  */
 NecroCompiler necroCompilerMake();
 
+/*
+ * Constructs and returns a new NecroCompiler by value
+ * which takes the files it includes from the given
+ * NecroSession, which must outlive it
+ */
+NecroCompiler necroCompilerMakeSession(
+    NecroSession *sessionPtr
+);
+
+/*
+ * Constructs and returns a new NecroCompiler by value
+ * which takes the files it includes from the given
+ * nullable NecroSession and lets scripts call the
+ * natives in the given nullable NecroNativeFuncSet;
+ * both must outlive it
+ */
+NecroCompiler necroCompilerMakeNatives(
+    NecroSession *sessionPtr,
+    NecroNativeFuncSet *nativeFuncSetPtr
+);
+
 /* Parses the next number for the specified compiler */
 void necroCompilerNumber(
     NecroCompiler *compilerPtr,
@@ -187,7 +233,9 @@ void necroCompilerYieldStatement(NecroCompiler *compilerPtr);
 
 /*
  * Parses the next wait statement for the specified
- * compiler
+ * compiler; "wait for" followed by a number of ticks
+ * sleeps for that long, otherwise the statement
+ * yields until its condition is true
  */
 void necroCompilerWaitStatement(NecroCompiler *compilerPtr);
 
@@ -322,4 +370,16 @@ NecroObjectFunc *necroCompilerCompileScript(
     const char *fileName
 );
 
+/*
+ * compiles the specified Necro source file like
+ * necroCompilerCompileScript and also pushes the name
+ * of every file it includes, in order, to the back of
+ * the given arraylist of String
+ */
+NecroObjectFunc *necroCompilerCompileScriptIncludes(
+    NecroCompiler *compilerPtr,
+    const char *fileName,
+    ArrayList *includeListPtr
+);
+
 #endif
\ No newline at end of file
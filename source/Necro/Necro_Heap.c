@@ -0,0 +1,258 @@
+#include "Necro_Heap.h"
+
+#include <string.h>
+
+/* slots in each block of a heap */
+#define blockSlotCount 64
+#define blockListInitCapacity 4
+/* a cycle never starts with fewer objects than this */
+#define minCycleCount 256
+
+/* A slot big enough for any object in a heap */
+typedef union _NecroHeapSlot{
+    NecroObjectString string;
+    NecroObjectNativeFunc nativeFunc;
+} _NecroHeapSlot;
+
+/* Constructs and returns a new NecroHeap by value */
+NecroHeap necroHeapMake(){
+    NecroHeap toRet = {0};
+    toRet.phase = necro_heapIdle;
+    toRet._cycleCount = minCycleCount;
+    /* no blocks yet; the first alloc makes the list */
+    return toRet;
+}
+
+/*
+ * Moves the specified heap on to its next block,
+ * allocating the block if it does not yet exist
+ */
+static void necroHeapNextBlock(NecroHeap *heapPtr){
+    if(!(heapPtr->_blockList._ptr)){
+        heapPtr->_blockList = arrayListMake(
+            _NecroHeapSlot*,
+            blockListInitCapacity
+        );
+    }
+    if(heapPtr->_bumpPtr){
+        ++(heapPtr->_blockIndex);
+    }
+    if(heapPtr->_blockIndex
+        == heapPtr->_blockList.size
+    ){
+        _NecroHeapSlot *blockPtr = pgAlloc(
+            blockSlotCount,
+            sizeof(_NecroHeapSlot)
+        );
+        arrayListPushBack(_NecroHeapSlot*,
+            &(heapPtr->_blockList),
+            blockPtr
+        );
+    }
+    _NecroHeapSlot *blockPtr = arrayListGet(
+        _NecroHeapSlot*,
+        &(heapPtr->_blockList),
+        heapPtr->_blockIndex
+    );
+    heapPtr->_bumpPtr = (uint8_t*)blockPtr;
+    heapPtr->_bumpEndPtr
+        = (uint8_t*)(blockPtr + blockSlotCount);
+}
+
+/*
+ * Allocates a zeroed object of the specified type in
+ * the given heap and returns a pointer to it; only
+ * strings and native funcs may be allocated in a heap
+ */
+NecroObject *necroHeapAlloc(
+    NecroHeap *heapPtr,
+    NecroObjectType type
+){
+    assertTrue(
+        type == necro_stringObject
+            || type == necro_nativeFuncObject,
+        "bad type for heap alloc; " SRC_LOCATION
+    );
+    NecroObject *toRet = NULL;
+    /* reuse the slot of a collected object first */
+    if(heapPtr->_freeListPtr){
+        toRet = heapPtr->_freeListPtr;
+        heapPtr->_freeListPtr = toRet->nextPtr;
+    }
+    else{
+        if(heapPtr->_bumpPtr == heapPtr->_bumpEndPtr){
+            necroHeapNextBlock(heapPtr);
+        }
+        toRet = (NecroObject*)heapPtr->_bumpPtr;
+        heapPtr->_bumpPtr += sizeof(_NecroHeapSlot);
+    }
+    memset(toRet, 0, sizeof(_NecroHeapSlot));
+    toRet->type = type;
+    toRet->collectable = true;
+    /*
+     * objects made while sweeping are live; they sit
+     * ahead of the sweep and must survive it
+     */
+    toRet->mark = heapPtr->phase == necro_heapSweep
+        ? heapPtr->_liveMark
+        : !(heapPtr->_liveMark);
+
+    toRet->nextPtr = heapPtr->objectListHeadPtr;
+    heapPtr->objectListHeadPtr = toRet;
+    ++(heapPtr->objectCount);
+    return toRet;
+}
+
+/*
+ * Returns true if the specified heap has grown enough
+ * that a collection cycle should begin, false
+ * otherwise
+ */
+bool necroHeapCycleDue(NecroHeap *heapPtr){
+    return heapPtr->phase == necro_heapIdle
+        && heapPtr->objectCount >= heapPtr->_cycleCount;
+}
+
+/*
+ * Marks the specified object as reachable in the
+ * current cycle of the given heap; does nothing if
+ * the object does not belong to a heap
+ */
+void necroHeapMark(
+    NecroHeap *heapPtr,
+    NecroObject *objectPtr
+){
+    /* compiled objects are shared; never write them */
+    if(objectPtr->collectable){
+        objectPtr->mark = heapPtr->_liveMark;
+    }
+}
+
+/*
+ * Marks the specified value as reachable in the
+ * current cycle of the given heap if it is an object
+ */
+void necroHeapMarkValue(
+    NecroHeap *heapPtr,
+    NecroValue value
+){
+    if(necroIsObject(value)){
+        necroHeapMark(heapPtr, necroAsObject(value));
+    }
+}
+
+/*
+ * Starts sweeping the specified heap; every root
+ * should have been marked beforehand
+ */
+void necroHeapStartSweep(NecroHeap *heapPtr){
+    heapPtr->phase = necro_heapSweep;
+    heapPtr->_sweepPtrPtr
+        = &(heapPtr->objectListHeadPtr);
+}
+
+/*
+ * Frees the specified object of the given heap and
+ * returns its slot to the free list; the object
+ * should already be unlinked from the object list
+ */
+static void necroHeapFreeObject(
+    NecroHeap *heapPtr,
+    NecroObject *objectPtr
+){
+    /* frees the string contents but not the slot */
+    necroObjectFree(objectPtr);
+    objectPtr->nextPtr = heapPtr->_freeListPtr;
+    heapPtr->_freeListPtr = objectPtr;
+    --(heapPtr->objectCount);
+}
+
+/*
+ * Sweeps at most the given number of objects of the
+ * specified heap, freeing those which were not marked
+ * and removing freed strings from the given string
+ * interning hashmap; the heap goes idle once every
+ * object has been swept
+ */
+void necroHeapSweep(
+    NecroHeap *heapPtr,
+    HashMap *stringMapPtr,
+    size_t budget
+){
+    if(heapPtr->phase != necro_heapSweep){
+        return;
+    }
+    NecroObject **sweepPtrPtr = heapPtr->_sweepPtrPtr;
+    for(size_t i = 0; i < budget && *sweepPtrPtr; ++i){
+        NecroObject *objectPtr = *sweepPtrPtr;
+        if(objectPtr->mark == heapPtr->_liveMark){
+            sweepPtrPtr = &(objectPtr->nextPtr);
+            continue;
+        }
+        *sweepPtrPtr = objectPtr->nextPtr;
+        /* the intern map must not hand it out again */
+        if(objectPtr->type == necro_stringObject){
+            NecroObjectString *stringPtr
+                = (NecroObjectString*)objectPtr;
+            hashMapRemove(NecroObjectString*, NecroValue,
+                stringMapPtr,
+                stringPtr
+            );
+        }
+        necroHeapFreeObject(heapPtr, objectPtr);
+    }
+    heapPtr->_sweepPtrPtr = sweepPtrPtr;
+
+    /* finish the cycle once the list is swept */
+    if(!(*sweepPtrPtr)){
+        heapPtr->phase = necro_heapIdle;
+        heapPtr->_sweepPtrPtr = NULL;
+        heapPtr->_liveMark = !(heapPtr->_liveMark);
+        heapPtr->_cycleCount = heapPtr->objectCount * 2;
+        if(heapPtr->_cycleCount < minCycleCount){
+            heapPtr->_cycleCount = minCycleCount;
+        }
+    }
+}
+
+/*
+ * Frees every object in the specified heap but keeps
+ * its blocks for reuse
+ */
+void necroHeapClear(NecroHeap *heapPtr){
+    NecroObject *currentPtr = heapPtr->objectListHeadPtr;
+    NecroObject *nextPtr = NULL;
+    while(currentPtr){
+        nextPtr = currentPtr->nextPtr;
+        necroObjectFree(currentPtr);
+        currentPtr = nextPtr;
+    }
+
+    ArrayList blockList = heapPtr->_blockList;
+    memset(heapPtr, 0, sizeof(*heapPtr));
+    heapPtr->_blockList = blockList;
+    heapPtr->phase = necro_heapIdle;
+    heapPtr->_cycleCount = minCycleCount;
+}
+
+/*
+ * Frees the memory associated with the specified
+ * NecroHeap and every object in it
+ */
+void necroHeapFree(NecroHeap *heapPtr){
+    necroHeapClear(heapPtr);
+    if(heapPtr->_blockList._ptr){
+        for(size_t i = 0; i < heapPtr->_blockList.size;
+            ++i
+        ){
+            pgFree(arrayListGet(_NecroHeapSlot*,
+                &(heapPtr->_blockList),
+                i
+            ));
+        }
+        arrayListFree(_NecroHeapSlot*,
+            &(heapPtr->_blockList)
+        );
+    }
+    memset(heapPtr, 0, sizeof(*heapPtr));
+}
\ No newline at end of file
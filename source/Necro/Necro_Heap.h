@@ -0,0 +1,122 @@
+#ifndef NECRO_HEAP_H
+#define NECRO_HEAP_H
+
+#include "Necro_Object.h"
+
+/* the phases of a heap collection cycle */
+typedef enum NecroHeapPhase{
+    /* waiting for enough objects to start a cycle */
+    necro_heapIdle,
+    /* roots are marked; sweeping a few at a time */
+    necro_heapSweep
+} NecroHeapPhase;
+
+/*
+ * Allocates the objects a virtual machine creates at
+ * run time by bumping through blocks of fixed size
+ * slots, reusing the slots of collected objects, and
+ * holds the state of its incremental mark-sweep
+ * collector
+ */
+typedef struct NecroHeap{
+    /*
+     * arraylist of pointers to slot blocks, made on
+     * the first alloc; owned
+     */
+    ArrayList _blockList;
+    /* index of the block being bump allocated from */
+    size_t _blockIndex;
+    /* next unused slot of the current block */
+    uint8_t *_bumpPtr;
+    /* one past the last slot of the current block */
+    uint8_t *_bumpEndPtr;
+    /* slots of collected objects, through nextPtr */
+    NecroObject *_freeListPtr;
+    /* head of the list of every object in the heap */
+    NecroObject *objectListHeadPtr;
+    /* points to the link to the next object to sweep */
+    NecroObject **_sweepPtrPtr;
+    NecroHeapPhase phase;
+    /*
+     * the mark of objects found reachable in the
+     * current cycle; flips after every sweep so that
+     * marks need not be cleared
+     */
+    bool _liveMark;
+    /* number of objects in the heap */
+    size_t objectCount;
+    /* object count at which the next cycle starts */
+    size_t _cycleCount;
+} NecroHeap;
+
+/* Constructs and returns a new NecroHeap by value */
+NecroHeap necroHeapMake();
+
+/*
+ * Allocates a zeroed object of the specified type in
+ * the given heap and returns a pointer to it; only
+ * strings and native funcs may be allocated in a heap
+ */
+NecroObject *necroHeapAlloc(
+    NecroHeap *heapPtr,
+    NecroObjectType type
+);
+
+/*
+ * Returns true if the specified heap has grown enough
+ * that a collection cycle should begin, false
+ * otherwise
+ */
+bool necroHeapCycleDue(NecroHeap *heapPtr);
+
+/*
+ * Marks the specified object as reachable in the
+ * current cycle of the given heap; does nothing if
+ * the object does not belong to a heap
+ */
+void necroHeapMark(
+    NecroHeap *heapPtr,
+    NecroObject *objectPtr
+);
+
+/*
+ * Marks the specified value as reachable in the
+ * current cycle of the given heap if it is an object
+ */
+void necroHeapMarkValue(
+    NecroHeap *heapPtr,
+    NecroValue value
+);
+
+/*
+ * Starts sweeping the specified heap; every root
+ * should have been marked beforehand
+ */
+void necroHeapStartSweep(NecroHeap *heapPtr);
+
+/*
+ * Sweeps at most the given number of objects of the
+ * specified heap, freeing those which were not marked
+ * and removing freed strings from the given string
+ * interning hashmap; the heap goes idle once every
+ * object has been swept
+ */
+void necroHeapSweep(
+    NecroHeap *heapPtr,
+    HashMap *stringMapPtr,
+    size_t budget
+);
+
+/*
+ * Frees every object in the specified heap but keeps
+ * its blocks for reuse
+ */
+void necroHeapClear(NecroHeap *heapPtr);
+
+/*
+ * Frees the memory associated with the specified
+ * NecroHeap and every object in it
+ */
+void necroHeapFree(NecroHeap *heapPtr);
+
+#endif
\ No newline at end of file
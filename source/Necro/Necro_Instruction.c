@@ -0,0 +1,77 @@
+#include "Necro_Instruction.h"
+
+/*
+ * Returns the number of bytes taken by the specified
+ * opcode including its operands, or 0 if the opcode
+ * is unknown
+ */
+size_t necroInstructionLength(uint8_t opcode){
+    switch(opcode){
+        case necro_lessLocalLiteralJump:
+        case necro_greaterLocalLiteralJump:
+            return 6;
+        case necro_addLocalLiteral:
+            return 4;
+        case necro_getLocal:
+        case necro_setLocal:
+        case necro_setRLocal:
+        case necro_setThetaLocal:
+        case necro_setXLocal:
+        case necro_setYLocal:
+        case necro_jump:
+        case necro_jumpIfFalse:
+        case necro_loop:
+        case necro_callPop:
+        case necro_callNative:
+        case necro_callNativeFast:
+        case necro_callNativePop:
+        case necro_callNativeFastPop:
+            return 3;
+        case necro_literal:
+        case necro_defineGlobal:
+        case necro_getGlobal:
+        case necro_setGlobal:
+        case necro_setRGlobal:
+        case necro_setThetaGlobal:
+        case necro_setXGlobal:
+        case necro_setYGlobal:
+        case necro_call:
+            return 2;
+        case necro_pop:
+        case necro_true:
+        case necro_false:
+        case necro_add:
+        case necro_subtract:
+        case necro_multiply:
+        case necro_divide:
+        case necro_modulo:
+        case necro_negate:
+        case necro_addVectors:
+        case necro_subtractVectors:
+        case necro_addPointVector:
+        case necro_subtractPointVector:
+        case necro_subtractPoints:
+        case necro_multiplyVector:
+        case necro_divideVector:
+        case necro_equal:
+        case necro_greater:
+        case necro_less:
+        case necro_not:
+        case necro_makeVector:
+        case necro_makePoint:
+        case necro_getR:
+        case necro_getTheta:
+        case necro_getX:
+        case necro_getY:
+        case necro_print:
+        case necro_return:
+        case necro_yield:
+        case necro_sleep:
+        case necro_end:
+        case necro_pointDistance:
+        case necro_pointAngle:
+            return 1;
+        default:
+            return 0;
+    }
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef NECRO_INSTRUCTION_H
 #define NECRO_INSTRUCTION_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 typedef enum NecroInstruction {
     /*
      * instructs VM to load a literal value;
@@ -47,6 +50,28 @@ typedef enum NecroInstruction {
     necro_modulo,
     /* unary negation */
     necro_negate,
+    /*
+     * the vector arithmetic below is only emitted when
+     * the compiler knows the types of the operands,
+     * and skips the checks of the generic operators
+     */
+    /* vector plus vector */
+    necro_addVectors,
+    /* vector minus vector */
+    necro_subtractVectors,
+    /* point plus vector, giving a point */
+    necro_addPointVector,
+    /* point minus vector, giving a point */
+    necro_subtractPointVector,
+    /*
+     * point minus point, giving the vector from the
+     * second to the first
+     */
+    necro_subtractPoints,
+    /* vector times number */
+    necro_multiplyVector,
+    /* vector divided by number */
+    necro_divideVector,
     /* binary equality comparison */
     necro_equal,
     /* binary greater comparison */
@@ -102,6 +127,20 @@ typedef enum NecroInstruction {
     necro_loop,
     /* calls a function */
     necro_call,
+    /*
+     * calls a native function by its index in the
+     * native function set, with no callee on the
+     * stack, checking the arguments against its
+     * signature; FORMAT: [op][index][numArgs]
+     */
+    necro_callNative,
+    /*
+     * calls a native function like callNative but
+     * without checking its arguments, which the
+     * compiler has proven to fit its signature;
+     * FORMAT: [op][index][numArgs]
+     */
+    necro_callNativeFast,
     /* returns values from functions */
     necro_return,
     /*
@@ -109,8 +148,80 @@ typedef enum NecroInstruction {
      * preserves its state
      */
     necro_yield,
+    /*
+     * pops a number of ticks and yields, skipping
+     * that many resumes less one before running again;
+     * does not yield if the number is not positive
+     */
+    necro_sleep,
     /* ends the execution of a program */
     necro_end,
+
+    /*
+     * superinstructions; each fuses a sequence of the
+     * above which is common in scripts and behaves
+     * exactly like that sequence
+     */
+
+    /*
+     * adds a literal number to a local, storing the
+     * sum and leaving it on the stack; fuses
+     * getLocal, literal, add, setLocal;
+     * FORMAT: [op][slot][jumps][index]
+     */
+    necro_addLocalLiteral,
+    /*
+     * pushes whether a local is less than a literal
+     * number and jumps the specified distance if not;
+     * fuses getLocal, literal, less, jumpIfFalse;
+     * FORMAT: [op][slot][jumps][index][distance x2]
+     */
+    necro_lessLocalLiteralJump,
+    /*
+     * pushes whether a local is greater than a literal
+     * number and jumps the specified distance if not;
+     * fuses getLocal, literal, greater, jumpIfFalse;
+     * FORMAT: [op][slot][jumps][index][distance x2]
+     */
+    necro_greaterLocalLiteralJump,
+    /*
+     * calls a function and discards its result; fuses
+     * call, pop. The last byte is a real pop which runs
+     * when a script function returns;
+     * FORMAT: [op][numArgs][pop]
+     */
+    necro_callPop,
+    /*
+     * pushes the distance between two points; fuses
+     * subtractPoints, getR
+     */
+    necro_pointDistance,
+    /*
+     * pushes the angle from the second of two points
+     * to the first in degrees; fuses subtractPoints,
+     * getTheta
+     */
+    necro_pointAngle,
+    /*
+     * calls a native function and discards its
+     * result; fuses callNative, pop;
+     * FORMAT: [op][index][numArgs]
+     */
+    necro_callNativePop,
+    /*
+     * calls a native function without checking its
+     * arguments and discards its result; fuses
+     * callNativeFast, pop;
+     * FORMAT: [op][index][numArgs]
+     */
+    necro_callNativeFastPop,
 } NecroInstruction;
 
+/*
+ * Returns the number of bytes taken by the specified
+ * opcode including its operands, or 0 if the opcode
+ * is unknown
+ */
+size_t necroInstructionLength(uint8_t opcode);
+
 #endif
\ No newline at end of file
@@ -67,6 +67,17 @@ NecroLexer necroLexerMake(const char *fileName){
     return toRet;
 }
 
+/*
+ * Constructs and returns a lexer which replays the
+ * specified already lexed tokens, which must end
+ * with an EOF token
+ */
+NecroLexer necroLexerMakeReplay(const NecroToken *tokenPtr){
+    NecroLexer toRet = {0};
+    toRet.replayPtr = tokenPtr;
+    return toRet;
+}
+
 /*
  * Creates a new token of the specified type based on
  * the current state of the given lexer
@@ -456,6 +467,15 @@ NecroToken necroLexerMakeIdentifier(NecroLexer *lexerPtr){
 
 /* Gets the next token from the specified lexer */
 NecroToken necroLexerNext(NecroLexer *lexerPtr){
+    if(lexerPtr->replayPtr){
+        NecroToken toRet = *(lexerPtr->replayPtr);
+        /* stay on the EOF token once reached */
+        if(toRet.type != necro_tokenEOF){
+            ++(lexerPtr->replayPtr);
+        }
+        return toRet;
+    }
+
     necroLexerSkipWhitespace(lexerPtr);
     lexerPtr->startPtr = lexerPtr->currentPtr;
 
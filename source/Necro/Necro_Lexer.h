@@ -16,6 +16,12 @@ typedef struct NecroLexer{
     char *currentPtr;
     /* line number of current token */
     size_t lineNumber;
+    /*
+     * if not NULL, the lexer replays the tokens from
+     * here, which end with an EOF token, instead of
+     * scanning source code; not owned
+     */
+    const NecroToken *replayPtr;
 } NecroLexer;
 
 /*
@@ -24,6 +30,13 @@ typedef struct NecroLexer{
  */
 NecroLexer necroLexerMake(const char *fileName);
 
+/*
+ * Constructs and returns a lexer which replays the
+ * specified already lexed tokens, which must end
+ * with an EOF token
+ */
+NecroLexer necroLexerMakeReplay(const NecroToken *tokenPtr);
+
 /* Gets the next token from the specified lexer */
 NecroToken necroLexerNext(NecroLexer *lexerPtr);
 
@@ -2,6 +2,195 @@
 
 #define nameNativeFuncSetInitCapacity 20
 
+/*
+ * Returns the native type written as the specified
+ * character in a signature spec; error if there is no
+ * such type
+ */
+static NecroNativeType necroNativeTypeParse(char typeChar){
+    switch(typeChar){
+        case 'a':
+            return necro_nativeAny;
+        case 'b':
+            return necro_nativeBool;
+        case 'i':
+            return necro_nativeInt;
+        case 'f':
+            return necro_nativeFloat;
+        case 'n':
+            return necro_nativeNumber;
+        case 'v':
+            return necro_nativeVector;
+        case 'p':
+            return necro_nativePoint;
+        case 's':
+            return necro_nativeString;
+        default:
+            pgError(
+                "bad type in native signature spec; "
+                SRC_LOCATION
+            );
+            return necro_nativeAny;
+    }
+}
+
+/*
+ * Parses and returns the signature described by the
+ * specified spec by value; error if the spec is
+ * malformed. A spec is the return type, a colon, and
+ * the param types, each a single character: a for any,
+ * b bool, i int, f float, n number, v vector, p point,
+ * and s string. Params following a bar are optional
+ * and a star after the last param lets it repeat, e.g.
+ * "b:spvi|ssss" or "n:n*"
+ */
+NecroNativeSignature necroNativeSignatureParse(
+    const char *spec
+){
+    assertNotNull(
+        spec,
+        "null passed to native signature parse; "
+        SRC_LOCATION
+    );
+    NecroNativeSignature toRet = {0};
+    assertTrue(
+        spec[0] && spec[1] == ':',
+        "native signature spec must start with the "
+        "return type and a colon; "
+        SRC_LOCATION
+    );
+    toRet.returnType = necroNativeTypeParse(spec[0]);
+    toRet.minArity = -1;
+    for(const char *charPtr = spec + 2;
+        *charPtr;
+        ++charPtr
+    ){
+        if(*charPtr == '|'){
+            assertTrue(
+                toRet.minArity == -1,
+                "more than one bar in native signature "
+                "spec; "
+                SRC_LOCATION
+            );
+            toRet.minArity = toRet.paramCount;
+            continue;
+        }
+        if(*charPtr == '*'){
+            assertTrue(
+                toRet.paramCount > 0 && !charPtr[1],
+                "star must follow the last param of a "
+                "native signature spec; "
+                SRC_LOCATION
+            );
+            toRet.variadic = true;
+            continue;
+        }
+        assertTrue(
+            toRet.paramCount < NECRO_NATIVE_MAX_PARAMS,
+            "too many params in native signature spec; "
+            SRC_LOCATION
+        );
+        toRet.paramTypes[toRet.paramCount++]
+            = necroNativeTypeParse(*charPtr);
+    }
+    if(toRet.minArity == -1){
+        toRet.minArity = toRet.paramCount;
+    }
+    return toRet;
+}
+
+/*
+ * Returns the declared type of the param at the
+ * specified index of the given signature, which must
+ * accept that many arguments
+ */
+NecroNativeType necroNativeSignatureParamType(
+    const NecroNativeSignature *signaturePtr,
+    int index
+){
+    /* a variadic signature repeats its last param */
+    if(index >= signaturePtr->paramCount){
+        return signaturePtr->paramTypes[
+            signaturePtr->paramCount - 1
+        ];
+    }
+    return signaturePtr->paramTypes[index];
+}
+
+/*
+ * Returns true if the specified signature accepts the
+ * given number of arguments, false otherwise
+ */
+bool necroNativeSignatureAcceptsArity(
+    const NecroNativeSignature *signaturePtr,
+    int argc
+){
+    return argc >= signaturePtr->minArity
+        && (argc <= signaturePtr->paramCount
+            || signaturePtr->variadic);
+}
+
+/*
+ * Returns true if the specified value may be passed
+ * as a param of the given type, false otherwise
+ */
+bool necroNativeTypeAccepts(
+    NecroNativeType type,
+    NecroValue value
+){
+    switch(type){
+        case necro_nativeAny:
+            return true;
+        case necro_nativeBool:
+            return necroIsBool(value);
+        case necro_nativeInt:
+            return necroIsInt(value);
+        case necro_nativeFloat:
+        case necro_nativeNumber:
+            return necroIsInt(value)
+                || necroIsFloat(value);
+        case necro_nativeVector:
+            return necroIsVector(value);
+        case necro_nativePoint:
+            return necroIsPoint(value);
+        case necro_nativeString:
+            return necroIsString(value);
+        default:
+            return false;
+    }
+}
+
+/*
+ * Returns true if every one of the specified arguments
+ * may be passed to a native with the given signature,
+ * which must accept that many, converting in place
+ * the ints passed as floats; false otherwise
+ */
+bool necroNativeSignatureCheckArgs(
+    const NecroNativeSignature *signaturePtr,
+    int argc,
+    NecroValue *argv
+){
+    for(int i = 0; i < argc; ++i){
+        NecroNativeType type
+            = necroNativeSignatureParamType(
+                signaturePtr,
+                i
+            );
+        if(!necroNativeTypeAccepts(type, argv[i])){
+            return false;
+        }
+        if(type == necro_nativeFloat
+            && necroIsInt(argv[i])
+        ){
+            argv[i] = necroFloatValue(
+                (float)necroAsInt(argv[i])
+            );
+        }
+    }
+    return true;
+}
+
 /*
  * Creates and returns a new _NecroNameNativeFuncPair
  * by value; makes a heap copy of the name
@@ -22,6 +211,7 @@ _NecroNameNativeFuncPair _necroNameNativeFuncPairMake(
     toRet._func = func;
     toRet._name = pgAlloc(length + 1, sizeof(char));
     strncpy(toRet._name, name, length);
+    toRet._signaturePtr = NULL;
 
     return toRet;
 }
@@ -41,6 +231,10 @@ void _necroNameNativeFuncPairFree(
     pgFree(nameNativeFuncPairPtr->_name);
     nameNativeFuncPairPtr->_name = NULL;
     nameNativeFuncPairPtr->_func = NULL;
+    if(nameNativeFuncPairPtr->_signaturePtr){
+        pgFree(nameNativeFuncPairPtr->_signaturePtr);
+        nameNativeFuncPairPtr->_signaturePtr = NULL;
+    }
 }
 
 /*
@@ -85,6 +279,64 @@ void necroNativeFuncSetAdd(
     );
 }
 
+/*
+ * Adds the specified native function to the given
+ * native function set under the specified name with
+ * the signature described by the given spec; see
+ * necroNativeSignatureParse for the format
+ */
+void necroNativeFuncSetAddTyped(
+    NecroNativeFuncSet *nativeFuncSetPtr,
+    const char *name,
+    NecroNativeFunc func,
+    const char *spec
+){
+    necroNativeFuncSetAdd(nativeFuncSetPtr, name, func);
+    _NecroNameNativeFuncPair *pairPtr = arrayListBackPtr(
+        _NecroNameNativeFuncPair,
+        &(nativeFuncSetPtr->_nameNativeFuncPairs)
+    );
+    pairPtr->_signaturePtr = pgAlloc(
+        1,
+        sizeof(NecroNativeSignature)
+    );
+    *(pairPtr->_signaturePtr)
+        = necroNativeSignatureParse(spec);
+}
+
+/*
+ * Returns the index of the native function with the
+ * specified name, which is of the given length, in the
+ * specified native function set, or -1 if there is no
+ * such native
+ */
+int necroNativeFuncSetFind(
+    NecroNativeFuncSet *nativeFuncSetPtr,
+    const char *name,
+    int length
+){
+    assertNotNull(
+        nativeFuncSetPtr,
+        "null set passed to nativeFuncSet find; "
+        SRC_LOCATION
+    );
+    ArrayList *pairsPtr
+        = &(nativeFuncSetPtr->_nameNativeFuncPairs);
+    for(size_t i = 0; i < pairsPtr->size; ++i){
+        const char *pairName = arrayListGetPtr(
+            _NecroNameNativeFuncPair,
+            pairsPtr,
+            i
+        )->_name;
+        if(strncmp(pairName, name, length) == 0
+            && pairName[length] == '\0'
+        ){
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
 /*
  * Frees the memory associated with the specified
  * NecroNativeFuncSet
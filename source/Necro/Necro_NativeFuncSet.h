@@ -3,6 +3,97 @@
 
 #include "Necro_Object.h"
 
+/* max number of params a native signature declares */
+#define NECRO_NATIVE_MAX_PARAMS 16
+
+/*
+ * Defines the types which the params and return value
+ * of a native function may be declared as
+ */
+typedef enum NecroNativeType{
+    /* any value at all */
+    necro_nativeAny,
+    necro_nativeBool,
+    necro_nativeInt,
+    /* ints passed as floats are converted */
+    necro_nativeFloat,
+    /* either an int or a float */
+    necro_nativeNumber,
+    necro_nativeVector,
+    necro_nativePoint,
+    necro_nativeString
+} NecroNativeType;
+
+/*
+ * The declared params and return type of a native
+ * function, which the compiler checks calls against;
+ * a native with a signature may rely on its arguments
+ * being of the declared types
+ */
+typedef struct NecroNativeSignature{
+    NecroNativeType returnType;
+    NecroNativeType paramTypes[NECRO_NATIVE_MAX_PARAMS];
+    int paramCount;
+    /* params past this one are optional */
+    int minArity;
+    /* if true, the last param may repeat */
+    bool variadic;
+} NecroNativeSignature;
+
+/*
+ * Parses and returns the signature described by the
+ * specified spec by value; error if the spec is
+ * malformed. A spec is the return type, a colon, and
+ * the param types, each a single character: a for any,
+ * b bool, i int, f float, n number, v vector, p point,
+ * and s string. Params following a bar are optional
+ * and a star after the last param lets it repeat, e.g.
+ * "b:spvi|ssss" or "n:n*"
+ */
+NecroNativeSignature necroNativeSignatureParse(
+    const char *spec
+);
+
+/*
+ * Returns the declared type of the param at the
+ * specified index of the given signature, which must
+ * accept that many arguments
+ */
+NecroNativeType necroNativeSignatureParamType(
+    const NecroNativeSignature *signaturePtr,
+    int index
+);
+
+/*
+ * Returns true if the specified signature accepts the
+ * given number of arguments, false otherwise
+ */
+bool necroNativeSignatureAcceptsArity(
+    const NecroNativeSignature *signaturePtr,
+    int argc
+);
+
+/*
+ * Returns true if the specified value may be passed
+ * as a param of the given type, false otherwise
+ */
+bool necroNativeTypeAccepts(
+    NecroNativeType type,
+    NecroValue value
+);
+
+/*
+ * Returns true if every one of the specified arguments
+ * may be passed to a native with the given signature,
+ * which must accept that many, converting in place
+ * the ints passed as floats; false otherwise
+ */
+bool necroNativeSignatureCheckArgs(
+    const NecroNativeSignature *signaturePtr,
+    int argc,
+    NecroValue *argv
+);
+
 /*
  * A struct holding a native function and the name it
  * is to be associated with
@@ -11,6 +102,8 @@ typedef struct _NecroNameNativeFuncPair{
     /* owns its name (heap copied) */
     char *_name;
     NecroNativeFunc _func;
+    /* nullable; owns its signature (heap allocated) */
+    NecroNativeSignature *_signaturePtr;
 } _NecroNameNativeFuncPair;
 
 /*
@@ -55,6 +148,41 @@ void necroNativeFuncSetAdd(
     NecroNativeFunc func
 );
 
+/*
+ * Adds the specified native function to the given
+ * native function set under the specified name with
+ * the signature described by the given spec; see
+ * necroNativeSignatureParse for the format
+ */
+void necroNativeFuncSetAddTyped(
+    NecroNativeFuncSet *nativeFuncSetPtr,
+    const char *name,
+    NecroNativeFunc func,
+    const char *spec
+);
+
+/*
+ * Returns the index of the native function with the
+ * specified name, which is of the given length, in the
+ * specified native function set, or -1 if there is no
+ * such native
+ */
+int necroNativeFuncSetFind(
+    NecroNativeFuncSet *nativeFuncSetPtr,
+    const char *name,
+    int length
+);
+
+/*
+ * Returns a pointer to the pair at the specified
+ * index of the given native function set
+ */
+#define necroNativeFuncSetGetPair(NATIVEFUNCSETPTR, INDEX) \
+    arrayListGetPtr(_NecroNameNativeFuncPair, \
+        &((NATIVEFUNCSETPTR)->_nameNativeFuncPairs), \
+        (INDEX) \
+    )
+
 /*
  * Frees the memory associated with the specified
  * NecroNativeFuncSet
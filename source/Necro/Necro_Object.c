@@ -1,23 +1,22 @@
 #include "Necro_Object.h"
 
+#include "Necro_Heap.h"
+
 /*
  * Allocates a new NecroObject of the specified size
- * with the given type and inserts it at the head of
- * the specified object list (nullable)
+ * with the given type, in the specified heap if it is
+ * not NULL or on its own otherwise
  */
 static NecroObject *_necroObjectAlloc(
     size_t size,
     NecroObjectType type,
-    NecroObject **listHeadPtrPtr
+    NecroHeap *heapPtr
 ){
+    if(heapPtr){
+        return necroHeapAlloc(heapPtr, type);
+    }
     NecroObject *toRet = pgAlloc(1, size);
     toRet->type = type;
-
-    if(listHeadPtrPtr){
-        toRet->nextPtr = *listHeadPtrPtr;
-        *(listHeadPtrPtr) = toRet;
-    }
-
     return toRet;
 }
 
@@ -25,12 +24,12 @@ static NecroObject *_necroObjectAlloc(
 #define necroObjectAlloc( \
     TYPE, \
     OBJTYPE, \
-    LISTHEADPTRPTR \
+    HEAPPTR \
 ) \
     (TYPE*)_necroObjectAlloc( \
         sizeof(TYPE), \
         OBJTYPE, \
-        LISTHEADPTRPTR \
+        HEAPPTR \
     )
 
 /*
@@ -56,34 +55,26 @@ bool _necroObjectStringPtrCharwiseEquals(
 }
 
 /*
- * Allocates and returns a new NecroObjectString by
- * pointer, copying the specified number of characters
- * from the given character pointer, and inserting that
- * object at the start of the given object list
- * (nullable); however, if the string to copy is
- * already interned in the given HashMap, this
- * function simply returns a pointer to the
- * preexisting string and does not insert it in the
- * object list, otherwise inserts the string
- * into the map (NOTE: compile-constant strings are
- * owned by the literals and do not show up in the
- * virtual machine object list)
+ * Returns a pointer to the string interned in the
+ * given HashMap which equals the specified String,
+ * which is taken; if no such string is interned, the
+ * String is moved into a new NecroObjectString,
+ * allocated in the given heap (nullable), which is
+ * interned and returned. The lookup is done before
+ * allocating so repeated strings allocate no object
  */
-NecroObjectString *necroObjectStringCopy(
-    const char *chars,
-    size_t length,
-    NecroObject **listHeadPtrPtr,
+static NecroObjectString *necroObjectStringIntern(
+    String string,
+    NecroHeap *heapPtr,
     HashMap *stringMapPtr
 ){
-    NecroObjectString *toRet = necroObjectAlloc(
-        NecroObjectString,
-        necro_stringObject,
-        listHeadPtrPtr
-    );
-    toRet->string = stringMakeCLength(chars, length);
-    toRet->cachedHashCode = constructureStringHash(
-        &(toRet->string)
+    /* a stack key to look the string up with */
+    NecroObjectString key = {0};
+    key.string = string;
+    key.cachedHashCode = constructureStringHash(
+        &(key.string)
     );
+    NecroObjectString *keyPtr = &key;
 
     /*
      * swap out the equals func for a O(n) charwise
@@ -91,38 +82,44 @@ NecroObjectString *necroObjectStringCopy(
      */
     stringMapPtr->_equalsFunc
         = _necroObjectStringPtrCharwiseEquals;
+    NecroObjectString *toRet = NULL;
     /*
      * if string map has an identical string, free
-     * the newly allocated string and return a pointer
-     * to the preexisting one
+     * the String and return a pointer to the
+     * preexisting one
      */
     if(hashMapHasKey(NecroObjectString*, NecroValue,
         stringMapPtr,
-        toRet
+        keyPtr
     )){
-        /*
-         * remove the temp string from the object list
-         */
-        if(listHeadPtrPtr){
-            *listHeadPtrPtr
-                = toRet->objectBase.nextPtr;
-        }
         /*
          * get the matching key in the string map,
          * i.e. the pointer to the interned string
          */
-        NecroObjectString *preexistingStringPtr
-            = hashMapGetKey(
-                NecroObjectString*,
-                NecroValue,
-                stringMapPtr,
-                toRet
-            );
-        necroObjectFree((NecroObject*)toRet);
-        toRet = preexistingStringPtr;
+        toRet = hashMapGetKey(
+            NecroObjectString*,
+            NecroValue,
+            stringMapPtr,
+            keyPtr
+        );
+        stringFree(&string);
+        /*
+         * a string not yet reached by an ongoing sweep
+         * is alive again once handed out
+         */
+        if(heapPtr && heapPtr->phase == necro_heapSweep){
+            necroHeapMark(heapPtr, (NecroObject*)toRet);
+        }
     }
-    /* otherwise, insert into the hashmap */
+    /* otherwise, make the object and insert it */
     else{
+        toRet = necroObjectAlloc(
+            NecroObjectString,
+            necro_stringObject,
+            heapPtr
+        );
+        toRet->string = string;
+        toRet->cachedHashCode = key.cachedHashCode;
         hashMapPut(NecroObjectString*, NecroValue,
             stringMapPtr,
             toRet,
@@ -132,103 +129,66 @@ NecroObjectString *necroObjectStringCopy(
     /* unswap the equals func */
     stringMapPtr->_equalsFunc
         = _necroObjectStringPtrEquals;
-    
+
     return toRet;
 }
 
 /*
- * Allocates and returns a new NecroObjectString by
- * pointer, holding the concatenation of the two
- * specified NecroObjectStrings, and also inserts that
- * object at the start of the given object list
- * (nullable); however, if the string to copy is
+ * Returns a pointer to a NecroObjectString holding
+ * the specified number of characters copied from the
+ * given character pointer; if such a string is
  * already interned in the given HashMap, this
  * function simply returns a pointer to the
- * preexisting string and does not insert it in the
- * object list, otherwise inserts the string
- * into the map (NOTE: compile-constant strings are
- * owned by the literals and do not show up in the
- * virtual machine object list)
+ * preexisting string, otherwise it allocates a new
+ * string in the given heap (nullable, in which case
+ * the caller owns the string) and inserts it into the
+ * map (NOTE: compile-constant strings are owned by
+ * the literals and do not live in the virtual
+ * machine heap)
  */
+NecroObjectString *necroObjectStringCopy(
+    const char *chars,
+    size_t length,
+    NecroHeap *heapPtr,
+    HashMap *stringMapPtr
+){
+    return necroObjectStringIntern(
+        stringMakeCLength(chars, length),
+        heapPtr,
+        stringMapPtr
+    );
+}
+
+/*
+     * swap out the equals func for a O(n) charwise
+     * string compare
+     */
 NecroObjectString *necroObjectStringConcat(
     NecroObjectString *leftStringPtr,
     NecroObjectString *rightStringPtr,
-    NecroObject **listHeadPtrPtr,
+    NecroHeap *heapPtr,
     HashMap *stringMapPtr
 ){
-    NecroObjectString *toRet = necroObjectAlloc(
-        NecroObjectString,
-        necro_stringObject,
-        listHeadPtrPtr
-    );
     size_t totalLength = leftStringPtr->string.length
         + rightStringPtr->string.length;
-    toRet->string = stringMakeAndReserve(
+    String concatenation = stringMakeAndReserve(
         totalLength + 1
     );
-    /* append the contesnts of the left operand */
+    /* append the contents of the left operand */
     stringAppend(
-        &(toRet->string),
+        &concatenation,
         &(leftStringPtr->string)
     );
     /* append the contents of the right operand */
     stringAppend(
-        &(toRet->string),
+        &concatenation,
         &(rightStringPtr->string)
     );
-    toRet->cachedHashCode = constructureStringHash(
-        &(toRet->string)
+    return necroObjectStringIntern(
+        concatenation,
+        heapPtr,
+        stringMapPtr
     );
-
-    /*
-     * swap out the equals func for a O(n) charwise
-     * string compare
-     */
-    stringMapPtr->_equalsFunc
-        = _necroObjectStringPtrCharwiseEquals;
-    /*
-     * if string map has an identical string, free
-     * the newly allocated string and return a pointer
-     * to the preexisting one
-     */
-    if(hashMapHasKey(NecroObjectString*, NecroValue,
-        stringMapPtr,
-        toRet
-    )){
-        /*
-         * remove the temp string from the object list
-         */
-        if(listHeadPtrPtr){
-            *listHeadPtrPtr
-                = toRet->objectBase.nextPtr;
-        }
-        /*
-         * get the matching key in the string map,
-         * i.e. the pointer to the interned string
-         */
-        NecroObjectString *preexistingStringPtr
-            = hashMapGetKey(
-                NecroObjectString*,
-                NecroValue,
-                stringMapPtr,
-                toRet
-            );
-        necroObjectFree((NecroObject*)toRet);
-        toRet = preexistingStringPtr;
-    }
-    /* otherwise, insert into the hashmap */
-    else{
-        hashMapPut(NecroObjectString*, NecroValue,
-            stringMapPtr,
-            toRet,
-            0
-        );
-    }
-    /* unswap the equals func */
-    stringMapPtr->_equalsFunc
-        = _necroObjectStringPtrEquals;
-
-    return toRet;
 }
 
 /*
@@ -243,7 +203,7 @@ NecroObjectFunc *necroObjectFuncMake(
     NecroObjectFunc *toRet = necroObjectAlloc(
         NecroObjectFunc,
         necro_funcObject,
-        NULL /* null for list; called by compiler */
+        NULL /* null for heap; called by compiler */
     );
     toRet->arity = 0;
     toRet->depth = depth;
@@ -261,19 +221,21 @@ NecroObjectFunc *necroObjectFuncMake(
 
 /*
  * Creates and returns a new NecroObjectNativeFunc by
- * pointer and also inserts the object at the start of
- * the given object list
+ * pointer, allocated in the given heap; the signature
+ * pointer is nullable and not owned
  */
 NecroObjectNativeFunc *necroObjectNativeFuncMake(
     NecroNativeFunc func,
-    NecroObject **listHeadPtrPtr
+    const struct NecroNativeSignature *signaturePtr,
+    NecroHeap *heapPtr
 ){
     NecroObjectNativeFunc *toRet = necroObjectAlloc(
         NecroObjectNativeFunc,
         necro_nativeFuncObject,
-        listHeadPtrPtr
+        heapPtr
     );
     toRet->func = func;
+    toRet->signaturePtr = signaturePtr;
     return toRet;
 }
 
@@ -307,7 +269,7 @@ static void printFunction(NecroObjectFunc *funcPtr){
     printf(
         "<fn %s>",
         funcPtr->namePtr != NULL
-            ? funcPtr->namePtr->string._ptr
+            ? stringCharPtr(&(funcPtr->namePtr->string))
             : "<unnamed script>"
     );
 }
@@ -340,7 +302,8 @@ void necroObjectPrint(NecroValue value){
 
 /*
  * Frees the memory associated with the specified
- * object
+ * object; the slot of an object in a NecroHeap is
+ * left for the heap to reclaim
  */
 void necroObjectFree(NecroObject *objectPtr){
     assertNotNull(
@@ -375,8 +338,10 @@ void necroObjectFree(NecroObject *objectPtr){
             return;
     }
 
-    /* free all objects; they are on the heap */
-    pgFree(objectPtr);
+    /* heap objects live in slots owned by the heap */
+    if(!(objectPtr->collectable)){
+        pgFree(objectPtr);
+    }
 }
 
 /* For use with the Constructure Hashmap */
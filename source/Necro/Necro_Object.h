@@ -7,6 +7,9 @@
 #include "PGUtil.h"
 #include "Constructure.h"
 
+typedef struct NecroHeap NecroHeap;
+struct NecroNativeSignature;
+
 /*
  * Defines the types of objects which Necro supports
  */
@@ -20,6 +23,10 @@ typedef enum NecroObjectType{
 /* the base struct for all object types */
 typedef struct NecroObject{
     NecroObjectType type;
+    /* true if the object belongs to a NecroHeap */
+    bool collectable;
+    /* compared to the live mark of the heap for GC */
+    bool mark;
     /* forms a linked list of objects for GC */
     struct NecroObject *nextPtr;
 } NecroObject;
@@ -50,6 +57,11 @@ typedef NecroValue (*NecroNativeFunc)(
 typedef struct NecroObjectNativeFunc{
     NecroObject objectBase;
     NecroNativeFunc func;
+    /*
+     * nullable; the arguments of a call are checked
+     * against it if present; not owned
+     */
+    const struct NecroNativeSignature *signaturePtr;
 } NecroObjectNativeFunc;
 
 /*
@@ -118,7 +130,9 @@ static inline NecroObjectString *necroObjectAsString(
 static inline char *necroObjectAsCString(
     NecroValue value
 ){
-    return necroObjectAsString(value)->string._ptr;
+    return stringCharPtr(
+        &(necroObjectAsString(value)->string)
+    );
 }
 
 /*
@@ -168,44 +182,41 @@ bool _necroObjectStringPtrCharwiseEquals(
 );
 
 /*
- * Allocates and returns a new NecroObjectString by
- * pointer, copying the specified number of characters
- * from the given character pointer, and inserting that
- * object at the start of the given object list
- * (nullable); however, if the string to copy is
+ * Returns a pointer to a NecroObjectString holding
+ * the specified number of characters copied from the
+ * given character pointer; if such a string is
  * already interned in the given HashMap, this
  * function simply returns a pointer to the
- * preexisting string and does not insert it in the
- * object list, otherwise inserts the string
- * into the map (NOTE: compile-constant strings are
- * owned by the literals and do not show up in the
- * virtual machine object list)
+ * preexisting string, otherwise it allocates a new
+ * string in the given heap (nullable, in which case
+ * the caller owns the string) and inserts it into the
+ * map (NOTE: compile-constant strings are owned by
+ * the literals and do not live in the virtual
+ * machine heap)
  */
 NecroObjectString *necroObjectStringCopy(
     const char *chars,
     size_t length,
-    NecroObject **listHeadPtrPtr,
+    NecroHeap *heapPtr,
     HashMap *stringMapPtr
 );
 
 /*
- * Allocates and returns a new NecroObjectString by
- * pointer, holding the concatenation of the two
- * specified NecroObjectStrings, and also inserts that
- * object at the start of the given object list
- * (nullable); however, if the string to copy is
- * already interned in the given HashMap, this
- * function simply returns a pointer to the
- * preexisting string and does not insert it in the
- * object list, otherwise inserts the string
- * into the map (NOTE: compile-constant strings are
- * owned by the literals and do not show up in the
- * virtual machine object list)
+ * Returns a pointer to a NecroObjectString holding
+ * the concatenation of the two specified
+ * NecroObjectStrings; if such a string is already
+ * interned in the given HashMap, this function simply
+ * returns a pointer to the preexisting string,
+ * otherwise it allocates a new string in the given
+ * heap (nullable, in which case the caller owns the
+ * string) and inserts it into the map (NOTE:
+ * compile-constant strings are owned by the literals
+ * and do not live in the virtual machine heap)
  */
 NecroObjectString *necroObjectStringConcat(
     NecroObjectString *leftStringPtr,
     NecroObjectString *rightStringPtr,
-    NecroObject **listHeadPtrPtr,
+    NecroHeap *heapPtr,
     HashMap *stringMapPtr
 );
 
@@ -221,12 +232,13 @@ NecroObjectFunc *necroObjectFuncMake(
 
 /*
  * Creates and returns a new NecroObjectNativeFunc by
- * pointer and also inserts the object at the start of
- * the given object list
+ * pointer, allocated in the given heap; the signature
+ * pointer is nullable and not owned
  */
 NecroObjectNativeFunc *necroObjectNativeFuncMake(
     NecroNativeFunc func,
-    NecroObject **listHeadPtrPtr
+    const struct NecroNativeSignature *signaturePtr,
+    NecroHeap *heapPtr
 );
 
 /*
@@ -240,7 +252,8 @@ void necroObjectPrint(NecroValue value);
 
 /*
  * Frees the memory associated with the specified
- * object
+ * object; the slot of an object in a NecroHeap is
+ * left for the heap to reclaim
  */
 void necroObjectFree(NecroObject *objectPtr);
 
@@ -0,0 +1,991 @@
+#include "Necro_Optimizer.h"
+
+#include <limits.h>
+#include <stdint.h>
+
+#include "Necro_Instruction.h"
+#include "Necro_Object.h"
+
+/* define to leave out the superinstructions */
+/* #define NECRO_NO_SUPERINSTRUCTIONS */
+
+/* the passes are repeated until nothing changes */
+#define maxPassCount 16
+
+/* A decoded instruction */
+typedef struct _NecroOptInstruction{
+    uint8_t opcode;
+    /*
+     * operand bytes; jumps keep their target instead
+     * of their trailing distance
+     */
+    uint8_t operands[5];
+    uint16_t lineNumber;
+    /*
+     * for jumps, the index of the instruction jumped
+     * to, or the instruction count if past the end
+     */
+    size_t targetIndex;
+    /* whether any jump lands on this instruction */
+    bool isTarget;
+    /* cleared to delete the instruction */
+    bool isLive;
+} _NecroOptInstruction;
+
+/* Returns true if the specified opcode is a jump */
+static bool isJump(uint8_t opcode){
+    return opcode == necro_jump
+        || opcode == necro_jumpIfFalse
+        || opcode == necro_loop
+        || opcode == necro_lessLocalLiteralJump
+        || opcode == necro_greaterLocalLiteralJump;
+}
+
+/*
+ * Returns true if execution never falls through the
+ * specified opcode to the next instruction
+ */
+static bool isTerminator(uint8_t opcode){
+    return opcode == necro_jump
+        || opcode == necro_loop
+        || opcode == necro_return
+        || opcode == necro_end;
+}
+
+/*
+ * Returns a pointer to the instruction at the given
+ * index of the specified instruction list
+ */
+#define instructionAt(LISTPTR, INDEX) \
+    arrayListGetPtr(_NecroOptInstruction, \
+        (LISTPTR), \
+        (INDEX) \
+    )
+
+/*
+ * Decodes the code of the specified program into the
+ * given empty instruction list; returns false if the
+ * code could not be decoded
+ */
+static bool decode(
+    NecroProgram *programPtr,
+    ArrayList *instructionListPtr
+){
+    uint8_t *codePtr = programPtr->code._ptr;
+    size_t codeSize = programPtr->code.size;
+    /*
+     * maps code offsets to instruction indices, or to
+     * SIZE_MAX for offsets inside an instruction
+     */
+    size_t *indexAtOffsetPtr = pgAlloc(
+        codeSize + 1,
+        sizeof(size_t)
+    );
+    for(size_t offset = 0; offset <= codeSize; ++offset){
+        indexAtOffsetPtr[offset] = SIZE_MAX;
+    }
+    bool success = true;
+
+    for(size_t offset = 0; offset < codeSize;){
+        size_t length = necroInstructionLength(codePtr[offset]);
+        if(length == 0 || offset + length > codeSize){
+            success = false;
+            goto end;
+        }
+        _NecroOptInstruction instruction = {0};
+        instruction.opcode = codePtr[offset];
+        for(size_t i = 1; i < length; ++i){
+            instruction.operands[i - 1] = codePtr[offset + i];
+        }
+        instruction.lineNumber = arrayListGet(uint16_t,
+            &(programPtr->lineNumbers),
+            offset
+        );
+        instruction.isLive = true;
+        indexAtOffsetPtr[offset]
+            = instructionListPtr->size;
+        arrayListPushBack(_NecroOptInstruction,
+            instructionListPtr,
+            instruction
+        );
+        offset += length;
+    }
+    indexAtOffsetPtr[codeSize] = instructionListPtr->size;
+
+    /* resolve jump distances to instruction indices */
+    for(size_t offset = 0, i = 0;
+        i < instructionListPtr->size;
+        ++i
+    ){
+        _NecroOptInstruction *instructionPtr
+            = instructionAt(instructionListPtr, i);
+        size_t length = necroInstructionLength(
+            instructionPtr->opcode
+        );
+        if(isJump(instructionPtr->opcode)){
+            /* the distance is the last two bytes */
+            uint8_t *distancePtr
+                = &(instructionPtr->operands[length - 3]);
+            size_t distance
+                = (((size_t)distancePtr[0]) << 8)
+                    | distancePtr[1];
+            size_t nextOffset = offset + length;
+            size_t targetOffset = 0;
+            if(instructionPtr->opcode == necro_loop){
+                if(distance > nextOffset){
+                    success = false;
+                    goto end;
+                }
+                targetOffset = nextOffset - distance;
+            }
+            else{
+                targetOffset = nextOffset + distance;
+            }
+            /* targets must be instruction boundaries */
+            if(targetOffset > codeSize
+                || indexAtOffsetPtr[targetOffset]
+                    == SIZE_MAX
+            ){
+                success = false;
+                goto end;
+            }
+            instructionPtr->targetIndex
+                = indexAtOffsetPtr[targetOffset];
+        }
+        offset += length;
+    }
+
+end:
+    pgFree(indexAtOffsetPtr);
+    return success;
+}
+
+/*
+ * Recomputes which instructions of the specified list
+ * are jump targets
+ */
+static void markTargets(ArrayList *instructionListPtr){
+    size_t count = instructionListPtr->size;
+    for(size_t i = 0; i < count; ++i){
+        instructionAt(instructionListPtr, i)->isTarget
+            = false;
+    }
+    for(size_t i = 0; i < count; ++i){
+        _NecroOptInstruction *instructionPtr
+            = instructionAt(instructionListPtr, i);
+        if(isJump(instructionPtr->opcode)
+            && instructionPtr->targetIndex < count
+        ){
+            instructionAt(
+                instructionListPtr,
+                instructionPtr->targetIndex
+            )->isTarget = true;
+        }
+    }
+}
+
+/*
+ * Retrieves the constant pushed by the specified
+ * instruction; returns false if it does not push a
+ * non object constant
+ */
+static bool getConstant(
+    NecroProgram *programPtr,
+    _NecroOptInstruction *instructionPtr,
+    NecroValue *valuePtr
+){
+    switch(instructionPtr->opcode){
+        case necro_true:
+            *valuePtr = necroBoolValue(true);
+            return true;
+        case necro_false:
+            *valuePtr = necroBoolValue(false);
+            return true;
+        case necro_literal:
+            *valuePtr = necroLiteralsGet(
+                &(programPtr->literals),
+                instructionPtr->operands[0]
+            );
+            return !necroIsObject(*valuePtr);
+        default:
+            return false;
+    }
+}
+
+/*
+ * Rewrites the specified instruction to push the
+ * given constant; returns false if the literal table
+ * of the program is full
+ */
+static bool setConstant(
+    NecroProgram *programPtr,
+    _NecroOptInstruction *instructionPtr,
+    NecroValue value
+){
+    if(necroIsBool(value)){
+        instructionPtr->opcode = necroAsBool(value)
+            ? necro_true
+            : necro_false;
+        return true;
+    }
+    if(programPtr->literals.literals.size > UINT8_MAX){
+        return false;
+    }
+    instructionPtr->opcode = necro_literal;
+    instructionPtr->operands[0] = (uint8_t)
+        necroProgramPushBackLiteral(programPtr, value);
+    return true;
+}
+
+/* Returns true if the specified value is a number */
+#define isNumber(VALUE) \
+    (necroIsInt(VALUE) || necroIsFloat(VALUE))
+
+/* Returns the specified number value as a float */
+#define numberAsFloat(VALUE) \
+    (necroIsInt(VALUE) \
+        ? (float)necroAsInt(VALUE) \
+        : necroAsFloat(VALUE))
+
+/*
+ * Evaluates the specified binary opcode on the given
+ * constants the way the virtual machine would;
+ * returns false if it cannot be folded, including
+ * whenever it would raise a runtime error
+ */
+static bool foldBinary(
+    uint8_t opcode,
+    NecroValue a,
+    NecroValue b,
+    NecroValue *resultPtr
+){
+    if(opcode == necro_equal){
+        *resultPtr = necroBoolValue(necroValueEquals(a, b));
+        return true;
+    }
+    if(!isNumber(a) || !isNumber(b)){
+        return false;
+    }
+    if(opcode == necro_makeVector){
+        *resultPtr = necroVectorValue(((Polar){
+            numberAsFloat(a),
+            numberAsFloat(b)
+        }));
+        return true;
+    }
+    if(opcode == necro_makePoint){
+        *resultPtr = necroPointValue(((Point2D){
+            numberAsFloat(a),
+            numberAsFloat(b)
+        }));
+        return true;
+    }
+    if(necroIsInt(a) && necroIsInt(b)){
+        /* widen so that overflow is caught, not folded */
+        long long x = necroAsInt(a);
+        long long y = necroAsInt(b);
+        long long result = 0;
+        switch(opcode){
+            case necro_add:
+                result = x + y;
+                break;
+            case necro_subtract:
+                result = x - y;
+                break;
+            case necro_multiply:
+                result = x * y;
+                break;
+            case necro_divide:
+                if(y == 0){
+                    return false;
+                }
+                result = x / y;
+                break;
+            case necro_modulo:
+                if(y == 0){
+                    return false;
+                }
+                result = x % y;
+                break;
+            case necro_greater:
+                *resultPtr = necroBoolValue(x > y);
+                return true;
+            case necro_less:
+                *resultPtr = necroBoolValue(x < y);
+                return true;
+            default:
+                return false;
+        }
+        if(result < INT_MIN || result > INT_MAX){
+            return false;
+        }
+        *resultPtr = necroIntValue((int)result);
+        return true;
+    }
+    float x = numberAsFloat(a);
+    float y = numberAsFloat(b);
+    switch(opcode){
+        case necro_add:
+            *resultPtr = necroFloatValue(x + y);
+            return true;
+        case necro_subtract:
+            *resultPtr = necroFloatValue(x - y);
+            return true;
+        case necro_multiply:
+            *resultPtr = necroFloatValue(x * y);
+            return true;
+        case necro_divide:
+            *resultPtr = necroFloatValue(x / y);
+            return true;
+        case necro_greater:
+            *resultPtr = necroBoolValue(x > y);
+            return true;
+        case necro_less:
+            *resultPtr = necroBoolValue(x < y);
+            return true;
+        default:
+            /* modulo of floats is a runtime error */
+            return false;
+    }
+}
+
+/*
+ * Evaluates the specified unary opcode on the given
+ * constant the way the virtual machine would;
+ * returns false if it cannot be folded
+ */
+static bool foldUnary(
+    uint8_t opcode,
+    NecroValue a,
+    NecroValue *resultPtr
+){
+    switch(opcode){
+        case necro_negate:
+            if(necroIsInt(a) && necroAsInt(a) != INT_MIN){
+                *resultPtr = necroIntValue(-necroAsInt(a));
+                return true;
+            }
+            if(necroIsFloat(a)){
+                *resultPtr = necroFloatValue(-necroAsFloat(a));
+                return true;
+            }
+            if(necroIsVector(a)){
+                *resultPtr = necroVectorValue(
+                    polarNegate(necroAsVector(a))
+                );
+                return true;
+            }
+            return false;
+        case necro_not:
+            if(necroIsBool(a)){
+                *resultPtr = necroBoolValue(!necroAsBool(a));
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+/*
+ * Returns true if the specified instruction pushes a
+ * value without any other effect
+ */
+static bool isPurePush(uint8_t opcode){
+    return opcode == necro_literal
+        || opcode == necro_true
+        || opcode == necro_false
+        || opcode == necro_getLocal;
+}
+
+/*
+ * Returns true if the specified instruction pushes a
+ * literal int or float
+ */
+static bool isNumberLiteral(
+    NecroProgram *programPtr,
+    _NecroOptInstruction *instructionPtr
+){
+    NecroValue value = {0};
+    return instructionPtr->opcode == necro_literal
+        && getConstant(programPtr, instructionPtr, &value)
+        && isNumber(value);
+}
+
+/*
+ * Returns true if the specified instruction always
+ * pushes an int or float when it does not error
+ */
+static bool pushesNumber(
+    NecroProgram *programPtr,
+    _NecroOptInstruction *instructionPtr
+){
+    switch(instructionPtr->opcode){
+        case necro_getR:
+        case necro_getTheta:
+        case necro_getX:
+        case necro_getY:
+            return true;
+        default:
+            return isNumberLiteral(programPtr, instructionPtr);
+    }
+}
+
+/*
+ * Returns true if the specified opcode always pushes
+ * a bool when it does not error
+ */
+static bool pushesBool(uint8_t opcode){
+    return opcode == necro_true
+        || opcode == necro_false
+        || opcode == necro_equal
+        || opcode == necro_greater
+        || opcode == necro_less
+        || opcode == necro_not;
+}
+
+/*
+ * Returns true if the two specified instructions name
+ * the same global variable
+ */
+static bool sameGlobal(
+    NecroProgram *programPtr,
+    _NecroOptInstruction *aPtr,
+    _NecroOptInstruction *bPtr
+){
+    return necroValueEquals(
+        necroLiteralsGet(
+            &(programPtr->literals),
+            aPtr->operands[0]
+        ),
+        necroLiteralsGet(
+            &(programPtr->literals),
+            bPtr->operands[0]
+        )
+    );
+}
+
+/*
+ * Folds constant expressions and removes redundant
+ * sequences in the specified instruction list;
+ * returns true if anything changed
+ */
+static bool peephole(
+    NecroProgram *programPtr,
+    ArrayList *instructionListPtr
+){
+    bool changed = false;
+    size_t count = instructionListPtr->size;
+    for(size_t i = 0; i < count; ++i){
+        _NecroOptInstruction *aPtr
+            = instructionAt(instructionListPtr, i);
+        if(!aPtr->isLive || i + 1 >= count){
+            continue;
+        }
+        /* [jump to next] */
+        if((aPtr->opcode == necro_jump
+                || aPtr->opcode == necro_jumpIfFalse)
+            && aPtr->targetIndex == i + 1
+        ){
+            aPtr->isLive = false;
+            changed = true;
+            continue;
+        }
+        _NecroOptInstruction *bPtr
+            = instructionAt(instructionListPtr, i + 1);
+        /* the rest of a sequence must not be a target */
+        if(bPtr->isTarget){
+            continue;
+        }
+        NecroValue a = {0};
+        NecroValue b = {0};
+        NecroValue result = {0};
+
+        /* [const][const][binary op] */
+        if(i + 2 < count
+            && !instructionAt(instructionListPtr, i + 2)
+                ->isTarget
+            && getConstant(programPtr, aPtr, &a)
+            && getConstant(programPtr, bPtr, &b)
+        ){
+            _NecroOptInstruction *opPtr = instructionAt(
+                instructionListPtr,
+                i + 2
+            );
+            if(foldBinary(opPtr->opcode, a, b, &result)
+                && setConstant(programPtr, aPtr, result)
+            ){
+                bPtr->isLive = false;
+                opPtr->isLive = false;
+                changed = true;
+                i += 2;
+                continue;
+            }
+        }
+        /* [const][unary op] */
+        if(getConstant(programPtr, aPtr, &a)
+            && foldUnary(bPtr->opcode, a, &result)
+            && setConstant(programPtr, aPtr, result)
+        ){
+            bPtr->isLive = false;
+            changed = true;
+            ++i;
+            continue;
+        }
+        /* [const bool][jump if false] always or never */
+        if(bPtr->opcode == necro_jumpIfFalse
+            && (aPtr->opcode == necro_true
+                || aPtr->opcode == necro_false)
+        ){
+            /* the condition stays on the stack either way */
+            if(aPtr->opcode == necro_true){
+                bPtr->isLive = false;
+            }
+            else{
+                bPtr->opcode = necro_jump;
+            }
+            changed = true;
+            ++i;
+            continue;
+        }
+        /* [push][pop] */
+        if(isPurePush(aPtr->opcode)
+            && bPtr->opcode == necro_pop
+        ){
+            aPtr->isLive = false;
+            bPtr->isLive = false;
+            changed = true;
+            ++i;
+            continue;
+        }
+        /*
+         * [number][negate][negate] and [bool][not][not];
+         * only when the operand is proven to be of the
+         * right type, since the pair would otherwise
+         * raise a type error
+         */
+        if((aPtr->opcode == necro_negate
+                || aPtr->opcode == necro_not)
+            && bPtr->opcode == aPtr->opcode
+            && i > 0
+            && !aPtr->isTarget
+        ){
+            _NecroOptInstruction *operandPtr
+                = instructionAt(instructionListPtr, i - 1);
+            bool isProven = operandPtr->isLive
+                && (aPtr->opcode == necro_negate
+                    ? pushesNumber(programPtr, operandPtr)
+                    : pushesBool(operandPtr->opcode));
+            if(isProven){
+                aPtr->isLive = false;
+                bPtr->isLive = false;
+                changed = true;
+                ++i;
+                continue;
+            }
+        }
+        /* [store x][pop][load x] keeps the stored value */
+        if(i + 2 < count && bPtr->opcode == necro_pop){
+            _NecroOptInstruction *loadPtr = instructionAt(
+                instructionListPtr,
+                i + 2
+            );
+            bool isReload = !loadPtr->isTarget
+                && ((aPtr->opcode == necro_setLocal
+                    && loadPtr->opcode == necro_getLocal
+                    && aPtr->operands[0]
+                        == loadPtr->operands[0]
+                    && aPtr->operands[1]
+                        == loadPtr->operands[1])
+                || (aPtr->opcode == necro_setGlobal
+                    && loadPtr->opcode == necro_getGlobal
+                    && sameGlobal(
+                        programPtr,
+                        aPtr,
+                        loadPtr
+                    )));
+            if(isReload){
+                bPtr->isLive = false;
+                loadPtr->isLive = false;
+                changed = true;
+                i += 2;
+                continue;
+            }
+        }
+    }
+    return changed;
+}
+
+/*
+ * Retargets jumps which land on unconditional jumps
+ * in the specified instruction list to the final
+ * destination; returns true if anything changed
+ */
+static bool threadJumps(ArrayList *instructionListPtr){
+    bool changed = false;
+    size_t count = instructionListPtr->size;
+    for(size_t i = 0; i < count; ++i){
+        _NecroOptInstruction *instructionPtr
+            = instructionAt(instructionListPtr, i);
+        if(!instructionPtr->isLive
+            || !isJump(instructionPtr->opcode)
+        ){
+            continue;
+        }
+        size_t target = instructionPtr->targetIndex;
+        /* hop limit guards against jump cycles */
+        for(size_t hops = 0; hops < count; ++hops){
+            if(target >= count){
+                break;
+            }
+            _NecroOptInstruction *targetPtr
+                = instructionAt(instructionListPtr, target);
+            if(targetPtr->opcode != necro_jump
+                && targetPtr->opcode != necro_loop
+            ){
+                break;
+            }
+            target = targetPtr->targetIndex;
+        }
+        if(target == instructionPtr->targetIndex){
+            continue;
+        }
+        /* conditional jumps can only go forward */
+        if(instructionPtr->opcode != necro_jump
+            && instructionPtr->opcode != necro_loop
+            && target <= i
+        ){
+            continue;
+        }
+        instructionPtr->targetIndex = target;
+        changed = true;
+    }
+    return changed;
+}
+
+/*
+ * Marks every instruction in the specified list that
+ * cannot be reached from the first as dead; returns
+ * true if anything changed
+ */
+static bool removeUnreachable(ArrayList *instructionListPtr){
+    size_t count = instructionListPtr->size;
+    if(count == 0){
+        return false;
+    }
+    bool *reachedPtr = pgAlloc(count, sizeof(bool));
+    size_t *worklistPtr = pgAlloc(count, sizeof(size_t));
+    size_t worklistSize = 0;
+    reachedPtr[0] = true;
+    worklistPtr[worklistSize++] = 0;
+
+    while(worklistSize > 0){
+        size_t i = worklistPtr[--worklistSize];
+        _NecroOptInstruction *instructionPtr
+            = instructionAt(instructionListPtr, i);
+        size_t successors[2] = {count, count};
+        if(!isTerminator(instructionPtr->opcode)){
+            successors[0] = i + 1;
+        }
+        if(isJump(instructionPtr->opcode)){
+            successors[1] = instructionPtr->targetIndex;
+        }
+        for(int s = 0; s < 2; ++s){
+            size_t next = successors[s];
+            if(next < count && !reachedPtr[next]){
+                reachedPtr[next] = true;
+                worklistPtr[worklistSize++] = next;
+            }
+        }
+    }
+
+    bool changed = false;
+    for(size_t i = 0; i < count; ++i){
+        _NecroOptInstruction *instructionPtr
+            = instructionAt(instructionListPtr, i);
+        if(!reachedPtr[i] && instructionPtr->isLive){
+            instructionPtr->isLive = false;
+            changed = true;
+        }
+    }
+    pgFree(worklistPtr);
+    pgFree(reachedPtr);
+    return changed;
+}
+
+/*
+ * Deletes dead instructions from the specified list,
+ * moving jumps aimed at a dead instruction onto the
+ * next live one
+ */
+static void compact(ArrayList *instructionListPtr){
+    size_t count = instructionListPtr->size;
+    /* new index of each old index, plus the end */
+    size_t *newIndexPtr = pgAlloc(count + 1, sizeof(size_t));
+    size_t liveCount = 0;
+    for(size_t i = 0; i < count; ++i){
+        newIndexPtr[i] = liveCount;
+        if(instructionAt(instructionListPtr, i)->isLive){
+            ++liveCount;
+        }
+    }
+    newIndexPtr[count] = liveCount;
+
+    size_t writeIndex = 0;
+    for(size_t i = 0; i < count; ++i){
+        _NecroOptInstruction instruction
+            = arrayListGet(_NecroOptInstruction,
+                instructionListPtr,
+                i
+            );
+        if(!instruction.isLive){
+            continue;
+        }
+        if(isJump(instruction.opcode)){
+            instruction.targetIndex
+                = newIndexPtr[instruction.targetIndex];
+        }
+        *instructionAt(instructionListPtr, writeIndex)
+            = instruction;
+        ++writeIndex;
+    }
+    instructionListPtr->size = liveCount;
+    pgFree(newIndexPtr);
+}
+
+#ifndef NECRO_NO_SUPERINSTRUCTIONS
+/*
+ * Replaces the sequences of the specified instruction
+ * list which have a superinstruction with it; the
+ * fused instructions other than the first must not be
+ * jump targets
+ */
+static void fuse(
+    NecroProgram *programPtr,
+    ArrayList *instructionListPtr
+){
+    markTargets(instructionListPtr);
+    size_t count = instructionListPtr->size;
+    for(size_t i = 0; i + 1 < count; ++i){
+        _NecroOptInstruction *aPtr
+            = instructionAt(instructionListPtr, i);
+        _NecroOptInstruction *bPtr
+            = instructionAt(instructionListPtr, i + 1);
+        if(bPtr->isTarget){
+            continue;
+        }
+        /* [call][pop] */
+        if(aPtr->opcode == necro_call
+            && bPtr->opcode == necro_pop
+        ){
+            aPtr->opcode = necro_callPop;
+            aPtr->operands[1] = necro_pop;
+            bPtr->isLive = false;
+            ++i;
+            continue;
+        }
+        /* [call native][pop] */
+        if((aPtr->opcode == necro_callNative
+                || aPtr->opcode == necro_callNativeFast)
+            && bPtr->opcode == necro_pop
+        ){
+            aPtr->opcode = aPtr->opcode == necro_callNative
+                ? necro_callNativePop
+                : necro_callNativeFastPop;
+            bPtr->isLive = false;
+            ++i;
+            continue;
+        }
+        /* [subtract points][get r or theta] */
+        if(aPtr->opcode == necro_subtractPoints
+            && (bPtr->opcode == necro_getR
+                || bPtr->opcode == necro_getTheta)
+        ){
+            aPtr->opcode = bPtr->opcode == necro_getR
+                ? necro_pointDistance
+                : necro_pointAngle;
+            bPtr->isLive = false;
+            ++i;
+            continue;
+        }
+        if(i + 3 >= count
+            || aPtr->opcode != necro_getLocal
+            || !isNumberLiteral(programPtr, bPtr)
+        ){
+            continue;
+        }
+        _NecroOptInstruction *opPtr
+            = instructionAt(instructionListPtr, i + 2);
+        _NecroOptInstruction *lastPtr
+            = instructionAt(instructionListPtr, i + 3);
+        if(opPtr->isTarget || lastPtr->isTarget){
+            continue;
+        }
+        /* [get x][literal][add][set x] */
+        if(opPtr->opcode == necro_add
+            && lastPtr->opcode == necro_setLocal
+            && lastPtr->operands[0] == aPtr->operands[0]
+            && lastPtr->operands[1] == aPtr->operands[1]
+        ){
+            aPtr->opcode = necro_addLocalLiteral;
+        }
+        /* [get x][literal][less or greater][jump if false] */
+        else if((opPtr->opcode == necro_less
+                || opPtr->opcode == necro_greater)
+            && lastPtr->opcode == necro_jumpIfFalse
+        ){
+            aPtr->opcode = opPtr->opcode == necro_less
+                ? necro_lessLocalLiteralJump
+                : necro_greaterLocalLiteralJump;
+            aPtr->targetIndex = lastPtr->targetIndex;
+        }
+        else{
+            continue;
+        }
+        aPtr->operands[2] = bPtr->operands[0];
+        bPtr->isLive = false;
+        opPtr->isLive = false;
+        lastPtr->isLive = false;
+        i += 3;
+    }
+    compact(instructionListPtr);
+}
+#endif
+
+/*
+ * Encodes the specified instruction list back into
+ * the code and line numbers of the given program;
+ * returns false without touching the program if a
+ * jump does not fit
+ */
+static bool encode(
+    NecroProgram *programPtr,
+    ArrayList *instructionListPtr
+){
+    size_t count = instructionListPtr->size;
+    size_t *offsetPtr = pgAlloc(count + 1, sizeof(size_t));
+    size_t offset = 0;
+    for(size_t i = 0; i < count; ++i){
+        offsetPtr[i] = offset;
+        offset += necroInstructionLength(
+            instructionAt(instructionListPtr, i)->opcode
+        );
+    }
+    offsetPtr[count] = offset;
+
+    /* resolve jumps first so failure leaves no trace */
+    for(size_t i = 0; i < count; ++i){
+        _NecroOptInstruction *instructionPtr
+            = instructionAt(instructionListPtr, i);
+        if(!isJump(instructionPtr->opcode)){
+            continue;
+        }
+        size_t length = necroInstructionLength(
+            instructionPtr->opcode
+        );
+        size_t nextOffset = offsetPtr[i] + length;
+        size_t targetOffset
+            = offsetPtr[instructionPtr->targetIndex];
+        size_t distance = 0;
+        if(targetOffset >= nextOffset){
+            distance = targetOffset - nextOffset;
+            if(instructionPtr->opcode == necro_loop){
+                instructionPtr->opcode = necro_jump;
+            }
+        }
+        else{
+            /* only unconditional jumps go backward */
+            if(instructionPtr->opcode != necro_jump
+                && instructionPtr->opcode != necro_loop
+            ){
+                pgFree(offsetPtr);
+                return false;
+            }
+            distance = nextOffset - targetOffset;
+            instructionPtr->opcode = necro_loop;
+        }
+        if(distance > UINT16_MAX){
+            pgFree(offsetPtr);
+            return false;
+        }
+        uint8_t *distancePtr
+            = &(instructionPtr->operands[length - 3]);
+        distancePtr[0] = (uint8_t)((distance >> 8) & 0xff);
+        distancePtr[1] = (uint8_t)(distance & 0xff);
+    }
+    pgFree(offsetPtr);
+
+    arrayListClear(uint8_t, &(programPtr->code));
+    arrayListClear(uint16_t, &(programPtr->lineNumbers));
+    for(size_t i = 0; i < count; ++i){
+        _NecroOptInstruction *instructionPtr
+            = instructionAt(instructionListPtr, i);
+        size_t length = necroInstructionLength(
+            instructionPtr->opcode
+        );
+        necroProgramPushBackCode(
+            programPtr,
+            instructionPtr->opcode,
+            instructionPtr->lineNumber
+        );
+        for(size_t j = 1; j < length; ++j){
+            necroProgramPushBackCode(
+                programPtr,
+                instructionPtr->operands[j - 1],
+                instructionPtr->lineNumber
+            );
+        }
+    }
+    return true;
+}
+
+/*
+ * Optimizes the bytecode of the specified program in
+ * place; folds constant expressions and branches,
+ * removes pushes which are immediately popped, double
+ * negations of operands proven to be numbers or
+ * bools, and reloads of a just stored variable,
+ * threads jumps to jumps, and deletes unreachable
+ * code, then fuses common sequences into
+ * superinstructions. The line number of every
+ * surviving instruction is kept. Does nothing if the
+ * optimized jumps would not fit
+ */
+void necroOptimizerRun(NecroProgram *programPtr){
+    assertNotNull(
+        programPtr,
+        "null program passed to optimize; "
+        SRC_LOCATION
+    );
+    ArrayList instructionList = arrayListMake(
+        _NecroOptInstruction,
+        programPtr->code.size + 1
+    );
+    if(!decode(programPtr, &instructionList)){
+        goto end;
+    }
+
+    for(int pass = 0; pass < maxPassCount; ++pass){
+        markTargets(&instructionList);
+        bool changed = peephole(
+            programPtr,
+            &instructionList
+        );
+        compact(&instructionList);
+        changed |= threadJumps(&instructionList);
+        changed |= removeUnreachable(&instructionList);
+        compact(&instructionList);
+        if(!changed){
+            break;
+        }
+    }
+
+    #ifndef NECRO_NO_SUPERINSTRUCTIONS
+    fuse(programPtr, &instructionList);
+    #endif
+
+    encode(programPtr, &instructionList);
+
+end:
+    arrayListFree(_NecroOptInstruction, &instructionList);
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef NECRO_OPTIMIZER_H
+#define NECRO_OPTIMIZER_H
+
+#include "Necro_Program.h"
+
+/*
+ * Optimizes the bytecode of the specified program in
+ * place; folds constant expressions and branches,
+ * removes pushes which are immediately popped, double
+ * negations of operands proven to be numbers or
+ * bools, and reloads of a just stored variable,
+ * threads jumps to jumps, and deletes unreachable
+ * code, then fuses common sequences into
+ * superinstructions. The line number of every
+ * surviving instruction is kept. Does nothing if the
+ * optimized jumps would not fit
+ */
+void necroOptimizerRun(NecroProgram *programPtr);
+
+#endif
\ No newline at end of file
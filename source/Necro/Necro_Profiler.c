@@ -0,0 +1,734 @@
+#include "Necro_Profiler.h"
+
+#ifdef NECRO_PROFILE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define hasCycleCounter
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define hasCycleCounter
+#endif
+
+#include "PGUtil.h"
+
+#define profileListInitCapacity 64
+#define nativeMapInitCapacity 64
+#define stackMapInitCapacity 256
+#define reportListInitCapacity 256
+/* longest folded stack kept; deeper frames are cut */
+#define stackBufferSize 1024
+
+/* The running totals of one native function */
+typedef struct _NecroProfilerNative{
+    NecroNativeFunc func;
+    uint64_t calls;
+    uint64_t ticks;
+} _NecroProfilerNative;
+
+/* The totals of one script line, for the report */
+typedef struct _NecroProfilerLine{
+    NecroProfile *profilePtr;
+    uint16_t lineNumber;
+    uint64_t instructions;
+    uint64_t ticks;
+} _NecroProfilerLine;
+
+/* arraylist of NecroProfile*, every profile made */
+static ArrayList profileList;
+/*
+ * hashmap slots pack each value right after its key,
+ * so the keys and values of the maps below may be
+ * misaligned and are only copied in and out of the
+ * maps with memcpy
+ */
+/* hashmap of NecroNativeFunc to _NecroProfilerNative */
+static HashMap nativeMap;
+/* hashmap of String folded stack to uint64_t samples */
+static HashMap stackMap;
+static uint64_t sampleCount = 0;
+static bool initialized = false;
+/* guards everything above */
+static atomic_flag lock = ATOMIC_FLAG_INIT;
+
+/* instructions left until the next stack sample */
+_Thread_local int _necroProfilerCountdown
+    = NECRO_PROFILE_SAMPLE_PERIOD;
+
+#ifdef NECRO_PROFILE_CYCLES
+/* the instruction being timed on this thread */
+static _Thread_local NecroProfile *timedProfilePtr;
+static _Thread_local size_t timedOffset;
+static _Thread_local uint64_t timedStart;
+#endif
+
+/* the file folded stacks are written to */
+static FILE *foldedFilePtr = NULL;
+/* the list natives are copied to for the report */
+static ArrayList *nativeListPtr = NULL;
+
+/*
+ * Returns the native function held by the specified
+ * possibly misaligned key
+ */
+static NecroNativeFunc nativeFuncKeyGet(const void *keyPtr){
+    NecroNativeFunc toRet = NULL;
+    memcpy(&toRet, keyPtr, sizeof(toRet));
+    return toRet;
+}
+
+/* Returns a hash of the specified native function */
+static size_t nativeFuncHash(const void *funcPtr){
+    uintptr_t bits = (uintptr_t)nativeFuncKeyGet(funcPtr);
+    /* functions are aligned, so the low bits are 0 */
+    return (size_t)((bits >> 4) ^ (bits >> 16));
+}
+
+/*
+ * Returns true if the specified native functions are
+ * the same, false otherwise
+ */
+static bool nativeFuncEquals(
+    const void *funcPtr1,
+    const void *funcPtr2
+){
+    return nativeFuncKeyGet(funcPtr1)
+        == nativeFuncKeyGet(funcPtr2);
+}
+
+/* Spins until the profiler lock is held */
+static void necroProfilerLock(){
+    while(atomic_flag_test_and_set_explicit(
+        &lock,
+        memory_order_acquire
+    )){
+        /* spin */
+    }
+}
+
+/* Releases the profiler lock */
+static void necroProfilerUnlock(){
+    atomic_flag_clear_explicit(&lock, memory_order_release);
+}
+
+/*
+ * Initializes the profiler if it has not been yet;
+ * the lock must be held
+ */
+static void necroProfilerInit(){
+    if(initialized){
+        return;
+    }
+    profileList = arrayListMake(NecroProfile*,
+        profileListInitCapacity
+    );
+    nativeMap = hashMapMake(
+        NecroNativeFunc,
+        _NecroProfilerNative,
+        nativeMapInitCapacity,
+        nativeFuncHash,
+        nativeFuncEquals
+    );
+    stackMap = hashMapMake(
+        String,
+        uint64_t,
+        stackMapInitCapacity,
+        constructureStringHash,
+        constructureStringEquals
+    );
+    sampleCount = 0;
+    initialized = true;
+}
+
+/*
+ * Returns the current value of the profiler clock in
+ * ticks; only differences between readings are
+ * meaningful
+ */
+uint64_t necroProfilerClock(){
+    #ifdef hasCycleCounter
+    return __rdtsc();
+    #else
+    struct timespec time = {0};
+    timespec_get(&time, TIME_UTC);
+    return ((uint64_t)time.tv_sec) * 1000000000u
+        + (uint64_t)time.tv_nsec;
+    #endif
+}
+
+/*
+ * Returns the profile of the program of the specified
+ * function, making one if it has none; functions
+ * without a script name take their own name
+ */
+NecroProfile *necroProfilerAttach(NecroObjectFunc *funcPtr){
+    NecroProgram *programPtr = &(funcPtr->program);
+    necroProfilerLock();
+    necroProfilerInit();
+    NecroProfile *profilePtr = atomic_load_explicit(
+        &(programPtr->profilePtr),
+        memory_order_relaxed
+    );
+    if(!profilePtr){
+        profilePtr = pgAlloc(1, sizeof(*profilePtr));
+        profilePtr->name = stringMakeC(
+            funcPtr->namePtr
+                ? stringCharPtr(&(funcPtr->namePtr->string))
+                : "unnamed script"
+        );
+        size_t codeSize = programPtr->code.size;
+        profilePtr->codeSize = codeSize;
+        /* one extra so an empty program allocates */
+        profilePtr->lineNumbers = pgAlloc(
+            codeSize + 1,
+            sizeof(uint16_t)
+        );
+        memcpy(
+            profilePtr->lineNumbers,
+            programPtr->lineNumbers._ptr,
+            codeSize * sizeof(uint16_t)
+        );
+        profilePtr->instructionCounts = pgAlloc(
+            codeSize + 1,
+            sizeof(uint64_t)
+        );
+        profilePtr->tickCounts = pgAlloc(
+            codeSize + 1,
+            sizeof(uint64_t)
+        );
+        arrayListPushBack(NecroProfile*,
+            &profileList,
+            profilePtr
+        );
+        atomic_store_explicit(
+            &(programPtr->profilePtr),
+            profilePtr,
+            memory_order_release
+        );
+    }
+    necroProfilerUnlock();
+    return profilePtr;
+}
+
+/*
+ * Names the profiles of the specified compiled script
+ * and of every function defined in it after the given
+ * script file name
+ */
+void necroProfilerNameScript(
+    NecroObjectFunc *scriptPtr,
+    const char *fileName
+){
+    NecroProfile *profilePtr = necroProfilerAttach(
+        scriptPtr
+    );
+    String name = stringMakeC(fileName);
+    if(scriptPtr->namePtr){
+        stringAppendC(&name, ":");
+        stringAppend(&name, &(scriptPtr->namePtr->string));
+    }
+    necroProfilerLock();
+    stringFree(&(profilePtr->name));
+    profilePtr->name = name;
+    necroProfilerUnlock();
+
+    NecroLiterals *literalsPtr
+        = &(scriptPtr->program.literals);
+    for(size_t i = 0; i < literalsPtr->literals.size; ++i){
+        NecroValue literal = necroLiteralsGet(literalsPtr, i);
+        if(necroIsObject(literal)
+            && necroObjectGetType(literal)
+                == necro_funcObject
+        ){
+            necroProfilerNameScript(
+                necroObjectAsFunc(literal),
+                fileName
+            );
+        }
+    }
+}
+
+/*
+ * Records a sample of the call stack of the specified
+ * virtual machine
+ */
+void _necroProfilerSample(NecroVirtualMachine *vmPtr){
+    _necroProfilerCountdown = NECRO_PROFILE_SAMPLE_PERIOD;
+
+    /* attach first so the lock is free to take */
+    for(int i = 0; i < vmPtr->frameCount; ++i){
+        NecroObjectFunc *funcPtr
+            = vmPtr->callStack[i].funcPtr;
+        if(!atomic_load_explicit(
+            &(funcPtr->program.profilePtr),
+            memory_order_acquire
+        )){
+            necroProfilerAttach(funcPtr);
+        }
+    }
+
+    char buffer[stackBufferSize] = {0};
+    size_t length = 0;
+    necroProfilerLock();
+    for(int i = 0; i < vmPtr->frameCount; ++i){
+        NecroCallFrame *framePtr = &(vmPtr->callStack[i]);
+        NecroProgram *programPtr
+            = &(framePtr->funcPtr->program);
+        NecroProfile *profilePtr = atomic_load_explicit(
+            &(programPtr->profilePtr),
+            memory_order_relaxed
+        );
+        size_t offset = framePtr->instructionPtr
+            - (uint8_t*)programPtr->code._ptr;
+        /* frames below the top are past their call */
+        if(i < vmPtr->frameCount - 1 && offset > 0){
+            --offset;
+        }
+        int written = snprintf(
+            buffer + length,
+            stackBufferSize - length,
+            "%s%s:%u",
+            i > 0 ? ";" : "",
+            stringCharPtr(&(profilePtr->name)),
+            (unsigned)profilePtr->lineNumbers[offset]
+        );
+        /* keep only the frames which fit whole */
+        if(written < 0
+            || (size_t)written >= stackBufferSize - length
+        ){
+            buffer[length] = '\0';
+            break;
+        }
+        length += written;
+    }
+
+    String key = stringMakeC(buffer);
+    void *countPtr = hashMapGetPtr(String, uint64_t,
+        &stackMap,
+        &key
+    );
+    if(countPtr){
+        uint64_t count = 0;
+        memcpy(&count, countPtr, sizeof(count));
+        ++count;
+        memcpy(countPtr, &count, sizeof(count));
+        stringFree(&key);
+    }
+    else{
+        /* hashmap takes ownership of the key */
+        uint64_t count = 1;
+        hashMapPutPtr(String, uint64_t,
+            &stackMap,
+            &key,
+            &count
+        );
+    }
+    ++sampleCount;
+    necroProfilerUnlock();
+}
+
+#ifdef NECRO_PROFILE_CYCLES
+/*
+ * Charges the ticks since the last instruction started
+ * on this thread to that instruction and starts timing
+ * the one at the specified offset of the given
+ * profile; only used with NECRO_PROFILE_CYCLES
+ */
+void _necroProfilerTimeInstruction(
+    NecroProfile *profilePtr,
+    size_t offset
+){
+    uint64_t now = necroProfilerClock();
+    if(timedProfilePtr){
+        atomic_fetch_add_explicit(
+            &(timedProfilePtr->tickCounts[timedOffset]),
+            now - timedStart,
+            memory_order_relaxed
+        );
+    }
+    timedProfilePtr = profilePtr;
+    timedOffset = offset;
+    timedStart = now;
+}
+#endif
+
+/*
+ * Ends the timing of the instruction last run on this
+ * thread once its virtual machine stops running
+ */
+void necroProfilerEndRun(){
+    #ifdef NECRO_PROFILE_CYCLES
+    if(timedProfilePtr){
+        atomic_fetch_add_explicit(
+            &(timedProfilePtr->tickCounts[timedOffset]),
+            necroProfilerClock() - timedStart,
+            memory_order_relaxed
+        );
+        timedProfilePtr = NULL;
+    }
+    #endif
+}
+
+/*
+ * Charges the specified number of clock ticks to a
+ * call of the given native function
+ */
+void necroProfilerNative(
+    NecroNativeFunc func,
+    uint64_t ticks
+){
+    necroProfilerLock();
+    necroProfilerInit();
+    void *nativePtr = hashMapGetPtr(
+        NecroNativeFunc,
+        _NecroProfilerNative,
+        &nativeMap,
+        &func
+    );
+    _NecroProfilerNative native = {0};
+    if(nativePtr){
+        memcpy(&native, nativePtr, sizeof(native));
+        ++(native.calls);
+        native.ticks += ticks;
+        memcpy(nativePtr, &native, sizeof(native));
+    }
+    else{
+        native.func = func;
+        native.calls = 1;
+        native.ticks = ticks;
+        hashMapPutPtr(NecroNativeFunc, _NecroProfilerNative,
+            &nativeMap,
+            &func,
+            &native
+        );
+    }
+    necroProfilerUnlock();
+}
+
+/*
+ * Orders script lines by ticks if instructions were
+ * timed and by instructions otherwise, busiest first
+ */
+static int lineCompare(const void *ptr1, const void *ptr2){
+    const _NecroProfilerLine *linePtr1 = ptr1;
+    const _NecroProfilerLine *linePtr2 = ptr2;
+    #ifdef NECRO_PROFILE_CYCLES
+    if(linePtr1->ticks != linePtr2->ticks){
+        return linePtr1->ticks < linePtr2->ticks ? 1 : -1;
+    }
+    #endif
+    if(linePtr1->instructions != linePtr2->instructions){
+        return linePtr1->instructions
+            < linePtr2->instructions ? 1 : -1;
+    }
+    return 0;
+}
+
+/* Orders native functions by ticks, busiest first */
+static int nativeCompare(const void *ptr1, const void *ptr2){
+    const _NecroProfilerNative *nativePtr1 = ptr1;
+    const _NecroProfilerNative *nativePtr2 = ptr2;
+    if(nativePtr1->ticks != nativePtr2->ticks){
+        return nativePtr1->ticks < nativePtr2->ticks
+            ? 1 : -1;
+    }
+    return 0;
+}
+
+/*
+ * Pushes the totals of every line of the specified
+ * profile which ran to the back of the given arraylist
+ * of _NecroProfilerLine
+ */
+static void pushProfileLines(
+    NecroProfile *profilePtr,
+    ArrayList *lineListPtr
+){
+    uint16_t maxLineNumber = 0;
+    for(size_t i = 0; i < profilePtr->codeSize; ++i){
+        if(profilePtr->lineNumbers[i] > maxLineNumber){
+            maxLineNumber = profilePtr->lineNumbers[i];
+        }
+    }
+    _NecroProfilerLine *linesPtr = pgAlloc(
+        maxLineNumber + 1,
+        sizeof(*linesPtr)
+    );
+    for(size_t i = 0; i < profilePtr->codeSize; ++i){
+        _NecroProfilerLine *linePtr
+            = &(linesPtr[profilePtr->lineNumbers[i]]);
+        linePtr->instructions += atomic_load_explicit(
+            &(profilePtr->instructionCounts[i]),
+            memory_order_relaxed
+        );
+        linePtr->ticks += atomic_load_explicit(
+            &(profilePtr->tickCounts[i]),
+            memory_order_relaxed
+        );
+    }
+    for(size_t i = 0; i <= maxLineNumber; ++i){
+        if(linesPtr[i].instructions > 0){
+            linesPtr[i].profilePtr = profilePtr;
+            linesPtr[i].lineNumber = (uint16_t)i;
+            arrayListPushBack(_NecroProfilerLine,
+                lineListPtr,
+                linesPtr[i]
+            );
+        }
+    }
+    pgFree(linesPtr);
+}
+
+/*
+ * Pushes a copy of the specified native function
+ * totals, which may be misaligned, to the back of the
+ * native list
+ */
+static void pushNative(void *nativePtr){
+    _NecroProfilerNative native = {0};
+    memcpy(&native, nativePtr, sizeof(native));
+    arrayListPushBack(_NecroProfilerNative,
+        nativeListPtr,
+        native
+    );
+}
+
+/*
+ * Returns the name of the specified native function
+ * in the given native function set, or NULL if it is
+ * not found; the set pointer is nullable
+ */
+static const char *nativeFuncName(
+    NecroNativeFunc func,
+    NecroNativeFuncSet *nativeFuncSetPtr
+){
+    if(!nativeFuncSetPtr){
+        return NULL;
+    }
+    ArrayList *pairListPtr
+        = &(nativeFuncSetPtr->_nameNativeFuncPairs);
+    for(size_t i = 0; i < pairListPtr->size; ++i){
+        _NecroNameNativeFuncPair *pairPtr = arrayListGetPtr(
+            _NecroNameNativeFuncPair,
+            pairListPtr,
+            i
+        );
+        if(pairPtr->_func == func){
+            return pairPtr->_name;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Writes a text report of the time spent on each
+ * script line and native function so far to the
+ * file with the specified name, busiest first; the
+ * native function set pointer, which is nullable, is
+ * used to name the natives. Returns true on success
+ */
+bool necroProfilerWriteReport(
+    const char *fileName,
+    NecroNativeFuncSet *nativeFuncSetPtr
+){
+    FILE *filePtr = fopen(fileName, "w");
+    if(!filePtr){
+        return false;
+    }
+    necroProfilerLock();
+    necroProfilerInit();
+
+    ArrayList lineList = arrayListMake(_NecroProfilerLine,
+        reportListInitCapacity
+    );
+    for(size_t i = 0; i < profileList.size; ++i){
+        pushProfileLines(
+            arrayListGet(NecroProfile*, &profileList, i),
+            &lineList
+        );
+    }
+    uint64_t totalInstructions = 0;
+    uint64_t totalTicks = 0;
+    for(size_t i = 0; i < lineList.size; ++i){
+        _NecroProfilerLine *linePtr = arrayListGetPtr(
+            _NecroProfilerLine,
+            &lineList,
+            i
+        );
+        totalInstructions += linePtr->instructions;
+        totalTicks += linePtr->ticks;
+    }
+    qsort(
+        lineList._ptr,
+        lineList.size,
+        sizeof(_NecroProfilerLine),
+        lineCompare
+    );
+
+    fprintf(filePtr, "# Necro profile\n");
+    #ifdef hasCycleCounter
+    fprintf(filePtr, "# ticks are CPU cycles\n");
+    #else
+    fprintf(filePtr, "# ticks are nanoseconds\n");
+    #endif
+    fprintf(
+        filePtr,
+        "# %llu instructions, %llu stack samples\n",
+        (unsigned long long)totalInstructions,
+        (unsigned long long)sampleCount
+    );
+
+    fprintf(filePtr, "\n# script lines\n");
+    fprintf(
+        filePtr,
+        "instructions,share,ticks,script,line\n"
+    );
+    for(size_t i = 0; i < lineList.size; ++i){
+        _NecroProfilerLine *linePtr = arrayListGetPtr(
+            _NecroProfilerLine,
+            &lineList,
+            i
+        );
+        fprintf(
+            filePtr,
+            "%llu,%.4f,%llu,%s,%u\n",
+            (unsigned long long)linePtr->instructions,
+            ((double)linePtr->instructions)
+                / totalInstructions,
+            (unsigned long long)linePtr->ticks,
+            stringCharPtr(&(linePtr->profilePtr->name)),
+            (unsigned)linePtr->lineNumber
+        );
+    }
+    arrayListFree(_NecroProfilerLine, &lineList);
+
+    /* natives are copied out of the map to sort */
+    ArrayList nativeList = arrayListMake(
+        _NecroProfilerNative,
+        nativeMapInitCapacity
+    );
+    nativeListPtr = &nativeList;
+    hashMapApply(NecroNativeFunc, _NecroProfilerNative,
+        &nativeMap,
+        pushNative
+    );
+    nativeListPtr = NULL;
+    qsort(
+        nativeList._ptr,
+        nativeList.size,
+        sizeof(_NecroProfilerNative),
+        nativeCompare
+    );
+
+    fprintf(filePtr, "\n# native functions\n");
+    fprintf(filePtr, "calls,ticks,ticks_per_call,name\n");
+    for(size_t i = 0; i < nativeList.size; ++i){
+        _NecroProfilerNative *nativePtr = arrayListGetPtr(
+            _NecroProfilerNative,
+            &nativeList,
+            i
+        );
+        const char *name = nativeFuncName(
+            nativePtr->func,
+            nativeFuncSetPtr
+        );
+        fprintf(
+            filePtr,
+            "%llu,%llu,%llu,%s\n",
+            (unsigned long long)nativePtr->calls,
+            (unsigned long long)nativePtr->ticks,
+            (unsigned long long)(nativePtr->ticks
+                / nativePtr->calls),
+            name ? name : "unknown native"
+        );
+    }
+    arrayListFree(_NecroProfilerNative, &nativeList);
+
+    necroProfilerUnlock();
+    return fclose(filePtr) == 0;
+}
+
+/*
+ * Writes the specified folded stack and its sample
+ * count, both of which may be misaligned, to the
+ * folded file
+ */
+static void writeFoldedStack(
+    void *stackPtr,
+    void *countPtr
+){
+    String stack = {0};
+    memcpy(&stack, stackPtr, sizeof(stack));
+    uint64_t count = 0;
+    memcpy(&count, countPtr, sizeof(count));
+    fprintf(
+        foldedFilePtr,
+        "%s %llu\n",
+        stringCharPtr(&stack),
+        (unsigned long long)count
+    );
+}
+
+/*
+ * Writes the call stack samples taken so far to the
+ * file with the specified name as folded stacks, one
+ * "frame;frame;frame count" line per distinct stack,
+ * for use with flamegraph tools. Returns true on
+ * success
+ */
+bool necroProfilerWriteFolded(const char *fileName){
+    FILE *filePtr = fopen(fileName, "w");
+    if(!filePtr){
+        return false;
+    }
+    necroProfilerLock();
+    necroProfilerInit();
+    foldedFilePtr = filePtr;
+    hashMapKeyValueApply(String, uint64_t,
+        &stackMap,
+        writeFoldedStack
+    );
+    foldedFilePtr = NULL;
+    necroProfilerUnlock();
+    return fclose(filePtr) == 0;
+}
+
+/*
+ * Frees every profile and sample; programs profiled
+ * so far must not be run again
+ */
+void necroProfilerFree(){
+    necroProfilerLock();
+    if(initialized){
+        for(size_t i = 0; i < profileList.size; ++i){
+            NecroProfile *profilePtr = arrayListGet(
+                NecroProfile*,
+                &profileList,
+                i
+            );
+            stringFree(&(profilePtr->name));
+            pgFree(profilePtr->lineNumbers);
+            pgFree(profilePtr->instructionCounts);
+            pgFree(profilePtr->tickCounts);
+            pgFree(profilePtr);
+        }
+        arrayListFree(NecroProfile*, &profileList);
+        hashMapFree(NecroNativeFunc, _NecroProfilerNative,
+            &nativeMap
+        );
+        hashMapKeyApply(String, uint64_t,
+            &stackMap,
+            stringFree
+        );
+        hashMapFree(String, uint64_t, &stackMap);
+        initialized = false;
+    }
+    necroProfilerUnlock();
+}
+
+#endif
\ No newline at end of file
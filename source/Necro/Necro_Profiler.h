@@ -0,0 +1,169 @@
+#ifndef NECRO_PROFILER_H
+#define NECRO_PROFILER_H
+
+/*
+ * Script level profiler for Necro, compiled in only
+ * when NECRO_PROFILE is defined. Every instruction run
+ * by any virtual machine is counted against the line
+ * of the script it came from, every native call is
+ * timed, and the call stack is sampled periodically;
+ * define NECRO_PROFILE_CYCLES as well to also time
+ * every instruction. Times are in clock ticks, which
+ * are CPU cycles where a cycle counter is available
+ * and nanoseconds otherwise
+ */
+
+#ifdef NECRO_PROFILE
+
+#include <stdatomic.h>
+
+#include "Constructure.h"
+
+#include "Necro_NativeFuncSet.h"
+#include "Necro_Object.h"
+#include "Necro_VirtualMachine.h"
+
+/* instructions run between two call stack samples */
+#define NECRO_PROFILE_SAMPLE_PERIOD 97
+
+/* The profile of a single program */
+typedef struct NecroProfile{
+    /* e.g. "script.nec" or "script.nec:funcName" */
+    String name;
+    /* number of bytes of code in the program */
+    size_t codeSize;
+    /*
+     * copy of the line number of each byte of code,
+     * so the profile outlives the program
+     */
+    uint16_t *lineNumbers;
+    /* number of times each offset was executed */
+    _Atomic uint64_t *instructionCounts;
+    /*
+     * clock ticks spent in the instruction at each
+     * offset; only counted with NECRO_PROFILE_CYCLES
+     */
+    _Atomic uint64_t *tickCounts;
+} NecroProfile;
+
+/* instructions left until the next stack sample */
+extern _Thread_local int _necroProfilerCountdown;
+
+/*
+ * Returns the current value of the profiler clock in
+ * ticks; only differences between readings are
+ * meaningful
+ */
+uint64_t necroProfilerClock();
+
+/*
+ * Returns the profile of the program of the specified
+ * function, making one if it has none; functions
+ * without a script name take their own name
+ */
+NecroProfile *necroProfilerAttach(NecroObjectFunc *funcPtr);
+
+/*
+ * Names the profiles of the specified compiled script
+ * and of every function defined in it after the given
+ * script file name
+ */
+void necroProfilerNameScript(
+    NecroObjectFunc *scriptPtr,
+    const char *fileName
+);
+
+/*
+ * Records a sample of the call stack of the specified
+ * virtual machine
+ */
+void _necroProfilerSample(NecroVirtualMachine *vmPtr);
+
+/*
+ * Charges the ticks since the last instruction started
+ * on this thread to that instruction and starts timing
+ * the one at the specified offset of the given
+ * profile; only used with NECRO_PROFILE_CYCLES
+ */
+void _necroProfilerTimeInstruction(
+    NecroProfile *profilePtr,
+    size_t offset
+);
+
+/*
+ * Counts the instruction about to run in the top call
+ * frame of the specified virtual machine
+ */
+static inline void necroProfilerInstruction(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    NecroProgram *programPtr
+        = &(framePtr->funcPtr->program);
+    NecroProfile *profilePtr = atomic_load_explicit(
+        &(programPtr->profilePtr),
+        memory_order_acquire
+    );
+    if(!profilePtr){
+        profilePtr = necroProfilerAttach(framePtr->funcPtr);
+    }
+    size_t offset = framePtr->instructionPtr
+        - (uint8_t*)programPtr->code._ptr;
+    atomic_fetch_add_explicit(
+        &(profilePtr->instructionCounts[offset]),
+        1,
+        memory_order_relaxed
+    );
+    #ifdef NECRO_PROFILE_CYCLES
+    _necroProfilerTimeInstruction(profilePtr, offset);
+    #endif
+    if(--_necroProfilerCountdown <= 0){
+        _necroProfilerSample(vmPtr);
+    }
+}
+
+/*
+ * Ends the timing of the instruction last run on this
+ * thread once its virtual machine stops running
+ */
+void necroProfilerEndRun();
+
+/*
+ * Charges the specified number of clock ticks to a
+ * call of the given native function
+ */
+void necroProfilerNative(
+    NecroNativeFunc func,
+    uint64_t ticks
+);
+
+/*
+ * Writes a text report of the time spent on each
+ * script line and native function so far to the
+ * file with the specified name, busiest first; the
+ * native function set pointer, which is nullable, is
+ * used to name the natives. Returns true on success
+ */
+bool necroProfilerWriteReport(
+    const char *fileName,
+    NecroNativeFuncSet *nativeFuncSetPtr
+);
+
+/*
+ * Writes the call stack samples taken so far to the
+ * file with the specified name as folded stacks, one
+ * "frame;frame;frame count" line per distinct stack,
+ * for use with flamegraph tools. Returns true on
+ * success
+ */
+bool necroProfilerWriteFolded(const char *fileName);
+
+/*
+ * Frees every profile and sample; programs profiled
+ * so far must not be run again
+ */
+void necroProfilerFree();
+
+#endif
+
+#endif
\ No newline at end of file
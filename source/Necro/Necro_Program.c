@@ -127,6 +127,50 @@ static size_t printByteInstruction(
     return offset + 2;
 }
 
+/*
+ * Prints out the disassembly of a 3-byte local
+ * variable instruction with its slot and number of
+ * access jumps
+ */
+static size_t printLocalInstruction(
+    const char *name,
+    NecroProgram *programPtr,
+    size_t offset
+){
+    uint8_t slot = arrayListGet(uint8_t,
+        &(programPtr->code),
+        offset + 1
+    );
+    uint8_t jumps = arrayListGet(uint8_t,
+        &(programPtr->code),
+        offset + 2
+    );
+    printf("%-8s %4d ^%d\n", name, slot, jumps);
+    return offset + 3;
+}
+
+/*
+ * Prints out the disassembly of a 3-byte native call
+ * instruction with its native index and number of
+ * arguments
+ */
+static size_t printNativeInstruction(
+    const char *name,
+    NecroProgram *programPtr,
+    size_t offset
+){
+    uint8_t index = arrayListGet(uint8_t,
+        &(programPtr->code),
+        offset + 1
+    );
+    uint8_t numArgs = arrayListGet(uint8_t,
+        &(programPtr->code),
+        offset + 2
+    );
+    printf("%-8s %4d (%d)\n", name, index, numArgs);
+    return offset + 3;
+}
+
 /* Prints out the disassembly of a jump instruction */
 static size_t printJumpInstruction(
     const char *name,
@@ -176,6 +220,48 @@ static size_t printLiteralInstruction(
     return offset + 2;
 }
 
+/*
+ * Prints out the disassembly of a superinstruction
+ * on a local and a literal, which may end with a jump
+ * distance, and returns the new offset
+ */
+static size_t printLocalLiteralInstruction(
+    const char *name,
+    NecroProgram *programPtr,
+    size_t offset,
+    bool hasJump
+){
+    uint8_t slot = arrayListGet(uint8_t,
+        &(programPtr->code),
+        offset + 1
+    );
+    uint8_t litIndex = arrayListGet(uint8_t,
+        &(programPtr->code),
+        offset + 3
+    );
+    printf("%-8s %4d '", name, slot);
+    necroValuePrint(necroLiteralsGet(
+        &(programPtr->literals),
+        litIndex
+    ));
+    printf("'");
+    if(!hasJump){
+        printf("\n");
+        return offset + 4;
+    }
+    uint16_t jump = (uint16_t)arrayListGet(uint8_t,
+        &(programPtr->code),
+        offset + 4
+    );
+    jump <<= 8;
+    jump |= arrayListGet(uint8_t,
+        &(programPtr->code),
+        offset + 5
+    );
+    printf(" -> %d\n", (int)(offset + 6 + jump));
+    return offset + 6;
+}
+
 /*
  * Prints out the disassembly of a single instruction
  * in the specified program and returns the new offset
@@ -242,13 +328,13 @@ size_t necroProgramDisassembleInstruction(
                 offset
             );
         case necro_getLocal:
-            return printByteInstruction(
+            return printLocalInstruction(
                 "GETLOCAL",
                 programPtr,
                 offset
             );
         case necro_setLocal:
-            return printByteInstruction(
+            return printLocalInstruction(
                 "SETLOCAL",
                 programPtr,
                 offset
@@ -293,6 +379,41 @@ size_t necroProgramDisassembleInstruction(
                 "NEG",
                 offset
             );
+        case necro_addVectors:
+            return printSimpleInstruction(
+                "ADDVV",
+                offset
+            );
+        case necro_subtractVectors:
+            return printSimpleInstruction(
+                "SUBVV",
+                offset
+            );
+        case necro_addPointVector:
+            return printSimpleInstruction(
+                "ADDPV",
+                offset
+            );
+        case necro_subtractPointVector:
+            return printSimpleInstruction(
+                "SUBPV",
+                offset
+            );
+        case necro_subtractPoints:
+            return printSimpleInstruction(
+                "SUBPP",
+                offset
+            );
+        case necro_multiplyVector:
+            return printSimpleInstruction(
+                "MULV",
+                offset
+            );
+        case necro_divideVector:
+            return printSimpleInstruction(
+                "DIVV",
+                offset
+            );
         case necro_equal:
             return printSimpleInstruction(
                 "EQUAL",
@@ -344,43 +465,51 @@ size_t necroProgramDisassembleInstruction(
                 offset
             );
         case necro_setRGlobal:
-            return printSimpleInstruction(
+            return printLiteralInstruction(
                 "SETRG",
+                programPtr,
                 offset
             );
         case necro_setThetaGlobal:
-            return printSimpleInstruction(
+            return printLiteralInstruction(
                 "SETTG",
+                programPtr,
                 offset
             );
         case necro_setXGlobal:
-            return printSimpleInstruction(
+            return printLiteralInstruction(
                 "SETXG",
+                programPtr,
                 offset
             );
         case necro_setYGlobal:
-            return printSimpleInstruction(
+            return printLiteralInstruction(
                 "SETYG",
+                programPtr,
                 offset
             );
         case necro_setRLocal:
-            return printSimpleInstruction(
+            return printLocalInstruction(
                 "SETRL",
+                programPtr,
                 offset
             );
         case necro_setThetaLocal:
-            return printSimpleInstruction(
+            return printLocalInstruction(
                 "SETTL",
+                programPtr,
                 offset
             );
         case necro_setXLocal:
-            return printSimpleInstruction(
+            return printLocalInstruction(
                 "SETXL",
+                programPtr,
                 offset
             );
         case necro_setYLocal:
-            return printSimpleInstruction(
+            return printLocalInstruction(
                 "SETYL",
+                programPtr,
                 offset
             );
         case necro_print:
@@ -415,6 +544,18 @@ size_t necroProgramDisassembleInstruction(
                 programPtr,
                 offset
             );
+        case necro_callNative:
+            return printNativeInstruction(
+                "NATIVE",
+                programPtr,
+                offset
+            );
+        case necro_callNativeFast:
+            return printNativeInstruction(
+                "NATIVEF",
+                programPtr,
+                offset
+            );
         case necro_return:
             return printSimpleInstruction(
                 "RET",
@@ -425,11 +566,66 @@ size_t necroProgramDisassembleInstruction(
                 "YIELD",
                 offset
             );
+        case necro_sleep:
+            return printSimpleInstruction(
+                "SLEEP",
+                offset
+            );
         case necro_end:
             return printSimpleInstruction(
                 "END",
                 offset
             );
+        case necro_addLocalLiteral:
+            return printLocalLiteralInstruction(
+                "ADDLOCAL",
+                programPtr,
+                offset,
+                false
+            );
+        case necro_lessLocalLiteralJump:
+            return printLocalLiteralInstruction(
+                "LTLOCJMP",
+                programPtr,
+                offset,
+                true
+            );
+        case necro_greaterLocalLiteralJump:
+            return printLocalLiteralInstruction(
+                "GTLOCJMP",
+                programPtr,
+                offset,
+                true
+            );
+        case necro_callPop:
+            /* skip the trailing pop byte as well */
+            return printByteInstruction(
+                "CALLPOP",
+                programPtr,
+                offset
+            ) + 1;
+        case necro_pointDistance:
+            return printSimpleInstruction(
+                "PDIST",
+                offset
+            );
+        case necro_pointAngle:
+            return printSimpleInstruction(
+                "PANGLE",
+                offset
+            );
+        case necro_callNativePop:
+            return printNativeInstruction(
+                "NATIVEPOP",
+                programPtr,
+                offset
+            );
+        case necro_callNativeFastPop:
+            return printNativeInstruction(
+                "NATIVEFPOP",
+                programPtr,
+                offset
+            );
         default:
             printf(
                 "unknown bad opcode %d\n",
@@ -1,6 +1,10 @@
 #ifndef NECRO_PROGRAM_H
 #define NECRO_PROGRAM_H
 
+#ifdef NECRO_PROFILE
+#include <stdatomic.h>
+#endif
+
 #include "Constructure.h"
 
 #include "Necro_Literals.h"
@@ -16,6 +20,18 @@ typedef struct NecroProgram{
     ArrayList lineNumbers;
     /* collection of literal values */
     NecroLiterals literals;
+    /*
+     * ahead of time translation of the program, if it
+     * has been bound to one; see Necro_Aot.h
+     */
+    const struct NecroAotProgram *aotPtr;
+    #ifdef NECRO_PROFILE
+    /*
+     * profile of the program, attached the first time
+     * it runs; see Necro_Profiler.h
+     */
+    _Atomic(struct NecroProfile*) profilePtr;
+    #endif
 } NecroProgram;
 
 /*
@@ -0,0 +1,180 @@
+#include "Necro_Session.h"
+
+#include <string.h>
+
+#include "PGUtil.h"
+
+#include "Necro_Lexer.h"
+
+#define sourceMapInitCapacity 16
+#define tokenListInitCapacity 256
+
+/* A source file lexed once for a session */
+typedef struct _NecroSessionSource{
+    /* the source code the tokens point into; owned */
+    char *sourcePtr;
+    /* arraylist of NecroToken ending with EOF */
+    ArrayList tokenList;
+} _NecroSessionSource;
+
+/* Constructs and returns a new NecroSession by value */
+NecroSession necroSessionMake(){
+    NecroSession toRet = {0};
+    toRet._sourceMap = hashMapMake(
+        String,
+        _NecroSessionSource*,
+        sourceMapInitCapacity,
+        constructureStringHash,
+        constructureStringEquals
+    );
+    atomic_flag_clear(&(toRet._lock));
+    return toRet;
+}
+
+/* Spins until the lock of the given session is held */
+static void necroSessionLock(NecroSession *sessionPtr){
+    while(atomic_flag_test_and_set_explicit(
+        &(sessionPtr->_lock),
+        memory_order_acquire
+    )){
+        /* spin */
+    }
+}
+
+/* Releases the lock of the given session */
+static void necroSessionUnlock(NecroSession *sessionPtr){
+    atomic_flag_clear_explicit(
+        &(sessionPtr->_lock),
+        memory_order_release
+    );
+}
+
+/*
+ * Loads and lexes the specified file and returns its
+ * tokens in a newly allocated _NecroSessionSource
+ */
+static _NecroSessionSource *necroSessionLex(
+    const char *fileName
+){
+    _NecroSessionSource *sourcePtr = pgAlloc(
+        1,
+        sizeof(*sourcePtr)
+    );
+    sourcePtr->tokenList = arrayListMake(NecroToken,
+        tokenListInitCapacity
+    );
+    NecroLexer lexer = necroLexerMake(fileName);
+    NecroToken token = {0};
+    do{
+        token = necroLexerNext(&lexer);
+        arrayListPushBackPtr(NecroToken,
+            &(sourcePtr->tokenList),
+            &token
+        );
+    } while(token.type != necro_tokenEOF);
+
+    /* take the source the tokens point into */
+    sourcePtr->sourcePtr = lexer.sourcePtr;
+    return sourcePtr;
+}
+
+/*
+ * Frees the specified _NecroSessionSource; the double
+ * pointer is for use with hashmap apply
+ */
+static void necroSessionSourceFree(
+    _NecroSessionSource **sourceDoublePtr
+){
+    _NecroSessionSource *sourcePtr = *sourceDoublePtr;
+    pgFree(sourcePtr->sourcePtr);
+    arrayListFree(NecroToken, &(sourcePtr->tokenList));
+    pgFree(sourcePtr);
+}
+
+/*
+ * Returns a pointer to the tokens of the specified
+ * file, which end with an EOF token; the file is
+ * loaded and lexed only the first time it is asked
+ * for. The tokens and the source they point into live
+ * until the session is freed
+ */
+const NecroToken *necroSessionGetTokens(
+    NecroSession *sessionPtr,
+    const char *fileName
+){
+    HashMap *sourceMapPtr = &(sessionPtr->_sourceMap);
+    String key = stringMakeC(fileName);
+
+    necroSessionLock(sessionPtr);
+    _NecroSessionSource **foundPtr = hashMapGetPtr(
+        String,
+        _NecroSessionSource*,
+        sourceMapPtr,
+        &key
+    );
+    _NecroSessionSource *sourcePtr
+        = foundPtr ? *foundPtr : NULL;
+    necroSessionUnlock(sessionPtr);
+
+    if(!sourcePtr){
+        /* lex unlocked so other compilers keep going */
+        _NecroSessionSource *lexedPtr
+            = necroSessionLex(fileName);
+
+        necroSessionLock(sessionPtr);
+        foundPtr = hashMapGetPtr(
+            String,
+            _NecroSessionSource*,
+            sourceMapPtr,
+            &key
+        );
+        if(foundPtr){
+            sourcePtr = *foundPtr;
+        }
+        else{
+            /* hashmap takes ownership of the key */
+            hashMapPutPtr(String, _NecroSessionSource*,
+                sourceMapPtr,
+                &key,
+                &lexedPtr
+            );
+            sourcePtr = lexedPtr;
+            lexedPtr = NULL;
+        }
+        necroSessionUnlock(sessionPtr);
+
+        /* another compiler lexed the file first */
+        if(lexedPtr){
+            necroSessionSourceFree(&lexedPtr);
+            stringFree(&key);
+        }
+    }
+    else{
+        stringFree(&key);
+    }
+
+    return arrayListGetPtr(NecroToken,
+        &(sourcePtr->tokenList),
+        0
+    );
+}
+
+/*
+ * Frees the memory associated with the specified
+ * NecroSession; tokens obtained from it must no
+ * longer be used
+ */
+void necroSessionFree(NecroSession *sessionPtr){
+    hashMapApply(String, _NecroSessionSource*,
+        &(sessionPtr->_sourceMap),
+        necroSessionSourceFree
+    );
+    hashMapKeyApply(String, _NecroSessionSource*,
+        &(sessionPtr->_sourceMap),
+        stringFree
+    );
+    hashMapFree(String, _NecroSessionSource*,
+        &(sessionPtr->_sourceMap)
+    );
+    memset(sessionPtr, 0, sizeof(*sessionPtr));
+}
\ No newline at end of file
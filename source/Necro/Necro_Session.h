@@ -0,0 +1,45 @@
+#ifndef NECRO_SESSION_H
+#define NECRO_SESSION_H
+
+#include <stdatomic.h>
+
+#include "Constructure.h"
+
+#include "Necro_Token.h"
+
+/*
+ * Caches the token streams of the files included by
+ * the scripts compiled with it, so that each file is
+ * read and lexed once however many scripts include
+ * it; may be shared by compilers on multiple threads
+ */
+typedef struct NecroSession{
+    /* hashmap of String to _NecroSessionSource* */
+    HashMap _sourceMap;
+    /* guards the source map */
+    atomic_flag _lock;
+} NecroSession;
+
+/* Constructs and returns a new NecroSession by value */
+NecroSession necroSessionMake();
+
+/*
+ * Returns a pointer to the tokens of the specified
+ * file, which end with an EOF token; the file is
+ * loaded and lexed only the first time it is asked
+ * for. The tokens and the source they point into live
+ * until the session is freed
+ */
+const NecroToken *necroSessionGetTokens(
+    NecroSession *sessionPtr,
+    const char *fileName
+);
+
+/*
+ * Frees the memory associated with the specified
+ * NecroSession; tokens obtained from it must no
+ * longer be used
+ */
+void necroSessionFree(NecroSession *sessionPtr);
+
+#endif
\ No newline at end of file
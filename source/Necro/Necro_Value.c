@@ -8,10 +8,11 @@
  * false otherwise
  */
 bool necroValueEquals(NecroValue a, NecroValue b){
-    if(a.type != b.type){
+    NecroValueType type = necroValueGetType(a);
+    if(type != necroValueGetType(b)){
         return false;
     }
-    switch(a.type){
+    switch(type){
         case necro_bool:
             return necroAsBool(a) == necroAsBool(b);
         case necro_int:
@@ -32,8 +33,8 @@ bool necroValueEquals(NecroValue a, NecroValue b){
         }
         case necro_object:
             return necroObjectEquals(
-                a.as.object,
-                b.as.object
+                necroAsObject(a),
+                necroAsObject(b)
             );
         default:
             pgError(
@@ -48,7 +49,7 @@ bool necroValueEquals(NecroValue a, NecroValue b){
 void necroValuePrint(NecroValue value){
     #define bufferSize 32
     static char buffer[bufferSize] = {0};
-    switch(value.type){
+    switch(necroValueGetType(value)){
         case necro_bool:
             printf(necroAsBool(value) ? "true" : "false");
             break;
@@ -90,9 +91,9 @@ void necroValuePrint(NecroValue value){
  * Frees the memory associated with the specified value
  */
 void necroValueFree(NecroValue value){
-    switch(value.type){
+    switch(necroValueGetType(value)){
         case necro_object:
-            necroObjectFree(value.as.object);
+            necroObjectFree(necroAsObject(value));
             break;
         default:
             /* do nothing */
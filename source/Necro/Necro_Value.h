@@ -2,6 +2,7 @@
 #define NECRO_VALUE_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "PGUtil.h"
 #include "ZMath.h"
@@ -24,6 +25,7 @@ typedef enum NecroValueType{
     necro_object,
 } NecroValueType;
 
+#ifndef NECRO_NAN_BOXING
 /* A tagged union of values for Necro */
 typedef struct NecroValue{
     NecroValueType type;
@@ -67,6 +69,9 @@ typedef struct NecroValue{
         {.object = (NecroObject*)(OBJECT)} \
     })
 
+/* Returns the type of the specified NecroValue */
+#define necroValueGetType(VALUE) ((VALUE).type)
+
 /*
  * Returns true if the specified NecroValue is a bool,
  * false otherwise
@@ -107,13 +112,286 @@ typedef struct NecroValue{
 #define necroIsObject(VALUE) \
     ((VALUE).type == necro_object)
 
+/* unchecked accessors used by the unboxing funcs */
+#define _necroUnboxBool(VALUE) ((VALUE).as.boolean)
+#define _necroUnboxInt(VALUE) ((VALUE).as.integer)
+#define _necroUnboxFloat(VALUE) ((VALUE).as.floating)
+#define _necroUnboxVector(VALUE) ((VALUE).as.vector)
+#define _necroUnboxPoint(VALUE) ((VALUE).as.point)
+#define _necroUnboxObject(VALUE) ((VALUE).as.object)
+
+#else
+/*
+ * A NaN-boxed value for Necro, 8 bytes in total.
+ *
+ * Vectors and points store their first float in the
+ * high 32 bits and their second float in the low 32
+ * bits, except that the lowest bit of the second
+ * float is taken to tell points (1) from vectors (0),
+ * costing that float one unit of its last place.
+ *
+ * Every other type sets the high 13 bits to a
+ * negative quiet NaN pattern which the first float of
+ * a pair never uses (such NaNs are replaced by the
+ * canonical NaN when packing), followed by a 3 bit
+ * type tag and a 48 bit payload holding the bool,
+ * int, float bits, or object pointer
+ */
+typedef struct NecroValue{
+    uint64_t bits;
+} NecroValue;
+
+/* high bits shared by all boxed (non pair) values */
+#define _necroBoxMask 0xFFF8000000000000ull
+#define _necroTagShift 48
+#define _necroPayloadMask 0x0000FFFFFFFFFFFFull
+/* bit of the second float marking a point */
+#define _necroPointBit 0x1ull
+/* quiet NaN stored in place of reserved NaNs */
+#define _necroCanonicalNaN 0x7FC00000ull
+
+/* The type tags of boxed values */
+typedef enum _NecroValueTag{
+    _necro_invalidTag,
+    _necro_boolTag,
+    _necro_intTag,
+    _necro_floatTag,
+    _necro_objectTag,
+} _NecroValueTag;
+
+/* Returns the raw bits of the specified float */
+static inline uint32_t _necroFloatToBits(float floating){
+    union{ float floating; uint32_t bits; } pun;
+    pun.floating = floating;
+    return pun.bits;
+}
+
+/* Returns the float with the specified raw bits */
+static inline float _necroBitsToFloat(uint32_t bits){
+    union{ float floating; uint32_t bits; } pun;
+    pun.bits = bits;
+    return pun.floating;
+}
+
+/*
+ * Boxes the specified payload under the specified
+ * type tag
+ */
+static inline NecroValue _necroBox(
+    _NecroValueTag tag,
+    uint64_t payload
+){
+    NecroValue toRet = {
+        _necroBoxMask
+            | (((uint64_t)tag) << _necroTagShift)
+            | (payload & _necroPayloadMask)
+    };
+    return toRet;
+}
+
+/*
+ * Packs the specified pair of floats, marking it as
+ * a point if the point bit is set
+ */
+static inline NecroValue _necroPackPair(
+    float first,
+    float second,
+    uint64_t pointBit
+){
+    uint64_t high = _necroFloatToBits(first);
+    if(((high << 32u) & _necroBoxMask) == _necroBoxMask){
+        high = _necroCanonicalNaN;
+    }
+    uint64_t low = (_necroFloatToBits(second)
+        & ~(uint32_t)_necroPointBit) | pointBit;
+    NecroValue toRet = {(high << 32u) | low};
+    return toRet;
+}
+
+/* Returns the first float of the specified pair */
+#define _necroPairFirst(VALUE) \
+    _necroBitsToFloat((uint32_t)((VALUE).bits >> 32u))
+
+/* Returns the second float of the specified pair */
+#define _necroPairSecond(VALUE) \
+    _necroBitsToFloat( \
+        (uint32_t)(VALUE).bits \
+            & ~(uint32_t)_necroPointBit \
+    )
+
+/*
+ * Returns true if the specified NecroValue is boxed,
+ * i.e. not a vector or point, false otherwise
+ */
+#define _necroIsBoxed(VALUE) \
+    (((VALUE).bits & _necroBoxMask) == _necroBoxMask)
+
+/*
+ * Returns true if the specified NecroValue is boxed
+ * under the specified tag, false otherwise
+ */
+#define _necroHasTag(VALUE, TAG) \
+    (((VALUE).bits >> _necroTagShift) \
+        == ((_necroBoxMask >> _necroTagShift) \
+            | (uint64_t)(TAG)))
+
+/* Constructs a NecroValue for the specified bool */
+#define necroBoolValue(BOOL) \
+    _necroBox(_necro_boolTag, (BOOL) ? 1u : 0u)
+
+/* Constructs a NecroValue for the specified int */
+#define necroIntValue(INT) \
+    _necroBox(_necro_intTag, (uint32_t)(int)(INT))
+
+/* Constructs a NecroValue for the specified float */
+#define necroFloatValue(FLOAT) \
+    _necroBox(_necro_floatTag, _necroFloatToBits(FLOAT))
+
+/*
+ * Constructs a NecroValue for the specified polar
+ * vector
+ */
+static inline NecroValue necroVectorValue(Polar vector){
+    return _necroPackPair(
+        vector.magnitude,
+        vector.angle,
+        0u
+    );
+}
+
+/* Constructs a NecroValue for the specified point */
+static inline NecroValue necroPointValue(Point2D point){
+    return _necroPackPair(
+        point.x,
+        point.y,
+        _necroPointBit
+    );
+}
+
+/*
+ * Constructs a NecroValue for the specified object;
+ * object pointers must fit in 48 bits, which user
+ * space pointers do on x86-64 and ARM64
+ */
+static inline NecroValue _necroObjectValue(
+    NecroObject *objectPtr
+){
+    hotAssertTrue(
+        ((uint64_t)(uintptr_t)objectPtr
+            & ~_necroPayloadMask) == 0u,
+        "object pointer too wide to box; "
+        SRC_LOCATION
+    );
+    return _necroBox(
+        _necro_objectTag,
+        (uint64_t)(uintptr_t)objectPtr
+    );
+}
+
+/* Constructs a NecroValue for the specified object */
+#define necroObjectValue(OBJECT) \
+    _necroObjectValue((NecroObject*)(OBJECT))
+
+/* Returns the type of the specified NecroValue */
+static inline NecroValueType necroValueGetType(
+    NecroValue value
+){
+    if(!_necroIsBoxed(value)){
+        return (value.bits & _necroPointBit)
+            ? necro_point
+            : necro_vector;
+    }
+    switch((value.bits >> _necroTagShift)
+        & ~(_necroBoxMask >> _necroTagShift)
+    ){
+        case _necro_boolTag:
+            return necro_bool;
+        case _necro_intTag:
+            return necro_int;
+        case _necro_floatTag:
+            return necro_float;
+        case _necro_objectTag:
+            return necro_object;
+        default:
+            return necro_invalidValue;
+    }
+}
+
+/*
+ * Returns true if the specified NecroValue is a bool,
+ * false otherwise
+ */
+#define necroIsBool(VALUE) \
+    _necroHasTag((VALUE), _necro_boolTag)
+
+/*
+ * Returns true if the specified NecroValue is an int,
+ * false otherwise
+ */
+#define necroIsInt(VALUE) \
+    _necroHasTag((VALUE), _necro_intTag)
+
+/*
+ * Returns true if the specified NecroValue is a float,
+ * false otherwise
+ */
+#define necroIsFloat(VALUE) \
+    _necroHasTag((VALUE), _necro_floatTag)
+
+/*
+ * Returns true if the specified NecroValue is a
+ * vector, false otherwise
+ */
+#define necroIsVector(VALUE) \
+    (!_necroIsBoxed(VALUE) \
+        && !((VALUE).bits & _necroPointBit))
+
+/*
+ * Returns true if the specified NecroValue is a point,
+ * false otherwise
+ */
+#define necroIsPoint(VALUE) \
+    (!_necroIsBoxed(VALUE) \
+        && ((VALUE).bits & _necroPointBit))
+
+/*
+ * Returns true if the specified NecroValue is an
+ * object, false otherwise
+ */
+#define necroIsObject(VALUE) \
+    _necroHasTag((VALUE), _necro_objectTag)
+
+/* unchecked accessors used by the unboxing funcs */
+#define _necroUnboxBool(VALUE) \
+    ((bool)((VALUE).bits & 1u))
+#define _necroUnboxInt(VALUE) \
+    ((int)(uint32_t)(VALUE).bits)
+#define _necroUnboxFloat(VALUE) \
+    _necroBitsToFloat((uint32_t)(VALUE).bits)
+#define _necroUnboxVector(VALUE) \
+    ((Polar){ \
+        _necroPairFirst(VALUE), \
+        _necroPairSecond(VALUE) \
+    })
+#define _necroUnboxPoint(VALUE) \
+    ((Point2D){ \
+        _necroPairFirst(VALUE), \
+        _necroPairSecond(VALUE) \
+    })
+#define _necroUnboxObject(VALUE) \
+    ((NecroObject*)(uintptr_t)( \
+        (VALUE).bits & _necroPayloadMask \
+    ))
+
+#endif
+
 /*
  * Unboxes the specified NecroValue as a bool, error if
  * invalid tag
  */
 static inline bool necroAsBool(NecroValue value){
     if(necroIsBool(value)){
-        return value.as.boolean;
+        return _necroUnboxBool(value);
     }
     else{
         pgError("bad access for bool; " SRC_LOCATION);
@@ -127,7 +405,7 @@ static inline bool necroAsBool(NecroValue value){
  */
 static inline int necroAsInt(NecroValue value){
     if(necroIsInt(value)){
-        return value.as.integer;
+        return _necroUnboxInt(value);
     }
     else{
         pgError(
@@ -144,7 +422,7 @@ static inline int necroAsInt(NecroValue value){
  */
 static inline float necroAsFloat(NecroValue value){
     if(necroIsFloat(value)){
-        return value.as.floating;
+        return _necroUnboxFloat(value);
     }
     else{
         pgError("bad access for float; " SRC_LOCATION);
@@ -158,7 +436,7 @@ static inline float necroAsFloat(NecroValue value){
  */
 static inline Polar necroAsVector(NecroValue value){
     if(necroIsVector(value)){
-        return value.as.vector;
+        return _necroUnboxVector(value);
     }
     else{
         pgError(
@@ -175,7 +453,7 @@ static inline Polar necroAsVector(NecroValue value){
  */
 static inline Point2D necroAsPoint(NecroValue value){
     if(necroIsPoint(value)){
-        return value.as.point;
+        return _necroUnboxPoint(value);
     }
     else{
         pgError("bad access for point; " SRC_LOCATION);
@@ -191,7 +469,7 @@ static inline NecroObject *necroAsObject(
     NecroValue value
 ){
     if(necroIsObject(value)){
-        return value.as.object;
+        return _necroUnboxObject(value);
     }
     else{
         pgError(
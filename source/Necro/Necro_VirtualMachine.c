@@ -1,62 +1,45 @@
 #include "Necro_VirtualMachine.h"
 
+#include <stdatomic.h>
+
+#include "Necro_Aot.h"
 #include "Necro_Instruction.h"
 #include "Necro_Object.h"
+#include "Necro_Profiler.h"
 
 #define stringMapInitCapacity 50
 #define globalsMapInitCapacity 20
 
+/*
+ * source of sleep ids, shared by all virtual machines
+ * so that no two sleeps in flight share an id
+ */
+static atomic_uint_fast32_t nextSleepId;
+
 /* define for verbose output */
 /* #define VM_VERBOSE */
 
 /*
  * Constructs and returns a new NecroVirtualMachine by
  * value; the native function set pointer is nullable,
- * as is the user function set pointer
+ * as is the user function set pointer. Nothing is
+ * allocated until a program is loaded
  */
 NecroVirtualMachine necroVirtualMachineMake(
     NecroNativeFuncSet *nativeFuncSetPtr
 ){
     NecroVirtualMachine toRet = {0};
-    /*
-     * allocate the globals map; only free when
-     * VM is freed, cleared upon reset
-     */
-    toRet.globalsMap = hashMapMake(
-        NecroObjectString*,
-        NecroValue,
-        globalsMapInitCapacity,
-        _necroObjectStringPtrHash,
-        _necroObjectStringPtrEquals
-    );
-
     toRet.nativeFuncSetPtr = nativeFuncSetPtr;
+    toRet.heap = necroHeapMake();
 
     /*
-     * do not allocate the string map; defer to when
-     * the virtual machine actually starts to run
-     * a program (since we copy the map from literals)
+     * do not allocate the stacks or maps; defer to
+     * when the virtual machine actually starts to run
+     * a program, so that idle pooled VMs stay small
      */
     return toRet;
 }
 
-/*
- * Pushes the specified value onto the stack of the
- * specified virtual machine
- */
-void necroVirtualMachineStackPush(
-    NecroVirtualMachine *vmPtr,
-    NecroValue value
-){
-    if(vmPtr->stackPtr
-        == vmPtr->stack + NECRO_STACK_SIZE
-    ){
-        pgError("Necro stack overflow\n");
-    }
-    *(vmPtr->stackPtr) = value;
-    ++(vmPtr->stackPtr);
-}
-
 /*
  * Pops the topmost value off the stack of the
  * specified virtual machine
@@ -64,9 +47,10 @@ void necroVirtualMachineStackPush(
 NecroValue necroVirtualMachineStackPop(
     NecroVirtualMachine *vmPtr
 ){
-    if(vmPtr->stackPtr == vmPtr->stack){
-        pgError("Necro stack underflow\n");
-    }
+    hotAssertFalse(
+        vmPtr->stackPtr == vmPtr->stack,
+        "Necro stack underflow; " SRC_LOCATION
+    );
     --(vmPtr->stackPtr);
     return *(vmPtr->stackPtr);
 }
@@ -111,8 +95,9 @@ void necroVirtualMachineRuntimeError(
         );
         char *funcNamePtr = "unnamed script";
         if(funcPtr->namePtr != NULL){
-            funcNamePtr
-                = funcPtr->namePtr->string._ptr;
+            funcNamePtr = stringCharPtr(
+                &(funcPtr->namePtr->string)
+            );
         }
         snprintf(
             buffer,
@@ -129,6 +114,65 @@ void necroVirtualMachineRuntimeError(
     #undef bufferSize
 }
 
+/*
+ * Doubles the size of the stack of the specified
+ * virtual machine, or allocates it if it has none,
+ * and moves every pointer into it; errors if the
+ * stack is already at NECRO_STACK_SIZE
+ */
+static void necroVirtualMachineGrowStack(
+    NecroVirtualMachine *vmPtr
+){
+    size_t capacity = vmPtr->stackEndPtr - vmPtr->stack;
+    if(capacity >= NECRO_STACK_SIZE){
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "Stack overflow"
+        );
+        return;
+    }
+    size_t newCapacity = capacity
+        ? capacity * 2
+        : NECRO_STACK_INIT_SIZE;
+    if(newCapacity > NECRO_STACK_SIZE){
+        newCapacity = NECRO_STACK_SIZE;
+    }
+
+    /* take offsets before the old stack is freed */
+    size_t stackOffset = vmPtr->stackPtr - vmPtr->stack;
+    size_t slotsOffsets[NECRO_CALLSTACK_SIZE] = {0};
+    for(int i = 0; i < vmPtr->frameCount; ++i){
+        slotsOffsets[i]
+            = vmPtr->callStack[i].slots - vmPtr->stack;
+    }
+    vmPtr->stack = pgRealloc(
+        vmPtr->stack,
+        newCapacity,
+        sizeof(NecroValue)
+    );
+    vmPtr->stackPtr = vmPtr->stack + stackOffset;
+    vmPtr->stackEndPtr = vmPtr->stack + newCapacity;
+    for(int i = 0; i < vmPtr->frameCount; ++i){
+        vmPtr->callStack[i].slots
+            = vmPtr->stack + slotsOffsets[i];
+    }
+}
+
+/*
+ * Pushes the specified value onto the stack of the
+ * specified virtual machine
+ */
+void necroVirtualMachineStackPush(
+    NecroVirtualMachine *vmPtr,
+    NecroValue value
+){
+    if(vmPtr->stackPtr == vmPtr->stackEndPtr){
+        necroVirtualMachineGrowStack(vmPtr);
+    }
+    *(vmPtr->stackPtr) = value;
+    ++(vmPtr->stackPtr);
+}
+
 /*
  * Associates the given C string with the given native
  * function as a global variable for the specified
@@ -159,7 +203,7 @@ static void necroVirtualMachineDefineNativeFunc(
         necroObjectValue(necroObjectStringCopy(
             nameNativeFuncPair._name,
             (int)strlen(nameNativeFuncPair._name),
-            &(vmPtr->objectListHeadPtr),
+            &(vmPtr->heap),
             &(vmPtr->stringMap)
         ))
     );
@@ -167,7 +211,8 @@ static void necroVirtualMachineDefineNativeFunc(
         vmPtr,
         necroObjectValue(necroObjectNativeFuncMake(
             nameNativeFuncPair._func,
-            &(vmPtr->objectListHeadPtr)
+            nameNativeFuncPair._signaturePtr,
+            &(vmPtr->heap)
         ))
     );
     NecroObjectString *namePtr = necroObjectAsString(
@@ -227,6 +272,94 @@ static void necroVirtualMachineDefineNativeFunc(
 #define readString(FRAMEPTR) \
     necroObjectAsString(readLiteral(FRAMEPTR))
 
+/*
+ * Threaded dispatch ends every instruction handler
+ * with its own indirect jump to the handler of the
+ * next opcode, rather than having all instructions
+ * share the single jump of the switch; it relies on
+ * the labels as values extension of GCC and Clang,
+ * so other compilers use the switch. Define
+ * NECRO_SWITCH_DISPATCH to force the switch
+ */
+#if (defined(__GNUC__) || defined(__clang__)) \
+    && !defined(NECRO_SWITCH_DISPATCH) \
+    && !defined(VM_VERBOSE)
+#define NECRO_THREADED_DISPATCH
+#endif
+
+#ifdef NECRO_PROFILE
+/*
+ * Counts the next instruction in the specified call
+ * frame for the profiler
+ */
+#define profileInstruction(FRAMEPTR) \
+    necroProfilerInstruction(vmPtr, FRAMEPTR)
+#else
+#define profileInstruction(FRAMEPTR) ((void)0)
+#endif
+
+#ifdef NECRO_THREADED_DISPATCH
+/*
+ * Marks the handler for the specified opcode as both
+ * a switch case and a dispatch table target
+ */
+#define vmCase(OPCODE) case OPCODE: label_##OPCODE
+
+/*
+ * Ends an instruction handler by jumping straight to
+ * the handler of the next opcode in the specified
+ * call frame
+ */
+#define vmDispatch(FRAMEPTR) \
+    goto *dispatchTable[ \
+        (profileInstruction(FRAMEPTR), readByte(FRAMEPTR)) \
+    ]
+#else
+/* Marks the handler for the specified opcode */
+#define vmCase(OPCODE) case OPCODE
+
+/*
+ * Ends an instruction handler, returning to the
+ * switch for the next opcode
+ */
+#define vmDispatch(FRAMEPTR) break
+#endif
+
+/*
+ * Returns a runtime error from the run loop if the
+ * specified operation does not succeed
+ */
+#define vmTry(OPERATION) \
+    do{ \
+        if((OPERATION) != necro_success){ \
+            return necro_runtimeError; \
+        } \
+    } while(false)
+
+/*
+ * Hands the specified call frame, which must be the
+ * top one, to the ahead of time translated code of
+ * its program for as long as there is some, since
+ * that code returns whenever it pushes or pops a
+ * frame; returns from the run loop if the code stops
+ * the program, and leaves the frame pointer at the
+ * top frame otherwise
+ */
+#define vmRunAot(FRAMEPTR) \
+    while((FRAMEPTR)->funcPtr->program.aotPtr){ \
+        NecroStepResult aotResult \
+            = (FRAMEPTR)->funcPtr->program.aotPtr->func( \
+                vmPtr, \
+                (FRAMEPTR) \
+            ); \
+        if(aotResult != necro_stepFrameChanged){ \
+            return (NecroInterpretResult)aotResult; \
+        } \
+        (FRAMEPTR) = &(vmPtr->callStack[ \
+            vmPtr->frameCount - 1 \
+        ]); \
+    }
+
 /*
  * Performs a binary arithmetic operation in the
  * specified virtual machine
@@ -361,6 +494,85 @@ static void necroVirtualMachineDefineNativeFunc(
         } \
     } while(false)
 
+/*
+ * Applies the specified binary operator to the given
+ * local and literal values with the same result as
+ * binaryNumberOperation, writing it to RESULT; used
+ * by the superinstructions
+ */
+#define localLiteralNumberOperation( \
+    VMPTR, \
+    LOCAL, \
+    LITERAL, \
+    OP, \
+    PUSHBOOL, \
+    RESULT, \
+    ERRMSG \
+) \
+    do{ \
+        if(necroIsInt(LOCAL) && necroIsInt(LITERAL)){ \
+            int a = necroAsInt(LOCAL); \
+            int b = necroAsInt(LITERAL); \
+            (RESULT) = (PUSHBOOL) \
+                ? necroBoolValue(a OP b) \
+                : necroIntValue(a OP b); \
+        } \
+        else if( \
+            (necroIsInt(LOCAL) || necroIsFloat(LOCAL)) \
+            && (necroIsInt(LITERAL) \
+                || necroIsFloat(LITERAL)) \
+        ){ \
+            float a = necroIsInt(LOCAL) \
+                ? (float)necroAsInt(LOCAL) \
+                : necroAsFloat(LOCAL); \
+            float b = necroIsInt(LITERAL) \
+                ? (float)necroAsInt(LITERAL) \
+                : necroAsFloat(LITERAL); \
+            (RESULT) = (PUSHBOOL) \
+                ? necroBoolValue(a OP b) \
+                : necroFloatValue(a OP b); \
+        } \
+        else{ \
+            necroVirtualMachineRuntimeError( \
+                (VMPTR), \
+                (ERRMSG) \
+            ); \
+            return necro_runtimeError; \
+        } \
+    } while(false)
+
+/*
+ * Performs a fused compare of a local to a literal
+ * and jump if false in the specified virtual machine
+ */
+#define localLiteralCompareJump(VMPTR, FRAMEPTR, OP) \
+    do{ \
+        uint8_t slot = readByte(FRAMEPTR); \
+        uint8_t jumps = readByte(FRAMEPTR); \
+        NecroValue literal = readLiteral(FRAMEPTR); \
+        uint16_t offset = readShort(FRAMEPTR); \
+        NecroCallFrame *frameToAccess = (FRAMEPTR); \
+        for(int i = 0; i < jumps; ++i){ \
+            frameToAccess = frameToAccess->accessPtr; \
+        } \
+        NecroValue result = {0}; \
+        localLiteralNumberOperation( \
+            (VMPTR), \
+            frameToAccess->slots[slot], \
+            literal, \
+            OP, \
+            true, \
+            result, \
+            "Operands of comparison should be " \
+            "numbers" \
+        ); \
+        /* the condition stays for the compiled pop */ \
+        necroVirtualMachineStackPush((VMPTR), result); \
+        if(!necroAsBool(result)){ \
+            (FRAMEPTR)->instructionPtr += offset; \
+        } \
+    } while(false)
+
 /*
  * Performs a member get operation in the specified
  * virtual machine
@@ -392,6 +604,37 @@ static void necroVirtualMachineDefineNativeFunc(
         ); \
     } while(false)
 
+/*
+ * Replaces the top two values on the stack of the
+ * specified virtual machine with the result of the
+ * given function of them; the compiler has proven
+ * that they pass the given type checks, so they are
+ * only checked in debug builds
+ */
+#define typedBinaryOperation( \
+    VMPTR, \
+    AISFUNC, \
+    AASFUNC, \
+    BISFUNC, \
+    BASFUNC, \
+    FUNC, \
+    NECROVALUEFUNC \
+) \
+    do{ \
+        NecroValue *bPtr = (VMPTR)->stackPtr - 1; \
+        NecroValue *aPtr = bPtr - 1; \
+        hotAssertTrue( \
+            AISFUNC(*aPtr) && BISFUNC(*bPtr), \
+            "bad operand of typed operator; " \
+            SRC_LOCATION \
+        ); \
+        *aPtr = NECROVALUEFUNC(FUNC( \
+            AASFUNC(*aPtr), \
+            BASFUNC(*bPtr) \
+        )); \
+        (VMPTR)->stackPtr = bPtr; \
+    } while(false)
+
 /*
  * Performs a global member set operation in the
  * specified virtual machine
@@ -399,8 +642,10 @@ static void necroVirtualMachineDefineNativeFunc(
 #define globalMemberSetOperation( \
     VMPTR, \
     FRAMEPTR, \
+    TYPENAME, \
     NECROISFUNC, \
-    VALUEASNAME, \
+    NECROASFUNC, \
+    NECROVALUEFUNC, \
     MEMBERNAME, \
     ERRMSG \
 ) \
@@ -413,7 +658,7 @@ static void necroVirtualMachineDefineNativeFunc(
             &((VMPTR)->globalsMap), \
             name \
         )){ \
-            pgWarning(name->string._ptr); \
+            pgWarning(stringCharPtr(&(name->string))); \
             pgWarning((ERRMSG)); \
             necroVirtualMachineRuntimeError( \
                 (VMPTR), \
@@ -455,8 +700,9 @@ static void necroVirtualMachineDefineNativeFunc(
             ); \
             return necro_runtimeError; \
         } \
-        globalPtr->as.VALUEASNAME.MEMBERNAME \
-            = valueAsFloat; \
+        TYPENAME composite = NECROASFUNC(*globalPtr); \
+        composite.MEMBERNAME = valueAsFloat; \
+        *globalPtr = NECROVALUEFUNC(composite); \
     } while(false)
 
 /*
@@ -466,8 +712,10 @@ static void necroVirtualMachineDefineNativeFunc(
 #define localMemberSetOperation( \
     VMPTR, \
     FRAMEPTR, \
+    TYPENAME, \
     NECROISFUNC, \
-    VALUEASNAME, \
+    NECROASFUNC, \
+    NECROVALUEFUNC, \
     MEMBERNAME, \
     ERRMSG \
 ) \
@@ -509,10 +757,66 @@ static void necroVirtualMachineDefineNativeFunc(
             ); \
             return necro_runtimeError; \
         } \
-        localPtr->as.VALUEASNAME.MEMBERNAME \
-            = valueAsFloat; \
+        TYPENAME composite = NECROASFUNC(*localPtr); \
+        composite.MEMBERNAME = valueAsFloat; \
+        *localPtr = NECROVALUEFUNC(composite); \
     } while(false)
 
+/* marks the heap of the VM being collected */
+static _Thread_local NecroHeap *markHeapPtr = NULL;
+
+/*
+ * Marks the name and value of a global variable; for
+ * use with hashmap apply
+ */
+static void necroVirtualMachineMarkGlobal(
+    NecroObjectString **namePtrPtr,
+    NecroValue *valuePtr
+){
+    necroHeapMark(
+        markHeapPtr,
+        (NecroObject*)(*namePtrPtr)
+    );
+    necroHeapMarkValue(markHeapPtr, *valuePtr);
+}
+
+/*
+ * Does one step of incremental garbage collection for
+ * the specified virtual machine: starts a cycle if
+ * enough objects have been made since the last one by
+ * marking its roots, then sweeps at most
+ * NECRO_GC_SWEEP_BUDGET objects. The roots are the
+ * stack, which holds the slots of every call frame,
+ * and the globals; compiled funcs and their literals
+ * are owned by the program, not the heap
+ */
+static void necroVirtualMachineCollectStep(
+    NecroVirtualMachine *vmPtr
+){
+    NecroHeap *heapPtr = &(vmPtr->heap);
+    if(necroHeapCycleDue(heapPtr)){
+        for(NecroValue *valuePtr = vmPtr->stack;
+            valuePtr < vmPtr->stackPtr;
+            ++valuePtr
+        ){
+            necroHeapMarkValue(heapPtr, *valuePtr);
+        }
+        markHeapPtr = heapPtr;
+        hashMapKeyValueApply(NecroObjectString*,
+            NecroValue,
+            &(vmPtr->globalsMap),
+            necroVirtualMachineMarkGlobal
+        );
+        markHeapPtr = NULL;
+        necroHeapStartSweep(heapPtr);
+    }
+    necroHeapSweep(
+        heapPtr,
+        &(vmPtr->stringMap),
+        NECRO_GC_SWEEP_BUDGET
+    );
+}
+
 /*
  * Concatenates two strings for the specified virtual
  * machine and pushes the result to the stack
@@ -520,6 +824,8 @@ static void necroVirtualMachineDefineNativeFunc(
 static void necroVirtualMachineConcatenate(
     NecroVirtualMachine *vmPtr
 ){
+    /* collect while the operands are on the stack */
+    necroVirtualMachineCollectStep(vmPtr);
     NecroObjectString *b = necroObjectAsString(
         necroVirtualMachineStackPop(vmPtr)
     );
@@ -530,7 +836,7 @@ static void necroVirtualMachineConcatenate(
         = necroObjectStringConcat(
             a,
             b,
-            &(vmPtr->objectListHeadPtr),
+            &(vmPtr->heap),
             &(vmPtr->stringMap)
         );
     necroVirtualMachineStackPush(
@@ -562,6 +868,45 @@ static void _setAccessPtr(
     }
 }
 
+/*
+ * Doubles the size of the call stack of the specified
+ * virtual machine, or allocates it if it has none,
+ * and moves the access links of its frames; callers
+ * must refetch their frame pointers afterwards
+ */
+static void necroVirtualMachineGrowCallStack(
+    NecroVirtualMachine *vmPtr
+){
+    int newCapacity = vmPtr->callStackCapacity
+        ? vmPtr->callStackCapacity * 2
+        : NECRO_CALLSTACK_INIT_SIZE;
+    if(newCapacity > NECRO_CALLSTACK_SIZE){
+        newCapacity = NECRO_CALLSTACK_SIZE;
+    }
+
+    /* take indices before the old stack is freed */
+    int accessIndices[NECRO_CALLSTACK_SIZE] = {0};
+    for(int i = 0; i < vmPtr->frameCount; ++i){
+        NecroCallFrame *accessPtr
+            = vmPtr->callStack[i].accessPtr;
+        accessIndices[i] = accessPtr
+            ? (int)(accessPtr - vmPtr->callStack)
+            : -1;
+    }
+    vmPtr->callStack = pgRealloc(
+        vmPtr->callStack,
+        newCapacity,
+        sizeof(NecroCallFrame)
+    );
+    vmPtr->callStackCapacity = newCapacity;
+    for(int i = 0; i < vmPtr->frameCount; ++i){
+        vmPtr->callStack[i].accessPtr
+            = accessIndices[i] < 0
+                ? NULL
+                : &(vmPtr->callStack[accessIndices[i]]);
+    }
+}
+
 /*
  * Calls the specified function; returns true if
  * successful, false otherwise
@@ -598,9 +943,9 @@ static bool necroVirtualMachineCall(
         );
         return false;
     }
-    NecroCallFrame *prevPtr = &(vmPtr->callStack[
-        vmPtr->frameCount - 1
-    ]);
+    if(vmPtr->frameCount == vmPtr->callStackCapacity){
+        necroVirtualMachineGrowCallStack(vmPtr);
+    }
     NecroCallFrame *framePtr = &(vmPtr->callStack[
         vmPtr->frameCount++
     ]);
@@ -608,7 +953,16 @@ static bool necroVirtualMachineCall(
     framePtr->instructionPtr
         = funcPtr->program.code._ptr;
     framePtr->slots = vmPtr->stackPtr - numArgs - 1;
-    _setAccessPtr(prevPtr, framePtr);
+    /* the script frame has no enclosing frame */
+    if(vmPtr->frameCount == 1){
+        framePtr->accessPtr = NULL;
+    }
+    else{
+        _setAccessPtr(
+            &(vmPtr->callStack[vmPtr->frameCount - 2]),
+            framePtr
+        );
+    }
 
     /*
      * copy strings from the function if it actually
@@ -629,6 +983,45 @@ static bool necroVirtualMachineCall(
     return true;
 }
 
+/*
+ * Checks the specified arguments of a native call
+ * against the given nullable signature, converting
+ * them where it declares floats; returns true if they
+ * fit, otherwise errors and returns false
+ */
+static bool necroVirtualMachineCheckNativeArgs(
+    NecroVirtualMachine *vmPtr,
+    const NecroNativeSignature *signaturePtr,
+    int numArgs,
+    NecroValue *argv
+){
+    if(!signaturePtr){
+        return true;
+    }
+    if(!necroNativeSignatureAcceptsArity(
+        signaturePtr,
+        numArgs
+    )){
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "wrong number of arguments to native"
+        );
+        return false;
+    }
+    if(!necroNativeSignatureCheckArgs(
+        signaturePtr,
+        numArgs,
+        argv
+    )){
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "wrong type of argument to native"
+        );
+        return false;
+    }
+    return true;
+}
+
 /*
  * Calls the specified function passed as a value but
  * errors if the value is not a function; returns true
@@ -649,13 +1042,31 @@ static bool necroVirtualMachineCallValue(
                     true
                 );
             case necro_nativeFuncObject: {
+                NecroObjectNativeFunc *nativeFuncPtr
+                    = necroObjectAsNativeFunc(callee);
+                if(!necroVirtualMachineCheckNativeArgs(
+                    vmPtr,
+                    nativeFuncPtr->signaturePtr,
+                    numArgs,
+                    vmPtr->stackPtr - numArgs
+                )){
+                    return false;
+                }
                 NecroNativeFunc nativeFunc
-                    = necroObjectAsNativeFunc(callee)
-                        ->func;
+                    = nativeFuncPtr->func;
+                #ifdef NECRO_PROFILE
+                uint64_t startTicks = necroProfilerClock();
+                #endif
                 NecroValue result = nativeFunc(
                     numArgs,
                     vmPtr->stackPtr - numArgs
                 );
+                #ifdef NECRO_PROFILE
+                necroProfilerNative(
+                    nativeFunc,
+                    necroProfilerClock() - startTicks
+                );
+                #endif
                 vmPtr->stackPtr -= numArgs + 1;
                 necroVirtualMachineStackPush(
                     vmPtr,
@@ -675,984 +1086,1880 @@ static bool necroVirtualMachineCallValue(
 }
 
 /*
- * Runs the specified virtual machine
+ * Calls the native function named by the next byte
+ * in the specified call frame as an index into the
+ * native function set of the given virtual machine,
+ * with as many arguments as the byte after; they are
+ * checked against its signature only if specified,
+ * and the result is pushed only if specified
  */
-static NecroInterpretResult necroVirtualMachineRun(
-    NecroVirtualMachine *vmPtr
+static inline NecroInterpretResult necroVirtualMachineCallNative(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr,
+    bool checkArgs,
+    bool pushResult
 ){
-    NecroCallFrame *framePtr = &(
-        vmPtr->callStack[vmPtr->frameCount - 1]
+    uint8_t index = readByte(framePtr);
+    int numArgs = readByte(framePtr);
+    /*
+     * the compiler only emits natives of its set and
+     * loaded bytecode is checked against the set
+     */
+    hotAssertTrue(
+        vmPtr->nativeFuncSetPtr
+            && index < vmPtr->nativeFuncSetPtr
+                ->_nameNativeFuncPairs.size,
+        "native call with no such native; "
+        SRC_LOCATION
     );
-    /* initialize instruction to 0 just to be safe */
-    uint8_t instruction = 0;
+    _NecroNameNativeFuncPair *pairPtr
+        = necroNativeFuncSetGetPair(
+            vmPtr->nativeFuncSetPtr,
+            index
+        );
+    NecroValue *argv = vmPtr->stackPtr - numArgs;
+    if(checkArgs && !necroVirtualMachineCheckNativeArgs(
+        vmPtr,
+        pairPtr->_signaturePtr,
+        numArgs,
+        argv
+    )){
+        return necro_runtimeError;
+    }
+    #ifdef NECRO_PROFILE
+    uint64_t startTicks = necroProfilerClock();
+    #endif
+    NecroValue result = pairPtr->_func(numArgs, argv);
+    #ifdef NECRO_PROFILE
+    necroProfilerNative(
+        pairPtr->_func,
+        necroProfilerClock() - startTicks
+    );
+    #endif
+    /* no callee below the arguments to pop */
+    vmPtr->stackPtr = argv;
+    if(pushResult){
+        necroVirtualMachineStackPush(vmPtr, result);
+    }
+    return necro_success;
+}
 
-    while(true){
-        /* debug printing */
-        #ifdef VM_VERBOSE
-        printf("Stack:");
-        for(NecroValue *slotPtr = vmPtr->stack;
-            slotPtr < vmPtr->stackPtr;
-            ++slotPtr
-        ){
-            printf("[");
-            necroValuePrint(*slotPtr);
-            printf("]");
-        }
-        printf("\n");
-        necroProgramDisassembleInstruction(
-            &(framePtr->funcPtr->program),
-            (size_t)(framePtr->instructionPtr
-                - (uint8_t*)framePtr->funcPtr->program
-                    .code._ptr)
+/*
+ * Defines the global named by the next string in the
+ * specified call frame as the top of the stack of
+ * the given virtual machine, popping it
+ */
+static inline NecroInterpretResult necroVirtualMachineDefineGlobal(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    /*
+     * associate the name of the global
+     * with its value (top of stack)
+     */
+    NecroObjectString *name
+        = readString(framePtr);
+    NecroValue value
+        = necroVirtualMachineStackPeek(
+            vmPtr,
+            0
         );
-        #endif
+    hashMapPutPtr(
+        NecroObjectString*,
+        NecroValue,
+        &(vmPtr->globalsMap),
+        &name,
+        &value
+    );
+    necroVirtualMachineStackPop(vmPtr);
+    return necro_success;
+}
 
-        /* read next instruction opcode */
-        instruction = readByte(framePtr);
-        switch(instruction){
-            case necro_literal: {
-                NecroValue literal
-                    = readLiteral(framePtr);
-                necroVirtualMachineStackPush(
-                    vmPtr,
-                    literal
-                );
-                break;
-            }
-            case necro_pop: {
-                necroVirtualMachineStackPop(vmPtr);
-                break;
-            }
-            case necro_defineGlobal: {
-                /*
-                 * associate the name of the global
-                 * with its value (top of stack)
-                 */
-                NecroObjectString *name
-                    = readString(framePtr);
-                NecroValue value
-                    = necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    );
-                hashMapPutPtr(
-                    NecroObjectString*,
-                    NecroValue,
-                    &(vmPtr->globalsMap),
-                    &name,
-                    &value
-                );
-                necroVirtualMachineStackPop(vmPtr);
-                break;
-            }
-            case necro_getGlobal: {
-                /*
-                 * get the name of the global from the
-                 * top of the stack
-                 */
-                NecroObjectString *name
-                    = readString(framePtr);
+/*
+ * Pushes the value of the global named by the next
+ * string in the specified call frame onto the stack
+ * of the given virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineGetGlobal(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    /*
+     * get the name of the global from the
+     * top of the stack
+     */
+    NecroObjectString *name
+        = readString(framePtr);
+
+    NecroValue value = {0};
+
+    if(hashMapHasKey(
+        NecroObjectString*,
+        NecroValue,
+        &(vmPtr->globalsMap),
+        name
+    )){
+        value = hashMapGet(
+            NecroObjectString*,
+            NecroValue,
+            &(vmPtr->globalsMap),
+            name
+        );
+    }
+    else{
+        /*
+         * special case: user defined funcs
+         * have different string interning,
+         * so try to do a full O(n)
+         * charwise string compare
+         */
+        vmPtr->globalsMap._equalsFunc
+            = _necroObjectStringPtrCharwiseEquals;
+
+        if(hashMapHasKey(
+            NecroObjectString*,
+            NecroValue,
+            &(vmPtr->globalsMap),
+            name
+        )){
+            value = hashMapGet(
+                NecroObjectString*,
+                NecroValue,
+                &(vmPtr->globalsMap),
+                name
+            );
+            vmPtr->globalsMap._equalsFunc
+                = _necroObjectStringPtrEquals;
+        }
+        else{
+            pgWarning(stringCharPtr(&(name->string)));
+            necroVirtualMachineRuntimeError(
+                vmPtr,
+                "undefined variable; " 
+                SRC_LOCATION
+            );
+            vmPtr->globalsMap._equalsFunc
+                = _necroObjectStringPtrEquals;
+            return necro_runtimeError;
+        }
+    }
+    necroVirtualMachineStackPush(
+        vmPtr,
+        value
+    );
+    return necro_success;
+}
+
+/*
+ * Sets the global named by the next string in the
+ * specified call frame to the top of the stack of
+ * the given virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineSetGlobal(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    /*
+     * get the name of the global from the
+     * top of the stack
+     */
+    NecroObjectString *name
+        = readString(framePtr);
+    if(!hashMapHasKey(
+        NecroObjectString*,
+        NecroValue,
+        &(vmPtr->globalsMap),
+        name
+    )){
+        pgWarning(stringCharPtr(&(name->string)));
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "undefined variable; "
+            SRC_LOCATION
+        );
+        return necro_runtimeError;
+    }
+    NecroValue value
+        = necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        );
+    hashMapPutPtr(
+        NecroObjectString*,
+        NecroValue,
+        &(vmPtr->globalsMap),
+        &name,
+        &value
+    );
+    return necro_success;
+}
+
+/*
+ * Adds the top two values on the stack of the
+ * specified virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineAdd(
+    NecroVirtualMachine *vmPtr
+){
+    /*
+     * if both operands are strings,
+     * concatenate them
+     */
+    if(necroIsString(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                0
+            )
+        ) && necroIsString(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                1
+            )
+        )
+    ){
+        necroVirtualMachineConcatenate(vmPtr);
+    }
+    /*
+     * otherwise if both operands are
+     * vectors, add them
+     */
+    else if(
+        necroIsVector(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                0
+            )
+        ) && necroIsVector(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                1
+            )
+        )
+    ){
+        Polar b = necroAsVector(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        Polar a = necroAsVector(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        Polar sum = polarAdd(a, b);
+        necroVirtualMachineStackPush(
+            vmPtr,
+            necroVectorValue(sum)
+        );
+    }
+    /* otherwise, check point + vector */
+    else if(
+        necroIsVector(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                0
+            )
+        ) && necroIsPoint(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                1
+            )
+        )
+    ){
+        Polar b = necroAsVector(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        Point2D a = necroAsPoint(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        Point2D sum
+            = point2DAddPolar(a, b);
+        necroVirtualMachineStackPush(
+            vmPtr,
+            necroPointValue(sum)
+        );
+    }
+    /*
+     * otherwise, they could be two numbers
+     */
+    else {
+        binaryNumberOperation(
+            vmPtr,
+            +,
+            false,
+            "Invalid operands for '+'"
+        );
+    }
+    return necro_success;
+}
+
+/*
+ * Subtracts the top value on the stack of the
+ * specified virtual machine from the one below
+ */
+static inline NecroInterpretResult necroVirtualMachineSubtract(
+    NecroVirtualMachine *vmPtr
+){
+    /*
+     * if both operands are vectors,
+     * subtract them
+     */
+    if(
+        necroIsVector(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                0
+            )
+        ) && necroIsVector(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                1
+            )
+        )
+    ){
+        Polar b = necroAsVector(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        Polar a = necroAsVector(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        Polar diff = polarSubtract(a, b);
+        necroVirtualMachineStackPush(
+            vmPtr,
+            necroVectorValue(diff)
+        );
+    }
+    /* otherwise, check point - vector */
+    else if(
+        necroIsVector(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                0
+            )
+        ) && necroIsPoint(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                1
+            )
+        )
+    ){
+        Polar b = necroAsVector(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        Point2D a = necroAsPoint(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        Point2D diff
+            = point2DSubtractPolar(a, b);
+        necroVirtualMachineStackPush(
+            vmPtr,
+            necroPointValue(diff)
+        );
+    }
+    /* otherwise, check point - point */
+    else if(
+        necroIsPoint(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                0
+            )
+        ) && necroIsPoint(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                1
+            )
+        )
+    ){
+        Point2D b = necroAsPoint(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        Point2D a = necroAsPoint(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        Polar diff = polarFromAToB(b, a);
+        necroVirtualMachineStackPush(
+            vmPtr,
+            necroVectorValue(diff)
+        );
+    }
+    else{
+        binaryNumberOperation(
+            vmPtr,
+            -,
+            false,
+            "Invalid operands for '-'"
+        );
+    }
+    return necro_success;
+}
+
+/*
+ * Multiplies the top two values on the stack of the
+ * specified virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineMultiply(
+    NecroVirtualMachine *vmPtr
+){
+    /*
+     * check for scalar multiplication of
+     * vector
+     */
+    if(
+        necroIsVector(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                1
+            )
+        ) && (necroIsInt(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                0
+            )
+        ) || necroIsFloat(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                0
+            )
+        ))
+    ){
+        NecroValue aValue
+            = necroVirtualMachineStackPop(
+                vmPtr
+            );
+        Polar polar = necroAsVector(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        float scalar = 
+            necroIsInt(aValue)
+                ? necroAsInt(aValue)
+                : necroAsFloat(aValue);
+        Polar multiple = polarMultiply(
+            polar,
+            scalar
+        );
+        necroVirtualMachineStackPush(
+            vmPtr,
+            necroVectorValue(multiple)
+        );
+    }
+    else{
+        binaryNumberOperation(
+            vmPtr,
+            *,
+            false,
+            "Invalid operands for '*' "
+            "(in case of vector multiply, "
+            "it must be vector * scalar)"
+        );
+    }
+    return necro_success;
+}
+
+/*
+ * Divides the second value on the stack of the
+ * specified virtual machine by the top one
+ */
+static inline NecroInterpretResult necroVirtualMachineDivide(
+    NecroVirtualMachine *vmPtr
+){
+    /*
+     * check for scalar division of
+     * vector
+     */
+    if(
+        necroIsVector(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                1
+            )
+        ) && (necroIsInt(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                0
+            )
+        ) || necroIsFloat(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                0
+            )
+        ))
+    ){
+        NecroValue aValue
+            = necroVirtualMachineStackPop(
+                vmPtr
+            );
+        Polar polar = necroAsVector(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        float scalar = 
+            necroIsInt(aValue)
+                ? necroAsInt(aValue)
+                : necroAsFloat(aValue);
+        Polar quotient = polarDivide(
+            polar,
+            scalar
+        );
+        necroVirtualMachineStackPush(
+            vmPtr,
+            necroVectorValue(quotient)
+        );
+    }
+    else{
+        binaryNumberOperation(
+            vmPtr,
+            /,
+            false,
+            "Invalid operands for '/' "
+            "(in case of vector divide, "
+            "it must be vector / scalar)"
+        );
+    }
+    return necro_success;
+}
+
+/*
+ * Takes the second value on the stack of the
+ * specified virtual machine modulo the top one
+ */
+static inline NecroInterpretResult necroVirtualMachineModulo(
+    NecroVirtualMachine *vmPtr
+){
+    if(!necroIsInt(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                0
+            )
+        ) || !necroIsInt(
+            necroVirtualMachineStackPeek(
+                vmPtr,
+                1
+            )
+        )
+    ){
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "Operands of '%' should be "
+            "integers only"
+        );
+        return necro_runtimeError;
+    }
+    int b = necroAsInt(
+        necroVirtualMachineStackPop(vmPtr)
+    );
+    int a = necroAsInt(
+        necroVirtualMachineStackPop(vmPtr)
+    );
+    necroVirtualMachineStackPush(
+        vmPtr,
+        necroIntValue(a % b)
+    );
+    return necro_success;
+}
+
+/*
+ * Negates the top value on the stack of the
+ * specified virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineNegate(
+    NecroVirtualMachine *vmPtr
+){
+    if(necroIsInt(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        necroVirtualMachineStackPush(
+            vmPtr,
+            necroIntValue(-necroAsInt(
+                necroVirtualMachineStackPop(
+                    vmPtr
+                )
+            ))
+        );
+    }
+    else if(necroIsFloat(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        necroVirtualMachineStackPush(
+            vmPtr,
+            necroFloatValue(-necroAsFloat(
+                necroVirtualMachineStackPop(
+                    vmPtr
+                )
+            ))
+        );
+    }
+    else if(necroIsVector(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        Polar vector = necroAsVector(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+        necroVirtualMachineStackPush(
+            vmPtr,
+            necroVectorValue(
+                polarNegate(vector)
+            )
+        );
+    }
+    else{
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "Operand of unary '-' should "
+            "be number or vector"
+        );
+        return necro_runtimeError;
+    }
+    return necro_success;
+}
+
+/* Returns the specified int or float as a float */
+static inline float necroVirtualMachineAsScalar(
+    NecroValue value
+){
+    return necroIsInt(value)
+        ? necroAsInt(value)
+        : necroAsFloat(value);
+}
+
+/* Returns whether the specified value is a number */
+static inline bool necroVirtualMachineIsScalar(
+    NecroValue value
+){
+    return necroIsInt(value) || necroIsFloat(value);
+}
+
+/*
+ * Returns the vector from the second specified point
+ * to the first
+ */
+static inline Polar necroVirtualMachinePointDiff(
+    Point2D a,
+    Point2D b
+){
+    return polarFromAToB(b, a);
+}
+
+/*
+ * Adds the top two values on the stack of the
+ * specified virtual machine, which are vectors
+ */
+static inline void necroVirtualMachineAddVectors(
+    NecroVirtualMachine *vmPtr
+){
+    typedBinaryOperation(
+        vmPtr,
+        necroIsVector,
+        necroAsVector,
+        necroIsVector,
+        necroAsVector,
+        polarAdd,
+        necroVectorValue
+    );
+}
+
+/*
+ * Subtracts the top value on the stack of the
+ * specified virtual machine from the one below,
+ * which are vectors
+ */
+static inline void necroVirtualMachineSubtractVectors(
+    NecroVirtualMachine *vmPtr
+){
+    typedBinaryOperation(
+        vmPtr,
+        necroIsVector,
+        necroAsVector,
+        necroIsVector,
+        necroAsVector,
+        polarSubtract,
+        necroVectorValue
+    );
+}
+
+/*
+ * Adds the vector on top of the stack of the
+ * specified virtual machine to the point below
+ */
+static inline void necroVirtualMachineAddPointVector(
+    NecroVirtualMachine *vmPtr
+){
+    typedBinaryOperation(
+        vmPtr,
+        necroIsPoint,
+        necroAsPoint,
+        necroIsVector,
+        necroAsVector,
+        point2DAddPolar,
+        necroPointValue
+    );
+}
+
+/*
+ * Subtracts the vector on top of the stack of the
+ * specified virtual machine from the point below
+ */
+static inline void necroVirtualMachineSubtractPointVector(
+    NecroVirtualMachine *vmPtr
+){
+    typedBinaryOperation(
+        vmPtr,
+        necroIsPoint,
+        necroAsPoint,
+        necroIsVector,
+        necroAsVector,
+        point2DSubtractPolar,
+        necroPointValue
+    );
+}
+
+/*
+ * Subtracts the point on top of the stack of the
+ * specified virtual machine from the point below,
+ * giving the vector between them
+ */
+static inline void necroVirtualMachineSubtractPoints(
+    NecroVirtualMachine *vmPtr
+){
+    typedBinaryOperation(
+        vmPtr,
+        necroIsPoint,
+        necroAsPoint,
+        necroIsPoint,
+        necroAsPoint,
+        necroVirtualMachinePointDiff,
+        necroVectorValue
+    );
+}
+
+/*
+ * Multiplies the vector second on the stack of the
+ * specified virtual machine by the number on top
+ */
+static inline void necroVirtualMachineMultiplyVector(
+    NecroVirtualMachine *vmPtr
+){
+    typedBinaryOperation(
+        vmPtr,
+        necroIsVector,
+        necroAsVector,
+        necroVirtualMachineIsScalar,
+        necroVirtualMachineAsScalar,
+        polarMultiply,
+        necroVectorValue
+    );
+}
+
+/*
+ * Divides the vector second on the stack of the
+ * specified virtual machine by the number on top
+ */
+static inline void necroVirtualMachineDivideVector(
+    NecroVirtualMachine *vmPtr
+){
+    typedBinaryOperation(
+        vmPtr,
+        necroIsVector,
+        necroAsVector,
+        necroVirtualMachineIsScalar,
+        necroVirtualMachineAsScalar,
+        polarDivide,
+        necroVectorValue
+    );
+}
+
+/*
+ * Replaces the top two points on the stack of the
+ * specified virtual machine with the distance
+ * between them, exactly as the magnitude of their
+ * difference would be
+ */
+static inline void necroVirtualMachinePointDistance(
+    NecroVirtualMachine *vmPtr
+){
+    NecroValue *bPtr = vmPtr->stackPtr - 1;
+    NecroValue *aPtr = bPtr - 1;
+    hotAssertTrue(
+        necroIsPoint(*aPtr) && necroIsPoint(*bPtr),
+        "bad operand of typed operator; "
+        SRC_LOCATION
+    );
+    /* the magnitude alone skips the arctangent */
+    Vector2D diff = vector2DFromAToB(
+        necroAsPoint(*bPtr),
+        necroAsPoint(*aPtr)
+    );
+    *aPtr = necroFloatValue(vector2DMagnitude(diff));
+    vmPtr->stackPtr = bPtr;
+}
+
+/*
+ * Replaces the top two points on the stack of the
+ * specified virtual machine with the angle from the
+ * top one to the other, exactly as the angle of their
+ * difference would be
+ */
+static inline void necroVirtualMachinePointAngle(
+    NecroVirtualMachine *vmPtr
+){
+    NecroValue *bPtr = vmPtr->stackPtr - 1;
+    NecroValue *aPtr = bPtr - 1;
+    hotAssertTrue(
+        necroIsPoint(*aPtr) && necroIsPoint(*bPtr),
+        "bad operand of typed operator; "
+        SRC_LOCATION
+    );
+    /* the angle alone skips the square root */
+    Polar diff = {0};
+    diff.angle = vector2DAngle(vector2DFromAToB(
+        necroAsPoint(*bPtr),
+        necroAsPoint(*aPtr)
+    ));
+    /*
+     * round trip through a vector value, which may
+     * cost the angle its last bit when NaN boxed
+     */
+    diff = necroAsVector(necroVectorValue(diff));
+    *aPtr = necroFloatValue(diff.angle);
+    vmPtr->stackPtr = bPtr;
+}
+
+/*
+ * Compares whether the second value on the stack of
+ * the specified virtual machine is greater than the
+ * top one
+ */
+static inline NecroInterpretResult necroVirtualMachineGreater(
+    NecroVirtualMachine *vmPtr
+){
+    binaryNumberOperation(
+        vmPtr,
+        >,
+        true,
+        "Operands of comparison should be "
+        "numbers"
+    );
+    return necro_success;
+}
+
+/*
+ * Compares whether the second value on the stack of
+ * the specified virtual machine is less than the
+ * top one
+ */
+static inline NecroInterpretResult necroVirtualMachineLess(
+    NecroVirtualMachine *vmPtr
+){
+    binaryNumberOperation(
+        vmPtr,
+        <,
+        true,
+        "Operands of comparison should be "
+        "numbers"
+    );
+    return necro_success;
+}
+
+/*
+ * Negates the bool on top of the stack of the
+ * specified virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineNot(
+    NecroVirtualMachine *vmPtr
+){
+    if(!necroIsBool(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "Operand of unary '!' should "
+            "be bool"
+        );
+        return necro_runtimeError;
+    }
+    necroVirtualMachineStackPush(
+        vmPtr,
+        necroBoolValue(!necroAsBool(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        ))
+    );
+    return necro_success;
+}
+
+/*
+ * Makes a vector of the top two values on the stack
+ * of the specified virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineMakeVector(
+    NecroVirtualMachine *vmPtr
+){
+    float r = 0;
+    float theta = 0;
+
+    /* top of the stack should be theta */
+    if(necroIsInt(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        theta = necroAsInt(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+    }
+    else if(necroIsFloat(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        theta = necroAsFloat(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+    }
+    else{
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "Theta operand of '<>' should "
+            "be a number"
+        );
+        return necro_runtimeError;
+    }
+    /*
+     * after getting theta, top of stack
+     * should be R
+     */
+    if(necroIsInt(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        r = necroAsInt(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+    }
+    else if(necroIsFloat(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        r = necroAsFloat(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+    }
+    else{
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "R operand of '<>' should "
+            "be a number"
+        );
+        return necro_runtimeError;
+    }
+    Polar vector = {r, theta};
+    necroVirtualMachineStackPush(
+        vmPtr,
+        necroVectorValue(vector)
+    );
+    return necro_success;
+}
 
-                NecroValue value = {0};
+/*
+ * Makes a point of the top two values on the stack
+ * of the specified virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineMakePoint(
+    NecroVirtualMachine *vmPtr
+){
+    float x = 0;
+    float y = 0;
 
-                if(hashMapHasKey(
-                    NecroObjectString*,
-                    NecroValue,
-                    &(vmPtr->globalsMap),
-                    name
-                )){
-                    value = hashMapGet(
-                        NecroObjectString*,
-                        NecroValue,
-                        &(vmPtr->globalsMap),
-                        name
-                    );
-                }
-                else{
-                    /*
-                     * special case: user defined funcs
-                     * have different string interning,
-                     * so try to do a full O(n)
-                     * charwise string compare
-                     */
-                    vmPtr->globalsMap._equalsFunc
-                        = _necroObjectStringPtrCharwiseEquals;
-
-                    if(hashMapHasKey(
-                        NecroObjectString*,
-                        NecroValue,
-                        &(vmPtr->globalsMap),
-                        name
-                    )){
-                        value = hashMapGet(
-                            NecroObjectString*,
-                            NecroValue,
-                            &(vmPtr->globalsMap),
-                            name
-                        );
-                        vmPtr->globalsMap._equalsFunc
-                            = _necroObjectStringPtrEquals;
-                    }
-                    else{
-                        pgWarning(name->string._ptr);
-                        necroVirtualMachineRuntimeError(
-                            vmPtr,
-                            "undefined variable; " 
-                            SRC_LOCATION
-                        );
-                        vmPtr->globalsMap._equalsFunc
-                            = _necroObjectStringPtrEquals;
-                        return necro_runtimeError;
-                    }
-                }
-                necroVirtualMachineStackPush(
-                    vmPtr,
-                    value
-                );
-                break;
-            }
-            case necro_setGlobal: {
-                /*
-                 * get the name of the global from the
-                 * top of the stack
-                 */
-                NecroObjectString *name
-                    = readString(framePtr);
-                if(!hashMapHasKey(
-                    NecroObjectString*,
-                    NecroValue,
-                    &(vmPtr->globalsMap),
-                    name
-                )){
-                    pgWarning(name->string._ptr);
-                    necroVirtualMachineRuntimeError(
-                        vmPtr,
-                        "undefined variable; "
-                        SRC_LOCATION
-                    );
-                    return necro_runtimeError;
-                }
-                NecroValue value
-                    = necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    );
-                hashMapPutPtr(
-                    NecroObjectString*,
-                    NecroValue,
-                    &(vmPtr->globalsMap),
-                    &name,
-                    &value
-                );
-                break;
-            }
-            case necro_getLocal: {
-                /* get the stack slot of the local */
-                uint8_t slot = readByte(framePtr);
-                /* get number of access jumps */
-                uint8_t jumps = readByte(framePtr);
+    /* top of the stack should be y */
+    if(necroIsInt(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        y = necroAsInt(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+    }
+    else if(necroIsFloat(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        y = necroAsFloat(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+    }
+    else{
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "Y operand of '[]' should "
+            "be a number"
+        );
+        return necro_runtimeError;
+    }
+    /*
+     * after getting y, top of stack
+     * should be x
+     */
+    if(necroIsInt(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        x = necroAsInt(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+    }
+    else if(necroIsFloat(
+        necroVirtualMachineStackPeek(
+            vmPtr,
+            0
+        )
+    )){
+        x = necroAsFloat(
+            necroVirtualMachineStackPop(
+                vmPtr
+            )
+        );
+    }
+    else{
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "X operand of '[]' should "
+            "be a number"
+        );
+        return necro_runtimeError;
+    }
+    Point2D point = {x, y};
+    necroVirtualMachineStackPush(
+        vmPtr,
+        necroPointValue(point)
+    );
+    return necro_success;
+}
+
+/*
+ * Gets the magnitude of the vector on top of the
+ * stack of the specified virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineGetR(
+    NecroVirtualMachine *vmPtr
+){
+    memberGetOperation(
+        vmPtr,
+        Polar,
+        necroIsVector,
+        necroAsVector,
+        magnitude,
+        "Expect operand of \".r\" to be "
+        "a vector"
+    );
+    return necro_success;
+}
+
+/*
+ * Gets the angle of the vector on top of the stack
+ * of the specified virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineGetTheta(
+    NecroVirtualMachine *vmPtr
+){
+    memberGetOperation(
+        vmPtr,
+        Polar,
+        necroIsVector,
+        necroAsVector,
+        angle,
+        "Expect operand of \".t\" to be "
+        "a vector"
+    );
+    return necro_success;
+}
+
+/*
+ * Gets the x coordinate of the point on top of the
+ * stack of the specified virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineGetX(
+    NecroVirtualMachine *vmPtr
+){
+    memberGetOperation(
+        vmPtr,
+        Point2D,
+        necroIsPoint,
+        necroAsPoint,
+        x,
+        "Expect operand of \".x\" to be "
+        "a point"
+    );
+    return necro_success;
+}
+
+/*
+ * Gets the y coordinate of the point on top of the
+ * stack of the specified virtual machine
+ */
+static inline NecroInterpretResult necroVirtualMachineGetY(
+    NecroVirtualMachine *vmPtr
+){
+    memberGetOperation(
+        vmPtr,
+        Point2D,
+        necroIsPoint,
+        necroAsPoint,
+        y,
+        "Expect operand of \".y\" to be "
+        "a point"
+    );
+    return necro_success;
+}
+
+/*
+ * Sets the magnitude of the global vector named by
+ * the next string in the specified call frame
+ */
+static inline NecroInterpretResult necroVirtualMachineSetRGlobal(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    globalMemberSetOperation(
+        vmPtr,
+        framePtr,
+        Polar,
+        necroIsVector,
+        necroAsVector,
+        necroVectorValue,
+        magnitude,
+        "Error for setRGlobal"
+    );
+    return necro_success;
+}
+
+/*
+ * Sets the angle of the global vector named by the
+ * next string in the specified call frame
+ */
+static inline NecroInterpretResult necroVirtualMachineSetThetaGlobal(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    globalMemberSetOperation(
+        vmPtr,
+        framePtr,
+        Polar,
+        necroIsVector,
+        necroAsVector,
+        necroVectorValue,
+        angle,
+        "Error for setThetaGlobal"
+    );
+    return necro_success;
+}
+
+/*
+ * Sets the x coordinate of the global point named
+ * by the next string in the specified call frame
+ */
+static inline NecroInterpretResult necroVirtualMachineSetXGlobal(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    globalMemberSetOperation(
+        vmPtr,
+        framePtr,
+        Point2D,
+        necroIsPoint,
+        necroAsPoint,
+        necroPointValue,
+        x,
+        "Error for setXGlobal"
+    );
+    return necro_success;
+}
+
+/*
+ * Sets the y coordinate of the global point named
+ * by the next string in the specified call frame
+ */
+static inline NecroInterpretResult necroVirtualMachineSetYGlobal(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    globalMemberSetOperation(
+        vmPtr,
+        framePtr,
+        Point2D,
+        necroIsPoint,
+        necroAsPoint,
+        necroPointValue,
+        y,
+        "Error for setYGlobal"
+    );
+    return necro_success;
+}
+
+/*
+ * Sets the magnitude of the local vector in the
+ * next slot of the specified call frame
+ */
+static inline NecroInterpretResult necroVirtualMachineSetRLocal(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    localMemberSetOperation(
+        vmPtr,
+        framePtr,
+        Polar,
+        necroIsVector,
+        necroAsVector,
+        necroVectorValue,
+        magnitude,
+        "Error for setRLocal"
+    );
+    return necro_success;
+}
+
+/*
+ * Sets the angle of the local vector in the next
+ * slot of the specified call frame
+ */
+static inline NecroInterpretResult necroVirtualMachineSetThetaLocal(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    localMemberSetOperation(
+        vmPtr,
+        framePtr,
+        Polar,
+        necroIsVector,
+        necroAsVector,
+        necroVectorValue,
+        angle,
+        "Error for setThetaLocal"
+    );
+    return necro_success;
+}
+
+/*
+ * Sets the x coordinate of the local point in the
+ * next slot of the specified call frame
+ */
+static inline NecroInterpretResult necroVirtualMachineSetXLocal(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    localMemberSetOperation(
+        vmPtr,
+        framePtr,
+        Point2D,
+        necroIsPoint,
+        necroAsPoint,
+        necroPointValue,
+        x,
+        "Error for setXLocal"
+    );
+    return necro_success;
+}
+
+/*
+ * Sets the y coordinate of the local point in the
+ * next slot of the specified call frame
+ */
+static inline NecroInterpretResult necroVirtualMachineSetYLocal(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    localMemberSetOperation(
+        vmPtr,
+        framePtr,
+        Point2D,
+        necroIsPoint,
+        necroAsPoint,
+        necroPointValue,
+        y,
+        "Error for setYLocal"
+    );
+    return necro_success;
+}
+
+/*
+ * Adds the next literal in the specified call frame
+ * to the local in the next slot
+ */
+static inline NecroInterpretResult necroVirtualMachineAddLocalLiteral(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    uint8_t slot = readByte(framePtr);
+    uint8_t jumps = readByte(framePtr);
+    NecroValue literal
+        = readLiteral(framePtr);
+
+    NecroCallFrame *frameToAccess
+        = framePtr;
+    for(int i = 0; i < jumps; ++i){
+        frameToAccess
+            = frameToAccess->accessPtr;
+    }
+    NecroValue *localPtr
+        = &(frameToAccess->slots[slot]);
+    NecroValue sum = {0};
+    localLiteralNumberOperation(
+        vmPtr,
+        *localPtr,
+        literal,
+        +,
+        false,
+        sum,
+        "Invalid operands for '+'"
+    );
+    /* assignment leaves the value */
+    *localPtr = sum;
+    necroVirtualMachineStackPush(vmPtr, sum);
+    return necro_success;
+}
+
+/*
+ * Compares whether the local in the next slot of the
+ * specified call frame is less than the next
+ * literal, jumping if not
+ */
+static inline NecroInterpretResult necroVirtualMachineLessLocalLiteralJump(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    localLiteralCompareJump(
+        vmPtr,
+        framePtr,
+        <
+    );
+    return necro_success;
+}
+
+/*
+ * Compares whether the local in the next slot of the
+ * specified call frame is greater than the next
+ * literal, jumping if not
+ */
+static inline NecroInterpretResult necroVirtualMachineGreaterLocalLiteralJump(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    localLiteralCompareJump(
+        vmPtr,
+        framePtr,
+        >
+    );
+    return necro_success;
+}
+
+/*
+ * Returns from the function in the specified call
+ * frame, which must be the top one of the given
+ * virtual machine, pushing its result for the caller;
+ * returns true if the script itself returned, false
+ * otherwise
+ */
+static inline bool necroVirtualMachineReturn(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    NecroValue result = necroVirtualMachineStackPop(
+        vmPtr
+    );
+    --(vmPtr->frameCount);
+    if(vmPtr->frameCount == 0){
+        necroVirtualMachineStackPop(vmPtr);
+        return true;
+    }
+
+    vmPtr->stackPtr = framePtr->slots;
+    /*
+     * push the return value back onto the stack; even
+     * "null" returns actually return the value FALSE
+     */
+    necroVirtualMachineStackPush(vmPtr, result);
+    return false;
+}
+
+/*
+ * Pops the number of ticks for the specified virtual
+ * machine to sleep; returns necro_yielded if it goes
+ * to sleep, or necro_success if the number is not
+ * positive and it should carry on
+ */
+static inline NecroInterpretResult necroVirtualMachineSleep(
+    NecroVirtualMachine *vmPtr
+){
+    NecroValue ticksValue
+        = necroVirtualMachineStackPop(vmPtr);
+    int ticks = 0;
+    if(necroIsInt(ticksValue)){
+        ticks = necroAsInt(ticksValue);
+    }
+    else if(necroIsFloat(ticksValue)){
+        ticks = (int)necroAsFloat(ticksValue);
+    }
+    else{
+        necroVirtualMachineRuntimeError(
+            vmPtr,
+            "Operand of 'wait for' should be "
+            "a number"
+        );
+        return necro_runtimeError;
+    }
+    if(ticks <= 0){
+        return necro_success;
+    }
+    /* this yield counts as the first tick */
+    vmPtr->sleepTicks = ticks - 1;
+    vmPtr->sleepId = (uint32_t)atomic_fetch_add(
+        &nextSleepId,
+        1
+    ) + 1;
+    return necro_yielded;
+}
+
+/*
+ * Runs the specified virtual machine
+ */
+static NecroInterpretResult necroVirtualMachineRun(
+    NecroVirtualMachine *vmPtr
+){
+    NecroCallFrame *framePtr = &(
+        vmPtr->callStack[vmPtr->frameCount - 1]
+    );
+    /* initialize instruction to 0 just to be safe */
+    uint8_t instruction = 0;
 
-                NecroCallFrame *frameToAccess
-                    = framePtr;
-                for(int i = 0; i < jumps; ++i){
-                    frameToAccess
-                        = frameToAccess->accessPtr;
-                }
-                /*
-                 * push the value of the local to the
-                 * top of the stack; get the local
-                 * relative to the call frame
-                 */
-                necroVirtualMachineStackPush(
-                    vmPtr,
-                    frameToAccess->slots[slot]
-                );
-                break;
-            }
-            case necro_setLocal: {
-                /* get the stack slot of the local */
-                uint8_t slot = readByte(framePtr);
-                /* get number of access jumps */
-                uint8_t jumps = readByte(framePtr);
+    #ifdef NECRO_THREADED_DISPATCH
+    /* handler label addresses indexed by opcode */
+    static void *const dispatchTable[] = {
+        [necro_literal] = &&label_necro_literal,
+        [necro_pop] = &&label_necro_pop,
+        [necro_defineGlobal] = &&label_necro_defineGlobal,
+        [necro_getGlobal] = &&label_necro_getGlobal,
+        [necro_setGlobal] = &&label_necro_setGlobal,
+        [necro_getLocal] = &&label_necro_getLocal,
+        [necro_setLocal] = &&label_necro_setLocal,
+        [necro_true] = &&label_necro_true,
+        [necro_false] = &&label_necro_false,
+        [necro_add] = &&label_necro_add,
+        [necro_subtract] = &&label_necro_subtract,
+        [necro_multiply] = &&label_necro_multiply,
+        [necro_divide] = &&label_necro_divide,
+        [necro_modulo] = &&label_necro_modulo,
+        [necro_negate] = &&label_necro_negate,
+        [necro_addVectors] = &&label_necro_addVectors,
+        [necro_subtractVectors]
+            = &&label_necro_subtractVectors,
+        [necro_addPointVector]
+            = &&label_necro_addPointVector,
+        [necro_subtractPointVector]
+            = &&label_necro_subtractPointVector,
+        [necro_subtractPoints]
+            = &&label_necro_subtractPoints,
+        [necro_multiplyVector]
+            = &&label_necro_multiplyVector,
+        [necro_divideVector] = &&label_necro_divideVector,
+        [necro_equal] = &&label_necro_equal,
+        [necro_greater] = &&label_necro_greater,
+        [necro_less] = &&label_necro_less,
+        [necro_not] = &&label_necro_not,
+        [necro_makeVector] = &&label_necro_makeVector,
+        [necro_makePoint] = &&label_necro_makePoint,
+        [necro_getR] = &&label_necro_getR,
+        [necro_getTheta] = &&label_necro_getTheta,
+        [necro_getX] = &&label_necro_getX,
+        [necro_getY] = &&label_necro_getY,
+        [necro_setRGlobal] = &&label_necro_setRGlobal,
+        [necro_setThetaGlobal] = &&label_necro_setThetaGlobal,
+        [necro_setXGlobal] = &&label_necro_setXGlobal,
+        [necro_setYGlobal] = &&label_necro_setYGlobal,
+        [necro_setRLocal] = &&label_necro_setRLocal,
+        [necro_setThetaLocal] = &&label_necro_setThetaLocal,
+        [necro_setXLocal] = &&label_necro_setXLocal,
+        [necro_setYLocal] = &&label_necro_setYLocal,
+        [necro_print] = &&label_necro_print,
+        [necro_jump] = &&label_necro_jump,
+        [necro_jumpIfFalse] = &&label_necro_jumpIfFalse,
+        [necro_loop] = &&label_necro_loop,
+        [necro_call] = &&label_necro_call,
+        [necro_callNative] = &&label_necro_callNative,
+        [necro_callNativeFast]
+            = &&label_necro_callNativeFast,
+        [necro_return] = &&label_necro_return,
+        [necro_yield] = &&label_necro_yield,
+        [necro_sleep] = &&label_necro_sleep,
+        [necro_end] = &&label_necro_end,
+        [necro_addLocalLiteral]
+            = &&label_necro_addLocalLiteral,
+        [necro_lessLocalLiteralJump]
+            = &&label_necro_lessLocalLiteralJump,
+        [necro_greaterLocalLiteralJump]
+            = &&label_necro_greaterLocalLiteralJump,
+        [necro_callPop] = &&label_necro_callPop,
+        [necro_pointDistance]
+            = &&label_necro_pointDistance,
+        [necro_pointAngle] = &&label_necro_pointAngle,
+        [necro_callNativePop]
+            = &&label_necro_callNativePop,
+        [necro_callNativeFastPop]
+            = &&label_necro_callNativeFastPop,
+    };
+    #endif
 
-                NecroCallFrame *frameToAccess
-                    = framePtr;
-                for(int i = 0; i < jumps; ++i){
-                    frameToAccess
-                        = frameToAccess->accessPtr;
-                }
-                /*
-                 * write the value of the stack top
-                 * to the slot (but don't pop it off
-                 * since assignment is an expression);
-                 * set the local relative to the call
-                 * frame
-                 */
-                frameToAccess->slots[slot]
-                    = necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    );
-                break;
-            }
-            case necro_true: {
-                necroVirtualMachineStackPush(
-                    vmPtr,
-                    necroBoolValue(true)
-                );
-                break;
-            }
-            case necro_false: {
-                necroVirtualMachineStackPush(
-                    vmPtr,
-                    necroBoolValue(false)
-                );
-                break;
-            }
-            case necro_add: {
-                /*
-                 * if both operands are strings,
-                 * concatenate them
-                 */
-                if(necroIsString(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            0
-                        )
-                    ) && necroIsString(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            1
-                        )
-                    )
-                ){
-                    necroVirtualMachineConcatenate(vmPtr);
-                }
-                /*
-                 * otherwise if both operands are
-                 * vectors, add them
-                 */
-                else if(
-                    necroIsVector(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            0
-                        )
-                    ) && necroIsVector(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            1
-                        )
-                    )
-                ){
-                    Polar b = necroAsVector(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                    Polar a = necroAsVector(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                    Polar sum = polarAdd(a, b);
-                    necroVirtualMachineStackPush(
-                        vmPtr,
-                        necroVectorValue(sum)
-                    );
-                }
-                /* otherwise, check point + vector */
-                else if(
-                    necroIsVector(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            0
-                        )
-                    ) && necroIsPoint(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            1
-                        )
-                    )
-                ){
-                    Polar b = necroAsVector(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                    Point2D a = necroAsPoint(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                    Point2D sum
-                        = point2DAddPolar(a, b);
-                    necroVirtualMachineStackPush(
-                        vmPtr,
-                        necroPointValue(sum)
-                    );
-                }
-                /*
-                 * otherwise, they could be two numbers
-                 */
-                else {
-                    binaryNumberOperation(
-                        vmPtr,
-                        +,
-                        false,
-                        "Invalid operands for '+'"
-                    );
-                }
-                break;
-            }
-            case necro_subtract: {
-                /*
-                 * if both operands are vectors,
-                 * subtract them
-                 */
-                if(
-                    necroIsVector(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            0
-                        )
-                    ) && necroIsVector(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            1
-                        )
-                    )
-                ){
-                    Polar b = necroAsVector(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                    Polar a = necroAsVector(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                    Polar diff = polarSubtract(a, b);
-                    necroVirtualMachineStackPush(
-                        vmPtr,
-                        necroVectorValue(diff)
-                    );
-                }
-                /* otherwise, check point - vector */
-                else if(
-                    necroIsVector(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            0
-                        )
-                    ) && necroIsPoint(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            1
-                        )
-                    )
-                ){
-                    Polar b = necroAsVector(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                    Point2D a = necroAsPoint(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                    Point2D diff
-                        = point2DSubtractPolar(a, b);
-                    necroVirtualMachineStackPush(
-                        vmPtr,
-                        necroPointValue(diff)
-                    );
-                }
-                else{
-                    binaryNumberOperation(
-                        vmPtr,
-                        -,
-                        false,
-                        "Invalid operands for '-'"
-                    );
-                }
-                break;
-            }
-            case necro_multiply: {
-                /*
-                 * check for scalar multiplication of
-                 * vector
-                 */
-                if(
-                    necroIsVector(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            1
-                        )
-                    ) && (necroIsInt(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            0
-                        )
-                    ) || necroIsFloat(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            0
-                        )
-                    ))
-                ){
-                    NecroValue aValue
-                        = necroVirtualMachineStackPop(
-                            vmPtr
-                        );
-                    Polar polar = necroAsVector(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                    float scalar = 
-                        aValue.type == necro_int
-                            ? necroAsInt(aValue)
-                            : necroAsFloat(aValue);
-                    Polar multiple = polarMultiply(
-                        polar,
-                        scalar
-                    );
-                    necroVirtualMachineStackPush(
-                        vmPtr,
-                        necroVectorValue(multiple)
-                    );
-                }
-                else{
-                    binaryNumberOperation(
-                        vmPtr,
-                        *,
-                        false,
-                        "Invalid operands for '*' "
-                        "(in case of vector multiply, "
-                        "it must be vector * scalar)"
-                    );
-                }
-                break;
-            }
-            case necro_divide: {
-                /*
-                 * check for scalar division of
-                 * vector
-                 */
-                if(
-                    necroIsVector(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            1
-                        )
-                    ) && (necroIsInt(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            0
-                        )
-                    ) || necroIsFloat(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            0
-                        )
-                    ))
-                ){
-                    NecroValue aValue
-                        = necroVirtualMachineStackPop(
-                            vmPtr
-                        );
-                    Polar polar = necroAsVector(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                    float scalar = 
-                        aValue.type == necro_int
-                            ? necroAsInt(aValue)
-                            : necroAsFloat(aValue);
-                    Polar quotient = polarDivide(
-                        polar,
-                        scalar
-                    );
-                    necroVirtualMachineStackPush(
-                        vmPtr,
-                        necroVectorValue(quotient)
-                    );
-                }
-                else{
-                    binaryNumberOperation(
-                        vmPtr,
-                        /,
-                        false,
-                        "Invalid operands for '/' "
-                        "(in case of vector divide, "
-                        "it must be vector / scalar)"
-                    );
-                }
-                break;
-            }
-            case necro_modulo: {
-                if(!necroIsInt(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            0
-                        )
-                    ) || !necroIsInt(
-                        necroVirtualMachineStackPeek(
-                            vmPtr,
-                            1
-                        )
-                    )
-                ){
-                    necroVirtualMachineRuntimeError(
-                        vmPtr,
-                        "Operands of '%' should be "
-                        "integers only"
-                    );
-                    return necro_runtimeError;
-                }
-                int b = necroAsInt(
-                    necroVirtualMachineStackPop(vmPtr)
-                );
-                int a = necroAsInt(
-                    necroVirtualMachineStackPop(vmPtr)
-                );
-                necroVirtualMachineStackPush(
-                    vmPtr,
-                    necroIntValue(a % b)
-                );
-                break;
-            }
-            case necro_negate: {
-                if(necroIsInt(
-                    necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    )
-                )){
-                    necroVirtualMachineStackPush(
-                        vmPtr,
-                        necroIntValue(-necroAsInt(
-                            necroVirtualMachineStackPop(
-                                vmPtr
-                            )
-                        ))
-                    );
-                }
-                else if(necroIsFloat(
-                    necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    )
-                )){
-                    necroVirtualMachineStackPush(
-                        vmPtr,
-                        necroFloatValue(-necroAsFloat(
-                            necroVirtualMachineStackPop(
-                                vmPtr
-                            )
-                        ))
-                    );
-                }
-                else if(necroIsVector(
-                    necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    )
-                )){
-                    Polar vector = necroAsVector(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                    necroVirtualMachineStackPush(
-                        vmPtr,
-                        necroVectorValue(
-                            polarNegate(vector)
-                        )
-                    );
-                }
-                else{
-                    necroVirtualMachineRuntimeError(
-                        vmPtr,
-                        "Operand of unary '-' should "
-                        "be number or vector"
-                    );
-                    return necro_runtimeError;
-                }
-                break;
-            }
-            case necro_equal: {
-                NecroValue b = necroVirtualMachineStackPop(
-                    vmPtr
-                );
-                NecroValue a = necroVirtualMachineStackPop(
-                    vmPtr
-                );
+    vmRunAot(framePtr);
+    while(true){
+        /* debug printing */
+        #ifdef VM_VERBOSE
+        printf("Stack:");
+        for(NecroValue *slotPtr = vmPtr->stack;
+            slotPtr < vmPtr->stackPtr;
+            ++slotPtr
+        ){
+            printf("[");
+            necroValuePrint(*slotPtr);
+            printf("]");
+        }
+        printf("\n");
+        necroProgramDisassembleInstruction(
+            &(framePtr->funcPtr->program),
+            (size_t)(framePtr->instructionPtr
+                - (uint8_t*)framePtr->funcPtr->program
+                    .code._ptr)
+        );
+        #endif
+
+        /* read next instruction opcode */
+        profileInstruction(framePtr);
+        instruction = readByte(framePtr);
+        switch(instruction){
+            vmCase(necro_literal): {
+                NecroValue literal
+                    = readLiteral(framePtr);
                 necroVirtualMachineStackPush(
                     vmPtr,
-                    necroBoolValue(
-                        necroValueEquals(a, b)
-                    )
+                    literal
                 );
-                break;
+                vmDispatch(framePtr);
             }
-            case necro_greater: {
-                binaryNumberOperation(
-                    vmPtr,
-                    >,
-                    true,
-                    "Operands of comparison should be "
-                    "numbers"
-                );
-                break;
+            vmCase(necro_pop): {
+                necroVirtualMachineStackPop(vmPtr);
+                vmDispatch(framePtr);
             }
-            case necro_less: {
-                binaryNumberOperation(
+            vmCase(necro_defineGlobal): {
+                vmTry(necroVirtualMachineDefineGlobal(
                     vmPtr,
-                    <,
-                    true,
-                    "Operands of comparison should be "
-                    "numbers"
-                );
-                break;
+                    framePtr
+                ));
+                vmDispatch(framePtr);
             }
-            case necro_not: {
-                if(!necroIsBool(
-                    necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    )
-                )){
-                    necroVirtualMachineRuntimeError(
-                        vmPtr,
-                        "Operand of unary '!' should "
-                        "be bool"
-                    );
-                    return necro_runtimeError;
-                }
-                necroVirtualMachineStackPush(
+            vmCase(necro_getGlobal): {
+                vmTry(necroVirtualMachineGetGlobal(
                     vmPtr,
-                    necroBoolValue(!necroAsBool(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    ))
-                );
-                break;
+                    framePtr
+                ));
+                vmDispatch(framePtr);
             }
-            case necro_makeVector: {
-                float r = 0;
-                float theta = 0;
-
-                /* top of the stack should be theta */
-                if(necroIsInt(
-                    necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    )
-                )){
-                    theta = necroAsInt(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                }
-                else if(necroIsFloat(
-                    necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    )
-                )){
-                    theta = necroAsFloat(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                }
-                else{
-                    necroVirtualMachineRuntimeError(
-                        vmPtr,
-                        "Theta operand of '<>' should "
-                        "be a number"
-                    );
-                    return necro_runtimeError;
+            vmCase(necro_setGlobal): {
+                vmTry(necroVirtualMachineSetGlobal(
+                    vmPtr,
+                    framePtr
+                ));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_getLocal): {
+                /* get the stack slot of the local */
+                uint8_t slot = readByte(framePtr);
+                /* get number of access jumps */
+                uint8_t jumps = readByte(framePtr);
+
+                NecroCallFrame *frameToAccess
+                    = framePtr;
+                for(int i = 0; i < jumps; ++i){
+                    frameToAccess
+                        = frameToAccess->accessPtr;
                 }
                 /*
-                 * after getting theta, top of stack
-                 * should be R
+                 * push the value of the local to the
+                 * top of the stack; get the local
+                 * relative to the call frame
                  */
-                if(necroIsInt(
-                    necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    )
-                )){
-                    r = necroAsInt(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                }
-                else if(necroIsFloat(
-                    necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    )
-                )){
-                    r = necroAsFloat(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                }
-                else{
-                    necroVirtualMachineRuntimeError(
-                        vmPtr,
-                        "R operand of '<>' should "
-                        "be a number"
-                    );
-                    return necro_runtimeError;
-                }
-                Polar vector = {r, theta};
                 necroVirtualMachineStackPush(
                     vmPtr,
-                    necroVectorValue(vector)
+                    frameToAccess->slots[slot]
                 );
-                break;
+                vmDispatch(framePtr);
             }
-            case necro_makePoint: {
-                float x = 0;
-                float y = 0;
+            vmCase(necro_setLocal): {
+                /* get the stack slot of the local */
+                uint8_t slot = readByte(framePtr);
+                /* get number of access jumps */
+                uint8_t jumps = readByte(framePtr);
 
-                /* top of the stack should be y */
-                if(necroIsInt(
-                    necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    )
-                )){
-                    y = necroAsInt(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                }
-                else if(necroIsFloat(
-                    necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    )
-                )){
-                    y = necroAsFloat(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                }
-                else{
-                    necroVirtualMachineRuntimeError(
-                        vmPtr,
-                        "Y operand of '[]' should "
-                        "be a number"
-                    );
-                    return necro_runtimeError;
+                NecroCallFrame *frameToAccess
+                    = framePtr;
+                for(int i = 0; i < jumps; ++i){
+                    frameToAccess
+                        = frameToAccess->accessPtr;
                 }
                 /*
-                 * after getting y, top of stack
-                 * should be x
+                 * write the value of the stack top
+                 * to the slot (but don't pop it off
+                 * since assignment is an expression);
+                 * set the local relative to the call
+                 * frame
                  */
-                if(necroIsInt(
-                    necroVirtualMachineStackPeek(
-                        vmPtr,
-                        0
-                    )
-                )){
-                    x = necroAsInt(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
-                    );
-                }
-                else if(necroIsFloat(
-                    necroVirtualMachineStackPeek(
+                frameToAccess->slots[slot]
+                    = necroVirtualMachineStackPeek(
                         vmPtr,
                         0
-                    )
-                )){
-                    x = necroAsFloat(
-                        necroVirtualMachineStackPop(
-                            vmPtr
-                        )
                     );
-                }
-                else{
-                    necroVirtualMachineRuntimeError(
-                        vmPtr,
-                        "X operand of '[]' should "
-                        "be a number"
-                    );
-                    return necro_runtimeError;
-                }
-                Point2D point = {x, y};
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_true): {
                 necroVirtualMachineStackPush(
                     vmPtr,
-                    necroPointValue(point)
+                    necroBoolValue(true)
                 );
-                break;
+                vmDispatch(framePtr);
             }
-            case necro_getR: {
-                memberGetOperation(
+            vmCase(necro_false): {
+                necroVirtualMachineStackPush(
                     vmPtr,
-                    Polar,
-                    necroIsVector,
-                    necroAsVector,
-                    magnitude,
-                    "Expect operand of \".r\" to be "
-                    "a vector"
+                    necroBoolValue(false)
                 );
-                break;
+                vmDispatch(framePtr);
             }
-            case necro_getTheta: {
-                memberGetOperation(
-                    vmPtr,
-                    Polar,
-                    necroIsVector,
-                    necroAsVector,
-                    angle,
-                    "Expect operand of \".t\" to be "
-                    "a vector"
-                );
-                break;
+            vmCase(necro_add): {
+                vmTry(necroVirtualMachineAdd(vmPtr));
+                vmDispatch(framePtr);
             }
-            case necro_getX: {
-                memberGetOperation(
-                    vmPtr,
-                    Point2D,
-                    necroIsPoint,
-                    necroAsPoint,
-                    x,
-                    "Expect operand of \".x\" to be "
-                    "a point"
-                );
-                break;
+            vmCase(necro_subtract): {
+                vmTry(necroVirtualMachineSubtract(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_multiply): {
+                vmTry(necroVirtualMachineMultiply(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_divide): {
+                vmTry(necroVirtualMachineDivide(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_modulo): {
+                vmTry(necroVirtualMachineModulo(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_negate): {
+                vmTry(necroVirtualMachineNegate(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_addVectors): {
+                necroVirtualMachineAddVectors(vmPtr);
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_subtractVectors): {
+                necroVirtualMachineSubtractVectors(vmPtr);
+                vmDispatch(framePtr);
             }
-            case necro_getY: {
-                memberGetOperation(
+            vmCase(necro_addPointVector): {
+                necroVirtualMachineAddPointVector(vmPtr);
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_subtractPointVector): {
+                necroVirtualMachineSubtractPointVector(vmPtr);
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_subtractPoints): {
+                necroVirtualMachineSubtractPoints(vmPtr);
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_multiplyVector): {
+                necroVirtualMachineMultiplyVector(vmPtr);
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_divideVector): {
+                necroVirtualMachineDivideVector(vmPtr);
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_equal): {
+                NecroValue b = necroVirtualMachineStackPop(
+                    vmPtr
+                );
+                NecroValue a = necroVirtualMachineStackPop(
+                    vmPtr
+                );
+                necroVirtualMachineStackPush(
                     vmPtr,
-                    Point2D,
-                    necroIsPoint,
-                    necroAsPoint,
-                    y,
-                    "Expect operand of \".y\" to be "
-                    "a point"
+                    necroBoolValue(
+                        necroValueEquals(a, b)
+                    )
                 );
-                break;
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_greater): {
+                vmTry(necroVirtualMachineGreater(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_less): {
+                vmTry(necroVirtualMachineLess(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_not): {
+                vmTry(necroVirtualMachineNot(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_makeVector): {
+                vmTry(necroVirtualMachineMakeVector(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_makePoint): {
+                vmTry(necroVirtualMachineMakePoint(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_getR): {
+                vmTry(necroVirtualMachineGetR(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_getTheta): {
+                vmTry(necroVirtualMachineGetTheta(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_getX): {
+                vmTry(necroVirtualMachineGetX(vmPtr));
+                vmDispatch(framePtr);
             }
-            case necro_setRGlobal: {
-                globalMemberSetOperation(
+            vmCase(necro_getY): {
+                vmTry(necroVirtualMachineGetY(vmPtr));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_setRGlobal): {
+                vmTry(necroVirtualMachineSetRGlobal(
                     vmPtr,
-                    framePtr,
-                    necroIsVector,
-                    vector,
-                    magnitude,
-                    "Error for setRGlobal"
-                );
-                break;
+                    framePtr
+                ));
+                vmDispatch(framePtr);
             }
-            case necro_setThetaGlobal: {
-                globalMemberSetOperation(
+            vmCase(necro_setThetaGlobal): {
+                vmTry(necroVirtualMachineSetThetaGlobal(
                     vmPtr,
-                    framePtr,
-                    necroIsVector,
-                    vector,
-                    angle,
-                    "Error for setThetaGlobal"
-                );
-                break;
+                    framePtr
+                ));
+                vmDispatch(framePtr);
             }
-            case necro_setXGlobal: {
-                globalMemberSetOperation(
+            vmCase(necro_setXGlobal): {
+                vmTry(necroVirtualMachineSetXGlobal(
                     vmPtr,
-                    framePtr,
-                    necroIsPoint,
-                    point,
-                    x,
-                    "Error for setXGlobal"
-                );
-                break;
+                    framePtr
+                ));
+                vmDispatch(framePtr);
             }
-            case necro_setYGlobal: {
-                globalMemberSetOperation(
+            vmCase(necro_setYGlobal): {
+                vmTry(necroVirtualMachineSetYGlobal(
                     vmPtr,
-                    framePtr,
-                    necroIsPoint,
-                    point,
-                    y,
-                    "Error for setYGlobal"
-                );
-                break;
+                    framePtr
+                ));
+                vmDispatch(framePtr);
             }
-            case necro_setRLocal: {
-                localMemberSetOperation(
+            vmCase(necro_setRLocal): {
+                vmTry(necroVirtualMachineSetRLocal(
                     vmPtr,
-                    framePtr,
-                    necroIsVector,
-                    vector,
-                    magnitude,
-                    "Error for setRLocal"
-                );
-                break;
+                    framePtr
+                ));
+                vmDispatch(framePtr);
             }
-            case necro_setThetaLocal: {
-                localMemberSetOperation(
+            vmCase(necro_setThetaLocal): {
+                vmTry(necroVirtualMachineSetThetaLocal(
                     vmPtr,
-                    framePtr,
-                    necroIsVector,
-                    vector,
-                    angle,
-                    "Error for setThetaLocal"
-                );
-                break;
+                    framePtr
+                ));
+                vmDispatch(framePtr);
             }
-            case necro_setXLocal: {
-                localMemberSetOperation(
+            vmCase(necro_setXLocal): {
+                vmTry(necroVirtualMachineSetXLocal(
                     vmPtr,
-                    framePtr,
-                    necroIsPoint,
-                    point,
-                    x,
-                    "Error for setXLocal"
-                );
-                break;
+                    framePtr
+                ));
+                vmDispatch(framePtr);
             }
-            case necro_setYLocal: {
-                localMemberSetOperation(
+            vmCase(necro_setYLocal): {
+                vmTry(necroVirtualMachineSetYLocal(
                     vmPtr,
-                    framePtr,
-                    necroIsPoint,
-                    point,
-                    y,
-                    "Error for setYLocal"
-                );
-                break;
+                    framePtr
+                ));
+                vmDispatch(framePtr);
             }
-            case necro_print: {
+            vmCase(necro_print): {
                 necroValuePrint(
                     necroVirtualMachineStackPop(vmPtr)
                 );
                 printf("\n");
-                break;
+                vmDispatch(framePtr);
             }
-            case necro_jump: {
+            vmCase(necro_jump): {
                 uint16_t offset = readShort(framePtr);
                 framePtr->instructionPtr += offset;
-                break;
+                vmDispatch(framePtr);
             }
-            case necro_jumpIfFalse: {
+            vmCase(necro_jumpIfFalse): {
                 uint16_t offset = readShort(framePtr);
                 /* peek; compiler pops if needed */
                 NecroValue condition
@@ -1661,19 +2968,19 @@ static NecroInterpretResult necroVirtualMachineRun(
                         0
                     );
                 /* jump if false */
-                if(condition.type == necro_bool
+                if(necroIsBool(condition)
                     && !necroAsBool(condition)
                 ){
                     framePtr->instructionPtr += offset;
                 }
-                break;
+                vmDispatch(framePtr);
             }
-            case necro_loop: {
+            vmCase(necro_loop): {
                 uint16_t offset = readShort(framePtr);
                 framePtr->instructionPtr -= offset;
-                break;
+                vmDispatch(framePtr);
             }
-            case necro_call: {
+            vmCase(necro_call): {
                 int numArgs = readByte(framePtr);
                 if(!necroVirtualMachineCallValue(
                     vmPtr,
@@ -1692,43 +2999,393 @@ static NecroInterpretResult necroVirtualMachineRun(
                 framePtr = &(vmPtr->callStack[
                     vmPtr->frameCount - 1
                 ]);
-                break;
+                vmRunAot(framePtr);
+                vmDispatch(framePtr);
             }
-            case necro_return: {
-                NecroValue result
-                    = necroVirtualMachineStackPop(
-                        vmPtr
-                    );
-                --(vmPtr->frameCount);
-                if(vmPtr->frameCount == 0){
-                    necroVirtualMachineStackPop(vmPtr);
-                    return necro_success;
+            vmCase(necro_callNative): {
+                vmTry(necroVirtualMachineCallNative(
+                    vmPtr,
+                    framePtr,
+                    true,
+                    true
+                ));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_callNativeFast): {
+                vmTry(necroVirtualMachineCallNative(
+                    vmPtr,
+                    framePtr,
+                    false,
+                    true
+                ));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_addLocalLiteral): {
+                vmTry(necroVirtualMachineAddLocalLiteral(
+                    vmPtr,
+                    framePtr
+                ));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_lessLocalLiteralJump): {
+                vmTry(necroVirtualMachineLessLocalLiteralJump(
+                    vmPtr,
+                    framePtr
+                ));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_greaterLocalLiteralJump): {
+                vmTry(necroVirtualMachineGreaterLocalLiteralJump(
+                    vmPtr,
+                    framePtr
+                ));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_callPop): {
+                int numArgs = readByte(framePtr);
+                int frameCount = vmPtr->frameCount;
+                if(!necroVirtualMachineCallValue(
+                    vmPtr,
+                    necroVirtualMachineStackPeek(
+                        vmPtr,
+                        numArgs
+                    ),
+                    numArgs
+                )){
+                    return necro_runtimeError;
                 }
-
-                vmPtr->stackPtr = framePtr->slots;
                 /*
-                 * push the return value back onto the
-                 * stack; even "null" returns actually
-                 * return the value FALSE
+                 * native funcs return right away, so
+                 * pop and skip the pop byte; a script
+                 * func runs that pop when it returns
                  */
-                necroVirtualMachineStackPush(
+                if(vmPtr->frameCount == frameCount){
+                    necroVirtualMachineStackPop(vmPtr);
+                    ++(framePtr->instructionPtr);
+                }
+                else{
+                    framePtr = &(vmPtr->callStack[
+                        vmPtr->frameCount - 1
+                    ]);
+                    vmRunAot(framePtr);
+                }
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_pointDistance): {
+                necroVirtualMachinePointDistance(vmPtr);
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_pointAngle): {
+                necroVirtualMachinePointAngle(vmPtr);
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_callNativePop): {
+                vmTry(necroVirtualMachineCallNative(
                     vmPtr,
-                    result
-                );
+                    framePtr,
+                    true,
+                    false
+                ));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_callNativeFastPop): {
+                vmTry(necroVirtualMachineCallNative(
+                    vmPtr,
+                    framePtr,
+                    false,
+                    false
+                ));
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_return): {
+                if(necroVirtualMachineReturn(
+                    vmPtr,
+                    framePtr
+                )){
+                    return necro_success;
+                }
                 framePtr = &(vmPtr->callStack[
                     vmPtr->frameCount - 1
                 ]);
-                break;
+                vmRunAot(framePtr);
+                vmDispatch(framePtr);
             }
-            case necro_yield:
+            vmCase(necro_yield):
                 return necro_yielded;
-            case necro_end: 
+            vmCase(necro_sleep): {
+                NecroInterpretResult sleepResult
+                    = necroVirtualMachineSleep(vmPtr);
+                if(sleepResult != necro_success){
+                    return sleepResult;
+                }
+                vmDispatch(framePtr);
+            }
+            vmCase(necro_end): 
                 return necro_success;
         }
     }
     return necro_success;
 }
 
+/*
+ * Runs the single instruction at the instruction
+ * pointer of the specified call frame, which must be
+ * the top one of the given virtual machine, exactly
+ * as the run loop would; for ahead of time translated
+ * code, which leaves the instructions it does not
+ * handle itself to this. Literal, pop, true, false,
+ * getLocal, setLocal, equal, the jumps, yield, and end
+ * cannot be stepped
+ */
+NecroStepResult necroVirtualMachineStep(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+){
+    NecroInterpretResult result = necro_success;
+    uint8_t instruction = readByte(framePtr);
+    switch(instruction){
+        case necro_defineGlobal:
+            result = necroVirtualMachineDefineGlobal(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_getGlobal:
+            result = necroVirtualMachineGetGlobal(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_setGlobal:
+            result = necroVirtualMachineSetGlobal(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_add:
+            result = necroVirtualMachineAdd(vmPtr);
+            break;
+        case necro_subtract:
+            result = necroVirtualMachineSubtract(vmPtr);
+            break;
+        case necro_multiply:
+            result = necroVirtualMachineMultiply(vmPtr);
+            break;
+        case necro_divide:
+            result = necroVirtualMachineDivide(vmPtr);
+            break;
+        case necro_modulo:
+            result = necroVirtualMachineModulo(vmPtr);
+            break;
+        case necro_negate:
+            result = necroVirtualMachineNegate(vmPtr);
+            break;
+        case necro_addVectors:
+            necroVirtualMachineAddVectors(vmPtr);
+            break;
+        case necro_subtractVectors:
+            necroVirtualMachineSubtractVectors(vmPtr);
+            break;
+        case necro_addPointVector:
+            necroVirtualMachineAddPointVector(vmPtr);
+            break;
+        case necro_subtractPointVector:
+            necroVirtualMachineSubtractPointVector(vmPtr);
+            break;
+        case necro_subtractPoints:
+            necroVirtualMachineSubtractPoints(vmPtr);
+            break;
+        case necro_multiplyVector:
+            necroVirtualMachineMultiplyVector(vmPtr);
+            break;
+        case necro_divideVector:
+            necroVirtualMachineDivideVector(vmPtr);
+            break;
+        case necro_greater:
+            result = necroVirtualMachineGreater(vmPtr);
+            break;
+        case necro_less:
+            result = necroVirtualMachineLess(vmPtr);
+            break;
+        case necro_not:
+            result = necroVirtualMachineNot(vmPtr);
+            break;
+        case necro_makeVector:
+            result = necroVirtualMachineMakeVector(vmPtr);
+            break;
+        case necro_makePoint:
+            result = necroVirtualMachineMakePoint(vmPtr);
+            break;
+        case necro_getR:
+            result = necroVirtualMachineGetR(vmPtr);
+            break;
+        case necro_getTheta:
+            result = necroVirtualMachineGetTheta(vmPtr);
+            break;
+        case necro_getX:
+            result = necroVirtualMachineGetX(vmPtr);
+            break;
+        case necro_getY:
+            result = necroVirtualMachineGetY(vmPtr);
+            break;
+        case necro_setRGlobal:
+            result = necroVirtualMachineSetRGlobal(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_setThetaGlobal:
+            result = necroVirtualMachineSetThetaGlobal(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_setXGlobal:
+            result = necroVirtualMachineSetXGlobal(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_setYGlobal:
+            result = necroVirtualMachineSetYGlobal(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_setRLocal:
+            result = necroVirtualMachineSetRLocal(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_setThetaLocal:
+            result = necroVirtualMachineSetThetaLocal(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_setXLocal:
+            result = necroVirtualMachineSetXLocal(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_setYLocal:
+            result = necroVirtualMachineSetYLocal(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_print:
+            necroValuePrint(
+                necroVirtualMachineStackPop(vmPtr)
+            );
+            printf("\n");
+            break;
+        case necro_addLocalLiteral:
+            result = necroVirtualMachineAddLocalLiteral(
+                vmPtr,
+                framePtr
+            );
+            break;
+        case necro_lessLocalLiteralJump:
+            result
+                = necroVirtualMachineLessLocalLiteralJump(
+                    vmPtr,
+                    framePtr
+                );
+            break;
+        case necro_greaterLocalLiteralJump:
+            result
+                = necroVirtualMachineGreaterLocalLiteralJump(
+                    vmPtr,
+                    framePtr
+                );
+            break;
+        case necro_callNative:
+            result = necroVirtualMachineCallNative(
+                vmPtr,
+                framePtr,
+                true,
+                true
+            );
+            break;
+        case necro_callNativeFast:
+            result = necroVirtualMachineCallNative(
+                vmPtr,
+                framePtr,
+                false,
+                true
+            );
+            break;
+        case necro_callNativePop:
+            result = necroVirtualMachineCallNative(
+                vmPtr,
+                framePtr,
+                true,
+                false
+            );
+            break;
+        case necro_callNativeFastPop:
+            result = necroVirtualMachineCallNative(
+                vmPtr,
+                framePtr,
+                false,
+                false
+            );
+            break;
+        case necro_call:
+        case necro_callPop: {
+            int numArgs = readByte(framePtr);
+            int frameCount = vmPtr->frameCount;
+            if(!necroVirtualMachineCallValue(
+                vmPtr,
+                necroVirtualMachineStackPeek(
+                    vmPtr,
+                    numArgs
+                ),
+                numArgs
+            )){
+                return necro_stepRuntimeError;
+            }
+            if(vmPtr->frameCount != frameCount){
+                return necro_stepFrameChanged;
+            }
+            /* a native func has already returned */
+            if(instruction == necro_callPop){
+                necroVirtualMachineStackPop(vmPtr);
+                ++(framePtr->instructionPtr);
+            }
+            break;
+        }
+        case necro_pointDistance:
+            necroVirtualMachinePointDistance(vmPtr);
+            break;
+        case necro_pointAngle:
+            necroVirtualMachinePointAngle(vmPtr);
+            break;
+        case necro_return:
+            return necroVirtualMachineReturn(vmPtr, framePtr)
+                ? necro_stepSuccess
+                : necro_stepFrameChanged;
+        case necro_sleep:
+            result = necroVirtualMachineSleep(vmPtr);
+            if(result == necro_yielded){
+                return necro_stepYielded;
+            }
+            break;
+        default:
+            pgError(
+                "instruction cannot be stepped; "
+                SRC_LOCATION
+            );
+            return necro_stepRuntimeError;
+    }
+    return result == necro_success
+        ? necro_stepContinue
+        : necro_stepRuntimeError;
+}
+
 /*
  * Loads all native functions defined in native func
  * set pointed to by the specified virtual machine
@@ -1776,7 +3433,12 @@ NecroInterpretResult necroVirtualMachineInterpret(
         vmPtr,
         funcObjectProgramPtr
     );
-    return necroVirtualMachineRun(vmPtr);
+    NecroInterpretResult result
+        = necroVirtualMachineRun(vmPtr);
+    #ifdef NECRO_PROFILE
+    necroProfilerEndRun();
+    #endif
+    return result;
 }
 
 /*
@@ -1799,13 +3461,27 @@ void necroVirtualMachineLoad(
         SRC_LOCATION
     );
     necroVirtualMachineReset(vmPtr);
+    /*
+     * allocate the globals map on first load; only
+     * free when VM is freed, cleared upon reset
+     */
+    if(!(vmPtr->globalsMapAllocated)){
+        vmPtr->globalsMap = hashMapMake(
+            NecroObjectString*,
+            NecroValue,
+            globalsMapInitCapacity,
+            _necroObjectStringPtrHash,
+            _necroObjectStringPtrEquals
+        );
+        vmPtr->globalsMapAllocated = true;
+    }
 
     /*
      * copy compile-time strings from the program
      * literals into the runtime string interning
      * hashmap; the strings are owned either by the
      * literals, in the case of compile-time strings,
-     * or by the object list, in the case of runtime
+     * or by the heap, in the case of runtime
      * strings, and should not be freed from the map
      * itself.
      */
@@ -1838,30 +3514,33 @@ void necroVirtualMachineLoad(
 /*
  * Has the specified virtual machine continue running
  * its program; should only be used if the virtual
- * machine has previously yielded
+ * machine has previously yielded. A sleeping virtual
+ * machine uses up one of its sleep ticks and yields
+ * again instead
  */
 NecroInterpretResult necroVirtualMachineResume(
     NecroVirtualMachine *vmPtr
 ){
-    return necroVirtualMachineRun(vmPtr);
+    if(vmPtr->sleepTicks > 0){
+        --(vmPtr->sleepTicks);
+        return necro_yielded;
+    }
+    /* bounded, so a resume never stalls on the GC */
+    necroVirtualMachineCollectStep(vmPtr);
+    NecroInterpretResult result
+        = necroVirtualMachineRun(vmPtr);
+    #ifdef NECRO_PROFILE
+    necroProfilerEndRun();
+    #endif
+    return result;
 }
 
 /*
- * Frees all objects in the object list of the given
- * virtual machine
+ * Ends the sleep of the specified virtual machine so
+ * that the next resume runs its program
  */
-static void necroVirtualMachineFreeObjects(
-    NecroVirtualMachine *vmPtr
-){
-    NecroObject *currentPtr = vmPtr->objectListHeadPtr;
-    NecroObject *nextPtr = NULL;
-    while(currentPtr){
-        nextPtr = currentPtr->nextPtr;
-        necroObjectFree(currentPtr);
-        currentPtr = nextPtr;
-    }
-    
-    vmPtr->objectListHeadPtr = NULL;
+void necroVirtualMachineWake(NecroVirtualMachine *vmPtr){
+    vmPtr->sleepTicks = 0;
 }
 
 /*
@@ -1892,15 +3571,19 @@ void necroVirtualMachineReset(
 ){
     vmPtr->stackPtr = vmPtr->stack;
     vmPtr->frameCount = 0;
-    necroVirtualMachineFreeObjects(vmPtr);
+    vmPtr->sleepTicks = 0;
+    /* keeps the heap blocks for the next program */
+    necroHeapClear(&(vmPtr->heap));
     necroVirtualMachineFreeStringMap(vmPtr);
 
     /* clear all globals including native funcs */
-    hashMapClear(
-        NecroObjectString*,
-        NecroValue,
-        &(vmPtr->globalsMap)
-    );
+    if(vmPtr->globalsMapAllocated){
+        hashMapClear(
+            NecroObjectString*,
+            NecroValue,
+            &(vmPtr->globalsMap)
+        );
+    }
 }
 
 /*
@@ -1910,12 +3593,16 @@ void necroVirtualMachineReset(
 void necroVirtualMachineFree(
     NecroVirtualMachine *vmPtr
 ){
-    necroVirtualMachineFreeObjects(vmPtr);
+    necroHeapFree(&(vmPtr->heap));
     necroVirtualMachineFreeStringMap(vmPtr);
-    hashMapFree(
-        NecroObjectString*,
-        NecroValue,
-        &(vmPtr->globalsMap)
-    );
+    if(vmPtr->globalsMapAllocated){
+        hashMapFree(
+            NecroObjectString*,
+            NecroValue,
+            &(vmPtr->globalsMap)
+        );
+    }
+    pgFree(vmPtr->stack);
+    pgFree(vmPtr->callStack);
     memset(vmPtr, 0, sizeof(*vmPtr));
 }
\ No newline at end of file
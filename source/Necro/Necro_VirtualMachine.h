@@ -3,14 +3,34 @@
 
 #include "Necro_Program.h"
 #include "Necro_Object.h"
+#include "Necro_Heap.h"
 #include "Necro_NativeFuncSet.h"
 
-/* size of the stack */
+/* max size of the stack */
 #define NECRO_STACK_SIZE 256
 
-/* size of the call stack */
+/*
+ * size of the stack once a VM first runs; it doubles
+ * whenever full up to NECRO_STACK_SIZE
+ */
+#define NECRO_STACK_INIT_SIZE 32
+
+/* max size of the call stack */
 #define NECRO_CALLSTACK_SIZE 16
 
+/*
+ * size of the call stack once a VM first runs; it
+ * doubles whenever full up to NECRO_CALLSTACK_SIZE
+ */
+#define NECRO_CALLSTACK_INIT_SIZE 4
+
+/*
+ * most objects swept by one step of the incremental
+ * collector; a step runs on every resume and when a
+ * string is made while a collection is under way
+ */
+#define NECRO_GC_SWEEP_BUDGET 64
+
 /*
  * used to report back the result of interpreting a
  * program
@@ -21,6 +41,22 @@ typedef enum NecroInterpretResult{
     necro_runtimeError
 } NecroInterpretResult;
 
+/*
+ * used to report back the result of running part of
+ * a program outside of the run loop, as ahead of time
+ * translated code does; the first three end the run
+ * like the matching interpret results
+ */
+typedef enum NecroStepResult{
+    necro_stepSuccess = necro_success,
+    necro_stepYielded = necro_yielded,
+    necro_stepRuntimeError = necro_runtimeError,
+    /* a frame was pushed or popped */
+    necro_stepFrameChanged,
+    /* the same frame carries on */
+    necro_stepContinue
+} NecroStepResult;
+
 /* Stores information regarding a function call */
 typedef struct NecroCallFrame{
     NecroObjectFunc *funcPtr;
@@ -37,16 +73,26 @@ typedef struct NecroCallFrame{
  * the virtual machine which interprets necro programs
  */
 typedef struct NecroVirtualMachine{
-    /* stack used by VM to keep track of func calls */
-    NecroCallFrame callStack[NECRO_CALLSTACK_SIZE];
+    /*
+     * stack used by VM to keep track of func calls;
+     * allocated and grown on demand
+     */
+    NecroCallFrame *callStack;
+    /* number of frames the call stack can hold */
+    int callStackCapacity;
     /* stores height of call stack i.e. num calls */
     int frameCount;
-    /* stack used by VM to store all values */
-    NecroValue stack[NECRO_STACK_SIZE];
+    /*
+     * stack used by VM to store all values; allocated
+     * and grown on demand
+     */
+    NecroValue *stack;
     /* pointer to one past the top of the stack */
     NecroValue *stackPtr;
-    /* pointer to the head of the object list */
-    NecroObject *objectListHeadPtr;
+    /* pointer to one past the end of the stack */
+    NecroValue *stackEndPtr;
+    /* holds the objects made at run time */
+    NecroHeap heap;
     /*
      * hashmap of NecroObjectString* to NecroValue for
      * string interning
@@ -58,14 +104,29 @@ typedef struct NecroVirtualMachine{
      * global variables
      */
     HashMap globalsMap;
+    bool globalsMapAllocated;
     /* pointer to the set of native functions */
     NecroNativeFuncSet *nativeFuncSetPtr;
+    /*
+     * number of resumes left to skip before the VM
+     * runs again, set by a "wait for" statement; a
+     * scheduler may instead leave a sleeping VM alone
+     * and wake it once that many ticks pass
+     */
+    int sleepTicks;
+    /*
+     * id of the most recent sleep, unique among all
+     * virtual machines; lets a scheduler tell a stale
+     * wakeup from one for the current sleep
+     */
+    uint32_t sleepId;
 } NecroVirtualMachine;
 
 /*
  * Constructs and returns a new NecroVirtualMachine by
  * value; the native function set pointer is nullable,
- * as is the user function set pointer
+ * as is the user function set pointer. Nothing is
+ * allocated until a program is loaded
  */
 NecroVirtualMachine necroVirtualMachineMake(
     NecroNativeFuncSet *nativeFuncSetPtr
@@ -93,12 +154,44 @@ void necroVirtualMachineLoad(
 /*
  * Has the specified virtual machine continue running
  * its program; should only be used if the virtual
- * machine has previously yielded
+ * machine has previously yielded. A sleeping virtual
+ * machine uses up one of its sleep ticks and yields
+ * again instead
  */
 NecroInterpretResult necroVirtualMachineResume(
     NecroVirtualMachine *vmPtr
 );
 
+/*
+ * Ends the sleep of the specified virtual machine so
+ * that the next resume runs its program
+ */
+void necroVirtualMachineWake(NecroVirtualMachine *vmPtr);
+
+/*
+ * Pushes the specified value onto the stack of the
+ * specified virtual machine
+ */
+void necroVirtualMachineStackPush(
+    NecroVirtualMachine *vmPtr,
+    NecroValue value
+);
+
+/*
+ * Runs the single instruction at the instruction
+ * pointer of the specified call frame, which must be
+ * the top one of the given virtual machine, exactly
+ * as the run loop would; for ahead of time translated
+ * code, which leaves the instructions it does not
+ * handle itself to this. Literal, pop, true, false,
+ * getLocal, setLocal, equal, the jumps, yield, and end
+ * cannot be stepped
+ */
+NecroStepResult necroVirtualMachineStep(
+    NecroVirtualMachine *vmPtr,
+    NecroCallFrame *framePtr
+);
+
 /*
  * Resets the state of the given NecroVirtualMachine
  */
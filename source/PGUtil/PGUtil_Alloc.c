@@ -1,15 +1,18 @@
 #include "PGUtil_Alloc.h"
 
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "PGUtil_Error.h"
 
-/* 
- * Returns a pointer to a newly allocated block which 
- * holds the specified number of items, each of the 
+/*
+ * Returns a pointer to a newly allocated block which
+ * holds the specified number of items, each of the
  * given size
  */
-void *pgAlloc(size_t numItems, size_t size){
+static void *rawAlloc(size_t numItems, size_t size){
     assertTrue(numItems > 0, "numItems must be > 0");
     assertTrue(size > 0, "size must be > 0");
     void *toRet = calloc(numItems, size);
@@ -18,14 +21,14 @@ void *pgAlloc(size_t numItems, size_t size){
 }
 
 /*
- * Returns a pointer to a reallocated block which 
- * holds the specified number of items, each of the 
- * given size, having the same data as was previously 
+ * Returns a pointer to a reallocated block which
+ * holds the specified number of items, each of the
+ * given size, having the same data as was previously
  * held in the specified pointer
  */
-void *pgRealloc(
-    void *ptr, 
-    size_t numItems, 
+static void *rawRealloc(
+    void *ptr,
+    size_t numItems,
     size_t size
 ){
     assertTrue(numItems > 0, "numItems must be > 0");
@@ -34,4 +37,633 @@ void *pgRealloc(
     void *toRet = realloc(ptr, numItems * size);
     assertTrue(toRet, "realloc fail");
     return toRet;
-}
\ No newline at end of file
+}
+
+#ifndef PG_ALLOC_TRACKING
+
+/*
+ * Returns a pointer to a newly allocated block which
+ * holds the specified number of items, each of the
+ * given size
+ */
+void *pgAlloc(size_t numItems, size_t size){
+    return rawAlloc(numItems, size);
+}
+
+/*
+ * Returns a pointer to a reallocated block which
+ * holds the specified number of items, each of the
+ * given size, having the same data as was previously
+ * held in the specified pointer
+ */
+void *pgRealloc(
+    void *ptr,
+    size_t numItems,
+    size_t size
+){
+    return rawRealloc(ptr, numItems, size);
+}
+
+#else /* PG_ALLOC_TRACKING */
+
+#define tableInitCapacity 1024
+#define tagStackSize 16
+#define messageBufferSize 256
+/* forbidden call sites warned of; later ones count */
+#define warnedSiteCapacity 64
+
+/* A single live allocation in the side table */
+typedef struct AllocRecord{
+    /* NULL marks empty, tombstonePtr marks erased */
+    void *ptr;
+    size_t size;
+    /* SRC_LOCATION string of the call site */
+    const char *site;
+    const char *tag;
+} AllocRecord;
+
+/* Live allocations aggregated by call site and tag */
+typedef struct AllocSite{
+    const char *site;
+    const char *tag;
+    size_t count;
+    size_t bytes;
+} AllocSite;
+
+static char tombstoneMarker;
+#define tombstonePtr ((void*)&tombstoneMarker)
+
+/*
+ * open addressed table of AllocRecord keyed by ptr;
+ * allocated with raw calloc so it is never tracked
+ */
+static AllocRecord *table = NULL;
+static size_t tableCapacity = 0;
+static size_t tableCount = 0;
+static size_t tableTombstones = 0;
+
+static PGAllocStats frameStats = {0};
+static PGAllocStats lastFrameStats = {0};
+static bool atExitRegistered = false;
+
+/* forbidden call sites which were already warned of */
+static const char *warnedSites[warnedSiteCapacity];
+static size_t warnedSiteCount = 0;
+
+/* the tracker may be hit from multiple threads */
+static atomic_flag tableLock = ATOMIC_FLAG_INIT;
+
+static _Thread_local const char *tagStack[tagStackSize];
+static _Thread_local int tagDepth = 0;
+static _Thread_local const char *forbidScopeName = NULL;
+static _Thread_local int forbidDepth = 0;
+static _Thread_local int allowDepth = 0;
+
+/* Spins until the side table lock is acquired */
+static void lockTable(){
+    while(atomic_flag_test_and_set_explicit(
+        &tableLock,
+        memory_order_acquire
+    )){
+        /* spin */
+    }
+}
+
+/* Releases the side table lock */
+static void unlockTable(){
+    atomic_flag_clear_explicit(
+        &tableLock,
+        memory_order_release
+    );
+}
+
+/* Returns the hash of the given pointer */
+static size_t hashPtr(const void *ptr){
+    return (size_t)(((uintptr_t)ptr >> 4)
+        * (uintptr_t)2654435761u);
+}
+
+/* Returns the tag of the calling thread or NULL */
+static const char *currentTag(){
+    return tagDepth > 0 ? tagStack[tagDepth - 1] : NULL;
+}
+
+/*
+ * Returns a pointer to the record of the given
+ * pointer in the side table, or NULL if untracked
+ */
+static AllocRecord *findRecord(const void *ptr){
+    if(tableCapacity == 0){
+        return NULL;
+    }
+    size_t mask = tableCapacity - 1;
+    size_t index = hashPtr(ptr) & mask;
+    while(table[index].ptr){
+        if(table[index].ptr == ptr){
+            return &(table[index]);
+        }
+        index = (index + 1) & mask;
+    }
+    return NULL;
+}
+
+/*
+ * Rebuilds the side table with the given power of 2
+ * capacity, dropping tombstones
+ */
+static void rehashTable(size_t newCapacity){
+    AllocRecord *oldTable = table;
+    size_t oldCapacity = tableCapacity;
+
+    table = calloc(newCapacity, sizeof(*table));
+    assertNotNull(table, "alloc table fail; " SRC_LOCATION);
+    tableCapacity = newCapacity;
+    tableTombstones = 0;
+
+    size_t mask = tableCapacity - 1;
+    for(size_t i = 0; i < oldCapacity; ++i){
+        void *ptr = oldTable[i].ptr;
+        if(!ptr || ptr == tombstonePtr){
+            continue;
+        }
+        size_t index = hashPtr(ptr) & mask;
+        while(table[index].ptr){
+            index = (index + 1) & mask;
+        }
+        table[index] = oldTable[i];
+    }
+    free(oldTable);
+}
+
+/* Inserts the given record into the side table */
+static void insertRecord(AllocRecord record){
+    /* keep load (including tombstones) under half */
+    if((tableCount + tableTombstones + 1) * 2
+        > tableCapacity
+    ){
+        size_t newCapacity = tableCapacity
+            ? tableCapacity
+            : tableInitCapacity;
+        while((tableCount + 1) * 4 > newCapacity){
+            newCapacity *= 2;
+        }
+        rehashTable(newCapacity);
+    }
+    size_t mask = tableCapacity - 1;
+    size_t index = hashPtr(record.ptr) & mask;
+    while(table[index].ptr
+        && table[index].ptr != tombstonePtr
+    ){
+        index = (index + 1) & mask;
+    }
+    if(table[index].ptr == tombstonePtr){
+        --tableTombstones;
+    }
+    table[index] = record;
+    ++tableCount;
+
+    ++(frameStats.liveCount);
+    frameStats.liveBytes += record.size;
+    if(frameStats.liveBytes > frameStats.peakLiveBytes){
+        frameStats.peakLiveBytes = frameStats.liveBytes;
+    }
+}
+
+/* Erases the given record from the side table */
+static void eraseRecord(AllocRecord *recordPtr){
+    --(frameStats.liveCount);
+    frameStats.liveBytes -= recordPtr->size;
+    memset(recordPtr, 0, sizeof(*recordPtr));
+    recordPtr->ptr = tombstonePtr;
+    --tableCount;
+    ++tableTombstones;
+}
+
+/* Prints leaks to stderr; registered with atexit */
+static void dumpLeaksAtExit(){
+    pgAllocDumpLeaks(stderr);
+}
+
+/*
+ * Returns true if the given site was already warned
+ * of, marking it warned otherwise; must hold the
+ * side table lock
+ */
+static bool checkWarnedSite(const char *site){
+    for(size_t i = 0; i < warnedSiteCount; ++i){
+        if(strcmp(warnedSites[i], site) == 0){
+            return true;
+        }
+    }
+    if(warnedSiteCount == warnedSiteCapacity){
+        return true;
+    }
+    warnedSites[warnedSiteCount++] = site;
+    return false;
+}
+
+/*
+ * Counts the allocation at the given site if the
+ * calling thread is in a forbidden allocation scope
+ * which no allowed scope lifts, warning the first
+ * time the site does so
+ */
+static void countIfForbidden(const char *site){
+    if(forbidDepth == 0 || allowDepth > 0){
+        return;
+    }
+    lockTable();
+    ++(frameStats.forbiddenCount);
+    bool warned = checkWarnedSite(site);
+    unlockTable();
+
+    if(!warned){
+        char buffer[messageBufferSize] = {0};
+        snprintf(
+            buffer,
+            messageBufferSize - 1,
+            "heap allocation in no-alloc scope %s "
+            "at %s",
+            forbidScopeName,
+            site
+        );
+        pgWarning(buffer);
+    }
+}
+
+/*
+ * Allocates like pgAlloc and records the given call
+ * site (a SRC_LOCATION string) in the allocation
+ * side table
+ */
+void *_pgAllocTracked(
+    size_t numItems,
+    size_t size,
+    const char *site
+){
+    countIfForbidden(site);
+    void *toRet = rawAlloc(numItems, size);
+    AllocRecord record = {
+        toRet,
+        numItems * size,
+        site,
+        currentTag()
+    };
+
+    lockTable();
+    if(!atExitRegistered){
+        atExitRegistered = true;
+        atexit(dumpLeaksAtExit);
+    }
+    insertRecord(record);
+    ++(frameStats.allocCount);
+    frameStats.bytesAllocated += record.size;
+    unlockTable();
+
+    return toRet;
+}
+
+/*
+ * Reallocates like pgRealloc and moves the record of
+ * the given pointer to the new block, attributing it
+ * to the given call site
+ */
+void *_pgReallocTracked(
+    void *ptr,
+    size_t numItems,
+    size_t size,
+    const char *site
+){
+    countIfForbidden(site);
+
+    /* erase the old record before the block moves */
+    const char *tag = currentTag();
+    size_t oldSize = 0;
+    if(ptr){
+        lockTable();
+        AllocRecord *oldRecordPtr = findRecord(ptr);
+        if(oldRecordPtr){
+            oldSize = oldRecordPtr->size;
+            if(oldRecordPtr->tag){
+                tag = oldRecordPtr->tag;
+            }
+            eraseRecord(oldRecordPtr);
+        }
+        unlockTable();
+    }
+
+    void *toRet = rawRealloc(ptr, numItems, size);
+    AllocRecord record = {
+        toRet,
+        numItems * size,
+        site,
+        tag
+    };
+
+    lockTable();
+    insertRecord(record);
+    ++(frameStats.reallocCount);
+    if(record.size > oldSize){
+        frameStats.bytesAllocated
+            += record.size - oldSize;
+    }
+    unlockTable();
+
+    return toRet;
+}
+
+/*
+ * Frees the given pointer and erases its record;
+ * warns if the pointer was never tracked
+ */
+void _pgFreeTracked(void *ptr, const char *site){
+    if(!ptr){
+        return;
+    }
+    lockTable();
+    AllocRecord *recordPtr = findRecord(ptr);
+    if(recordPtr){
+        eraseRecord(recordPtr);
+        ++(frameStats.freeCount);
+    }
+    unlockTable();
+
+    if(!recordPtr){
+        static char buffer[messageBufferSize] = {0};
+        snprintf(
+            buffer,
+            messageBufferSize - 1,
+            "pgFree of untracked pointer at %s",
+            site
+        );
+        pgWarning(buffer);
+    }
+    free(ptr);
+}
+
+/*
+ * Pushes the given tag (should be a string literal)
+ * for the calling thread; subsequent allocations on
+ * that thread are attributed to the tag
+ */
+void pgAllocPushTag(const char *tag){
+    assertTrue(
+        tagDepth < tagStackSize,
+        "alloc tag stack overflow; " SRC_LOCATION
+    );
+    tagStack[tagDepth++] = tag;
+}
+
+/* Pops the current allocation tag of the thread */
+void pgAllocPopTag(){
+    assertTrue(
+        tagDepth > 0,
+        "alloc tag stack underflow; " SRC_LOCATION
+    );
+    --tagDepth;
+}
+
+/*
+ * Marks the end of a frame; the counters accumulated
+ * since the previous mark become the last frame stats
+ */
+void pgAllocFrameMark(){
+    lockTable();
+    lastFrameStats = frameStats;
+    /* live counts carry over; the rest restart */
+    frameStats.allocCount = 0;
+    frameStats.reallocCount = 0;
+    frameStats.freeCount = 0;
+    frameStats.bytesAllocated = 0;
+    frameStats.forbiddenCount = 0;
+    frameStats.peakLiveBytes = frameStats.liveBytes;
+    unlockTable();
+}
+
+/*
+ * Begins a scope on the calling thread in which any
+ * tracked allocation or reallocation is an error;
+ * scopes may nest
+ */
+void pgAllocForbidBegin(const char *scopeName){
+    if(forbidDepth == 0){
+        forbidScopeName = scopeName;
+    }
+    ++forbidDepth;
+}
+
+/* Ends the innermost forbidden allocation scope */
+void pgAllocForbidEnd(){
+    assertTrue(
+        forbidDepth > 0,
+        "no-alloc scope underflow; " SRC_LOCATION
+    );
+    if(--forbidDepth == 0){
+        forbidScopeName = NULL;
+    }
+}
+
+/*
+ * Begins a scope on the calling thread which lifts
+ * any enclosing forbidden allocation scope, e.g. for
+ * loading inside an otherwise steady state update
+ */
+void pgAllocAllowBegin(){
+    ++allowDepth;
+}
+
+/* Ends the innermost allowed allocation scope */
+void pgAllocAllowEnd(){
+    assertTrue(
+        allowDepth > 0,
+        "alloc scope underflow; " SRC_LOCATION
+    );
+    --allowDepth;
+}
+
+/* Returns the allocation scope of the calling thread */
+PGAllocScope pgAllocScopeGet(){
+    PGAllocScope toRet = {currentTag(), NULL};
+    if(forbidDepth > 0 && allowDepth == 0){
+        toRet.forbidScopeName = forbidScopeName;
+    }
+    return toRet;
+}
+
+/*
+ * Enters the given allocation scope on the calling
+ * thread; must be paired with pgAllocScopeExit()
+ */
+void pgAllocScopeEnter(PGAllocScope scope){
+    if(scope.tag){
+        pgAllocPushTag(scope.tag);
+    }
+    /* allowed scopes lift any forbidding of the thread */
+    if(scope.forbidScopeName){
+        pgAllocForbidBegin(scope.forbidScopeName);
+    }
+    else{
+        pgAllocAllowBegin();
+    }
+}
+
+/*
+ * Exits the given allocation scope, which must be the
+ * one last entered on the calling thread
+ */
+void pgAllocScopeExit(PGAllocScope scope){
+    if(scope.forbidScopeName){
+        pgAllocForbidEnd();
+    }
+    else{
+        pgAllocAllowEnd();
+    }
+    if(scope.tag){
+        pgAllocPopTag();
+    }
+}
+
+/* Returns the counters for the current frame */
+PGAllocStats pgAllocGetStats(){
+    lockTable();
+    PGAllocStats toRet = frameStats;
+    unlockTable();
+    return toRet;
+}
+
+/* Returns the counters for the previous frame */
+PGAllocStats pgAllocGetLastFrameStats(){
+    lockTable();
+    PGAllocStats toRet = lastFrameStats;
+    unlockTable();
+    return toRet;
+}
+
+/* Orders sites by location then tag for grouping */
+static int compareBySite(const void *a, const void *b){
+    const AllocSite *siteA = a;
+    const AllocSite *siteB = b;
+    int siteCompare = strcmp(siteA->site, siteB->site);
+    if(siteCompare != 0){
+        return siteCompare;
+    }
+    /* untagged records sort before tagged ones */
+    if(!siteA->tag || !siteB->tag){
+        return (siteA->tag != NULL)
+            - (siteB->tag != NULL);
+    }
+    return strcmp(siteA->tag, siteB->tag);
+}
+
+/* Orders sites by total bytes, largest first */
+static int compareByBytes(const void *a, const void *b){
+    const AllocSite *siteA = a;
+    const AllocSite *siteB = b;
+    if(siteA->bytes == siteB->bytes){
+        return 0;
+    }
+    return siteA->bytes < siteB->bytes ? 1 : -1;
+}
+
+/*
+ * Prints all live allocations grouped by call site,
+ * largest total size first
+ */
+void pgAllocReportLive(FILE *filePtr){
+    lockTable();
+    size_t numRecords = tableCount;
+    AllocSite *sites = NULL;
+    if(numRecords > 0){
+        sites = calloc(numRecords, sizeof(*sites));
+        assertNotNull(
+            sites,
+            "alloc report fail; " SRC_LOCATION
+        );
+    }
+    size_t numSites = 0;
+    for(size_t i = 0; i < tableCapacity; ++i){
+        AllocRecord *recordPtr = &(table[i]);
+        if(!recordPtr->ptr
+            || recordPtr->ptr == tombstonePtr
+        ){
+            continue;
+        }
+        sites[numSites++] = (AllocSite){
+            recordPtr->site,
+            recordPtr->tag,
+            1,
+            recordPtr->size
+        };
+    }
+    unlockTable();
+
+    /* collapse records from the same site */
+    qsort(sites, numSites, sizeof(*sites), compareBySite);
+    size_t numGroups = 0;
+    for(size_t i = 0; i < numSites; ++i){
+        if(numGroups > 0 && compareBySite(
+            &(sites[numGroups - 1]),
+            &(sites[i])
+        ) == 0){
+            ++(sites[numGroups - 1].count);
+            sites[numGroups - 1].bytes += sites[i].bytes;
+        }
+        else{
+            sites[numGroups++] = sites[i];
+        }
+    }
+    qsort(sites, numGroups, sizeof(*sites), compareByBytes);
+
+    fprintf(
+        filePtr,
+        "live allocations: %zu in %zu sites\n",
+        numSites,
+        numGroups
+    );
+    for(size_t i = 0; i < numGroups; ++i){
+        fprintf(
+            filePtr,
+            "%10zu bytes %6zu allocs  %-12s %s\n",
+            sites[i].bytes,
+            sites[i].count,
+            sites[i].tag ? sites[i].tag : "-",
+            sites[i].site
+        );
+    }
+    free(sites);
+}
+
+/*
+ * Prints every live allocation individually; called
+ * automatically at exit
+ */
+void pgAllocDumpLeaks(FILE *filePtr){
+    lockTable();
+    if(tableCount > 0){
+        fprintf(
+            filePtr,
+            "leaked %zu allocations (%zu bytes):\n",
+            frameStats.liveCount,
+            frameStats.liveBytes
+        );
+        for(size_t i = 0; i < tableCapacity; ++i){
+            AllocRecord *recordPtr = &(table[i]);
+            if(!recordPtr->ptr
+                || recordPtr->ptr == tombstonePtr
+            ){
+                continue;
+            }
+            fprintf(
+                filePtr,
+                "  %p %zu bytes %s %s\n",
+                recordPtr->ptr,
+                recordPtr->size,
+                recordPtr->tag ? recordPtr->tag : "-",
+                recordPtr->site
+            );
+        }
+    }
+    unlockTable();
+}
+
+#endif /* PG_ALLOC_TRACKING */
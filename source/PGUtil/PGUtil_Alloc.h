@@ -1,8 +1,21 @@
 #ifndef PGUTIL_ALLOC_H
 #define PGUTIL_ALLOC_H
 
+#include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 
+#include "PGUtil_Error.h"
+
+/*
+ * Define PG_ALLOC_TRACKING (e.g. via the CMake option
+ * of the same name) to route pgAlloc, pgRealloc, and
+ * pgFree through a tracker which records the call
+ * site, size, and tag of every live allocation
+ */
+
+#ifndef PG_ALLOC_TRACKING
+
 /* 
  * Returns a pointer to a newly allocated block which 
  * holds the specified number of items, each of the 
@@ -39,4 +52,189 @@ void *pgRealloc(
         (PTR_NAME) = (NEW_VALUE); \
     } while(false)
 
-#endif
\ No newline at end of file
+/* tracking hooks compile out when not tracking */
+#define pgAllocPushTag(TAG) ((void)0)
+#define pgAllocPopTag() ((void)0)
+#define pgAllocFrameMark() ((void)0)
+#define pgAllocForbidBegin(SCOPENAME) ((void)0)
+#define pgAllocForbidEnd() ((void)0)
+#define pgAllocAllowBegin() ((void)0)
+#define pgAllocAllowEnd() ((void)0)
+
+/* container call sites are only kept when tracking */
+#define PG_ALLOC_SITE_PARAM
+#define PG_ALLOC_SITE_ARG
+#define PG_ALLOC_SITE_FORWARD
+#define pgAllocAt(NUMITEMS, SIZE, SITE) \
+    pgAlloc(NUMITEMS, SIZE)
+#define pgReallocAt(PTR, NUMITEMS, SIZE, SITE) \
+    pgRealloc(PTR, NUMITEMS, SIZE)
+
+#else /* PG_ALLOC_TRACKING */
+
+/*
+ * Holds allocation counters; live counts are totals
+ * whereas the others are reset every frame mark
+ */
+typedef struct PGAllocStats{
+    size_t allocCount;
+    size_t reallocCount;
+    size_t freeCount;
+    size_t bytesAllocated;
+    /* allocations made in a forbidden scope */
+    size_t forbiddenCount;
+    size_t liveCount;
+    size_t liveBytes;
+    size_t peakLiveBytes;
+} PGAllocStats;
+
+/*
+ * Allocates like pgAlloc and records the given call
+ * site (a SRC_LOCATION string) in the allocation
+ * side table
+ */
+void *_pgAllocTracked(
+    size_t numItems,
+    size_t size,
+    const char *site
+);
+
+/*
+ * Reallocates like pgRealloc and moves the record of
+ * the given pointer to the new block, attributing it
+ * to the given call site
+ */
+void *_pgReallocTracked(
+    void *ptr,
+    size_t numItems,
+    size_t size,
+    const char *site
+);
+
+/*
+ * Frees the given pointer and erases its record;
+ * warns if the pointer was never tracked
+ */
+void _pgFreeTracked(void *ptr, const char *site);
+
+#define pgAlloc(NUMITEMS, SIZE) \
+    _pgAllocTracked(NUMITEMS, SIZE, SRC_LOCATION)
+
+#define pgRealloc(PTR, NUMITEMS, SIZE) \
+    _pgReallocTracked(PTR, NUMITEMS, SIZE, SRC_LOCATION)
+
+/*
+ * Containers take the call site of their typed
+ * macros as a trailing parameter and allocate at it,
+ * so that allocations they make on behalf of a
+ * caller are attributed to that caller
+ */
+#define PG_ALLOC_SITE_PARAM , const char *allocSite
+#define PG_ALLOC_SITE_ARG , SRC_LOCATION
+#define PG_ALLOC_SITE_FORWARD , allocSite
+#define pgAllocAt(NUMITEMS, SIZE, SITE) \
+    _pgAllocTracked(NUMITEMS, SIZE, SITE)
+#define pgReallocAt(PTR, NUMITEMS, SIZE, SITE) \
+    _pgReallocTracked(PTR, NUMITEMS, SIZE, SITE)
+
+/* Frees the given pointer and sets it to NULL */
+#define pgFree(PTR_NAME) \
+    do{ \
+        _pgFreeTracked(PTR_NAME, SRC_LOCATION); \
+        (PTR_NAME) = NULL; \
+    } while(false)
+
+/*
+ * Frees the given pointer and sets it to the
+ * given new value
+ */
+#define pgFreeAndSwap(PTR_NAME, NEW_VALUE) \
+    do{ \
+        _pgFreeTracked(PTR_NAME, SRC_LOCATION); \
+        (PTR_NAME) = (NEW_VALUE); \
+    } while(false)
+
+/*
+ * Pushes the given tag (should be a string literal)
+ * for the calling thread; subsequent allocations on
+ * that thread are attributed to the tag
+ */
+void pgAllocPushTag(const char *tag);
+
+/* Pops the current allocation tag of the thread */
+void pgAllocPopTag();
+
+/*
+ * Marks the end of a frame; the counters accumulated
+ * since the previous mark become the last frame stats
+ */
+void pgAllocFrameMark();
+
+/*
+ * Begins a scope on the calling thread in which any
+ * tracked allocation or reallocation is counted as
+ * forbidden and warned of, once per call site;
+ * scopes may nest
+ */
+void pgAllocForbidBegin(const char *scopeName);
+
+/* Ends the innermost forbidden allocation scope */
+void pgAllocForbidEnd();
+
+/*
+ * Begins a scope on the calling thread which lifts
+ * any enclosing forbidden allocation scope, e.g. for
+ * loading inside an otherwise steady state update
+ */
+void pgAllocAllowBegin();
+
+/* Ends the innermost allowed allocation scope */
+void pgAllocAllowEnd();
+
+/*
+ * The allocation tag and scope of a thread, captured
+ * so that work handed to another thread, such as a
+ * job, runs under them
+ */
+typedef struct PGAllocScope{
+    const char *tag;
+    /* NULL if allocations are allowed */
+    const char *forbidScopeName;
+} PGAllocScope;
+
+/* Returns the allocation scope of the calling thread */
+PGAllocScope pgAllocScopeGet();
+
+/*
+ * Enters the given allocation scope on the calling
+ * thread; must be paired with pgAllocScopeExit()
+ */
+void pgAllocScopeEnter(PGAllocScope scope);
+
+/*
+ * Exits the given allocation scope, which must be the
+ * one last entered on the calling thread
+ */
+void pgAllocScopeExit(PGAllocScope scope);
+
+/* Returns the counters for the current frame */
+PGAllocStats pgAllocGetStats();
+
+/* Returns the counters for the previous frame */
+PGAllocStats pgAllocGetLastFrameStats();
+
+/*
+ * Prints all live allocations grouped by call site,
+ * largest total size first
+ */
+void pgAllocReportLive(FILE *filePtr);
+
+/*
+ * Prints every live allocation individually; called
+ * automatically at exit
+ */
+void pgAllocDumpLeaks(FILE *filePtr);
+
+#endif /* PG_ALLOC_TRACKING */
+
+#endif
@@ -65,4 +65,40 @@ void assertStringEqual(
     const char *errorMsg
 );
 
+/*
+ * Checks on hot paths (iterator validity, accessor
+ * bounds, interpreter stack bounds) are kept in debug
+ * builds or when PG_HOT_CHECKS is defined, and are
+ * compiled out entirely otherwise; the expressions
+ * passed to the macros below must therefore not have
+ * side effects
+ */
+#if defined(_DEBUG) || defined(PG_HOT_CHECKS)
+#define PG_HOT_CHECKS_ENABLED
+
+/*
+ * Asserts that the given bool is true on a hot path,
+ * printing the given error message otherwise
+ */
+#define hotAssertTrue(ASSERTION, MSG) \
+    assertTrue(ASSERTION, MSG)
+
+/*
+ * Asserts that the given bool is false on a hot path,
+ * printing the given error message otherwise
+ */
+#define hotAssertFalse(ASSERTION, MSG) \
+    assertFalse(ASSERTION, MSG)
+
+/* Evaluates the given hot path check statement */
+#define hotCheck(...) __VA_ARGS__
+
+#else
+
+#define hotAssertTrue(ASSERTION, MSG) ((void)0)
+#define hotAssertFalse(ASSERTION, MSG) ((void)0)
+#define hotCheck(...) ((void)0)
+
+#endif
+
 #endif
\ No newline at end of file
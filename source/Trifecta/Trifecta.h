@@ -5,6 +5,7 @@
 #include "Trifecta_Directory.h"
 #include "Trifecta_GlyphMap.h"
 #include "Trifecta_Input.h"
+#include "Trifecta_Jobs.h"
 #include "Trifecta_Sprite.h"
 #include "Trifecta_Time.h"
 #include "Trifecta_Uchar.h"
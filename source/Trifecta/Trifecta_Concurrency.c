@@ -1,3 +1,8 @@
+/* needed for thread affinity on linux */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "Trifecta_Concurrency.h"
 
 #include "PGUtil.h"
@@ -6,6 +11,8 @@
 
 #include <sys/errno.h>
 #include <signal.h>
+#include <sched.h>
+#include <unistd.h>
 
 /*
  * Initializes the current thread; should be called by
@@ -68,6 +75,53 @@ JoinReturnCode threadJoin(Thread thread){
     return joinSuccess;
 }
 
+/* Yields the remainder of the current time slice */
+void threadYield(){
+    sched_yield();
+}
+
+/*
+ * Returns the number of processors available to the
+ * process, or 1 if it cannot be determined
+ */
+size_t getProcessorCount(){
+    long result = sysconf(_SC_NPROCESSORS_ONLN);
+    if(result < 1){
+        return 1u;
+    }
+    return (size_t)result;
+}
+
+/*
+ * Attempts to restrict the specified thread to the
+ * processor with the given index; returns true if
+ * successful, false otherwise (including on
+ * platforms without affinity control)
+ */
+bool threadPinToProcessor(
+    Thread thread,
+    size_t processorIndex
+){
+    #ifdef __linux__
+    if(processorIndex >= CPU_SETSIZE){
+        return false;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(processorIndex, &cpuSet);
+    return pthread_setaffinity_np(
+        thread,
+        sizeof(cpuSet),
+        &cpuSet
+    ) == 0;
+    #else
+    /* no affinity control; scheduler decides */
+    (void)thread;
+    (void)processorIndex;
+    return false;
+    #endif
+}
+
 #endif /* end __unix__ */
 
 #ifdef WIN32
@@ -120,4 +174,41 @@ JoinReturnCode threadJoin(Thread thread){
     }
 }
 
+/* Yields the remainder of the current time slice */
+void threadYield(){
+    SwitchToThread();
+}
+
+/*
+ * Returns the number of processors available to the
+ * process, or 1 if it cannot be determined
+ */
+size_t getProcessorCount(){
+    SYSTEM_INFO systemInfo = {0};
+    GetSystemInfo(&systemInfo);
+    if(systemInfo.dwNumberOfProcessors < 1){
+        return 1u;
+    }
+    return (size_t)systemInfo.dwNumberOfProcessors;
+}
+
+/*
+ * Attempts to restrict the specified thread to the
+ * processor with the given index; returns true if
+ * successful, false otherwise (including on
+ * platforms without affinity control)
+ */
+bool threadPinToProcessor(
+    Thread thread,
+    size_t processorIndex
+){
+    if(processorIndex >= sizeof(DWORD_PTR) * 8u){
+        return false;
+    }
+    return SetThreadAffinityMask(
+        thread,
+        ((DWORD_PTR)1u) << processorIndex
+    ) != 0;
+}
+
 #endif /* end WIN32 */
\ No newline at end of file
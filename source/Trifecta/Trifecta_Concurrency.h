@@ -2,6 +2,7 @@
 #define TRIFECTA_CONCURRENCY_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __unix__
 
@@ -88,4 +89,24 @@ typedef enum JoinReturnCode{
 /* Attempts to join the specified thread */
 JoinReturnCode threadJoin(Thread thread);
 
+/* Yields the remainder of the current time slice */
+void threadYield();
+
+/*
+ * Returns the number of processors available to the
+ * process, or 1 if it cannot be determined
+ */
+size_t getProcessorCount();
+
+/*
+ * Attempts to restrict the specified thread to the
+ * processor with the given index; returns true if
+ * successful, false otherwise (including on
+ * platforms without affinity control)
+ */
+bool threadPinToProcessor(
+    Thread thread,
+    size_t processorIndex
+);
+
 #endif
\ No newline at end of file
@@ -249,7 +249,7 @@ void tfDirectoryGetNextFileName(
         );
         stringAppendC(&findString, "/*");
         dirPtr->_searchHandle = FindFirstFileA(
-            findString._ptr,
+            stringCharPtr(&findString),
             &findData
         );
         stringFree(&findString);
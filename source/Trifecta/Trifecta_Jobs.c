@@ -0,0 +1,535 @@
+#include "Trifecta_Jobs.h"
+
+#include <stdint.h>
+
+#include "PGUtil.h"
+#include "Trifecta_Time.h"
+
+/* failed steal rounds before an idle worker yields */
+#define spinsBeforeYield 64
+/* yields before an idle worker starts sleeping */
+#define yieldsBeforeSleep 16
+/* how long a sleeping idle worker naps between polls */
+#define idleSleepNano 100000
+
+/*
+ * A single queued job; fields are atomic because a
+ * thief may read a slot while its owner reuses it,
+ * in which case the thief's claim always fails
+ */
+typedef struct JobSlot{
+    _Atomic(TFJobFunc) func;
+    _Atomic(void*) argPtr;
+    _Atomic(TFJobCounter*) counterPtr;
+    #ifdef PG_ALLOC_TRACKING
+    _Atomic(const char*) allocTag;
+    _Atomic(const char*) allocForbidScopeName;
+    #endif
+} JobSlot;
+
+/* A job read out of a deque */
+typedef struct Job{
+    TFJobFunc func;
+    void *argPtr;
+    TFJobCounter *counterPtr;
+    #ifdef PG_ALLOC_TRACKING
+    /* the allocation scope the job was queued in */
+    PGAllocScope allocScope;
+    #endif
+} Job;
+
+/*
+ * A Chase-Lev work stealing deque; the owning thread
+ * pushes and pops at the bottom while other threads
+ * steal from the top
+ */
+typedef struct JobDeque{
+    JobSlot slots[tfJobDequeCapacity];
+    char _pad0[64];
+    atomic_llong top;
+    char _pad1[64];
+    atomic_llong bottom;
+    char _pad2[64];
+} JobDeque;
+
+/* Per thread state; index 0 is the main thread */
+typedef struct Worker{
+    JobDeque deque;
+    Thread thread;
+    /* state for picking steal victims */
+    uint32_t randomState;
+} Worker;
+
+static Worker *workersPtr = NULL;
+/* number of workers including the main thread */
+static size_t workerArraySize = 0u;
+static atomic_bool running;
+
+static bool initialized = false;
+
+/* the worker owned by the calling thread, if any */
+static _Thread_local Worker *currentWorkerPtr = NULL;
+
+#define dequeMask (tfJobDequeCapacity - 1)
+
+_Static_assert(
+    (tfJobDequeCapacity & dequeMask) == 0,
+    "job deque capacity must be a power of two"
+);
+
+/*
+ * Pushes the given job onto the bottom of the given
+ * deque; returns false if the deque was full, true
+ * otherwise. Owner thread only
+ */
+static bool jobDequePush(JobDeque *dequePtr, Job job){
+    long long bottom = atomic_load_explicit(
+        &(dequePtr->bottom),
+        memory_order_relaxed
+    );
+    long long top = atomic_load_explicit(
+        &(dequePtr->top),
+        memory_order_acquire
+    );
+    if(bottom - top >= tfJobDequeCapacity){
+        return false;
+    }
+    JobSlot *slotPtr
+        = &(dequePtr->slots[bottom & dequeMask]);
+    atomic_store_explicit(
+        &(slotPtr->func),
+        job.func,
+        memory_order_relaxed
+    );
+    atomic_store_explicit(
+        &(slotPtr->argPtr),
+        job.argPtr,
+        memory_order_relaxed
+    );
+    atomic_store_explicit(
+        &(slotPtr->counterPtr),
+        job.counterPtr,
+        memory_order_relaxed
+    );
+    #ifdef PG_ALLOC_TRACKING
+    atomic_store_explicit(
+        &(slotPtr->allocTag),
+        job.allocScope.tag,
+        memory_order_relaxed
+    );
+    atomic_store_explicit(
+        &(slotPtr->allocForbidScopeName),
+        job.allocScope.forbidScopeName,
+        memory_order_relaxed
+    );
+    #endif
+    /* publish the slot along with the new bottom */
+    atomic_store_explicit(
+        &(dequePtr->bottom),
+        bottom + 1,
+        memory_order_release
+    );
+    return true;
+}
+
+/* Reads the job held by the given slot */
+static Job jobSlotRead(JobSlot *slotPtr){
+    Job toRet = {0};
+    toRet.func = atomic_load_explicit(
+        &(slotPtr->func),
+        memory_order_relaxed
+    );
+    toRet.argPtr = atomic_load_explicit(
+        &(slotPtr->argPtr),
+        memory_order_relaxed
+    );
+    toRet.counterPtr = atomic_load_explicit(
+        &(slotPtr->counterPtr),
+        memory_order_relaxed
+    );
+    #ifdef PG_ALLOC_TRACKING
+    toRet.allocScope.tag = atomic_load_explicit(
+        &(slotPtr->allocTag),
+        memory_order_relaxed
+    );
+    toRet.allocScope.forbidScopeName
+        = atomic_load_explicit(
+            &(slotPtr->allocForbidScopeName),
+            memory_order_relaxed
+        );
+    #endif
+    return toRet;
+}
+
+/*
+ * Pops the bottom job of the given deque into the
+ * given pointer; returns false if the deque was
+ * empty, true otherwise. Owner thread only
+ */
+static bool jobDequePop(JobDeque *dequePtr, Job *jobPtr){
+    long long bottom = atomic_load_explicit(
+        &(dequePtr->bottom),
+        memory_order_relaxed
+    ) - 1;
+    /*
+     * the bottom store must be ordered before the top
+     * load, so both are sequentially consistent
+     */
+    atomic_store_explicit(
+        &(dequePtr->bottom),
+        bottom,
+        memory_order_seq_cst
+    );
+    long long top = atomic_load_explicit(
+        &(dequePtr->top),
+        memory_order_seq_cst
+    );
+
+    /* deque was empty; restore bottom */
+    if(top > bottom){
+        atomic_store_explicit(
+            &(dequePtr->bottom),
+            bottom + 1,
+            memory_order_relaxed
+        );
+        return false;
+    }
+
+    *jobPtr = jobSlotRead(
+        &(dequePtr->slots[bottom & dequeMask])
+    );
+    if(top != bottom){
+        return true;
+    }
+
+    /* last job; race any thieves for it */
+    bool won = atomic_compare_exchange_strong_explicit(
+        &(dequePtr->top),
+        &top,
+        top + 1,
+        memory_order_seq_cst,
+        memory_order_relaxed
+    );
+    atomic_store_explicit(
+        &(dequePtr->bottom),
+        bottom + 1,
+        memory_order_relaxed
+    );
+    return won;
+}
+
+/*
+ * Steals the top job of the given deque into the
+ * given pointer; returns false if the deque was
+ * empty or another thread won the job, true
+ * otherwise. Any thread
+ */
+static bool jobDequeSteal(
+    JobDeque *dequePtr,
+    Job *jobPtr
+){
+    long long top = atomic_load_explicit(
+        &(dequePtr->top),
+        memory_order_seq_cst
+    );
+    long long bottom = atomic_load_explicit(
+        &(dequePtr->bottom),
+        memory_order_seq_cst
+    );
+    if(top >= bottom){
+        return false;
+    }
+
+    *jobPtr = jobSlotRead(
+        &(dequePtr->slots[top & dequeMask])
+    );
+    return atomic_compare_exchange_strong_explicit(
+        &(dequePtr->top),
+        &top,
+        top + 1,
+        memory_order_seq_cst,
+        memory_order_relaxed
+    );
+}
+
+/*
+ * Runs the given job, under the allocation scope it
+ * was queued in if tracking, and signals its counter
+ */
+static void runJob(Job job){
+    #ifdef PG_ALLOC_TRACKING
+    pgAllocScopeEnter(job.allocScope);
+    job.func(job.argPtr);
+    pgAllocScopeExit(job.allocScope);
+    #else
+    job.func(job.argPtr);
+    #endif
+    if(job.counterPtr){
+        atomic_fetch_sub_explicit(
+            &(job.counterPtr->_pending),
+            1u,
+            memory_order_release
+        );
+    }
+}
+
+/* Returns the next value of a xorshift generator */
+static uint32_t nextRandom(uint32_t *statePtr){
+    uint32_t x = *statePtr;
+    x ^= x << 13u;
+    x ^= x >> 17u;
+    x ^= x << 5u;
+    *statePtr = x;
+    return x;
+}
+
+/*
+ * Tries to find a job for the given worker, first
+ * from its own deque and then by stealing from the
+ * others starting at a random victim; returns true
+ * if a job was found, false otherwise
+ */
+static bool findJob(Worker *workerPtr, Job *jobPtr){
+    if(jobDequePop(&(workerPtr->deque), jobPtr)){
+        return true;
+    }
+    size_t startIndex
+        = nextRandom(&(workerPtr->randomState))
+            % workerArraySize;
+    for(size_t i = 0u; i < workerArraySize; ++i){
+        Worker *victimPtr = &(workersPtr[
+            (startIndex + i) % workerArraySize
+        ]);
+        if(victimPtr == workerPtr){
+            continue;
+        }
+        if(jobDequeSteal(&(victimPtr->deque), jobPtr)){
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Runs jobs until the job system stops */
+static DECLARE_RUNNABLE_FUNC(workerLoop, arg){
+    initThread();
+    currentWorkerPtr = (Worker*)arg;
+
+    Job job = {0};
+    int idleRounds = 0;
+    int idleYields = 0;
+    while(atomic_load_explicit(
+        &running,
+        memory_order_acquire
+    )){
+        if(findJob(currentWorkerPtr, &job)){
+            runJob(job);
+            idleRounds = 0;
+            idleYields = 0;
+            continue;
+        }
+        /* back off so idle workers leave the core */
+        if(++idleRounds < spinsBeforeYield){
+            continue;
+        }
+        idleRounds = 0;
+        if(idleYields < yieldsBeforeSleep){
+            ++idleYields;
+            threadYield();
+        }
+        else{
+            sleepUntil(addTimeNano(
+                getCurrentTime(),
+                idleSleepNano
+            ));
+        }
+    }
+    return 0;
+}
+
+/* Initializes the given job counter to zero */
+void tfJobCounterInit(TFJobCounter *counterPtr){
+    atomic_init(&(counterPtr->_pending), 0u);
+}
+
+/*
+ * Returns true if every job attached to the given
+ * counter has finished, false otherwise
+ */
+bool tfJobCounterIsDone(TFJobCounter *counterPtr){
+    return atomic_load_explicit(
+        &(counterPtr->_pending),
+        memory_order_acquire
+    ) == 0u;
+}
+
+/*
+ * Initializes the job system with the specified
+ * number of worker threads, or one fewer than the
+ * number of processors if 0, if it has not already
+ * been initialized; the calling thread becomes the
+ * main thread of the job system
+ */
+void tfJobSystemInit(size_t workerCount){
+    if(initialized){
+        return;
+    }
+    if(workerCount == 0u){
+        size_t processorCount = getProcessorCount();
+        workerCount = processorCount > 1u
+            ? processorCount - 1u
+            : 1u;
+    }
+
+    workerArraySize = workerCount + 1u;
+    workersPtr = pgAlloc(
+        workerArraySize,
+        sizeof(*workersPtr)
+    );
+    for(size_t i = 0u; i < workerArraySize; ++i){
+        Worker *workerPtr = &(workersPtr[i]);
+        atomic_init(&(workerPtr->deque.top), 0);
+        atomic_init(&(workerPtr->deque.bottom), 0);
+        /* xorshift state must be nonzero */
+        workerPtr->randomState
+            = (uint32_t)(i * 2654435761u) | 1u;
+    }
+    atomic_init(&running, true);
+    initialized = true;
+
+    /* the calling thread owns worker 0 */
+    currentWorkerPtr = &(workersPtr[0]);
+
+    size_t processorCount = getProcessorCount();
+    for(size_t i = 1u; i < workerArraySize; ++i){
+        CreateReturn createReturn = threadCreate(
+            workerLoop,
+            &(workersPtr[i])
+        );
+        if(!createReturn.success){
+            pgError(
+                "failed to create job worker; "
+                SRC_LOCATION
+            );
+        }
+        workersPtr[i].thread = createReturn.thread;
+        /*
+         * pin each worker to its own core, leaving
+         * core 0 to the main thread; pinning is only
+         * a hint so failure is ignored
+         */
+        if(processorCount > 1u){
+            threadPinToProcessor(
+                createReturn.thread,
+                i % processorCount
+            );
+        }
+    }
+}
+
+/*
+ * Returns the number of worker threads in the job
+ * system, not counting the main thread
+ */
+size_t tfJobSystemWorkerCount(){
+    if(!initialized){
+        return 0u;
+    }
+    return workerArraySize - 1u;
+}
+
+/*
+ * Queues the given function to be run with the given
+ * argument on some thread of the job system; if the
+ * counter pointer is not NULL, it is incremented now
+ * and decremented once the job finishes. Must be
+ * called from the main thread or from within a job
+ */
+void tfJobRun(
+    TFJobFunc func,
+    void *argPtr,
+    TFJobCounter *counterPtr
+){
+    assertTrue(
+        initialized,
+        "job system not initialized; " SRC_LOCATION
+    );
+    assertNotNull(
+        currentWorkerPtr,
+        "tfJobRun called from a thread outside the "
+        "job system; " SRC_LOCATION
+    );
+    if(counterPtr){
+        atomic_fetch_add_explicit(
+            &(counterPtr->_pending),
+            1u,
+            memory_order_relaxed
+        );
+    }
+    Job job = {func, argPtr, counterPtr};
+    #ifdef PG_ALLOC_TRACKING
+    job.allocScope = pgAllocScopeGet();
+    #endif
+    /* if the deque is full, run the job right away */
+    if(!jobDequePush(&(currentWorkerPtr->deque), job)){
+        runJob(job);
+    }
+}
+
+/*
+ * Blocks until every job attached to the given
+ * counter has finished; the calling thread runs
+ * queued jobs while it waits. Must be called from
+ * the main thread or from within a job
+ */
+void tfJobWait(TFJobCounter *counterPtr){
+    assertTrue(
+        initialized,
+        "job system not initialized; " SRC_LOCATION
+    );
+    assertNotNull(
+        currentWorkerPtr,
+        "tfJobWait called from a thread outside the "
+        "job system; " SRC_LOCATION
+    );
+    Job job = {0};
+    while(!tfJobCounterIsDone(counterPtr)){
+        if(findJob(currentWorkerPtr, &job)){
+            runJob(job);
+        }
+        else{
+            /* the remaining jobs are in flight */
+            threadYield();
+        }
+    }
+}
+
+/*
+ * Stops and joins every worker thread if the job
+ * system has not yet been destroyed; all counters
+ * should be waited on beforehand
+ */
+void tfJobSystemDestroy(){
+    if(!initialized){
+        return;
+    }
+    atomic_store_explicit(
+        &running,
+        false,
+        memory_order_release
+    );
+    for(size_t i = 1u; i < workerArraySize; ++i){
+        threadJoin(workersPtr[i].thread);
+    }
+    /* run any stragglers nobody waited on */
+    currentWorkerPtr = &(workersPtr[0]);
+    Job job = {0};
+    while(findJob(currentWorkerPtr, &job)){
+        runJob(job);
+    }
+    currentWorkerPtr = NULL;
+
+    pgFree(workersPtr);
+    workerArraySize = 0u;
+    initialized = false;
+}
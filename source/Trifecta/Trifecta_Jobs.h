@@ -0,0 +1,78 @@
+#ifndef TRIFECTA_JOBS_H
+#define TRIFECTA_JOBS_H
+
+#include <stdatomic.h>
+
+#include "Trifecta_Concurrency.h"
+
+/*
+ * The max number of jobs a single worker may have
+ * queued at once; jobs beyond this run inline
+ */
+#define tfJobDequeCapacity 4096
+
+/* A typedef for a function which can be run as a job */
+typedef void (*TFJobFunc)(void *argPtr);
+
+/*
+ * Tracks the number of unfinished jobs in a group;
+ * pass to tfJobRun() for each job in the group, then
+ * to tfJobWait() to join them all
+ */
+typedef struct TFJobCounter{
+    atomic_size_t _pending;
+} TFJobCounter;
+
+/* Initializes the given job counter to zero */
+void tfJobCounterInit(TFJobCounter *counterPtr);
+
+/*
+ * Returns true if every job attached to the given
+ * counter has finished, false otherwise
+ */
+bool tfJobCounterIsDone(TFJobCounter *counterPtr);
+
+/*
+ * Initializes the job system with the specified
+ * number of worker threads, or one fewer than the
+ * number of processors if 0, if it has not already
+ * been initialized; the calling thread becomes the
+ * main thread of the job system
+ */
+void tfJobSystemInit(size_t workerCount);
+
+/*
+ * Returns the number of worker threads in the job
+ * system, not counting the main thread
+ */
+size_t tfJobSystemWorkerCount();
+
+/*
+ * Queues the given function to be run with the given
+ * argument on some thread of the job system; if the
+ * counter pointer is not NULL, it is incremented now
+ * and decremented once the job finishes. Must be
+ * called from the main thread or from within a job
+ */
+void tfJobRun(
+    TFJobFunc func,
+    void *argPtr,
+    TFJobCounter *counterPtr
+);
+
+/*
+ * Blocks until every job attached to the given
+ * counter has finished; the calling thread runs
+ * queued jobs while it waits. Must be called from
+ * the main thread or from within a job
+ */
+void tfJobWait(TFJobCounter *counterPtr);
+
+/*
+ * Stops and joins every worker thread if the job
+ * system has not yet been destroyed; all counters
+ * should be waited on beforehand
+ */
+void tfJobSystemDestroy();
+
+#endif
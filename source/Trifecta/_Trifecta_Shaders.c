@@ -74,10 +74,10 @@ GLuint _loadShaders(){
                 vertexShaderId,
                 logLength,
                 NULL,
-                errorMsg._ptr
+                stringCharPtr(&errorMsg)
             );
             pgWarning("error compiling vertex shader");
-            pgError(errorMsg._ptr);
+            pgError(stringCharPtr(&errorMsg));
 	    }
     }
 
@@ -110,10 +110,10 @@ GLuint _loadShaders(){
                 fragmentShaderId,
                 logLength,
                 NULL,
-                errorMsg._ptr
+                stringCharPtr(&errorMsg)
             );
             pgWarning("error compiling frag shader");
-            pgError(errorMsg._ptr);
+            pgError(stringCharPtr(&errorMsg));
 	    }
     }
 
@@ -143,9 +143,9 @@ GLuint _loadShaders(){
                 programId,
                 logLength,
                 NULL,
-                errorMsg._ptr
+                stringCharPtr(&errorMsg)
             );
-            pgError(errorMsg._ptr);
+            pgError(stringCharPtr(&errorMsg));
 	    }
     }
 
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
+#include "ZMath_Bitwise.h"
+
 /*
  * VECS supports up to 64 components, each one having
  * id of the form 2^k
@@ -119,4 +121,18 @@ typedef uint32_t VecsComponentId;
         vecsComponentSetFromId(id) \
     )
 
+/*
+ * Returns the lowest component id in the specified
+ * component set, which must be nonempty
+ */
+#define vecsComponentSetFirstId(set) \
+    ((VecsComponentId)countTrailingZeros64(set))
+
+/*
+ * Removes the lowest component id from the given
+ * component set
+ */
+#define vecsComponentSetRemoveFirstId(set) \
+    clearLowestBit(set)
+
 #endif
\ No newline at end of file
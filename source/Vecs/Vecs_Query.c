@@ -194,6 +194,7 @@ static bool _vecsQueryItrSkipEmptyArchetypes(
     return true;
 }
 
+#ifdef PG_HOT_CHECKS_ENABLED
 /*
  * Throws error if concurrent modification detected
  * for the specified query iterator
@@ -212,6 +213,7 @@ static void errorIfConcurrentModification(
         SRC_LOCATION
     );
 }
+#endif
 
 /* Returns an iterator over the specified query */
 VecsQueryItr vecsQueryItr(VecsQuery *queryPtr){
@@ -253,7 +255,7 @@ VecsQueryItr vecsQueryItr(VecsQuery *queryPtr){
  * has more elements, false otherwise
  */
 bool vecsQueryItrHasEntity(VecsQueryItr *itrPtr){
-    errorIfConcurrentModification(itrPtr);
+    hotCheck(errorIfConcurrentModification(itrPtr));
     /*
      * if the current archetype itr has entities,
      * _vecsQuerySkipEmptyArchetypes will return
@@ -271,7 +273,7 @@ void vecsQueryItrAdvance(VecsQueryItr *itrPtr){
     if(!itrPtr || !(itrPtr->_queryPtr)){
         return;
     }
-    errorIfConcurrentModification(itrPtr);
+    hotCheck(errorIfConcurrentModification(itrPtr));
 
     _vecsArchetypeItrAdvance(&(itrPtr->_archetypeItr));
     _vecsQueryItrSkipEmptyArchetypes(itrPtr);
@@ -288,14 +290,14 @@ void *_vecsQueryItrGetPtr(
     VecsQueryItr *itrPtr,
     VecsComponentId componentId
 ){
-    assertTrue(
+    hotAssertTrue(
         vecsQueryItrHasEntity(itrPtr),
         "error: query itr has no entities left; "
         SRC_LOCATION
     );
 
     /* error if component id is invalid for query */
-    assertTrue(
+    hotAssertTrue(
         vecsComponentSetContainsId(
             itrPtr->_queryPtr->_acceptComponentSet,
             componentId
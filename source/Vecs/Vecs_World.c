@@ -2,6 +2,8 @@
 
 #define archetypeListInitCapacity 50
 #define queryListInitCapacity 50
+/* the allocation tag of the memory of the world */
+#define allocTag "vecs"
 
 /* A pair of component sets used for query mapping */
 typedef struct VecsComponentSetPair{
@@ -158,7 +160,8 @@ VecsWorld vecsWorldMake(
     size_t entityCapacity,
     VecsComponentList *componentListPtr
 ){
-    return (VecsWorld) {
+    pgAllocPushTag(allocTag);
+    VecsWorld toRet = {
         ._archetypeList = arrayListMake(
             _VecsArchetype,
             archetypeListInitCapacity
@@ -207,6 +210,8 @@ VecsWorld vecsWorldMake(
             entityCapacity
         )
     };
+    pgAllocPopTag();
+    return toRet;
 }
 
 /* Clears all state of the specified ECS world */
@@ -791,13 +796,14 @@ bool _vecsWorldIdAddComponent(
 }
 
 /*
- * Queues an order to add the given component to the
- * specified entity, returns true if successful, false
- * otherwise (e.g. the entity is dead); the
- * componentPtr is shallow copied to the heap and the
- * original pointer is not freed by the ECS
+ * Pushes an order to add the given component to the
+ * specified entity of the given ECS world to the back
+ * of the specified queue, returns true if successful,
+ * false otherwise (e.g. the entity is dead); the
+ * world is only read
  */
-bool _vecsWorldEntityQueueAddComponent(
+static bool vecsWorldQueueAddComponentOrder(
+    ArrayList *queuePtr,
     VecsWorld *worldPtr,
     VecsComponentId componentId,
     VecsEntity entity,
@@ -812,6 +818,7 @@ bool _vecsWorldEntityQueueAddComponent(
             worldPtr->_componentListPtr,
             componentId
         );
+    pgAllocPushTag(allocTag);
     void *heapCopy = NULL;
     /* make a heap copy if component not marker */
     if(componentMetadata._componentSize != 0){
@@ -832,12 +839,35 @@ bool _vecsWorldEntityQueueAddComponent(
         heapCopy
     };
     arrayListPushBack(AddComponentOrder,
-        &(worldPtr->_addComponentQueue),
+        queuePtr,
         order
     );
+    pgAllocPopTag();
     return true;
 }
 
+/*
+ * Queues an order to add the given component to the
+ * specified entity, returns true if successful, false
+ * otherwise (e.g. the entity is dead); the
+ * componentPtr is shallow copied to the heap and the
+ * original pointer is not freed by the ECS
+ */
+bool _vecsWorldEntityQueueAddComponent(
+    VecsWorld *worldPtr,
+    VecsComponentId componentId,
+    VecsEntity entity,
+    void *componentPtr
+){
+    return vecsWorldQueueAddComponentOrder(
+        &(worldPtr->_addComponentQueue),
+        worldPtr,
+        componentId,
+        entity,
+        componentPtr
+    );
+}
+
 /*
  * Sets the given component to the specified entity,
  * returns true if successful, false otherwise; the
@@ -955,14 +985,14 @@ bool _vecsWorldIdSetComponent(
 }
 
 /*
- * Queues an order to set the given component of the
- * specified entity to the provided value, returns true
- * if successful, false otherwise (e.g. the entity is
- * dead); the componentPtr is shallow copied to the
- * heap and the original pointer is not freed by the
- * ECS
+ * Pushes an order to set the given component of the
+ * specified entity of the given ECS world to the back
+ * of the specified queue, returns true if successful,
+ * false otherwise (e.g. the entity is dead); the
+ * world is only read
  */
-bool _vecsWorldEntityQueueSetComponent(
+static bool vecsWorldQueueSetComponentOrder(
+    ArrayList *queuePtr,
     VecsWorld *worldPtr,
     VecsComponentId componentId,
     VecsEntity entity,
@@ -977,6 +1007,7 @@ bool _vecsWorldEntityQueueSetComponent(
                worldPtr->_componentListPtr,
                componentId
         );
+    pgAllocPushTag(allocTag);
     void *heapCopy = NULL;
     /* make a heap copy if component not marker */
     if(componentMetadata._componentSize != 0){
@@ -997,12 +1028,36 @@ bool _vecsWorldEntityQueueSetComponent(
         heapCopy
     };
     arrayListPushBack(SetComponentOrder,
-        &(worldPtr->_setComponentQueue),
+        queuePtr,
         order
     );
+    pgAllocPopTag();
     return true;
 }
 
+/*
+ * Queues an order to set the given component of the
+ * specified entity to the provided value, returns true
+ * if successful, false otherwise (e.g. the entity is
+ * dead); the componentPtr is shallow copied to the
+ * heap and the original pointer is not freed by the
+ * ECS
+ */
+bool _vecsWorldEntityQueueSetComponent(
+    VecsWorld *worldPtr,
+    VecsComponentId componentId,
+    VecsEntity entity,
+    void *componentPtr
+){
+    return vecsWorldQueueSetComponentOrder(
+        &(worldPtr->_setComponentQueue),
+        worldPtr,
+        componentId,
+        entity,
+        componentPtr
+    );
+}
+
 /*
  * Removes the specified component from the given
  * entity, returns true if successful, false otherwise;
@@ -1091,10 +1146,12 @@ bool _vecsWorldIdRemoveComponent(
 }
 
 /*
- * Queues an order to remove the specified component
- * from the given entity
+ * Pushes an order to remove the specified component
+ * from the given entity of the given ECS world to the
+ * back of the specified queue; the world is only read
  */
-bool _vecsWorldEntityQueueRemoveComponent(
+static bool vecsWorldQueueRemoveComponentOrder(
+    ArrayList *queuePtr,
     VecsWorld *worldPtr,
     VecsComponentId componentId,
     VecsEntity entity
@@ -1109,12 +1166,29 @@ bool _vecsWorldEntityQueueRemoveComponent(
         componentId
     };
     arrayListPushBack(RemoveComponentOrder,
-        &(worldPtr->_removeComponentQueue),
+        queuePtr,
         order
     );
     return true;
 }
 
+/*
+ * Queues an order to remove the specified component
+ * from the given entity
+ */
+bool _vecsWorldEntityQueueRemoveComponent(
+    VecsWorld *worldPtr,
+    VecsComponentId componentId,
+    VecsEntity entity
+){
+    return vecsWorldQueueRemoveComponentOrder(
+        &(worldPtr->_removeComponentQueue),
+        worldPtr,
+        componentId,
+        entity
+    );
+}
+
 /*
  * Adds the specified entity to the given ECS world
  * and returns the new entity; takes ownership of the
@@ -1125,6 +1199,7 @@ VecsEntity vecsWorldAddEntity(
     VecsWorld *worldPtr,
     ArrayList *componentDataPairListPtr
 ){
+    pgAllocPushTag(allocTag);
     /* allocate a new entity */
     VecsEntity entity = _vecsEntityListAllocate(
         &(worldPtr->_entityList)
@@ -1228,6 +1303,7 @@ VecsEntity vecsWorldAddEntity(
             ).componentPtr
         );
     }
+    pgAllocPopTag();
     return entity;
 }
 
@@ -1243,6 +1319,7 @@ void vecsWorldQueueAddEntity(
     VecsWorld *worldPtr,
     ArrayList *componentDataPairListPtr
 ){
+    pgAllocPushTag(allocTag);
     /* add a dummy to the queue; construct in place */
     AddEntityOrder dummy = {0};
     arrayListPushBack(AddEntityOrder,
@@ -1342,6 +1419,7 @@ void vecsWorldQueueAddEntity(
             dataPair
         );
     } /* end of for loop */
+    pgAllocPopTag();
 }
 
 /*
@@ -1403,11 +1481,12 @@ bool vecsWorldIdRemoveEntity(
 }
 
 /*
- * Queues an order to remove the specified entity from
- * the given ECS world, returns true if successful,
- * false otherwise (e.g. if the entity is already dead)
+ * Pushes an order to remove the specified entity from
+ * the given ECS world to the back of the specified
+ * queue; the world is only read
  */
-bool vecsWorldEntityQueueRemoveEntity(
+static bool vecsWorldQueueRemoveEntityOrder(
+    ArrayList *queuePtr,
     VecsWorld *worldPtr,
     VecsEntity entity
 ){
@@ -1419,12 +1498,28 @@ bool vecsWorldEntityQueueRemoveEntity(
         .entity = entity
     };
     arrayListPushBack(RemoveEntityOrder,
-        &(worldPtr->_removeEntityQueue),
+        queuePtr,
         order
     );
     return true;
 }
 
+/*
+ * Queues an order to remove the specified entity from
+ * the given ECS world, returns true if successful,
+ * false otherwise (e.g. if the entity is already dead)
+ */
+bool vecsWorldEntityQueueRemoveEntity(
+    VecsWorld *worldPtr,
+    VecsEntity entity
+){
+    return vecsWorldQueueRemoveEntityOrder(
+        &(worldPtr->_removeEntityQueue),
+        worldPtr,
+        entity
+    );
+}
+
 /*
  * Handles all queued remove entity orders given
  * to the ECS world since the last time this
@@ -1583,16 +1678,201 @@ static void vecsWorldHandleSetComponentOrders(
     );
 }
 
+/*
+ * Constructs and returns a new empty order buffer by
+ * value
+ */
+VecsOrderBuffer vecsOrderBufferMake(size_t initCapacity){
+    pgAllocPushTag(allocTag);
+    VecsOrderBuffer toRet = {
+        ._addComponentQueue = arrayListMake(
+            AddComponentOrder,
+            initCapacity
+        ),
+        ._setComponentQueue = arrayListMake(
+            SetComponentOrder,
+            initCapacity
+        ),
+        ._removeComponentQueue = arrayListMake(
+            RemoveComponentOrder,
+            initCapacity
+        ),
+        ._removeEntityQueue = arrayListMake(
+            RemoveEntityOrder,
+            initCapacity
+        )
+    };
+    pgAllocPopTag();
+    return toRet;
+}
+
+/*
+ * Queues an order in the specified buffer to add the
+ * given component to the specified entity of the
+ * given ECS world, returns true if successful, false
+ * otherwise (e.g. the entity is dead); the world is
+ * only read, and the componentPtr is shallow copied
+ * to the heap
+ */
+bool _vecsOrderBufferQueueAddComponent(
+    VecsOrderBuffer *bufferPtr,
+    VecsWorld *worldPtr,
+    VecsComponentId componentId,
+    VecsEntity entity,
+    void *componentPtr
+){
+    return vecsWorldQueueAddComponentOrder(
+        &(bufferPtr->_addComponentQueue),
+        worldPtr,
+        componentId,
+        entity,
+        componentPtr
+    );
+}
+
+/*
+ * Queues an order in the specified buffer to set the
+ * given component of the specified entity of the
+ * given ECS world, returns true if successful, false
+ * otherwise (e.g. the entity is dead); the world is
+ * only read, and the componentPtr is shallow copied
+ * to the heap
+ */
+bool _vecsOrderBufferQueueSetComponent(
+    VecsOrderBuffer *bufferPtr,
+    VecsWorld *worldPtr,
+    VecsComponentId componentId,
+    VecsEntity entity,
+    void *componentPtr
+){
+    return vecsWorldQueueSetComponentOrder(
+        &(bufferPtr->_setComponentQueue),
+        worldPtr,
+        componentId,
+        entity,
+        componentPtr
+    );
+}
+
+/*
+ * Queues an order in the specified buffer to remove
+ * the specified component from the given entity of
+ * the given ECS world, which is only read
+ */
+bool _vecsOrderBufferQueueRemoveComponent(
+    VecsOrderBuffer *bufferPtr,
+    VecsWorld *worldPtr,
+    VecsComponentId componentId,
+    VecsEntity entity
+){
+    return vecsWorldQueueRemoveComponentOrder(
+        &(bufferPtr->_removeComponentQueue),
+        worldPtr,
+        componentId,
+        entity
+    );
+}
+
+/*
+ * Queues an order in the specified buffer to remove
+ * the specified entity from the given ECS world,
+ * which is only read; returns true if successful,
+ * false otherwise (e.g. if the entity is already dead)
+ */
+bool vecsOrderBufferQueueRemoveEntity(
+    VecsOrderBuffer *bufferPtr,
+    VecsWorld *worldPtr,
+    VecsEntity entity
+){
+    return vecsWorldQueueRemoveEntityOrder(
+        &(bufferPtr->_removeEntityQueue),
+        worldPtr,
+        entity
+    );
+}
+
+/*
+ * Moves every order in the specified buffer to the
+ * back of the queues of the given ECS world, leaving
+ * the buffer empty; no other thread may queue orders
+ * for the world meanwhile
+ */
+void vecsWorldAppendOrders(
+    VecsWorld *worldPtr,
+    VecsOrderBuffer *bufferPtr
+){
+    pgAllocPushTag(allocTag);
+    /* the orders own their heap copies; move them */
+    #define appendQueue(TYPENAME, QUEUENAME) \
+        do{ \
+            for(size_t i = 0; \
+                i < bufferPtr->QUEUENAME.size; \
+                ++i \
+            ){ \
+                arrayListPushBack(TYPENAME, \
+                    &(worldPtr->QUEUENAME), \
+                    arrayListGet(TYPENAME, \
+                        &(bufferPtr->QUEUENAME), \
+                        i \
+                    ) \
+                ); \
+            } \
+            arrayListClear(TYPENAME, \
+                &(bufferPtr->QUEUENAME) \
+            ); \
+        } while(false)
+
+    appendQueue(AddComponentOrder, _addComponentQueue);
+    appendQueue(SetComponentOrder, _setComponentQueue);
+    appendQueue(
+        RemoveComponentOrder,
+        _removeComponentQueue
+    );
+    appendQueue(RemoveEntityOrder, _removeEntityQueue);
+
+    #undef appendQueue
+    pgAllocPopTag();
+}
+
+/*
+ * Frees the memory associated with the given order
+ * buffer, including that of any orders left in it
+ */
+void vecsOrderBufferFree(VecsOrderBuffer *bufferPtr){
+    arrayListApply(AddComponentOrder,
+        &(bufferPtr->_addComponentQueue),
+        addComponentOrderFree
+    );
+    arrayListFree(AddComponentOrder,
+        &(bufferPtr->_addComponentQueue)
+    );
+    arrayListApply(SetComponentOrder,
+        &(bufferPtr->_setComponentQueue),
+        setComponentOrderFree
+    );
+    arrayListFree(SetComponentOrder,
+        &(bufferPtr->_setComponentQueue)
+    );
+    arrayListFree(RemoveComponentOrder,
+        &(bufferPtr->_removeComponentQueue)
+    );
+    arrayListFree(RemoveEntityOrder,
+        &(bufferPtr->_removeEntityQueue)
+    );
+}
+
 /*
  * Handles all queued orders given to the ECS world
  * since the last time this function was called
  */
 void vecsWorldHandleOrders(VecsWorld *worldPtr){
+    pgAllocPushTag(allocTag);
     vecsWorldHandleRemoveEntityOrders(worldPtr);
     vecsWorldHandleRemoveComponentOrders(worldPtr);
     vecsWorldHandleAddEntityOrders(worldPtr);
     vecsWorldHandleAddComponentOrders(worldPtr);
     vecsWorldHandleSetComponentOrders(worldPtr);
+    pgAllocPopTag();
 }
 
 /*
@@ -662,6 +662,162 @@ bool vecsWorldEntityQueueRemoveEntity(
         vecsWorldGetEntityById(worldPtr, entityId) \
     )
 
+/*
+ * Orders queued apart from an ECS world, so that
+ * several threads can queue orders for the same world
+ * at once; the orders do nothing until appended to
+ * the queues of the world itself
+ */
+typedef struct VecsOrderBuffer{
+    ArrayList _addComponentQueue;
+    ArrayList _setComponentQueue;
+    ArrayList _removeComponentQueue;
+    ArrayList _removeEntityQueue;
+} VecsOrderBuffer;
+
+/*
+ * Constructs and returns a new empty order buffer by
+ * value
+ */
+VecsOrderBuffer vecsOrderBufferMake(size_t initCapacity);
+
+/*
+ * Queues an order in the specified buffer to add the
+ * given component to the specified entity of the
+ * given ECS world, returns true if successful, false
+ * otherwise (e.g. the entity is dead); the world is
+ * only read, and the componentPtr is shallow copied
+ * to the heap
+ */
+bool _vecsOrderBufferQueueAddComponent(
+    VecsOrderBuffer *bufferPtr,
+    VecsWorld *worldPtr,
+    VecsComponentId componentId,
+    VecsEntity entity,
+    void *componentPtr
+);
+
+/*
+ * Queues an order in the specified buffer to add the
+ * given component to the specified entity of the
+ * given ECS world, returns true if successful, false
+ * otherwise (e.g. the entity is dead); the world is
+ * only read, and the componentPtr is shallow copied
+ * to the heap
+ */
+#define vecsOrderBufferQueueAddComponent( \
+    typeName, \
+    bufferPtr, \
+    worldPtr, \
+    entity, \
+    componentPtr \
+) \
+    (_vecsOrderBufferQueueAddComponent( \
+        bufferPtr, \
+        worldPtr, \
+        vecsComponentGetId(typeName), \
+        entity, \
+        componentPtr \
+    ))
+
+/*
+ * Queues an order in the specified buffer to set the
+ * given component of the specified entity of the
+ * given ECS world, returns true if successful, false
+ * otherwise (e.g. the entity is dead); the world is
+ * only read, and the componentPtr is shallow copied
+ * to the heap
+ */
+bool _vecsOrderBufferQueueSetComponent(
+    VecsOrderBuffer *bufferPtr,
+    VecsWorld *worldPtr,
+    VecsComponentId componentId,
+    VecsEntity entity,
+    void *componentPtr
+);
+
+/*
+ * Queues an order in the specified buffer to set the
+ * given component of the specified entity of the
+ * given ECS world, returns true if successful, false
+ * otherwise (e.g. the entity is dead); the world is
+ * only read, and the componentPtr is shallow copied
+ * to the heap
+ */
+#define vecsOrderBufferQueueSetComponent( \
+    typeName, \
+    bufferPtr, \
+    worldPtr, \
+    entity, \
+    componentPtr \
+) \
+    (_vecsOrderBufferQueueSetComponent( \
+        bufferPtr, \
+        worldPtr, \
+        vecsComponentGetId(typeName), \
+        entity, \
+        componentPtr \
+    ))
+
+/*
+ * Queues an order in the specified buffer to remove
+ * the specified component from the given entity of
+ * the given ECS world, which is only read
+ */
+bool _vecsOrderBufferQueueRemoveComponent(
+    VecsOrderBuffer *bufferPtr,
+    VecsWorld *worldPtr,
+    VecsComponentId componentId,
+    VecsEntity entity
+);
+
+/*
+ * Queues an order in the specified buffer to remove
+ * the specified component from the given entity of
+ * the given ECS world, which is only read
+ */
+#define vecsOrderBufferQueueRemoveComponent( \
+    typeName, \
+    bufferPtr, \
+    worldPtr, \
+    entity \
+) \
+    (_vecsOrderBufferQueueRemoveComponent( \
+        bufferPtr, \
+        worldPtr, \
+        vecsComponentGetId(typeName), \
+        entity \
+    ))
+
+/*
+ * Queues an order in the specified buffer to remove
+ * the specified entity from the given ECS world,
+ * which is only read; returns true if successful,
+ * false otherwise (e.g. if the entity is already dead)
+ */
+bool vecsOrderBufferQueueRemoveEntity(
+    VecsOrderBuffer *bufferPtr,
+    VecsWorld *worldPtr,
+    VecsEntity entity
+);
+
+/*
+ * Moves every order in the specified buffer to the
+ * back of the queues of the given ECS world, leaving
+ * the buffer empty; no other thread may queue orders
+ * for the world meanwhile
+ */
+void vecsWorldAppendOrders(
+    VecsWorld *worldPtr,
+    VecsOrderBuffer *bufferPtr
+);
+
+/*
+ * Frees the memory associated with the given order
+ * buffer, including that of any orders left in it
+ */
+void vecsOrderBufferFree(VecsOrderBuffer *bufferPtr);
+
 /*
  * Handles all queued orders given to the ECS world
  * since the last time this function was called
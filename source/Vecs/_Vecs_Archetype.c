@@ -30,17 +30,16 @@ _VecsArchetype _vecsArchetypeMake(
     };
 
     /* initialize each component array */
-    for(VecsComponentId i = 0;
-        i < vecsMaxNumComponents;
-        ++i
-    ){
-        /* skip if component not within archetype */
-        if(!vecsComponentSetContainsId(
-            componentSet,
-            i
-        )){
-            continue;
-        }
+    VecsComponentSet remainingComponents
+        = componentSet;
+    while(remainingComponents){
+        VecsComponentId i = vecsComponentSetFirstId(
+            remainingComponents
+        );
+        remainingComponents
+            = vecsComponentSetRemoveFirstId(
+                remainingComponents
+            );
 
         /* retrieve RTTI for the component */
         VecsComponentMetadata componentMetadata
@@ -61,12 +60,14 @@ _VecsArchetype _vecsArchetypeMake(
                 initEntityCapacity,
                 componentMetadata._componentSize,
                 componentMetadata._typeName
+                PG_ALLOC_SITE_ARG
             );
         #else
         toRet._componentStorageLists[i]
             = _arrayListMake(
                 initEntityCapacity,
                 componentMetadata._componentSize
+                PG_ALLOC_SITE_ARG
             );
         #endif
     }
@@ -145,17 +146,16 @@ void _vecsArchetypeClear(_VecsArchetype *archetypePtr){
     __vecsArchetypeReclaimAllEntities(archetypePtr);
 
     /* clear component data */
-    for(VecsComponentId i = 0;
-        i < vecsMaxNumComponents;
-        ++i
-    ){
-        /* skip if component not within archetype */
-        if(!vecsComponentSetContainsId(
-            archetypePtr->_componentSet,
-            i
-        )){
-            continue;
-        }
+    VecsComponentSet remainingComponents
+        = archetypePtr->_componentSet;
+    while(remainingComponents){
+        VecsComponentId i = vecsComponentSetFirstId(
+            remainingComponents
+        );
+        remainingComponents
+            = vecsComponentSetRemoveFirstId(
+                remainingComponents
+            );
 
         /* retrieve RTTI for the component */
         VecsComponentMetadata componentMetadata
@@ -232,14 +232,14 @@ void *__vecsArchetypeGetPtr(
     VecsComponentId componentId,
     VecsEntity entity
 ){
-    _vecsArchetypeErrorIfBadComponent(
+    hotCheck(_vecsArchetypeErrorIfBadComponent(
         archetypePtr,
         componentId
-    );
-    _vecsArchetypeErrorIfBadEntity(
+    ));
+    hotCheck(_vecsArchetypeErrorIfBadEntity(
         archetypePtr,
         entity
-    );
+    ));
 
     VecsComponentMetadata componentMetadata
         = vecsComponentListGetMetadata(
@@ -372,6 +372,7 @@ void __vecsArchetypeSetPtr(
         #ifdef _DEBUG
         , componentMetadata._typeName
         #endif
+        PG_ALLOC_SITE_ARG
     );
 
     ++(archetypePtr->_modificationCount);
@@ -428,6 +429,7 @@ static void componentStorageListFastRemove(
         #ifdef _DEBUG
         , componentMetadata._typeName
         #endif
+        PG_ALLOC_SITE_ARG
     );
     _arrayListPopBack(
         componentStorageListPtr
@@ -500,21 +502,17 @@ void _vecsArchetypeMoveEntity(
             ->_componentStorageLists[VecsEntityId]
                 .size;
 
-    /* iterate over all possible components */
-    for(VecsComponentId i = 0;
-        i < vecsMaxNumComponents;
-        ++i
-    ){
-        /*
-         * skip if component not within archetype, or
-         * equivalently, if entity lacks component
-         */
-        if(!vecsComponentSetContainsId(
-            srcArchetypePtr->_componentSet,
-            i
-        )){
-            continue;
-        }
+    /* iterate over components within archetype */
+    VecsComponentSet remainingComponents
+        = srcArchetypePtr->_componentSet;
+    while(remainingComponents){
+        VecsComponentId i = vecsComponentSetFirstId(
+            remainingComponents
+        );
+        remainingComponents
+            = vecsComponentSetRemoveFirstId(
+                remainingComponents
+            );
 
         VecsComponentMetadata componentMetadata
             = vecsComponentListGetMetadata(
@@ -558,6 +556,7 @@ void _vecsArchetypeMoveEntity(
                 #ifdef _DEBUG
                 , componentMetadata._typeName
                 #endif
+                PG_ALLOC_SITE_ARG
             );
         }
 
@@ -671,20 +670,16 @@ bool _vecsArchetypeRemoveEntity(
      * if reached here, entity exists in archetype;
      * remove all its components by iterating
      */
-    for(VecsComponentId i = 0;
-        i < vecsMaxNumComponents;
-        ++i
-    ){
-        /*
-         * skip if component not within archetype, or
-         * equivalently, if entity lacks component
-         */
-        if(!vecsComponentSetContainsId(
-            archetypePtr->_componentSet,
-            i
-        )){
-            continue;
-        }
+    VecsComponentSet remainingComponents
+        = archetypePtr->_componentSet;
+    while(remainingComponents){
+        VecsComponentId i = vecsComponentSetFirstId(
+            remainingComponents
+        );
+        remainingComponents
+            = vecsComponentSetRemoveFirstId(
+                remainingComponents
+            );
         VecsComponentMetadata componentMetadata
             = vecsComponentListGetMetadata(
                 archetypePtr->_componentListPtr,
@@ -784,21 +779,21 @@ bool _vecsArchetypeRemoveEntity(
         = archetypePtr->_componentStorageLists
             [VecsEntityId].size;
 
-    /* iterate over all possible components */
-    for(VecsComponentId i = 1;
-        i < vecsMaxNumComponents;
-        ++i
-    ){
-        /*
-         * skip if component not within archetype, or
-         * equivalently, if entity lacks component
-         */
-        if(!vecsComponentSetContainsId(
+    /* iterate over components within archetype */
+    /* entity id (component 0) is skipped */
+    VecsComponentSet remainingComponents
+        = vecsComponentSetRemoveId(
             archetypePtr->_componentSet,
-            i
-        )){
-            continue;
-        }
+            VecsEntityId
+        );
+    while(remainingComponents){
+        VecsComponentId i = vecsComponentSetFirstId(
+            remainingComponents
+        );
+        remainingComponents
+            = vecsComponentSetRemoveFirstId(
+                remainingComponents
+            );
 
         VecsComponentMetadata componentMetadata
             = vecsComponentListGetMetadata(
@@ -819,6 +814,7 @@ bool _vecsArchetypeRemoveEntity(
             _arrayListGrowIfNeeded(
                 componentStoragePtr,
                 componentMetadata._componentSize
+                PG_ALLOC_SITE_ARG
             ),
             "error: failed to grow for archetype add "
             "entity; "
@@ -875,19 +871,16 @@ static void componentStorageListFree(
 static void __vecsArchetypeFreeComponentStorageLists(
     _VecsArchetype *archetypePtr
 ){
-    for(VecsComponentId i = 0;
-        i < vecsMaxNumComponents;
-        ++i
-    ){
-        /*
-         * skip if component not within archetype
-         */
-        if(!vecsComponentSetContainsId(
-            archetypePtr->_componentSet,
-            i
-        )){
-            continue;
-        }
+    VecsComponentSet remainingComponents
+        = archetypePtr->_componentSet;
+    while(remainingComponents){
+        VecsComponentId i = vecsComponentSetFirstId(
+            remainingComponents
+        );
+        remainingComponents
+            = vecsComponentSetRemoveFirstId(
+                remainingComponents
+            );
 
         VecsComponentMetadata componentMetadata
             = vecsComponentListGetMetadata(
@@ -952,6 +945,7 @@ _VecsArchetypeItr _vecsArchetypeItr(
     };
 }
 
+#ifdef PG_HOT_CHECKS_ENABLED
 /*
  * Throws error if concurrent modification detected
  * for the specified archetype iterator
@@ -970,6 +964,7 @@ static void errorIfConcurrentModification(
         SRC_LOCATION
     );
 }
+#endif
 
 /*
  * Returns true if the specified archetype iterator
@@ -978,7 +973,7 @@ static void errorIfConcurrentModification(
 bool _vecsArchetypeItrHasEntity(
     _VecsArchetypeItr *itrPtr
 ){
-    errorIfConcurrentModification(itrPtr);
+    hotCheck(errorIfConcurrentModification(itrPtr));
 
     _VecsArchetype *archetypePtr
         = itrPtr->_archetypePtr;
@@ -1002,7 +997,7 @@ bool _vecsArchetypeItrHasEntity(
 void _vecsArchetypeItrAdvance(
     _VecsArchetypeItr *itrPtr
 ){
-    errorIfConcurrentModification(itrPtr);
+    hotCheck(errorIfConcurrentModification(itrPtr));
     ++(itrPtr->_currentIndex);
 }
 
@@ -1017,8 +1012,8 @@ void *__vecsArchetypeItrGetPtr(
     _VecsArchetypeItr *itrPtr,
     VecsComponentId componentId
 ){
-    errorIfConcurrentModification(itrPtr);
-    assertTrue(
+    hotCheck(errorIfConcurrentModification(itrPtr));
+    hotAssertTrue(
         _vecsArchetypeItrHasEntity(itrPtr),
         "error: archetype itr out of entities; "
         SRC_LOCATION
@@ -1026,10 +1021,10 @@ void *__vecsArchetypeItrGetPtr(
         
     _VecsArchetype *archetypePtr
         = itrPtr->_archetypePtr;
-    _vecsArchetypeErrorIfBadComponent(
+    hotCheck(_vecsArchetypeErrorIfBadComponent(
         archetypePtr,
         componentId
-    );
+    ));
 
     VecsComponentMetadata componentMetadata
         = vecsComponentListGetMetadata(
@@ -1045,6 +1040,7 @@ void *__vecsArchetypeItrGetPtr(
         = &(archetypePtr
             ->_componentStorageLists[componentId]);
 
+    #ifdef PG_HOT_CHECKS_ENABLED
     return _arrayListGetPtr(
         componentStorageListPtr,
         itrPtr->_currentIndex,
@@ -1053,4 +1049,11 @@ void *__vecsArchetypeItrGetPtr(
         , componentMetadata._typeName
         #endif
     );
+    #else
+    return _arrayListElementPtr(
+        componentStorageListPtr,
+        itrPtr->_currentIndex,
+        componentMetadata._componentSize
+    );
+    #endif
 }
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include "ZMath_Bitwise.h"
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 /* Swaps endianness of a short */
 uint16_t byteSwap16(uint16_t i){
     return (i << 8) | (i >> 8);
@@ -83,4 +87,63 @@ uint64_t fromBigEndian64(uint64_t i){
     else{
         return byteSwap64(i);
     }
-}
\ No newline at end of file
+}
+
+#if !defined(__GNUC__) && !defined(__clang__)
+
+/*
+ * Returns the number of trailing zero bits in the
+ * given int, which must be nonzero
+ */
+unsigned int countTrailingZeros32(uint32_t value){
+    #ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward(&index, value);
+    return (unsigned int)index;
+    #else
+    unsigned int count = 0;
+    while(!(value & 1u)){
+        value >>= 1;
+        ++count;
+    }
+    return count;
+    #endif
+}
+
+/*
+ * Returns the number of trailing zero bits in the
+ * given long, which must be nonzero
+ */
+unsigned int countTrailingZeros64(uint64_t value){
+    #if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return (unsigned int)index;
+    #else
+    uint32_t low = (uint32_t)value;
+    if(low){
+        return countTrailingZeros32(low);
+    }
+    return 32u + countTrailingZeros32(
+        (uint32_t)(value >> 32)
+    );
+    #endif
+}
+
+/* Returns the number of set bits in the given int */
+unsigned int popCount32(uint32_t value){
+    /* parallel bit count; no popcnt requirement */
+    value = value - ((value >> 1) & 0x55555555u);
+    value = (value & 0x33333333u)
+        + ((value >> 2) & 0x33333333u);
+    value = (value + (value >> 4)) & 0x0F0F0F0Fu;
+    return (unsigned int)((value * 0x01010101u) >> 24);
+}
+
+/* Returns the number of set bits in the given long */
+unsigned int popCount64(uint64_t value){
+    return popCount32((uint32_t)value)
+        + popCount32((uint32_t)(value >> 32));
+}
+
+#endif
\ No newline at end of file
@@ -62,4 +62,60 @@ uint64_t fromBigEndian64(uint64_t i);
 #define flipBit(variable, i) \
     ((variable) ^= (1 << (i)))
 
+/*
+ * Bit scanning and counting; on GCC and Clang these
+ * map to builtins, elsewhere to functions using
+ * compiler intrinsics or portable fallbacks
+ */
+#if defined(__GNUC__) || defined(__clang__)
+
+/*
+ * Returns the number of trailing zero bits in the
+ * given int, which must be nonzero
+ */
+#define countTrailingZeros32(value) \
+    ((unsigned int)__builtin_ctz((uint32_t)(value)))
+
+/*
+ * Returns the number of trailing zero bits in the
+ * given long, which must be nonzero
+ */
+#define countTrailingZeros64(value) \
+    ((unsigned int)__builtin_ctzll((uint64_t)(value)))
+
+/* Returns the number of set bits in the given int */
+#define popCount32(value) \
+    ((unsigned int)__builtin_popcount((uint32_t)(value)))
+
+/* Returns the number of set bits in the given long */
+#define popCount64(value) \
+    ((unsigned int)__builtin_popcountll( \
+        (uint64_t)(value) \
+    ))
+
+#else
+
+/*
+ * Returns the number of trailing zero bits in the
+ * given int, which must be nonzero
+ */
+unsigned int countTrailingZeros32(uint32_t value);
+
+/*
+ * Returns the number of trailing zero bits in the
+ * given long, which must be nonzero
+ */
+unsigned int countTrailingZeros64(uint64_t value);
+
+/* Returns the number of set bits in the given int */
+unsigned int popCount32(uint32_t value);
+
+/* Returns the number of set bits in the given long */
+unsigned int popCount64(uint64_t value);
+
+#endif
+
+/* Clears the lowest set bit of the given value */
+#define clearLowestBit(value) ((value) & ((value) - 1))
+
 #endif
\ No newline at end of file
@@ -32,16 +32,26 @@ ZMT zmtMake(uint32_t seed){
         sizeof(*(toRet.stateArray))
     );
 
+    zmtSeed(&toRet, seed);
+
+    return toRet;
+}
+
+/*
+ * Reseeds the given Mersenne Twister in place with
+ * the given integer, reusing its state array; it then
+ * generates the same numbers as a new one made with
+ * that seed
+ */
+void zmtSeed(ZMT *zmtPtr, uint32_t seed){
     /* init state array */
-    toRet.stateArray[0] = seed;
+    zmtPtr->stateArray[0] = seed;
     for(int i = 1; i < n; ++i){
         seed = f * (seed ^ (seed >> (w-2))) + i;
-        toRet.stateArray[i] = seed; 
+        zmtPtr->stateArray[i] = seed; 
     }
     
-    toRet.stateIndex = 0;
-
-    return toRet;
+    zmtPtr->stateIndex = 0;
 }
 
 /* 
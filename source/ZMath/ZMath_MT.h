@@ -16,6 +16,14 @@ typedef struct ZMT{
  */
 ZMT zmtMake(uint32_t seed);
 
+/*
+ * Reseeds the given Mersenne Twister in place with
+ * the given integer, reusing its state array; it then
+ * generates the same numbers as a new one made with
+ * that seed
+ */
+void zmtSeed(ZMT *zmtPtr, uint32_t seed);
+
 /*
  * Generates a random char from the given 
  * Mersenne Twister